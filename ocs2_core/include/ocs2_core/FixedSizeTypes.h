@@ -0,0 +1,201 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <type_traits>
+
+#include "ocs2_core/Types.h"
+
+/**
+ * The (state, input) dimensions for which the compile-time fixed-size kernels are instantiated. A problem "declares" its
+ * static dimensions by appearing in this list; the default covers the robotic examples shipped with OCS2 (double integrator,
+ * cartpole, ballbot, and quadrotor). A deployment can replace the list by defining the macro before the build, e.g.
+ * -D'OCS2_FIXED_SIZE_DIMENSIONS(X)=X(4, 1) X(6, 2)'.
+ */
+#ifndef OCS2_FIXED_SIZE_DIMENSIONS
+#define OCS2_FIXED_SIZE_DIMENSIONS(X) X(2, 1) X(4, 1) X(10, 3) X(12, 4)
+#endif
+
+namespace ocs2 {
+
+/**
+ * Fixed-size counterpart of ScalarFunctionQuadraticApproximation for a problem with NX states and NU inputs. The members are
+ * stack allocated so that the products in the LQ kernels are unrolled by Eigen. Setting NX or NU to Eigen::Dynamic yields
+ * the same layout as the dynamic type.
+ */
+template <int NX, int NU>
+struct ScalarFunctionQuadraticApproximationTpl {
+  static constexpr int stateDim = NX;
+  static constexpr int inputDim = NU;
+
+  /** Second derivative w.r.t state */
+  Eigen::Matrix<scalar_t, NX, NX> dfdxx;
+  /** Second derivative w.r.t input (lhs) and state (rhs) */
+  Eigen::Matrix<scalar_t, NU, NX> dfdux;
+  /** Second derivative w.r.t input */
+  Eigen::Matrix<scalar_t, NU, NU> dfduu;
+  /** First derivative w.r.t state */
+  Eigen::Matrix<scalar_t, NX, 1> dfdx;
+  /** First derivative w.r.t input */
+  Eigen::Matrix<scalar_t, NU, 1> dfdu;
+  /** Constant term */
+  scalar_t f = 0.;
+
+  /** Default constructor */
+  ScalarFunctionQuadraticApproximationTpl() = default;
+
+  /** Copy from the dynamic-size type. The dimensions must match NX and NU. */
+  explicit ScalarFunctionQuadraticApproximationTpl(const ScalarFunctionQuadraticApproximation& other) { *this = other; }
+
+  /** Assign from the dynamic-size type. The dimensions must match NX and NU. */
+  ScalarFunctionQuadraticApproximationTpl& operator=(const ScalarFunctionQuadraticApproximation& other) {
+    dfdxx = other.dfdxx;
+    dfdux = other.dfdux;
+    dfduu = other.dfduu;
+    dfdx = other.dfdx;
+    dfdu = other.dfdu;
+    f = other.f;
+    return *this;
+  }
+
+  /** Sets all coefficients to zero. */
+  ScalarFunctionQuadraticApproximationTpl& setZero() {
+    dfdxx.setZero();
+    dfdux.setZero();
+    dfduu.setZero();
+    dfdx.setZero();
+    dfdu.setZero();
+    f = 0.0;
+    return *this;
+  }
+
+  /** Copies into the dynamic-size type. */
+  void toDynamic(ScalarFunctionQuadraticApproximation& other) const {
+    other.dfdxx = dfdxx;
+    other.dfdux = dfdux;
+    other.dfduu = dfduu;
+    other.dfdx = dfdx;
+    other.dfdu = dfdu;
+    other.f = f;
+  }
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/**
+ * Fixed-size counterpart of VectorFunctionLinearApproximation for a function of NV dimensions (defaults to the state
+ * dimension, e.g. the dynamics) of a problem with NX states and NU inputs.
+ */
+template <int NX, int NU, int NV = NX>
+struct VectorFunctionLinearApproximationTpl {
+  static constexpr int stateDim = NX;
+  static constexpr int inputDim = NU;
+
+  /** Derivative w.r.t state */
+  Eigen::Matrix<scalar_t, NV, NX> dfdx;
+  /** Derivative w.r.t input */
+  Eigen::Matrix<scalar_t, NV, NU> dfdu;
+  /** Constant term */
+  Eigen::Matrix<scalar_t, NV, 1> f;
+
+  /** Default constructor */
+  VectorFunctionLinearApproximationTpl() = default;
+
+  /** Copy from the dynamic-size type. The dimensions must match NV, NX, and NU. */
+  explicit VectorFunctionLinearApproximationTpl(const VectorFunctionLinearApproximation& other) { *this = other; }
+
+  /** Assign from the dynamic-size type. The dimensions must match NV, NX, and NU. */
+  VectorFunctionLinearApproximationTpl& operator=(const VectorFunctionLinearApproximation& other) {
+    dfdx = other.dfdx;
+    dfdu = other.dfdu;
+    f = other.f;
+    return *this;
+  }
+
+  /** Sets all coefficients to zero. */
+  VectorFunctionLinearApproximationTpl& setZero() {
+    dfdx.setZero();
+    dfdu.setZero();
+    f.setZero();
+    return *this;
+  }
+
+  /** Copies into the dynamic-size type. */
+  void toDynamic(VectorFunctionLinearApproximation& other) const {
+    other.dfdx = dfdx;
+    other.dfdu = dfdu;
+    other.f = f;
+  }
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/**
+ * Returns a fixed-size read-only view on the memory of a dynamic-size matrix or vector, without copying.
+ *
+ * @tparam Rows : Number of rows of the view.
+ * @tparam Cols : Number of columns of the view.
+ * @param [in] m : Dynamic-size matrix of size Rows x Cols.
+ */
+template <int Rows, int Cols, typename Derived>
+Eigen::Map<const Eigen::Matrix<scalar_t, Rows, Cols>> fixedSizeMap(const Eigen::PlainObjectBase<Derived>& m) {
+  assert(m.rows() == Rows && m.cols() == Cols);
+  return Eigen::Map<const Eigen::Matrix<scalar_t, Rows, Cols>>(m.data());
+}
+
+/**
+ * Calls the generic functor with the compile-time dimensions if (stateDim, inputDim) is one of the pairs listed in
+ * OCS2_FIXED_SIZE_DIMENSIONS. The functor receives std::integral_constant<int, NX> and std::integral_constant<int, NU>.
+ *
+ * Example:
+ *   const bool dispatched = dispatchFixedSize(nx, nu, [&](auto nxTag, auto nuTag) {
+ *     kernel<decltype(nxTag)::value, decltype(nuTag)::value>(...);
+ *   });
+ *   if (!dispatched) { dynamicKernel(...); }
+ *
+ * @param [in] stateDim : The runtime state dimension.
+ * @param [in] inputDim : The runtime input dimension.
+ * @param [in] f : Generic functor.
+ * @return true if a fixed-size instantiation was called, false if the caller should fall back to the dynamic-size path.
+ */
+template <typename Functor>
+bool dispatchFixedSize(int stateDim, int inputDim, Functor&& f) {
+#define OCS2_FIXED_SIZE_CASE(NX, NU)                                             \
+  if (stateDim == (NX) && inputDim == (NU)) {                                    \
+    f(std::integral_constant<int, (NX)>(), std::integral_constant<int, (NU)>()); \
+    return true;                                                                 \
+  }
+  OCS2_FIXED_SIZE_DIMENSIONS(OCS2_FIXED_SIZE_CASE)
+#undef OCS2_FIXED_SIZE_CASE
+  return false;
+}
+
+}  // namespace ocs2
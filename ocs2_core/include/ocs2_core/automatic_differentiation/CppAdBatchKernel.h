@@ -0,0 +1,87 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace ocs2 {
+
+namespace cppad_batch {
+
+/**
+ * Number of points evaluated together by a batch kernel. The points are stored as structure of arrays, i.e. the values of
+ * an input or output element are contiguous for all points of a batch, such that the compiler can vectorize over the points
+ * with AVX2 or AVX-512.
+ */
+constexpr size_t kernelWidth = 8;
+
+/** Signature of a batch kernel: in[i * kernelWidth + k] is input i of point k, and similarly for out. The work array is scratch space. */
+using batch_kernel_t = void (*)(const double* in, double* out, double* work);
+
+/** Signature of the function that returns the required size of the work array of a batch kernel. */
+using batch_work_size_t = unsigned long (*)();
+
+/**
+ * Name of the batch kernel of a generated function.
+ * @param functionName : Name of the generated function, e.g. "model_forward_zero".
+ * @return name of the batch kernel.
+ */
+inline std::string getBatchKernelName(const std::string& functionName) {
+  return functionName + "_batch";
+}
+
+/**
+ * Name of the work size function of a batch kernel.
+ * @param functionName : Name of the generated function, e.g. "model_forward_zero".
+ * @return name of the function that returns the work size.
+ */
+inline std::string getBatchWorkSizeName(const std::string& functionName) {
+  return functionName + "_batch_work_size";
+}
+
+/**
+ * Creates the C source of a batch kernel for a function generated by CppADCodeGen. The kernel is a loop over the points of a
+ * batch which copies the inputs of a point from the structure of arrays layout, calls the generated function, and copies its
+ * outputs back. The generated source is included in the translation unit of the kernel under another function name, such
+ * that the compiler can inline it into the loop and vectorize the loop. Its conditional assignments are replaced by selects.
+ *
+ * @param source : Source of the generated function.
+ * @param functionName : Name of the generated function.
+ * @param inputSize : Size of the input array of the generated function.
+ * @param outputSize : Size of the output array of the generated function.
+ * @return Source of the batch kernel, or an empty string if the function is not defined in the source or calls atomic functions,
+ *         which require the model library.
+ */
+std::string createBatchKernelSource(const std::string& source, const std::string& functionName, size_t inputSize, size_t outputSize);
+
+}  // namespace cppad_batch
+}  // namespace ocs2
@@ -31,30 +31,65 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Eigen
 #include <Eigen/Core>
+#include <Eigen/Sparse>
 
 // STL
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
 
 // CppAD
 #include <cppad/cg.hpp>
 
 // CppAD helpers
 #include <ocs2_core/Types.h>
+#include <ocs2_core/automatic_differentiation/CppAdBatchKernel.h>
+#include <ocs2_core/automatic_differentiation/CppAdModelSwap.h>
 #include <ocs2_core/automatic_differentiation/CppAdSparsity.h>
 #include <ocs2_core/automatic_differentiation/Types.h>
 
 namespace ocs2 {
 
+// forward declarations
+class CppAdBackgroundCompilation;
+class CppAdModelBundle;
+class CppAdParallelCompilation;
+class ThreadPool;
+
 class CppAdInterface {
  public:
   enum class ApproximationOrder { Zero, First, Second };
 
+  /**
+   * Compiler backend for the generated model sources.
+   *  - Gcc: Compiles a shared library with an external gcc process. The library is stored on disk and reused across runs.
+   *  - LlvmJit: Compiles the sources in-process to memory with Clang/LLVM. Nothing is written to disk, the models are
+   *             therefore recompiled in every run and the compile flags are not used. Requires ocs2_core to be built with
+   *             OCS2_CPPAD_LLVM_JIT=ON.
+   */
+  enum class CompilerBackend { Gcc, LlvmJit };
+
   using ad_base_t = ocs2::ad_base_t;
   using ad_scalar_t = ocs2::ad_scalar_t;
   using ad_vector_t = ocs2::ad_vector_t;
   using ad_function_t = std::function<void(const ad_vector_t&, ad_vector_t&)>;
   using ad_parameterized_function_t = std::function<void(const ad_vector_t&, const ad_vector_t&, ad_vector_t&)>;
   using ad_fun_t = CppAD::ADFun<ad_base_t>;
+  using sparse_matrix_t = Eigen::SparseMatrix<scalar_t>;
+
+  /** Row and column indices of the nonzeros of a sparse derivative, in the order of its values. */
+  struct SparseIndices {
+    std::vector<size_t> rows;
+    std::vector<size_t> cols;
+  };
 
   /**
    * Constructor for parameterized functions
@@ -82,10 +117,11 @@ class CppAdInterface {
   CppAdInterface(ad_function_t adFunction, size_t variableDim, std::string modelName, std::string folderName = "/tmp/ocs2",
                  std::vector<std::string> compileFlags = {"-O3", "-g", "-march=native", "-mtune=native", "-ffast-math"});
 
-  ~CppAdInterface() = default;
+  ~CppAdInterface();
 
   /**
-   * Copy constructor. Models are reloaded if available.
+   * Copy constructor. If rhs has loaded its models, the copy shares the loaded library with rhs and only allocates its own
+   * evaluation buffers. Otherwise, models are loaded from disk if available.
    */
   CppAdInterface(const CppAdInterface& rhs);
 
@@ -100,7 +136,10 @@ class CppAdInterface {
   void loadModels(bool verbose = true);
 
   /**
-   * Creates models, compiles them, and saves them to disk
+   * Creates models, compiles them, and saves them to disk. Inside a CppAdParallelCompilation scope, the gcc compilation runs
+   * in the background and the models are loaded when the scope ends. Inside a CppAdBackgroundCompilation scope, this function
+   * returns without waiting for the compilation and the models are evaluated with finite differences until it finishes.
+   * Throws the error of a failed background compilation of this instance, if it has not been thrown yet.
    *
    * @param approximationOrder : Order of derivatives to generate
    * @param verbose : Print out extra information
@@ -108,13 +147,52 @@ class CppAdInterface {
   void createModels(ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
 
   /**
-   * Load models if they are available on disk. Creates a new library otherwise.
+   * Load models if they are available on disk and up to date. Creates a new library otherwise.
+   *
+   * A library is up to date if the cache key stored next to it matches the key of the current model. The key is a hash of
+   * the generated code of the optimized tape, the approximation order, the compile flags, and the CppAD version, such that
+   * a library is recompiled whenever the model changes. Inside a CppAdModelBundle scope, an up to date model of the bundle is
+   * preferred over the library on disk. Throws the error of a failed background compilation of this instance, if it has not
+   * been thrown yet.
    *
    * @param approximationOrder : Order of derivatives to generate
    * @param verbose : Print out extra information
    */
   void loadModelsIfAvailable(ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
 
+  /**
+   * Selects the compiler backend used by createModels and loadModelsIfAvailable. The default is CompilerBackend::Gcc.
+   * Throws if the backend is not available in this build.
+   */
+  void setCompilerBackend(CompilerBackend compilerBackend);
+
+  /** Returns whether the compiler backend is available in this build. */
+  static bool isCompilerBackendAvailable(CompilerBackend compilerBackend);
+
+  /**
+   * Enables the generation of batch kernels for the function value and the Jacobian in createModels and loadModelsIfAvailable,
+   * see getFunctionValueBatch and getJacobianBatch. Disabled by default.
+   */
+  void setBatchKernels(bool enable) { generateBatchKernels_ = enable; }
+
+  /**
+   * Returns whether the models are evaluated by the compiled library. This is false while the library is compiled in a
+   * CppAdBackgroundCompilation, and until the compiled library is swapped in after the compilation has finished.
+   */
+  bool isCompiled() const;
+
+  /**
+   * Switches this instance to the compiled library if its background compilation has finished. A failed compilation is not
+   * thrown, the fallback model stays in use and the error is thrown by the next createModels or loadModelsIfAvailable. Other
+   * threads may evaluate or copy this instance meanwhile: If the instance is in use, it is not switched and false is returned,
+   * such that a later call switches it. To switch all interfaces at once, use swapCompiledCppAdModels.
+   * @return true if this instance switched to the compiled library.
+   */
+  bool trySwapToCompiledModel();
+
+  /** Returns whether the loaded library provides batch kernels for the function value and, if generated, the Jacobian. */
+  bool hasBatchKernels() const;
+
   /**
    * @param x : input vector of size variableDim
    * @param p : parameter vector of size parameterDim
@@ -165,6 +243,99 @@ class CppAdInterface {
    */
   matrix_t getHessian(const vector_t& w, const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /**
+   * Evaluates the value, the Jacobian, and the Hessian of each output at the same point. Compared to separate calls of
+   * getFunctionValue, getJacobian, and getHessian, the input is assembled once and the sparse derivatives are scattered
+   * directly into the outputs with a precomputed map. The outputs are only reallocated and zero filled if their size changes,
+   * afterwards only the nonzeros are written. A caller keeping the approximation across calls must therefore not modify it.
+   *
+   * Requires the models to be generated with ApproximationOrder::Second. Like the model evaluation itself, this function uses
+   * per-instance buffers and must not be called concurrently on the same instance.
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] approximation : f = y, dfdx = d/dx( f(x,p) ), dfdxx[i] = dd/dxdx( f_i(x,p) ). dfdu, dfdux, and dfduu are not used.
+   */
+  void getQuadraticApproximation(const vector_t& x, const vector_t& p, VectorFunctionQuadraticApproximation& approximation) const;
+
+  /**
+   * Evaluates the function at a batch of points. If the library provides batch kernels, cppad_batch::kernelWidth points are
+   * evaluated per call of the generated code. Otherwise, the points are evaluated one by one. Like the model evaluation itself,
+   * this function uses per-instance buffers and must not be called concurrently on the same instance.
+   *
+   * @param xs : inputs of size variableDim, one point per column
+   * @param ps : parameters of size parameterDim, one point per column. Functions without parameters accept a matrix without rows.
+   * @param [out] values : y = f(x,p) of each point in its column, only reallocated if its size changes.
+   */
+  void getFunctionValueBatch(const matrix_t& xs, const matrix_t& ps, matrix_t& values) const;
+
+  /**
+   * Jacobians at a batch of points, see getFunctionValueBatch.
+   *
+   * @param xs : inputs of size variableDim, one point per column
+   * @param ps : parameters of size parameterDim, one point per column. Functions without parameters accept a matrix without rows.
+   * @param [out] jacobians : d/dx( f(x,p) ) of each point, only reallocated if the sizes change.
+   */
+  void getJacobianBatch(const matrix_t& xs, const matrix_t& ps, matrix_array_t& jacobians) const;
+
+  /** Indices of the Jacobian nonzeros w.r.t. the variables x. The pattern is fixed once the models are loaded. */
+  const SparseIndices& getJacobianSparseIndices() const { return jacobianIndices_; }
+
+  /** Indices of the nonzeros in the upper triangular part of the Hessian w.r.t. the variables x, i.e. rows[k] <= cols[k]. */
+  const SparseIndices& getHessianSparseIndices() const { return hessianIndices_; }
+
+  /**
+   * Jacobian nonzeros in the order of getJacobianSparseIndices().
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] values : nonzero values, only reallocated if its size changes.
+   */
+  void getJacobianNonZeros(const vector_t& x, const vector_t& p, vector_t& values) const;
+
+  /**
+   * Nonzeros of the upper triangular part of the weighted Hessian in the order of getHessianSparseIndices().
+   *
+   * @param w: vector of weights of size rangeDim
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] values : nonzero values, only reallocated if its size changes.
+   */
+  void getHessianNonZeros(const vector_t& w, const vector_t& x, const vector_t& p, vector_t& values) const;
+
+  /**
+   * Function value, Jacobian nonzeros, and weighted Hessian nonzeros at the same point, see getJacobianNonZeros and
+   * getHessianNonZeros. The input is assembled once for the three evaluations.
+   *
+   * @param w: vector of weights of size rangeDim
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] value : y = f(x,p), only reallocated if its size changes.
+   * @param [out] jacobianValues : Jacobian nonzeros in the order of getJacobianSparseIndices(), only reallocated if its size changes.
+   * @param [out] hessianValues : Hessian nonzeros in the order of getHessianSparseIndices(), only reallocated if its size changes.
+   */
+  void getApproximationNonZeros(const vector_t& w, const vector_t& x, const vector_t& p, vector_t& value, vector_t& jacobianValues,
+                                vector_t& hessianValues) const;
+
+  /**
+   * Sparse Jacobian, the values are filled into a copy of the cached sparsity pattern.
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @return d/dx( f(x,p) )
+   */
+  sparse_matrix_t getSparseJacobian(const vector_t& x, const vector_t& p = vector_t(0)) const;
+
+  /**
+   * Sparse weighted Hessian with both triangular parts, the values are filled into a copy of the cached sparsity pattern.
+   *
+   * @param w: vector of weights of size rangeDim
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @return dd/dxdx(sum_i  w_i*f_i(x,p) )
+   */
+  sparse_matrix_t getSparseHessian(const vector_t& w, const vector_t& x, const vector_t& p = vector_t(0)) const;
+
  private:
   /**
    * Defines library folder names
@@ -203,9 +374,11 @@ class CppAdInterface {
   void setApproximationOrder(ApproximationOrder approximationOrder, CppAD::cg::ModelCSourceGen<scalar_t>& sourceGen, ad_fun_t& fun) const;
 
   /**
-   * Stores the sparisty nonzeros
+   * Stores the sparisty nonzeros and the maps from the sparse derivatives to the dense outputs
+   * @param jacobianIndices : Nonzeros of the Jacobian in the order of the sparse derivatives
+   * @param hessianIndices : Nonzeros of the upper triangular part of the Hessian in the order of the sparse derivatives
    */
-  void setSparsityNonzeros();
+  void setSparsityPatterns(SparseIndices jacobianIndices, SparseIndices hessianIndices);
 
   /**
    * Creates sparsity pattern for the Jacobian that will be generated
@@ -221,10 +394,122 @@ class CppAdInterface {
    */
   cppad_sparsity::SparsityPattern createHessianSparsity(ad_fun_t& fun) const;
 
-  std::unique_ptr<CppAD::cg::DynamicLib<scalar_t>> dynamicLib_;
+  /** Loaded model library, shared between all copies of this interface. */
+  struct SharedLibrary;
+
+  /** Taped model that is evaluated with finite differences during a background compilation, shared between all copies. */
+  struct FallbackModel;
+
+  /**
+   * Marks an evaluation or a copy of the instance while the swap to the compiled library is pending, see trySwapToCompiledModel.
+   * Once the instance is swapped or has no pending swap, it costs a single atomic load.
+   */
+  class EvaluationGuard;
+
+  friend class CppAdBackgroundCompilation;
+  friend size_t swapCompiledCppAdModels();
+  friend class CppAdModelBundle;
+  friend class CppAdParallelCompilation;
+
+  /**
+   * Tapes the model function and optimizes the operation sequence. Sets the range dimension.
+   * @return taped ad function
+   */
+  std::unique_ptr<ad_fun_t> tapeModel();
+
+  /**
+   * Computes the cache key of the model library from the zero order operation graph of the taped function. For a tape of
+   * tapeModel without VecAD objects, CppAD's allocator is not used, such that the key can be computed without the tape lock.
+   * @param fun : taped ad function
+   * @param approximationOrder : Order of derivatives to generate
+   * @return hexadecimal cache key
+   */
+  std::string computeCacheKey(ad_fun_t& fun, ApproximationOrder approximationOrder) const;
+
+  /**
+   * Reads the cache key of the library on disk.
+   * @return cache key, empty if not available.
+   */
+  std::string readCacheKey() const;
+
+  /**
+   * Generates the sources on the calling thread and compiles them. The compilation runs on the thread pool of the active
+   * CppAdParallelCompilation scope if there is one.
+   */
+  void compileModels(std::unique_ptr<ad_fun_t> fun, ApproximationOrder approximationOrder, std::string cacheKey, bool verbose);
+
+  /** Generates the sources and compiles them in-process with the LLVM JIT. */
+  void jitCompileModels(std::unique_ptr<ad_fun_t> fun, ApproximationOrder approximationOrder, bool verbose);
+
+  /** Waits for a pending background compilation, if any, and loads the model. */
+  void finishCompilation();
+
+  /**
+   * Checks whether the models have to be evaluated by the fallback model. The compiled library only replaces it in
+   * trySwapToCompiledModel, never during an evaluation. Requires an EvaluationGuard in the const functions.
+   * @return true if the fallback model has to be used.
+   */
+  bool useFallbackModel() const { return fallbackModel_ != nullptr; }
+
+  /** Throws the stored error of a failed background compilation, if any, and clears it. */
+  void rethrowCompilationError();
+
+  /**
+   * Creates the fallback model of a background compilation.
+   * @param fun : taped ad function
+   * @param approximationOrder : Order of derivatives to generate
+   * @return fallback model, which evaluates a copy of the tape
+   */
+  std::shared_ptr<FallbackModel> createFallbackModel(ad_fun_t& fun, ApproximationOrder approximationOrder) const;
+
+  /**
+   * Evaluates the models with the taped function until the library of the background compilation is loaded.
+   * @param fallbackModel : The taped model.
+   */
+  void setFallbackModel(std::shared_ptr<FallbackModel> fallbackModel);
+
+  /**
+   * Creates this instance's model from the given library and updates the sizes.
+   * @param sharedLibrary : The loaded model library.
+   */
+  void setSharedLibrary(std::shared_ptr<SharedLibrary> sharedLibrary);
+
+  /** Destroys the model of this instance, if any. */
+  void releaseModel();
+
+  /** Looks up the batch kernels in the loaded library. Requires the lock of the shared library. */
+  void loadBatchKernels();
+
+  /**
+   * Packs the inputs of a batch into the structure of arrays layout of batchInput_.
+   * @return number of valid points, the remaining columns repeat the last point.
+   */
+  size_t packBatchInput(const matrix_t& xs, const matrix_t& ps, size_t start) const;
+
+  /** A kernel of the library that evaluates cppad_batch::kernelWidth points at once. */
+  struct BatchKernel {
+    cppad_batch::batch_kernel_t kernel = nullptr;
+    size_t workSize = 0;
+  };
+
+  std::shared_ptr<SharedLibrary> sharedLibrary_;
+  std::shared_future<std::shared_ptr<SharedLibrary>> pendingLibrary_;
+  std::shared_ptr<FallbackModel> fallbackModel_;
+  std::exception_ptr compilationError_;
+  CppAdParallelCompilation* compilationScope_ = nullptr;
   std::unique_ptr<CppAD::cg::GenericModel<scalar_t>> model_;
+
+  // Synchronization of trySwapToCompiledModel with concurrent evaluations and copies, see EvaluationGuard
+  std::atomic_bool swapPending_{false};
+  std::atomic_bool swapInProgress_{false};
+  mutable std::atomic_int numGuardedEvaluations_{0};
+
   ad_parameterized_function_t adFunction_;
   std::vector<std::string> compileFlags_;
+  CompilerBackend compilerBackend_ = CompilerBackend::Gcc;
+  bool generateBatchKernels_ = false;
+  BatchKernel forwardZeroBatch_;
+  BatchKernel sparseJacobianBatch_;
 
   // Sizes
   size_t variableDim_;
@@ -233,6 +518,31 @@ class CppAdInterface {
   size_t nnzJacobian_ = 0;
   size_t nnzHessian_ = 0;
 
+  // Sparsity patterns of the generated derivatives
+  SparseIndices jacobianIndices_;
+  SparseIndices hessianIndices_;
+
+  // Column-major indices of the sparse Jacobian entries in the (rangeDim x variableDim) matrix, and of the sparse upper
+  // triangular Hessian entries and their transposed counterparts in the (variableDim x variableDim) matrix.
+  std::vector<Eigen::Index> jacobianScatter_;
+  std::vector<std::pair<Eigen::Index, Eigen::Index>> hessianScatter_;
+
+  // Sparse matrices with the pattern of the derivatives, and the positions of the sparse entries in their value arrays
+  sparse_matrix_t jacobianPattern_;
+  sparse_matrix_t hessianPattern_;
+  std::vector<Eigen::Index> jacobianPatternScatter_;
+  std::vector<std::pair<Eigen::Index, Eigen::Index>> hessianPatternScatter_;
+
+  // Evaluation buffers of getQuadraticApproximation
+  mutable vector_t xpBuffer_;
+  mutable vector_t weightBuffer_;
+  mutable std::vector<scalar_t> sparseBuffer_;
+
+  // Evaluation buffers of the batch kernels, in structure of arrays layout with one row per point
+  mutable Eigen::Matrix<scalar_t, cppad_batch::kernelWidth, Eigen::Dynamic> batchInput_;
+  mutable Eigen::Matrix<scalar_t, cppad_batch::kernelWidth, Eigen::Dynamic> batchOutput_;
+  mutable std::vector<scalar_t> batchWork_;
+
   // Names
   std::string modelName_;
   std::string folderName_;
@@ -242,4 +552,181 @@ class CppAdInterface {
   std::string libraryName_;
 };
 
+/**
+ * While an instance of this class is alive, the model libraries created by CppAdInterface on the same thread are compiled
+ * concurrently on a thread pool, e.g. all the models of a robot interface. Taping and code generation stay on the calling
+ * thread since CppAD's tape memory is not thread-safe without CppAD::thread_alloc::parallel_setup. The compiler processes,
+ * which dominate the startup time, run in parallel.
+ *
+ * The models are loaded by finish() or when the scope ends, models must therefore not be evaluated before. Copies made inside
+ * the scope share the pending library with the original.
+ *
+ * Example:
+ *   CppAdParallelCompilation parallelCompilation;
+ *   // create the auto-differentiated dynamics, cost, and constraint terms
+ *   parallelCompilation.finish();  // waits for the compilations and loads the models, throws if a compilation failed
+ */
+class CppAdParallelCompilation {
+ public:
+  /**
+   * Constructor. Makes this scope active for the calling thread.
+   * @param nThreads : Number of concurrent compilations.
+   */
+  explicit CppAdParallelCompilation(size_t nThreads = std::max(std::thread::hardware_concurrency(), 1U));
+
+  /**
+   * Destructor. Waits for all compilations and loads the models. Compilation errors are only printed, call finish() to handle
+   * them. Each failed interface also rethrows its error at its next createModels or loadModelsIfAvailable.
+   */
+  ~CppAdParallelCompilation();
+
+  CppAdParallelCompilation(const CppAdParallelCompilation&) = delete;
+  CppAdParallelCompilation& operator=(const CppAdParallelCompilation&) = delete;
+
+  /** Waits for all pending compilations and loads the models. Rethrows the first compilation error. */
+  void finish();
+
+ private:
+  friend class CppAdInterface;
+
+  /** The active scope of the calling thread, nullptr if none. */
+  static CppAdParallelCompilation*& active();
+
+  /**
+   * Runs the compilation on the thread pool.
+   * @param compilation : The compilation task.
+   * @param resources : Objects used by the task. They are kept alive until the scope finishes and are released on its thread.
+   * @return future to the compiled library
+   */
+  std::shared_future<std::shared_ptr<CppAdInterface::SharedLibrary>> submit(
+      std::function<std::shared_ptr<CppAdInterface::SharedLibrary>()> compilation, std::shared_ptr<void> resources);
+
+  void registerInterface(CppAdInterface* adInterface);
+
+  void unregisterInterface(CppAdInterface* adInterface);
+
+  std::unique_ptr<ThreadPool> threadPoolPtr_;
+  CppAdParallelCompilation* previousScope_;
+
+  std::mutex mutex_;
+  std::set<CppAdInterface*> pendingInterfaces_;
+  std::vector<std::pair<std::shared_future<std::shared_ptr<CppAdInterface::SharedLibrary>>, std::shared_ptr<void>>> submittedCompilations_;
+};
+
+/**
+ * While an instance of this class is alive, the model libraries that CppAdInterface has to compile on the same thread are
+ * compiled on background threads, e.g. all the models of a robot interface. Unlike CppAdParallelCompilation, the interfaces
+ * can be used right away: Until its library is compiled, a model is evaluated with its CppAD tape and finite difference
+ * derivatives, which is accurate but slow. Libraries that are up to date on disk are loaded immediately, and the LLVM JIT
+ * backend always compiles on the calling thread.
+ *
+ * The interfaces and all their copies switch to the compiled library in swapCompiledCppAdModels, which the solvers call before
+ * each iteration. The evaluation path never switches models. An interface that is evaluated or copied by another thread while
+ * swapCompiledCppAdModels runs, e.g. by another solver or the MRT rollout, is skipped and switched by a later call. Interfaces
+ * that are not used by a solver are switched by calling swapCompiledCppAdModels or trySwapToCompiledModel.
+ *
+ * The scope only selects the compilation mode, the compilations continue after the scope ends. If a compilation fails, the
+ * interfaces keep evaluating the taped model. The error is thrown by wait() and by the next createModels or
+ * loadModelsIfAvailable of each interface that has observed it, never by an evaluation.
+ *
+ * Example:
+ *   {
+ *     CppAdBackgroundCompilation backgroundCompilation;
+ *     // create the auto-differentiated dynamics, cost, and constraint terms
+ *   }  // returns immediately, the models are usable
+ */
+class CppAdBackgroundCompilation {
+ public:
+  /** Constructor. Makes this scope active for the calling thread. */
+  CppAdBackgroundCompilation();
+
+  /** Destructor. Deactivates the scope without waiting for the compilations. */
+  ~CppAdBackgroundCompilation();
+
+  CppAdBackgroundCompilation(const CppAdBackgroundCompilation&) = delete;
+  CppAdBackgroundCompilation& operator=(const CppAdBackgroundCompilation&) = delete;
+
+  /** Waits until the libraries of all compilations started in this scope are compiled. Rethrows the first compilation error. */
+  void wait() const;
+
+ private:
+  friend class CppAdInterface;
+
+  /** The active scope of the calling thread, nullptr if none. */
+  static CppAdBackgroundCompilation*& active();
+
+  /**
+   * Runs the compilation on a background thread.
+   * @param compilation : The compilation task.
+   * @return future to the compiled library
+   */
+  std::shared_future<std::shared_ptr<CppAdInterface::SharedLibrary>> submit(
+      std::function<std::shared_ptr<CppAdInterface::SharedLibrary>()> compilation);
+
+  CppAdBackgroundCompilation* previousScope_;
+  std::vector<std::shared_future<std::shared_ptr<CppAdInterface::SharedLibrary>>> submittedCompilations_;
+};
+
+/**
+ * A single shared library with the generated models of several CppAdInterfaces, e.g. all the models of a robot interface, and
+ * a manifest with the cache key of each model. The bundle is loaded with one dlopen and does not need the model folders, which
+ * makes it suitable for deployment.
+ *
+ * A bundle is created by CppAdModelBundle::create from the sources that CppAdInterface stores next to the model libraries, or
+ * with the ocs2_cppad_bundle executable. While an instance of this class is alive, CppAdInterface::loadModelsIfAvailable on
+ * the same thread uses the model of the bundle if its cache key matches the current model. Other models are loaded or compiled
+ * as usual. The interfaces keep the library loaded after the scope ends.
+ *
+ * Example:
+ *   {
+ *     CppAdModelBundle modelBundle("/opt/robot/robot_models.so");
+ *     // create the auto-differentiated dynamics, cost, and constraint terms with loadModelsIfAvailable
+ *   }
+ */
+class CppAdModelBundle {
+ public:
+  /**
+   * Constructor. Loads the bundle and makes this scope active for the calling thread. Throws if the file is not a valid bundle.
+   * @param bundleFile : Path of the bundle library.
+   */
+  explicit CppAdModelBundle(std::string bundleFile);
+
+  /** Destructor. Deactivates the scope. */
+  ~CppAdModelBundle();
+
+  CppAdModelBundle(const CppAdModelBundle&) = delete;
+  CppAdModelBundle& operator=(const CppAdModelBundle&) = delete;
+
+  /** Returns the names of the models in the bundle. */
+  std::vector<std::string> getModelNames() const;
+
+  /** Returns the cache key of a model, empty if the bundle does not contain the model. */
+  std::string getCacheKey(const std::string& modelName) const;
+
+  /**
+   * Bundles the model libraries of a model folder. The libraries must have been created by CppAdInterface, which stores their
+   * sources and cache keys in the folder.
+   *
+   * @param modelFolder : The folderName of the CppAdInterfaces.
+   * @param modelNames : The models to bundle. If empty, all models in the folder are bundled.
+   * @param bundleFile : Path of the bundle library to create.
+   * @param compileFlags : Compilation flags of the bundle library.
+   * @param verbose : Print out extra information
+   */
+  static void create(const std::string& modelFolder, std::vector<std::string> modelNames, const std::string& bundleFile,
+                     const std::vector<std::string>& compileFlags = {"-O3", "-g", "-march=native", "-mtune=native", "-ffast-math"},
+                     bool verbose = true);
+
+ private:
+  friend class CppAdInterface;
+
+  /** The active scope of the calling thread, nullptr if none. */
+  static CppAdModelBundle*& active();
+
+  std::string bundleFile_;
+  std::shared_ptr<CppAdInterface::SharedLibrary> sharedLibrary_;
+  std::map<std::string, std::string> cacheKeys_;
+  CppAdModelBundle* previousScope_;
+};
+
 }  // namespace ocs2
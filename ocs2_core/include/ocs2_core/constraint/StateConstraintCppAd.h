@@ -73,6 +73,8 @@ class StateConstraintCppAd : public StateConstraint {
 
  private:
   std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+  // Approximation of the taped function, kept across calls of getQuadraticApproximation
+  mutable VectorFunctionQuadraticApproximation approximation_;
 };
 
 }  // namespace ocs2
@@ -75,6 +75,8 @@ class StateInputConstraintCppAd : public StateInputConstraint {
 
  private:
   std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+  // Approximation of the taped function, kept across calls of getQuadraticApproximation
+  mutable VectorFunctionQuadraticApproximation approximation_;
 };
 
 }  // namespace ocs2
@@ -54,6 +54,19 @@ class ControllerBase {
    */
   virtual vector_t computeInput(scalar_t t, const vector_t& x) = 0;
 
+  /**
+   * @brief Computes the control command at a given time and state and writes it to a preallocated input.
+   * The time lookup starts at the interval of the previous query, which makes the lookup O(1) for monotonically increasing times.
+   * Controllers that override this method do not allocate memory if the input has the right size already. The default implementation
+   * calls computeInput(t, x).
+   *
+   * @param [in] t: Current time.
+   * @param [in] x: Current state.
+   * @param [out] u: Current input.
+   * @param [in, out] timeIntervalHint: The time interval of the previous query, which is updated for the next query. Initialize it with 0.
+   */
+  virtual void computeInputInPlace(scalar_t t, const vector_t& x, vector_t& u, int& timeIntervalHint) { u = computeInput(t, x); }
+
   /**
    * @brief Merges this controller with another controller that comes active later in time
    * This method is typically used to merge controllers from multiple time partitions.
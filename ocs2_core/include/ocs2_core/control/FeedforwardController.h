@@ -85,6 +85,8 @@ class FeedforwardController final : public ControllerBase {
 
   vector_t computeInput(scalar_t t, const vector_t& x) override;
 
+  void computeInputInPlace(scalar_t t, const vector_t& x, vector_t& u, int& timeIntervalHint) override;
+
   void concatenate(const ControllerBase* nextController, int index, int length) override;
 
   int size() const override;
@@ -104,7 +106,7 @@ class FeedforwardController final : public ControllerBase {
   static FeedforwardController unFlatten(const scalar_array_t& timeArray, const std::vector<std::vector<float> const*>& flatArray2);
 
  private:
-  void flattenSingle(scalar_t time, std::vector<float>& flatArray) const;
+  void flattenSingle(LinearInterpolation::index_alpha_t indexAlpha, std::vector<float>& flatArray) const;
 
  public:
   scalar_array_t timeStamp_;
@@ -56,6 +56,18 @@ class StateCost {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const = 0;
 
+  /**
+   * Add the cost term quadratic approximation to the state derivatives of an accumulated approximation. Terms with sparse
+   * derivatives can override this to only add their nonzeros.
+   */
+  virtual void addQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                         const PreComputation& preComp, ScalarFunctionQuadraticApproximation& cost) const {
+    const auto costTermApproximation = getQuadraticApproximation(time, state, targetTrajectories, preComp);
+    cost.f += costTermApproximation.f;
+    cost.dfdx += costTermApproximation.dfdx;
+    cost.dfdxx += costTermApproximation.dfdxx;
+  }
+
  protected:
   StateCost(const StateCost& rhs) = default;
 };
@@ -68,6 +68,10 @@ class StateCostCppAd : public StateCost {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation& preComp) const override;
 
+  /* Adds only the structural nonzeros of the CppAD derivatives */
+  void addQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                 const PreComputation& preComp, ScalarFunctionQuadraticApproximation& cost) const override;
+
  protected:
   StateCostCppAd(const StateCostCppAd& rhs);
 
@@ -76,6 +80,12 @@ class StateCostCppAd : public StateCost {
 
  private:
   std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+  // Value and nonzeros of the derivatives, kept across calls of addQuadraticApproximation
+  mutable vector_t value_;
+  mutable vector_t jacobianNonZeros_;
+  mutable vector_t hessianNonZeros_;
+  // Approximation of the taped function, kept across calls of getQuadraticApproximation
+  mutable VectorFunctionQuadraticApproximation approximation_;
 };
 
 }  // namespace ocs2
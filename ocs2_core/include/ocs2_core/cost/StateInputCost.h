@@ -56,6 +56,16 @@ class StateInputCost {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const = 0;
 
+  /**
+   * Add the cost term quadratic approximation to an accumulated approximation of the same dimensions. Terms with sparse
+   * derivatives can override this to only add their nonzeros.
+   */
+  virtual void addQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                         const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                         ScalarFunctionQuadraticApproximation& cost) const {
+    cost += getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+  }
+
  protected:
   StateInputCost(const StateInputCost& rhs) = default;
 };
@@ -69,6 +69,10 @@ class StateInputCostCppAd : public StateInputCost {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation& preComputation) const override;
 
+  /** Adds only the structural nonzeros of the CppAD derivatives */
+  void addQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                                 const PreComputation& preComputation, ScalarFunctionQuadraticApproximation& cost) const override;
+
  protected:
   StateInputCostCppAd(const StateInputCostCppAd& rhs);
 
@@ -78,6 +82,12 @@ class StateInputCostCppAd : public StateInputCost {
 
  private:
   std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+  // Value and nonzeros of the derivatives, kept across calls of addQuadraticApproximation
+  mutable vector_t value_;
+  mutable vector_t jacobianNonZeros_;
+  mutable vector_t hessianNonZeros_;
+  // Approximation of the taped function, kept across calls of getQuadraticApproximation
+  mutable VectorFunctionQuadraticApproximation approximation_;
 };
 
 }  // namespace ocs2
@@ -122,6 +122,22 @@ class SystemDynamicsBase : public ControlledSystemBase {
    */
   VectorFunctionLinearApproximation linearApproximation(scalar_t t, const vector_t& x, const vector_t& u);
 
+  /**
+   * Computes the flow map linear approximations at a batch of points, e.g. at some nodes of a multiple shooting problem. The points
+   * are selected from trajectories by indices, such that the trajectories are neither copied nor repacked per batch. The default
+   * implementation calls linearApproximation(t, x, u) for each point. Derived classes can evaluate the points together, e.g. with the
+   * batch kernels of the CppAdInterface.
+   *
+   * @param [in] t: Time trajectory.
+   * @param [in] x: State trajectory.
+   * @param [in] u: Input trajectory.
+   * @param [in] indices: The indices i of the points (t[i], x[i], u[i]) of the batch.
+   * @param [out] approximations: Trajectory of state time derivative linear approximations, sized at least as the trajectories. Only
+   *                              the entries of the batch indices are written, such that batches can be evaluated concurrently.
+   */
+  virtual void linearApproximationBatch(const scalar_array_t& t, const vector_array_t& x, const vector_array_t& u,
+                                        const std::vector<size_t>& indices, std::vector<VectorFunctionLinearApproximation>& approximations);
+
   /** Computes the jump map linear approximation.
    *
    * @note This method updates the internal preComputation with the requestPreJump() callback and
@@ -64,8 +64,8 @@ class OperatingPoints final : public Initializer {
   OperatingPoints* clone() const override { return new OperatingPoints(*this); }
 
   void compute(scalar_t time, const vector_t& state, scalar_t nextTime, vector_t& input, vector_t& nextState) override {
-    input = LinearInterpolation::interpolate(time, timeTrajectory_, inputTrajectory_);
-    nextState = LinearInterpolation::interpolate(nextTime, timeTrajectory_, stateTrajectory_);
+    LinearInterpolation::interpolate(time, timeTrajectory_, inputTrajectory_, input);
+    LinearInterpolation::interpolate(nextTime, timeTrajectory_, stateTrajectory_, nextState);
   }
 
  private:
@@ -50,6 +50,43 @@ std::string toString(SensitivityIntegratorType integratorType);
  */
 SensitivityIntegratorType fromString(const std::string& name);
 
+/**
+ * Number of linearizations of the continuous dynamics per interval of the sensitivity discretization, e.g. 4 for RK4.
+ *
+ * Together with getStagePoint and applyStageDiscretization, this splits a DynamicsSensitivityDiscretizer into its stages, such that
+ * a stage of many intervals can be linearized at once with SystemDynamicsBase::linearApproximationBatch.
+ * @param integratorType: Integrator type enum
+ */
+size_t getNumStages(SensitivityIntegratorType integratorType);
+
+/**
+ * Point at which stage s > 0 of the interval [t, t + dt] starting at x is linearized. Stage 0 is linearized at (t, x).
+ *
+ * @param [in] integratorType: Integrator type enum
+ * @param [in] stage: The stage s, 0 < s < getNumStages(integratorType)
+ * @param [in] t : starting time of the discretization interval
+ * @param [in] x : starting state x_{k}
+ * @param [in] dt : interval duration
+ * @param [in] previousStageFlowMap : flow map of stage s - 1
+ * @param [out] stageTime : time of stage s
+ * @param [out] stageState : state of stage s
+ */
+void getStagePoint(SensitivityIntegratorType integratorType, size_t stage, scalar_t t, const vector_t& x, scalar_t dt,
+                   const vector_t& previousStageFlowMap, scalar_t& stageTime, vector_t& stageState);
+
+/**
+ * Discretizes the linear approximations of the continuous dynamics at the stages of the interval [t, t + dt] starting at x.
+ * The result is written to stageApproximations[0][index] in the form x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}.
+ *
+ * @param [in] integratorType: Integrator type enum
+ * @param [in] x : starting state x_{k}
+ * @param [in] dt : interval duration
+ * @param [in, out] stageApproximations : stageApproximations[s][index] is the linearization at stage s, stages s > 0 are used as workspace.
+ * @param [in] index : index of the interval in stageApproximations
+ */
+void applyStageDiscretization(SensitivityIntegratorType integratorType, const vector_t& x, scalar_t dt,
+                              std::vector<std::vector<VectorFunctionLinearApproximation>>& stageApproximations, size_t index);
+
 }  // namespace sensitivity_integrator
 
 /**
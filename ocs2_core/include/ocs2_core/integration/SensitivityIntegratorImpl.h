@@ -48,6 +48,13 @@ vector_t eulerDiscretization(SystemDynamicsBase& system, scalar_t t, const vecto
 VectorFunctionLinearApproximation eulerSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
                                                                  const vector_t& u, scalar_t dt);
 
+/**
+ * Forward euler discretization of a given linear approximation of the continuous dynamics at (x, u), e.g. computed with
+ * SystemDynamicsBase::linearApproximationBatch. The approximation is discretized in place to the form:
+ *      x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+ */
+void applyEulerSensitivityDiscretization(const vector_t& x, scalar_t dt, VectorFunctionLinearApproximation& continuousApproximation);
+
 /**
  * Computes the discretized dynamics. Uses an Runge-Kutta 2nd order discretization.
  * Returns x_{k+1}
@@ -62,6 +69,14 @@ vector_t rk2Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 VectorFunctionLinearApproximation rk2SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt);
 
+/**
+ * Runge-Kutta 2nd order discretization of given linear approximations of the continuous dynamics at its stages:
+ *      k1 at (t, x, u), k2 at (t + dt, x + dt * k1.f, u)
+ * The result is written to k1 in the form x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}, k2 is used as workspace.
+ */
+void applyRk2SensitivityDiscretization(const vector_t& x, scalar_t dt, VectorFunctionLinearApproximation& k1,
+                                       VectorFunctionLinearApproximation& k2);
+
 /**
  * Computes the discretized dynamics. Uses an Runge-Kutta 4th order discretization.
  * Returns x_{k+1}
@@ -76,4 +91,13 @@ vector_t rk4Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt);
 
+/**
+ * Runge-Kutta 4th order discretization of given linear approximations of the continuous dynamics at its stages:
+ *      k1 at (t, x, u), k2 at (t + dt/2, x + dt/2 * k1.f, u), k3 at (t + dt/2, x + dt/2 * k2.f, u), k4 at (t + dt, x + dt * k3.f, u)
+ * The result is written to k1 in the form x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}, k2 to k4 are used as workspace.
+ */
+void applyRk4SensitivityDiscretization(const vector_t& x, scalar_t dt, VectorFunctionLinearApproximation& k1,
+                                       VectorFunctionLinearApproximation& k2, VectorFunctionLinearApproximation& k3,
+                                       VectorFunctionLinearApproximation& k4);
+
 }  // namespace ocs2
\ No newline at end of file
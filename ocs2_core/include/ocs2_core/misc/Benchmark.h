@@ -29,7 +29,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <algorithm>
 #include <chrono>
+#include <initializer_list>
+#include <limits>
 
 #include "ocs2_core/Types.h"
 
@@ -107,5 +110,67 @@ class RepeatedTimer {
   std::chrono::steady_clock::time_point startTime_;
 };
 
+/**
+ * Wall-clock budget of a repeated computation, e.g. the iterations of a solver call. The duration of the next repetition is predicted from
+ * the RepeatedTimers of its phases, such that the computation can stop before it overruns the budget.
+ */
+class TimeBudget {
+ public:
+  /**
+   * Starts the budget from now on.
+   *
+   * @param [in] budgetInMilliseconds: The duration of the budget, a non-positive value for an unlimited budget.
+   */
+  void start(scalar_t budgetInMilliseconds) {
+    budget_ = std::chrono::duration<scalar_t, std::milli>(budgetInMilliseconds);
+    startTime_ = std::chrono::steady_clock::now();
+  }
+
+  /**
+   * @return Whether the budget is limited
+   */
+  bool isLimited() const { return budget_.count() > 0.0; }
+
+  /**
+   * @return Time elapsed since the start of the budget
+   */
+  scalar_t getElapsedInMilliseconds() const {
+    return std::chrono::duration<scalar_t, std::milli>(std::chrono::steady_clock::now() - startTime_).count();
+  }
+
+  /**
+   * @return Remaining time of the budget, infinity if the budget is unlimited
+   */
+  scalar_t getRemainingInMilliseconds() const {
+    return isLimited() ? budget_.count() - getElapsedInMilliseconds() : std::numeric_limits<scalar_t>::infinity();
+  }
+
+  /**
+   * @return Whether a computation of the given duration still fits into the remaining budget
+   */
+  bool fits(scalar_t durationInMilliseconds) const { return !isLimited() || durationInMilliseconds <= getRemainingInMilliseconds(); }
+
+  /**
+   * Predicts the duration of a computation as the sum of the durations of its phases. The duration of a phase is the larger of its average
+   * and its last interval, such that the prediction follows a slowdown immediately. Phases which were never timed do not contribute.
+   *
+   * @param [in] phaseTimers: The timers of the phases of the computation.
+   * @return The predicted duration
+   */
+  static scalar_t predictDurationInMilliseconds(std::initializer_list<const RepeatedTimer*> phaseTimers) {
+    scalar_t duration = 0.0;
+    for (const auto* timer : phaseTimers) {
+      if (timer->getNumTimedIntervals() > 0) {
+        duration += std::max(timer->getAverageInMilliseconds(), timer->getLastIntervalInMilliseconds());
+      }
+    }
+    return duration;
+  }
+
+ private:
+  std::chrono::duration<scalar_t, std::milli> budget_{0.0};
+  std::chrono::steady_clock::time_point startTime_{std::chrono::steady_clock::now()};
+};
+
 }  // namespace benchmark
 }  // namespace ocs2
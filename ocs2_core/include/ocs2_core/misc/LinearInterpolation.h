@@ -53,6 +53,65 @@ using remove_cvref_t = typename std::remove_cv<typename std::remove_reference<T>
  */
 index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray);
 
+/**
+ * Same as timeSegment(enquiryTime, timeArray), but the interval lookup starts at the interval of the previous query. If the enquiry
+ * times are monotonic, the lookup takes O(1) instead of O(log(n)). See also InterpolationCursor.
+ *
+ * @param [in] enquiryTime: The enquiry time for interpolation.
+ * @param [in] timeArray: interpolation time array.
+ * @param [in, out] intervalHint: The interval of the previous query, which is updated for the next query. Initialize it with 0.
+ * @return {index, alpha}
+ */
+index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, int& intervalHint);
+
+/**
+ * A stateful time-segment lookup on a fixed time array. The cursor remembers the interval of the previous query and starts the next
+ * search from there, such that sequential enquiries (forward or backward in time) take O(1), while random access falls back to a
+ * galloping search (see lookup::findIntervalInTimeArray). A cursor is not thread-safe; each thread should use its own.
+ *
+ * Example:
+ *   LinearInterpolation::InterpolationCursor cursor(timeTrajectory);
+ *   for (const auto t : enquiryTimes) {
+ *     const auto indexAlpha = cursor.timeSegment(t);
+ *     const matrix_t Am = LinearInterpolation::interpolate(indexAlpha, modelDataTrajectory, model_data::dynamics_dfdx);
+ *   }
+ */
+class InterpolationCursor {
+ public:
+  /** Constructs a cursor which is not attached to a time array. Call reset(timeArray) before the first query. */
+  InterpolationCursor() = default;
+
+  /**
+   * Constructor
+   * @param [in] timeArray: interpolation time array. The array is not copied and must outlive the cursor or the next reset.
+   */
+  explicit InterpolationCursor(const std::vector<scalar_t>& timeArray) : timeArrayPtr_(&timeArray) {}
+
+  /** Attaches the cursor to a new time array and restarts the search from the beginning. */
+  void reset(const std::vector<scalar_t>& timeArray) {
+    timeArrayPtr_ = &timeArray;
+    interval_ = 0;
+  }
+
+  /** Restarts the search from the beginning. Call this when the content of the attached time array has changed. */
+  void reset() { interval_ = 0; }
+
+  /**
+   * Get the interval index and interpolation coefficient alpha. Same result as LinearInterpolation::timeSegment(enquiryTime, timeArray).
+   *
+   * @param [in] enquiryTime: The enquiry time for interpolation.
+   * @return {index, alpha}
+   */
+  index_alpha_t timeSegment(scalar_t enquiryTime);
+
+  /** The attached time array. */
+  const std::vector<scalar_t>& timeArray() const { return *timeArrayPtr_; }
+
+ private:
+  const std::vector<scalar_t>* timeArrayPtr_ = nullptr;
+  int interval_ = 0;
+};
+
 /**
  * Directly uses the index and interpolation coefficient provided by the user
  * @note If sizes in data array are not equal, the interpolation will snap to the data
@@ -92,6 +151,35 @@ Data interpolate(index_alpha_t indexAlpha, const std::vector<Data, Alloc>& dataA
 template <typename Data, class Alloc>
 Data interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, const std::vector<Data, Alloc>& dataArray);
 
+/**
+ * Same as interpolate(indexAlpha, dataArray), but the result is written to the given object. This does not allocate memory if the
+ * result has the right size already.
+ *
+ * @param [in] indexAlpha : index and interpolation coefficient (alpha) pair
+ * @param [in] dataArray: vector of data
+ * @param [out] result: The interpolation result
+ *
+ * @tparam Data: Data type
+ * @tparam Alloc: Specialized allocation class
+ */
+template <typename Data, class Alloc>
+void interpolate(index_alpha_t indexAlpha, const std::vector<Data, Alloc>& dataArray, Data& result);
+
+/**
+ * Same as interpolate(enquiryTime, timeArray, dataArray), but the result is written to the given object. This does not allocate
+ * memory if the result has the right size already.
+ *
+ * @param [in] enquiryTime: The enquiry time for interpolation.
+ * @param [in] timeArray: Times vector
+ * @param [in] dataArray: Data vector
+ * @param [out] result: The interpolation result
+ *
+ * @tparam Data: Data type
+ * @tparam Alloc: Specialized allocation class
+ */
+template <typename Data, class Alloc>
+void interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, const std::vector<Data, Alloc>& dataArray, Data& result);
+
 /**
  * Directly uses the index and interpolation coefficient provided by the user
  * @note If sizes in data array are not equal, the interpolation will snap to the data
@@ -139,6 +227,92 @@ template <typename Data, class Alloc, class AccessFun>
 auto interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, const std::vector<Data, Alloc>& dataArray,
                  AccessFun accessFun) -> remove_cvref_t<typename std::result_of<AccessFun(const std::vector<Data, Alloc>&, size_t)>::type>;
 
+/**
+ * Get the interval indices and interpolation coefficients for a grid of enquiry times. The lookup of each enquiry time starts at the
+ * interval of the previous one, such that a sorted grid is resolved in a single merge pass over the time array.
+ *
+ * @param [in] queryTimes: The enquiry times for interpolation, preferably sorted.
+ * @param [in] timeArray: interpolation time array.
+ * @param [out] indexAlphaArray: The {index, alpha} pairs of the enquiry times.
+ */
+void timeSegmentBatch(const std::vector<scalar_t>& queryTimes, const std::vector<scalar_t>& timeArray,
+                      std::vector<index_alpha_t>& indexAlphaArray);
+
+/**
+ * Linearly interpolates the data on a grid of enquiry times. The segments are resolved as in timeSegmentBatch, and the results are
+ * written to the elements of the output array. This does not allocate memory if the output array and its elements have the right size.
+ *
+ * @param [in] queryTimes: The enquiry times for interpolation, preferably sorted.
+ * @param [in] timeArray: Times vector
+ * @param [in] dataArray: Data vector
+ * @param [out] result: The interpolation results, one per enquiry time.
+ *
+ * @tparam Data: Data type
+ * @tparam Alloc: Specialized allocation class
+ */
+template <typename Data, class Alloc>
+void interpolateBatch(const std::vector<scalar_t>& queryTimes, const std::vector<scalar_t>& timeArray,
+                      const std::vector<Data, Alloc>& dataArray, std::vector<Data, Alloc>& result);
+
+/**
+ * Same as interpolateBatch(queryTimes, timeArray, dataArray, result), but interpolates the subfield of Data given by the access function.
+ *
+ * @param [in] queryTimes: The enquiry times for interpolation, preferably sorted.
+ * @param [in] timeArray: Times vector
+ * @param [in] dataArray: Data vector
+ * @param [in] accessFun: Method to access the subfield of Data in array. The signature of the accessFun
+ *                        should be equivalent to the following where Field is any subfield of Data:
+ *                        const Field& AccessFun(const std::vector<Data, Alloc>& array, size_t index)
+ * @param [out] result: The interpolation results, one per enquiry time.
+ *
+ * @tparam Data: Data type
+ * @tparam Alloc: Specialized allocation class
+ * @tparam Field: Type of the subfield
+ * @tparam FieldAlloc: Specialized allocation class of the subfield
+ */
+template <typename Data, class Alloc, class AccessFun, typename Field, class FieldAlloc>
+void interpolateBatch(const std::vector<scalar_t>& queryTimes, const std::vector<scalar_t>& timeArray,
+                      const std::vector<Data, Alloc>& dataArray, AccessFun accessFun, std::vector<Field, FieldAlloc>& result);
+
+/**
+ * An access function together with the object to which the interpolated subfield is written. Use the field() factory to create it.
+ */
+template <class AccessFun, typename Field>
+struct FieldInterpolation {
+  AccessFun accessFun;
+  Field& result;
+};
+
+/**
+ * Creates a FieldInterpolation for interpolateFields.
+ *
+ * @param [in] accessFun: Method to access the subfield of Data in array (see interpolate).
+ * @param [out] result: The object to which the interpolated subfield is written.
+ */
+template <class AccessFun, typename Field>
+FieldInterpolation<AccessFun, Field> field(AccessFun accessFun, Field& result) {
+  return {accessFun, result};
+}
+
+/**
+ * Interpolates several subfields of the data array at the same index-alpha pair. The interval lookup is shared by all subfields, and
+ * each access function reads its subfield of the two neighboring data points. The results are written to the given objects, which does
+ * not allocate memory if they have the right size already.
+ *
+ * Example:
+ *   LinearInterpolation::interpolateFields(indexAlpha, modelDataTrajectory, LinearInterpolation::field(model_data::dynamics_dfdx, Am),
+ *                                          LinearInterpolation::field(model_data::dynamics_dfdu, Bm));
+ *
+ * @param [in] indexAlpha : index and interpolation coefficient (alpha) pair
+ * @param [in] dataArray: vector of data
+ * @param [in, out] fields: The subfields to be interpolated, created by field(accessFun, result).
+ *
+ * @tparam Data: Data type
+ * @tparam Alloc: Specialized allocation class
+ */
+template <typename Data, class Alloc, class... Fields>
+void interpolateFields(index_alpha_t indexAlpha, const std::vector<Data, Alloc>& dataArray, const Fields&... fields);
+
 }  // namespace LinearInterpolation
 }  // namespace ocs2
 
@@ -115,6 +115,58 @@ int findIntervalInTimeArray(const std::vector<SCALAR>& timeArray, SCALAR time) {
   }
 }
 
+/**
+ * Same as findIntervalInTimeArray, but the search starts at the given interval. The interval is bracketed by a galloping (exponential)
+ * search from the hint towards the enquiry time, followed by a binary search inside the bracket. The lookup therefore takes
+ * O(log(d)) where d is the distance between the hinted and the resulting interval, i.e. O(1) for monotonic sequential enquiries in either
+ * direction, and never more than twice the cost of the plain binary search.
+ *
+ * @tparam SCALAR : numerical type of time
+ * @param timeArray : sorted time array to perform the lookup in
+ * @param time : enquiry time
+ * @param intervalHint : the interval to start the search from, e.g. the interval of the previous enquiry time
+ * @return interval between [-1, size(timeArray)-1]
+ */
+template <typename SCALAR = double>
+int findIntervalInTimeArray(const std::vector<SCALAR>& timeArray, SCALAR time, int intervalHint) {
+  if (timeArray.empty()) {
+    return 0;
+  }
+
+  const auto lastIndex = static_cast<int>(timeArray.size()) - 1;
+  const int interval = std::min(std::max(intervalHint, -1), lastIndex);
+
+  // the result is the index before the first element which is not smaller than time. The search range [first, last) is bracketed such
+  // that all elements before first are smaller than time, and the element at last (if any) is not.
+  int first;
+  int last;
+  if (interval >= 0 && !(timeArray[interval] < time)) {
+    // gallop backward
+    last = interval;
+    int step = 1;
+    first = last - step;
+    while (first >= 0 && !(timeArray[first] < time)) {
+      last = first;
+      step *= 2;
+      first = last - step;
+    }
+    first = std::max(first + 1, 0);
+  } else {
+    // gallop forward
+    first = interval + 1;
+    int step = 1;
+    last = first;
+    while (last <= lastIndex && timeArray[last] < time) {
+      first = last + 1;
+      step *= 2;
+      last = first + step - 1;
+    }
+    last = std::min(last, lastIndex + 1);
+  }
+
+  return static_cast<int>(std::lower_bound(timeArray.begin() + first, timeArray.begin() + last, time) - timeArray.begin()) - 1;
+}
+
 /**
  * Same as findIntervalInTimeArray except for 1 rule:
  * if t = t0, a 0 is returned instead of -1
@@ -66,13 +66,10 @@ const Data& stdAccessFun(const std::vector<Data, Alloc>& vec, size_t ind) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
-  // corner cases (no time set OR single time element)
-  if (timeArray.size() <= 1) {
-    return {0, scalar_t(1.0)};
-  }
-
-  const int index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+/**
+ * Computes the interpolation coefficient for the interval found by lookup::findIntervalInTimeArray.
+ */
+inline index_alpha_t timeSegmentInInterval(int index, scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
   const auto lastInterval = static_cast<int>(timeArray.size() - 1);
   if (index >= 0) {
     if (index < lastInterval) {
@@ -104,6 +101,40 @@ inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
+  // corner cases (no time set OR single time element)
+  if (timeArray.size() <= 1) {
+    return {0, scalar_t(1.0)};
+  }
+
+  const int index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+  return timeSegmentInInterval(index, enquiryTime, timeArray);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, int& intervalHint) {
+  // corner cases (no time set OR single time element)
+  if (timeArray.size() <= 1) {
+    return {0, scalar_t(1.0)};
+  }
+
+  intervalHint = lookup::findIntervalInTimeArray(timeArray, enquiryTime, intervalHint);
+  return timeSegmentInInterval(intervalHint, enquiryTime, timeArray);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t InterpolationCursor::timeSegment(scalar_t enquiryTime) {
+  assert(timeArrayPtr_ != nullptr);
+  return LinearInterpolation::timeSegment(enquiryTime, *timeArrayPtr_, interval_);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -120,6 +151,37 @@ Data interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, c
   return interpolate(enquiryTime, timeArray, dataArray, stdAccessFun<Data, Alloc>);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Data, class Alloc>
+void interpolate(index_alpha_t indexAlpha, const std::vector<Data, Alloc>& dataArray, Data& result) {
+  assert(dataArray.size() > 0);
+  if (dataArray.size() > 1) {
+    // Normal interpolation case
+    const int index = indexAlpha.first;
+    const scalar_t alpha = indexAlpha.second;
+    const auto& lhs = dataArray[index];
+    const auto& rhs = dataArray[index + 1];
+    if (areSameSize(rhs, lhs)) {
+      result = alpha * lhs + (scalar_t(1.0) - alpha) * rhs;
+    } else {
+      result = (alpha > 0.5) ? lhs : rhs;
+    }
+  } else {  // dataArray.size() == 1
+    // Time vector has only 1 element -> Constant function
+    result = dataArray[0];
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Data, class Alloc>
+void interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, const std::vector<Data, Alloc>& dataArray, Data& result) {
+  interpolate(timeSegment(enquiryTime, timeArray), dataArray, result);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -153,5 +215,77 @@ auto interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, c
   return interpolate(timeSegment(enquiryTime, timeArray), dataArray, accessFun);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline void timeSegmentBatch(const std::vector<scalar_t>& queryTimes, const std::vector<scalar_t>& timeArray,
+                             std::vector<index_alpha_t>& indexAlphaArray) {
+  indexAlphaArray.resize(queryTimes.size());
+  int intervalHint = 0;
+  for (size_t i = 0; i < queryTimes.size(); i++) {
+    indexAlphaArray[i] = timeSegment(queryTimes[i], timeArray, intervalHint);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+/**
+ * Helper function which interpolates a single subfield of interpolateFields.
+ */
+template <typename Data, class Alloc, class AccessFun, typename Field>
+void interpolateField(index_alpha_t indexAlpha, const std::vector<Data, Alloc>& dataArray,
+                      const FieldInterpolation<AccessFun, Field>& field) {
+  if (dataArray.size() > 1) {
+    // Normal interpolation case
+    const int index = indexAlpha.first;
+    const scalar_t alpha = indexAlpha.second;
+    const auto& lhs = field.accessFun(dataArray, index);
+    const auto& rhs = field.accessFun(dataArray, index + 1);
+    if (areSameSize(rhs, lhs)) {
+      field.result = alpha * lhs + (scalar_t(1.0) - alpha) * rhs;
+    } else {
+      field.result = (alpha > 0.5) ? lhs : rhs;
+    }
+  } else {  // dataArray.size() == 1
+    // Time vector has only 1 element -> Constant function
+    field.result = field.accessFun(dataArray, 0);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Data, class Alloc, class... Fields>
+void interpolateFields(index_alpha_t indexAlpha, const std::vector<Data, Alloc>& dataArray, const Fields&... fields) {
+  assert(dataArray.size() > 0);
+  // expands the parameter pack in order
+  const int unused[] = {0, (interpolateField(indexAlpha, dataArray, fields), 0)...};
+  (void)unused;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Data, class Alloc>
+void interpolateBatch(const std::vector<scalar_t>& queryTimes, const std::vector<scalar_t>& timeArray,
+                      const std::vector<Data, Alloc>& dataArray, std::vector<Data, Alloc>& result) {
+  interpolateBatch(queryTimes, timeArray, dataArray, stdAccessFun<Data, Alloc>, result);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Data, class Alloc, class AccessFun, typename Field, class FieldAlloc>
+void interpolateBatch(const std::vector<scalar_t>& queryTimes, const std::vector<scalar_t>& timeArray,
+                      const std::vector<Data, Alloc>& dataArray, AccessFun accessFun, std::vector<Field, FieldAlloc>& result) {
+  result.resize(queryTimes.size());
+  int intervalHint = 0;
+  for (size_t i = 0; i < queryTimes.size(); i++) {
+    const auto indexAlpha = timeSegment(queryTimes[i], timeArray, intervalHint);
+    interpolateField(indexAlpha, dataArray, field(accessFun, result[i]));
+  }
+}
+
 }  // namespace LinearInterpolation
 }  // namespace ocs2
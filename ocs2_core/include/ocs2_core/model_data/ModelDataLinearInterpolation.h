@@ -38,6 +38,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * be computed as:
  *
  * LinearInterpolation::interpolate(indexAlpha, Pm, &modelDataTrajectory, model_data::cost_dfdux);
+ *
+ * When the trajectory is queried at sequential times (e.g. while integrating the Riccati equations), the index-alpha pair should be
+ * obtained from a LinearInterpolation::InterpolationCursor on the time trajectory, which reuses the previous lookup:
+ *
+ * LinearInterpolation::InterpolationCursor cursor(timeTrajectory);
+ * const auto indexAlpha = cursor.timeSegment(t);
  */
 
 /*
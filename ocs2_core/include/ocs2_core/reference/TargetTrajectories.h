@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <ostream>
+#include <utility>
 
 #include "ocs2_core/Types.h"
 
@@ -52,6 +53,9 @@ struct TargetTrajectories {
   vector_t getDesiredState(scalar_t time) const;
   vector_t getDesiredInput(scalar_t time) const;
 
+  /** Same as {getDesiredState(time), getDesiredInput(time)}, but the time segment is looked up only once. */
+  std::pair<vector_t, vector_t> getDesiredStateInput(scalar_t time) const;
+
   scalar_array_t timeTrajectory;
   vector_array_t stateTrajectory;
   vector_array_t inputTrajectory;
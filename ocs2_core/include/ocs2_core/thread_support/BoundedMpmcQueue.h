@@ -0,0 +1,141 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace ocs2 {
+
+/**
+ * Lock-free bounded multi-producer multi-consumer queue.
+ * - Any thread can push and pop. Each operation claims its cell with a single CAS on the enqueue or dequeue position.
+ * - Every cell carries a sequence number telling whether it is free for the producer or filled for the consumer of a position.
+ *
+ * Implementation follows D. Vyukov's bounded MPMC queue. The capacity is fixed, push fails when the queue is full.
+ *
+ * @tparam T : Element type. It has to be trivially copyable, typically a pointer.
+ */
+template <typename T>
+class BoundedMpmcQueue {
+  static_assert(std::is_trivially_copyable<T>::value, "BoundedMpmcQueue only supports trivially copyable types.");
+
+ public:
+  /**
+   * Constructor
+   * @param [in] capacity: Capacity, rounded up to the next power of two.
+   */
+  explicit BoundedMpmcQueue(size_t capacity = 64) {
+    size_t powerOfTwo = 1;
+    while (powerOfTwo < capacity) {
+      powerOfTwo *= 2;
+    }
+    mask_ = powerOfTwo - 1;
+    cells_.reset(new Cell[powerOfTwo]);
+    for (size_t i = 0; i < powerOfTwo; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  BoundedMpmcQueue(const BoundedMpmcQueue&) = delete;
+  BoundedMpmcQueue& operator=(const BoundedMpmcQueue&) = delete;
+
+  /**
+   * Pushes an element at the back. Can be called by any thread.
+   * @param [in] item: The element.
+   * @return True if the element was pushed, false if the queue was full.
+   */
+  bool push(T item) {
+    size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+      if (diff == 0) {  // free cell, claim it
+        if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {  // the cell of this position is still filled, i.e. the queue is full
+        return false;
+      } else {  // another producer claimed the position
+        pos = enqueuePos_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->data = item;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Pops an element from the front. Can be called by any thread.
+   * @param [out] item: The popped element.
+   * @return True if an element was popped, false if the queue was empty or the element at the front is still being pushed.
+   */
+  bool pop(T& item) {
+    size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1);
+      if (diff == 0) {  // filled cell, claim it
+        if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {  // the cell of this position is not filled yet, i.e. the queue is empty
+        return false;
+      } else {  // another consumer claimed the position
+        pos = dequeuePos_.load(std::memory_order_relaxed);
+      }
+    }
+    item = cell->data;
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** Capacity of the queue. */
+  size_t capacity() const { return mask_ + 1; }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T data;
+  };
+
+  size_t mask_;
+  std::unique_ptr<Cell[]> cells_;
+  std::atomic<size_t> enqueuePos_{0};
+  std::atomic<size_t> dequeuePos_{0};
+};
+
+}  // namespace ocs2
@@ -29,7 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
-#include <ocs2_core/thread_support/Synchronized.h>
+#include <mutex>
+
+#include <ocs2_core/thread_support/TripleBuffer.h>
 
 namespace ocs2 {
 
@@ -40,7 +42,10 @@ namespace ocs2 {
  * In the meantime, multiple threads can set new values to the buffer. The active value is not protected by a mutex, so
  * only one thread should access/modify the active value (i.e. not simultaneously calling get() and updateFromBuffer()).
  *
- * @tparam T : wrapped type
+ * The value is stored in a TripleBuffer: updateFromBuffer() is wait-free and never blocks on a thread calling setBuffer().
+ * Concurrent calls to setBuffer() are serialized with a mutex among themselves.
+ *
+ * @tparam T : wrapped type, must be default constructible and move assignable.
  */
 template <typename T>
 class BufferedValue {
@@ -49,42 +54,37 @@ class BufferedValue {
    * Constructor initializes with a given value and an empty buffer.
    * @param value
    */
-  explicit BufferedValue(T value) : activeValue_(std::move(value)), buffer_(nullptr){};
+  explicit BufferedValue(T value) : buffer_(std::move(value)){};
 
   /** Read the currently active value. */
-  const T& get() const { return activeValue_; }
+  const T& get() const { return buffer_.get(); }
 
   /** Read/write the currently active value. */
-  T& get() { return activeValue_; }
+  T& get() { return buffer_.get(); }
 
   /** Copy a new value into the buffer. */
-  void setBuffer(const T& value) { buffer_.reset(std::make_unique<T>(value)); }
+  void setBuffer(const T& value) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    buffer_.setBuffer(value);
+  }
 
   /** Move a new value into the buffer. */
-  void setBuffer(T&& value) { buffer_.reset(std::make_unique<T>(std::move(value))); }
+  void setBuffer(T&& value) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    buffer_.setBuffer(std::move(value));
+  }
 
   /**
    * Replaces the active value with the value in the buffer.
    * The active value is not mutex protected so this method is NOT thread-safe w.r.t. get()
-   * The buffer is mutex protected, so this method is thread-safe w.r.t. setBuffer()
+   * This method is wait-free and thread-safe w.r.t. setBuffer()
    * @return True: the active value was updated, False: the active value was not updated.
    */
-  bool updateFromBuffer() {
-    // Read buffer with a pointer swap to minimize time under the lock. The swapped value will be null if there was no new value set.
-    std::unique_ptr<T> updatedValuePtr(nullptr);
-    buffer_.swap(updatedValuePtr);
-
-    if (updatedValuePtr != nullptr) {
-      activeValue_ = std::move(*updatedValuePtr);
-      return true;
-    } else {
-      return false;
-    }
-  }
+  bool updateFromBuffer() { return buffer_.updateFromBuffer(); }
 
  private:
-  T activeValue_;
-  Synchronized<T> buffer_;
+  TripleBuffer<T> buffer_;
+  std::mutex writeMutex_;  // serializes the writers, the reader never takes it
 };
 
 }  // namespace ocs2
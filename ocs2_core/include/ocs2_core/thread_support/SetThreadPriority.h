@@ -30,8 +30,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <pthread.h>
+#include <sched.h>
 #include <iostream>
 #include <thread>
+#include <vector>
 
 namespace ocs2 {
 
@@ -73,4 +75,51 @@ inline void setThisThreadPriority(int priority) {
   setThreadPriority(priority, pthread_self());
 }
 
+/**
+ * Restricts the input thread to run only on the given CPU cores.
+ *
+ * @param cpuSet: The indices of the allowed CPU cores. An empty set leaves the affinity of the thread unchanged.
+ * @param thread: A reference to the tread.
+ */
+inline void setThreadAffinity(const std::vector<int>& cpuSet, pthread_t thread) {
+  if (cpuSet.empty()) {
+    return;
+  }
+
+  cpu_set_t cpuMask;
+  CPU_ZERO(&cpuMask);
+  for (const auto cpu : cpuSet) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      std::cerr << "WARNING: Ignoring invalid CPU index " << cpu << " in the thread affinity set." << std::endl;
+      continue;
+    }
+    CPU_SET(cpu, &cpuMask);
+  }
+
+  if (pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuMask) != 0) {
+    std::cerr << "WARNING: Failed to set threads CPU affinity (one possible reason could be "
+                 "that the requested cores are not available to this process.)"
+              << std::endl;
+  }
+}
+
+/**
+ * Restricts the input thread to run only on the given CPU cores.
+ *
+ * @param cpuSet: The indices of the allowed CPU cores. An empty set leaves the affinity of the thread unchanged.
+ * @param thread: A reference to the tread.
+ */
+inline void setThreadAffinity(const std::vector<int>& cpuSet, std::thread& thread) {
+  setThreadAffinity(cpuSet, thread.native_handle());
+}
+
+/**
+ * Restricts the thread this function is called from to run only on the given CPU cores.
+ *
+ * @param cpuSet: The indices of the allowed CPU cores. An empty set leaves the affinity of the thread unchanged.
+ */
+inline void setThisThreadAffinity(const std::vector<int>& cpuSet) {
+  setThreadAffinity(cpuSet, pthread_self());
+}
+
 }  // namespace ocs2
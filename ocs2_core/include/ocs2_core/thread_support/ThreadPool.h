@@ -29,13 +29,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <future>
 #include <mutex>
 #include <queue>
+#include <string>
 #include <thread>
 #include <vector>
 
+#include <ocs2_core/thread_support/BoundedMpmcQueue.h>
+#include <ocs2_core/thread_support/WorkStealingQueue.h>
+
 namespace ocs2 {
 
 /**
@@ -43,13 +49,32 @@ namespace ocs2 {
  */
 class ThreadPool {
  public:
+  /** Strategy used to distribute the tasks over the worker threads. */
+  enum class Scheduler {
+    SharedQueue,   //!< All tasks go through a single mutex protected FIFO queue.
+    WorkStealing,  //!< Each worker owns a lock-free deque and a lock-free injection slot. Idle workers steal from the other workers.
+  };
+
+  /** Strategy used by parallelFor to split the iteration range into chunks. */
+  enum class Chunking {
+    Static,  //!< One contiguous chunk of (end - begin) / (nThreads + 1) iterations per task, but at least grainSize.
+    Guided,  //!< Chunk size decreases with the remaining iterations, i.e. remaining / (nThreads + 1), but at least grainSize.
+    Dynamic  //!< Chunks of exactly grainSize iterations.
+  };
+
   /**
    * Constructor
    *
    * @param [in] nThreads: Number of threads to launch in the pool
    * @param [in] priority: The worker thread priority
+   * @param [in] scheduler: The task scheduling strategy of the pool
+   * @param [in] cpuSet: The CPU cores the threads are pinned to. If there is one core for each participating thread (the workers, and
+   *                     the calling thread if pinCallingThread is set), thread i is pinned to cpuSet[i], otherwise all threads share the
+   *                     whole set. An empty set leaves the CPU affinity of the threads unchanged.
+   * @param [in] pinCallingThread: Also pin the thread calling runParallel or parallelFor (to cpuSet[nThreads] or the whole set).
    */
-  explicit ThreadPool(size_t nThreads = 1, int priority = 0);
+  explicit ThreadPool(size_t nThreads = 1, int priority = 0, Scheduler scheduler = Scheduler::SharedQueue, std::vector<int> cpuSet = {},
+                      bool pinCallingThread = false);
 
   /**
    * Destructor
@@ -80,9 +105,38 @@ class ThreadPool {
    */
   void runParallel(std::function<void(int)> taskFunction, int N);
 
+  /**
+   * Helper function to run a loop over the index range [begin, end) in parallel with the help of the pool.
+   * The range is split into chunks of contiguous indices which are claimed by the workers with one atomic operation per chunk.
+   * The calling thread participates with ID = nThreads, see runParallel.
+   *
+   * @note This is a blocking operation, returns when all iterations are completed.
+   *
+   * @tparam Functor: The loop body, callable as taskFunction(int workerIndex, int i).
+   * @param [in] begin: First index of the loop.
+   * @param [in] end: One past the last index of the loop.
+   * @param [in] grainSize: Minimum number of iterations per chunk.
+   * @param [in] taskFunction: Loop body. workerIndex can be used to index designated thread resources.
+   * @param [in] chunking: The chunking strategy.
+   */
+  template <typename Functor>
+  void parallelFor(int begin, int end, int grainSize, Functor taskFunction, Chunking chunking = Chunking::Guided);
+
   /** Get the number of threads. */
   size_t numThreads() const { return workerThreads_.size(); }
 
+  /** Get the scheduling strategy of the pool. */
+  Scheduler scheduler() const { return scheduler_; }
+
+  /** Get the CPU cores the threads of the pool are pinned to. */
+  const std::vector<int>& cpuSet() const { return cpuSet_; }
+
+  /**
+   * Get the number of tasks submitted from outside the pool which went through the mutex protected overflow queue of the work-stealing
+   * scheduler, because the injection slots of all workers were full.
+   */
+  size_t numOverflowTasks() const { return numOverflowTasks_; }
+
  private:
   struct TaskBase;
 
@@ -90,12 +144,28 @@ class ThreadPool {
   struct Task;
 
   /**
-   * Thread worker loop
+   * Thread worker loop of the shared queue scheduler
    *
    * @param [in] workerIndex: worker thread index
    */
   void worker(int workerIndex);
 
+  /**
+   * Thread worker loop of the work-stealing scheduler
+   *
+   * @param [in] workerIndex: worker thread index
+   */
+  void workStealingWorker(int workerIndex);
+
+  /**
+   * Looks for a task in the own deque and injection slot, the deques and injection slots of the other workers, and finally in the
+   * overflow queue.
+   *
+   * @param [in] workerIndex: worker thread index
+   * @return the task or nullptr if no task was found
+   */
+  std::unique_ptr<TaskBase> findTask(int workerIndex);
+
   /**
    * Run a task asynchronously in another thread
    *
@@ -103,15 +173,91 @@ class ThreadPool {
    */
   void runTask(std::unique_ptr<TaskBase> taskPtr);
 
+  /**
+   * Pushes a task submitted from outside the pool to the injection slots of the work-stealing workers, starting at the next slot in
+   * round-robin order. Only if all slots are full, the task goes to the overflow queue.
+   * numPendingTasks_ has to be raised before, such that a worker never takes a task which is not counted yet.
+   *
+   * @param [in] task: owning pointer to the task object
+   */
+  void injectTask(TaskBase* task);
+
+  /**
+   * Run a batch of tasks asynchronously in other threads. With the shared queue scheduler, the queue lock is only taken once for the
+   * whole batch. With the work-stealing scheduler, no lock is taken unless workers are sleeping or the injection slots overflow.
+   *
+   * @param [in] taskPtrs: task objects
+   */
+  void runTasks(std::vector<std::unique_ptr<TaskBase>> taskPtrs);
+
+  /** Wakes up to numTasks sleeping workers of the work-stealing scheduler */
+  void notifyWorkers(size_t numTasks);
+
+  /**
+   * Get the CPU cores a participating thread is pinned to, see the constructor.
+   *
+   * @param [in] threadIndex: worker thread index, or numThreads() for the calling thread
+   */
+  std::vector<int> getThreadCpuSet(size_t threadIndex) const;
+
+  /** Pins the thread calling runParallel if pinCallingThread is set. Each calling thread is only pinned once. */
+  void pinCallingThread();
+
+  /**
+   * Claims the next chunk of a parallelFor loop.
+   *
+   * @param [in, out] nextIndex: The first index which is not yet claimed. It is shared by all tasks of the loop.
+   * @param [in] end: One past the last index of the loop.
+   * @param [in] chunkSize: The (minimum) chunk size.
+   * @param [in] numTasks: The number of tasks of the loop, used for the guided chunking.
+   * @param [in] chunking: The chunking strategy.
+   * @param [out] chunkBegin: First index of the claimed chunk.
+   * @param [out] chunkEnd: One past the last index of the claimed chunk.
+   * @return false if all iterations are already claimed.
+   */
+  static bool claimChunk(std::atomic_int& nextIndex, int end, int chunkSize, int numTasks, Chunking chunking, int& chunkBegin,
+                         int& chunkEnd);
+
+  const Scheduler scheduler_;
+  const std::vector<int> cpuSet_;
+  const bool pinCallingThread_;
+  std::atomic<std::thread::id> pinnedCallingThreadId_{};
+
   bool stop_{false};  //!< flag telling all threads to stop, protected by taskQueueLock_
 
+  // With the work-stealing scheduler, this is the overflow queue for tasks submitted from outside the pool
   std::queue<std::unique_ptr<TaskBase>> taskQueue_;  // protected by taskQueueLock_
   std::condition_variable taskQueueCondition_;
   std::mutex taskQueueLock_;
 
+  // Work-stealing scheduler
+  std::vector<std::unique_ptr<WorkStealingQueue<TaskBase*>>> workerQueues_;  // one deque per worker, holds owning raw pointers
+  std::vector<std::unique_ptr<BoundedMpmcQueue<TaskBase*>>> injectionQueues_;  // one slot per worker for tasks from outside the pool
+  std::atomic<size_t> nextInjectionIndex_{0};                                   // round-robin start of the next injection
+  std::atomic<size_t> numQueuedOverflowTasks_{0};                               // tasks in taskQueue_, read without the lock
+  std::atomic<size_t> numOverflowTasks_{0};                                     // total number of tasks which went to taskQueue_
+  std::atomic<size_t> numPendingTasks_{0};                                    // number of queued tasks which are not yet picked up
+  std::atomic<size_t> numSleepingWorkers_{0};
+
   std::vector<std::thread> workerThreads_;
 };
 
+namespace thread_pool {
+
+/**
+ * Get string name of the scheduler
+ * @param scheduler: Scheduler enum
+ */
+std::string toString(ThreadPool::Scheduler scheduler);
+
+/**
+ * Get scheduler from string name, useful for reading config file
+ * @param name: Scheduler name, either "SharedQueue" or "WorkStealing"
+ */
+ThreadPool::Scheduler fromString(const std::string& name);
+
+}  // namespace thread_pool
+
 /**
  * Task callback interface class.
  */
@@ -154,4 +300,32 @@ std::future<typename std::result_of<Functor(int)>::type> ThreadPool::run(Functor
   return future;
 }
 
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+template <typename Functor>
+void ThreadPool::parallelFor(int begin, int end, int grainSize, Functor taskFunction, Chunking chunking) {
+  if (begin >= end) {
+    return;
+  }
+
+  const int numIterations = end - begin;
+  const int numWorkers = static_cast<int>(numThreads()) + 1;
+  grainSize = std::max(grainSize, 1);
+  const int chunkSize = (chunking == Chunking::Static) ? std::max(grainSize, (numIterations + numWorkers - 1) / numWorkers) : grainSize;
+  const int numChunksUpperBound = (numIterations + chunkSize - 1) / chunkSize;
+  const int numTasks = std::min(numWorkers, numChunksUpperBound);
+
+  std::atomic_int nextIndex{begin};
+  auto task = [&](int workerIndex) {
+    int chunkBegin, chunkEnd;
+    while (claimChunk(nextIndex, end, chunkSize, numTasks, chunking, chunkBegin, chunkEnd)) {
+      for (int i = chunkBegin; i < chunkEnd; ++i) {
+        taskFunction(workerIndex, i);
+      }
+    }
+  };
+  runParallel(std::move(task), numTasks);
+}
+
 }  // namespace ocs2
@@ -0,0 +1,133 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+namespace ocs2 {
+
+/**
+ * Wait-free single-producer / single-consumer triple buffer.
+ *
+ * The three slots are owned by the producer (write slot), the consumer (read slot) and the buffer itself (middle slot). The producer
+ * fills its write slot and publishes it by exchanging it with the middle slot. The consumer takes the latest published value by
+ * exchanging its read slot with the middle slot. Both operations are a single atomic exchange, so neither side ever waits for the other.
+ * Values that are published but not consumed are overwritten by newer ones.
+ *
+ * Only one thread may act as producer (getWriteBuffer, publish, setBuffer) and only one thread may act as consumer (get,
+ * updateFromBuffer) at the same time. Old values are not destroyed on publishing or consuming, they are overwritten by the producer
+ * once their slot is reused.
+ *
+ * @tparam T : wrapped type, must be default constructible and move assignable.
+ */
+template <typename T>
+class TripleBuffer {
+ public:
+  /** Default constructor, all slots are default constructed. */
+  TripleBuffer() = default;
+
+  /** Constructor initializes the read slot with a copy of the given value. */
+  explicit TripleBuffer(const T& value) { buffers_[readIndex_] = value; }
+
+  /** Constructor initializes the read slot by moving the given value. */
+  explicit TripleBuffer(T&& value) { buffers_[readIndex_] = std::move(value); }
+
+  TripleBuffer(const TripleBuffer&) = delete;
+  TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+  /** Read the currently active value (consumer). */
+  const T& get() const { return buffers_[readIndex_]; }
+
+  /** Read/write the currently active value (consumer). */
+  T& get() { return buffers_[readIndex_]; }
+
+  /**
+   * Replaces the active value with the latest published value (consumer). Wait-free.
+   * @return True: the active value was updated, False: nothing new was published since the last update.
+   */
+  bool updateFromBuffer() {
+    if ((middle_.load(std::memory_order_relaxed) & newValueFlag) == 0) {
+      return false;
+    }
+    // acquire: the published slot is visible; release: the producer may only reuse our old slot after we are done reading it
+    readIndex_ = middle_.exchange(readIndex_, std::memory_order_acq_rel) & indexMask;
+    return true;
+  }
+
+  /** Access the write slot (producer). It may hold an old value which should be overwritten. */
+  T& getWriteBuffer() { return buffers_[writeIndex_]; }
+
+  /** Publishes the write slot such that the consumer picks it up on the next updateFromBuffer (producer). Wait-free. */
+  void publish() { writeIndex_ = middle_.exchange(writeIndex_ | newValueFlag, std::memory_order_acq_rel) & indexMask; }
+
+  /** Copy a new value into the buffer and publish it (producer). */
+  void setBuffer(const T& value) {
+    getWriteBuffer() = value;
+    publish();
+  }
+
+  /** Move a new value into the buffer and publish it (producer). */
+  void setBuffer(T&& value) {
+    getWriteBuffer() = std::move(value);
+    publish();
+  }
+
+  /**
+   * Resets all slots to a default constructed value and discards published values.
+   * @warning This method is NOT thread-safe, neither the producer nor the consumer may access the buffer concurrently.
+   */
+  void reset() {
+    for (auto& buffer : buffers_) {
+      buffer = T();
+    }
+    writeIndex_ = 0;
+    middle_ = 1;
+    readIndex_ = 2;
+  }
+
+ private:
+  static constexpr uint8_t indexMask = 0x3;
+  static constexpr uint8_t newValueFlag = 0x4;
+
+  std::array<T, 3> buffers_;
+  uint8_t writeIndex_ = 0;          //!< owned by the producer
+  std::atomic<uint8_t> middle_{1};  //!< index of the middle slot, with the newValueFlag set if it holds an unconsumed value
+  uint8_t readIndex_ = 2;           //!< owned by the consumer
+};
+
+template <typename T>
+constexpr uint8_t TripleBuffer<T>::indexMask;
+template <typename T>
+constexpr uint8_t TripleBuffer<T>::newValueFlag;
+
+}  // namespace ocs2
@@ -0,0 +1,164 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace ocs2 {
+
+/**
+ * Lock-free work-stealing deque (Chase-Lev).
+ * - The owner thread pushes and pops at the bottom without taking any lock.
+ * - Any other thread can steal from the top. Concurrent steals are resolved with a single CAS on the top index.
+ *
+ * Implementation follows "Correct and Efficient Work-Stealing for Weak Memory Models", N. M. Le et al., PPoPP 2013, with the
+ * seq_cst fences replaced by seq_cst accesses to the top and bottom indices.
+ * The storage grows when full. Retired buffers are kept alive until destruction since a concurrent thief might still read from them.
+ *
+ * @tparam T : Element type. It has to be trivially copyable, typically a pointer.
+ */
+template <typename T>
+class WorkStealingQueue {
+  static_assert(std::is_trivially_copyable<T>::value, "WorkStealingQueue only supports trivially copyable types.");
+
+ public:
+  /**
+   * Constructor
+   * @param [in] capacity: Initial capacity, rounded up to the next power of two.
+   */
+  explicit WorkStealingQueue(size_t capacity = 64) {
+    size_t powerOfTwo = 1;
+    while (powerOfTwo < capacity) {
+      powerOfTwo *= 2;
+    }
+    retiredBuffers_.emplace_back(new Buffer(powerOfTwo));
+    buffer_.store(retiredBuffers_.back().get(), std::memory_order_relaxed);
+  }
+
+  WorkStealingQueue(const WorkStealingQueue&) = delete;
+  WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+  /** Pushes an element at the bottom. Must only be called by the owner thread. */
+  void push(T item) {
+    const int64_t b = bottom_.load(std::memory_order_relaxed);
+    const int64_t t = top_.load(std::memory_order_acquire);
+    Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+    if (b - t > buffer->capacity - 1) {
+      buffer = grow(buffer, t, b);
+    }
+    buffer->put(b, item);
+    bottom_.store(b + 1, std::memory_order_release);
+  }
+
+  /**
+   * Pops an element from the bottom. Must only be called by the owner thread.
+   * @param [out] item: The popped element.
+   * @return True if an element was popped, false if the queue was empty.
+   */
+  bool pop(T& item) {
+    const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_seq_cst);
+
+    bool success = false;
+    if (t <= b) {
+      item = buffer->get(b);
+      success = true;
+      if (t == b) {  // last element, race against thieves
+        success = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+      }
+    } else {  // empty queue
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return success;
+  }
+
+  /**
+   * Steals an element from the top. Can be called by any thread.
+   * @param [out] item: The stolen element.
+   * @return True if an element was stolen, false if the queue was empty or another thread won the race.
+   */
+  bool steal(T& item) {
+    int64_t t = top_.load(std::memory_order_seq_cst);
+    const int64_t b = bottom_.load(std::memory_order_seq_cst);
+
+    if (t < b) {
+      const Buffer* buffer = buffer_.load(std::memory_order_acquire);
+      item = buffer->get(t);
+      return top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+    return false;
+  }
+
+  /** Approximate number of elements, exact only if no other thread is operating on the queue. */
+  size_t size() const {
+    const int64_t b = bottom_.load(std::memory_order_relaxed);
+    const int64_t t = top_.load(std::memory_order_relaxed);
+    return static_cast<size_t>(b > t ? b - t : 0);
+  }
+
+  /** Returns true if the queue is (approximately) empty. */
+  bool empty() const { return size() == 0; }
+
+ private:
+  struct Buffer {
+    explicit Buffer(size_t size) : capacity(static_cast<int64_t>(size)), mask(capacity - 1), data(new std::atomic<T>[size]) {}
+
+    T get(int64_t index) const { return data[index & mask].load(std::memory_order_relaxed); }
+    void put(int64_t index, T item) { data[index & mask].store(item, std::memory_order_relaxed); }
+
+    const int64_t capacity;
+    const int64_t mask;
+    std::unique_ptr<std::atomic<T>[]> data;
+  };
+
+  Buffer* grow(const Buffer* buffer, int64_t t, int64_t b) {
+    retiredBuffers_.emplace_back(new Buffer(2 * buffer->capacity));
+    Buffer* newBuffer = retiredBuffers_.back().get();
+    for (int64_t i = t; i < b; ++i) {
+      newBuffer->put(i, buffer->get(i));
+    }
+    buffer_.store(newBuffer, std::memory_order_release);
+    return newBuffer;
+  }
+
+  std::atomic<int64_t> top_{0};
+  std::atomic<int64_t> bottom_{0};
+  std::atomic<Buffer*> buffer_{nullptr};
+  std::vector<std::unique_ptr<Buffer>> retiredBuffers_;  // owns all buffers, only modified by the owner thread
+};
+
+}  // namespace ocs2
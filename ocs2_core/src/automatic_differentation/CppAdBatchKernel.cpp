@@ -0,0 +1,188 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include <ocs2_core/automatic_differentiation/CppAdBatchKernel.h>
+
+#include <algorithm>
+#include <regex>
+#include <sstream>
+#include <vector>
+
+namespace ocs2 {
+
+namespace cppad_batch {
+
+namespace {
+
+/**
+ * Declares the vector variants of the math functions provided by glibc's libmvec. They are declared under a different name, such
+ * that gcc does not fuse sin and cos of the same argument into sincos, which has no vector variant and prevents vectorization.
+ * Sinking is disabled such that the values of both branches of a select are computed unconditionally.
+ */
+const char* const vectorMathDeclarations = R"(#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__GLIBC__)
+double batch_sin(double) __asm__("sin") __attribute__((simd("notinbranch"), const, nothrow));
+double batch_cos(double) __asm__("cos") __attribute__((simd("notinbranch"), const, nothrow));
+double batch_exp(double) __asm__("exp") __attribute__((simd("notinbranch"), const, nothrow));
+double batch_log(double) __asm__("log") __attribute__((simd("notinbranch"), const, nothrow));
+double batch_pow(double, double) __asm__("pow") __attribute__((simd("notinbranch"), const, nothrow));
+#define sin batch_sin
+#define cos batch_cos
+#define exp batch_exp
+#define log batch_log
+#define pow batch_pow
+#pragma GCC optimize("no-tree-sink")
+#endif
+)";
+
+/**
+ * Extracts the body of a function definition.
+ * @return body without the enclosing braces, empty if not found.
+ */
+std::string getFunctionBody(const std::string& source, const std::string& functionName) {
+  const auto signature = source.find("void " + functionName + "(");
+  if (signature == std::string::npos) {
+    return {};
+  }
+  const auto begin = source.find('{', signature);
+  if (begin == std::string::npos) {
+    return {};
+  }
+  int depth = 0;
+  for (auto i = begin; i < source.size(); i++) {
+    if (source[i] == '{') {
+      depth++;
+    } else if (source[i] == '}' && --depth == 0) {
+      return source.substr(begin + 1, i - begin - 1);
+    }
+  }
+  return {};
+}
+
+/**
+ * Replaces the branches of conditional expressions, "if( c ) { a = e1; } else { a = e2; }" over five lines, by a select of both
+ * values. A loop with branches that contain function calls cannot be vectorized, since libmvec has no masked variants.
+ */
+std::vector<std::string> replaceBranchesBySelects(const std::vector<std::string>& statements) {
+  const std::regex ifLine(R"(^(\s*)if\s*\((.*)\)\s*\{\s*$)");
+  const std::regex assignmentLine(R"(^\s*(\w+\[\d+\])\s*=\s*(.*);\s*$)");
+  const std::regex elseLine(R"(^\s*\}\s*else\s*\{\s*$)");
+  const std::regex endLine(R"(^\s*\}\s*$)");
+
+  std::vector<std::string> result;
+  result.reserve(statements.size());
+  std::smatch ifMatch;
+  std::smatch trueMatch;
+  std::smatch falseMatch;
+  for (size_t i = 0; i < statements.size(); i++) {
+    if (i + 4 < statements.size() && std::regex_match(statements[i], ifMatch, ifLine) &&
+        std::regex_match(statements[i + 1], trueMatch, assignmentLine) && std::regex_match(statements[i + 2], elseLine) &&
+        std::regex_match(statements[i + 3], falseMatch, assignmentLine) && std::regex_match(statements[i + 4], endLine) &&
+        trueMatch.str(1) == falseMatch.str(1)) {
+      const std::string indentation = ifMatch.str(1);
+      result.push_back(indentation + "{");
+      result.push_back(indentation + "   const double trueValue = " + trueMatch.str(2) + ";");
+      result.push_back(indentation + "   const double falseValue = " + falseMatch.str(2) + ";");
+      result.push_back(indentation + "   " + trueMatch.str(1) + " = (" + ifMatch.str(2) + ") ? trueValue : falseValue;");
+      result.push_back(indentation + "}");
+      i += 4;
+    } else {
+      result.push_back(statements[i]);
+    }
+  }
+  return result;
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string createBatchKernelSource(const std::string& source, const std::string& functionName, size_t inputSize, size_t outputSize) {
+  // Atomic functions are evaluated through the model library, which is not available to the kernel
+  const std::string body = getFunctionBody(source, functionName);
+  if (body.empty() || body.find("atomicFun.") != std::string::npos) {
+    return {};
+  }
+
+  std::vector<std::string> lines;
+  std::istringstream sourceStream(source);
+  std::string line;
+  while (std::getline(sourceStream, line)) {
+    lines.push_back(line);
+  }
+
+  // The generated function is defined under the name of the point function, which is declared static such that it is inlined
+  const std::string pointFunctionName = functionName + "_batch_point";
+  const size_t inputArraySize = std::max<size_t>(inputSize, 1);
+  const size_t outputArraySize = std::max<size_t>(outputSize, 1);
+
+  std::ostringstream kernel;
+  kernel << "#include <math.h>\n\n";
+  kernel << vectorMathDeclarations << "\n";
+  kernel << "struct LangCAtomicFun;\n";
+  kernel << "static inline __attribute__((always_inline)) void " << pointFunctionName
+         << "(double const* const* in, double* const* out, struct LangCAtomicFun atomicFun);\n";
+  kernel << "#define " << functionName << " " << pointFunctionName << "\n";
+  for (const auto& sourceLine : replaceBranchesBySelects(lines)) {
+    kernel << sourceLine << "\n";
+  }
+  kernel << "#undef " << functionName << "\n\n";
+  kernel << "unsigned long " << getBatchWorkSizeName(functionName) << "(void) {\n";
+  kernel << "   return 0;\n";
+  kernel << "}\n\n";
+  const std::string kernelDeclaration = "void " + getBatchKernelName(functionName) + "(";
+  const std::string indentation(kernelDeclaration.size(), ' ');
+  kernel << kernelDeclaration << "double const* restrict in,\n";
+  kernel << indentation << "double* restrict out,\n";
+  kernel << indentation << "double* restrict work) {\n";
+  kernel << "   int k;\n";
+  kernel << "   (void) work;\n";
+  kernel << "#pragma GCC ivdep\n";
+  kernel << "   for (k = 0; k < " << kernelWidth << "; k++) {\n";
+  kernel << "      double pointIn[" << inputArraySize << "];\n";
+  kernel << "      double pointOut[" << outputArraySize << "];\n";
+  kernel << "      const double* pointInArray[1] = {pointIn};\n";
+  kernel << "      double* pointOutArray[1] = {pointOut};\n";
+  kernel << "      struct LangCAtomicFun atomicFun = {0};\n";
+  kernel << "      int i;\n";
+  kernel << "      for (i = 0; i < " << inputSize << "; i++) {\n";
+  kernel << "         pointIn[i] = in[i * " << kernelWidth << " + k];\n";
+  kernel << "      }\n";
+  kernel << "      " << pointFunctionName << "(pointInArray, pointOutArray, atomicFun);\n";
+  kernel << "      for (i = 0; i < " << outputSize << "; i++) {\n";
+  kernel << "         out[i * " << kernelWidth << " + k] = pointOut[i];\n";
+  kernel << "      }\n";
+  kernel << "   }\n";
+  kernel << "}\n";
+  return kernel.str();
+}
+
+}  // namespace cppad_batch
+}  // namespace ocs2
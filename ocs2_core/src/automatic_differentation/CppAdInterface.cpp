@@ -29,10 +29,283 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/automatic_differentiation/CppAdInterface.h>
 
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
 #include <boost/filesystem.hpp>
 
+#ifdef OCS2_CPPAD_LLVM_JIT
+#include <llvm/Config/llvm-config.h>  // defines LLVM_VERSION_MAJOR, which selects the CppADCodeGen implementation
+#include <cppad/cg/model/llvm/llvm.hpp>
+#endif
+
+#include <ocs2_core/automatic_differentiation/FiniteDifferenceMethods.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
 namespace ocs2 {
 
+namespace {
+
+/**
+ * CppAD allocates the memory of its tapes from per-thread pools, which are not synchronized unless thread_alloc::parallel_setup
+ * is called. Since the fallback models of a CppAdBackgroundCompilation are created and destroyed while the solver threads run,
+ * all uses of tapes that allocate, including their destruction, are serialized with this mutex.
+ */
+std::recursive_mutex& tapeMutex() {
+  static std::recursive_mutex mutex;
+  return mutex;
+}
+
+/**
+ * The interfaces that evaluate a fallback model while their library is compiled in the background, i.e. the interfaces that
+ * swapCompiledCppAdModels has to visit. The mutex is recursive since swapping a model unregisters the interface.
+ */
+struct FallbackInterfaceRegistry {
+  std::recursive_mutex mutex;
+  std::set<CppAdInterface*> interfaces;
+  std::atomic_size_t numInterfaces{0};  // checked without the lock, such that the solvers skip the registry once all are swapped
+};
+
+FallbackInterfaceRegistry& fallbackInterfaceRegistry() {
+  static FallbackInterfaceRegistry registry;
+  return registry;
+}
+
+void registerFallbackInterface(CppAdInterface* adInterface) {
+  auto& registry = fallbackInterfaceRegistry();
+  std::lock_guard<std::recursive_mutex> lock(registry.mutex);
+  registry.interfaces.insert(adInterface);
+  registry.numInterfaces = registry.interfaces.size();
+}
+
+void unregisterFallbackInterface(CppAdInterface* adInterface) {
+  auto& registry = fallbackInterfaceRegistry();
+  std::lock_guard<std::recursive_mutex> lock(registry.mutex);
+  registry.interfaces.erase(adInterface);
+  registry.numInterfaces = registry.interfaces.size();
+}
+
+// Identifies the manifest of a CppAdModelBundle
+constexpr const char* bundleManifestFunction = "ocs2_cppad_bundle_manifest";
+constexpr const char* bundleFormat = "ocs2_cppad_bundle";
+constexpr int bundleVersion = 1;
+
+// Relative step sizes of the central finite differences of the fallback models, balancing truncation and round-off errors
+const scalar_t firstOrderStepSize = std::cbrt(std::numeric_limits<scalar_t>::epsilon());
+const scalar_t secondOrderStepSize = std::pow(std::numeric_limits<scalar_t>::epsilon(), 0.25);
+
+/** Nonzeros of a sparsity pattern in row-major order, which is the order of the generated sparse derivatives. */
+CppAdInterface::SparseIndices getSparseIndices(const cppad_sparsity::SparsityPattern& sparsityPattern) {
+  CppAdInterface::SparseIndices sparseIndices;
+  for (size_t row = 0; row < sparsityPattern.size(); row++) {
+    for (const auto col : sparsityPattern[row]) {
+      sparseIndices.rows.push_back(row);
+      sparseIndices.cols.push_back(col);
+    }
+  }
+  return sparseIndices;
+}
+
+/** 64-bit FNV-1a hash. Unlike std::hash, the result is stable across processes and standard library implementations. */
+void hashCombine(uint64_t& hash, const std::string& data) {
+  constexpr uint64_t fnvPrime = 1099511628211ULL;
+  for (const char c : data) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= fnvPrime;
+  }
+  // separator, such that ("ab", "c") and ("a", "bc") hash differently
+  hash ^= 0xff;
+  hash *= fnvPrime;
+}
+
+/** Hashes the bytes of a value of a trivially copyable type, see hashCombine. */
+template <typename T>
+void hashValue(uint64_t& hash, const T& value) {
+  hashCombine(hash, std::string(reinterpret_cast<const char*>(&value), sizeof(T)));
+}
+
+/** Gives access to the generated sources of a model library. */
+class SourceGenerator : public CppAD::cg::ModelLibraryProcessor<scalar_t> {
+ public:
+  explicit SourceGenerator(CppAD::cg::ModelLibraryCSourceGen<scalar_t>& libraryGen)
+      : CppAD::cg::ModelLibraryProcessor<scalar_t>(libraryGen) {}
+
+  /** Generates (or returns the already generated) sources of a model. */
+  const std::map<std::string, std::string>& modelSources(CppAD::cg::ModelCSourceGen<scalar_t>& model) { return getSources(model); }
+
+  /** Generates (or returns the already generated) sources of the library. */
+  const std::map<std::string, std::string>& librarySources() { return getLibrarySources(); }
+};
+
+/**
+ * Adds the batch kernels of the function value and the Jacobian to the library. Functions that are not supported by
+ * cppad_batch::createBatchKernelSource are skipped, they are evaluated point by point. The skipped functions are reported if verbose.
+ */
+void addBatchKernelSources(SourceGenerator& sourceGenerator, CppAD::cg::ModelCSourceGen<scalar_t>& sourceGen,
+                           CppAD::cg::ModelLibraryCSourceGen<scalar_t>& libraryGen, const std::string& modelName, size_t inputDim,
+                           size_t rangeDim, size_t nnzJacobian, bool verbose) {
+  const auto& sources = sourceGenerator.modelSources(sourceGen);
+  const std::pair<std::string, size_t> functions[] = {{modelName + "_forward_zero", rangeDim},
+                                                      {modelName + "_sparse_jacobian", nnzJacobian}};
+  for (const auto& function : functions) {
+    const std::string& functionName = function.first;
+    const auto source = sources.find(functionName + ".c");
+    if (source != sources.end()) {
+      const auto kernelSource = cppad_batch::createBatchKernelSource(source->second, functionName, inputDim, function.second);
+      if (!kernelSource.empty()) {
+        libraryGen.addCustomFunctionSource(cppad_batch::getBatchKernelName(functionName) + ".c", kernelSource);
+      } else if (verbose) {
+        std::cerr << "[CppAdInterface] No batch kernel for " << functionName << ", it is evaluated point by point." << std::endl;
+      }
+    }
+  }
+}
+
+/** The objects required to compile a model library. They reference each other, hence are kept together at a fixed address. */
+struct ModelCompilation {
+  ModelCompilation(std::unique_ptr<CppAdInterface::ad_fun_t> funPtr, const std::string& modelName, const std::string& libraryName)
+      : fun(std::move(funPtr)), sourceGen(*fun, modelName), libraryGen(sourceGen), libraryProcessor(libraryGen, libraryName) {}
+
+  std::unique_ptr<CppAdInterface::ad_fun_t> fun;
+  CppAD::cg::ModelCSourceGen<scalar_t> sourceGen;
+  CppAD::cg::ModelLibraryCSourceGen<scalar_t> libraryGen;
+  CppAD::cg::DynamicModelLibraryProcessor<scalar_t> libraryProcessor;
+  CppAD::cg::GccCompiler<scalar_t> gccCompiler;
+};
+
+/** Creates the compilation objects, which contain the tape and are therefore destroyed under the tape lock. */
+std::shared_ptr<ModelCompilation> makeModelCompilation(std::unique_ptr<CppAdInterface::ad_fun_t> fun, const std::string& modelName,
+                                                       const std::string& libraryName) {
+  auto deleter = [](ModelCompilation* compilation) {
+    std::lock_guard<std::recursive_mutex> lock(tapeMutex());
+    delete compilation;
+  };
+  return std::shared_ptr<ModelCompilation>(new ModelCompilation(std::move(fun), modelName, libraryName), deleter);
+}
+
+}  // unnamed namespace
+
+/**
+ * The model library keeps a registry of the models that are created from it. Since copies of the interface may be created and
+ * destroyed from different threads, access to the registry is serialized. The evaluation itself only uses the buffers of
+ * the per-instance model and does not require locking.
+ */
+struct CppAdInterface::SharedLibrary {
+  explicit SharedLibrary(std::unique_ptr<CppAD::cg::ModelLibrary<scalar_t>> lib) : modelLibrary(std::move(lib)) {}
+
+  std::mutex mutex;
+  std::unique_ptr<CppAD::cg::ModelLibrary<scalar_t>> modelLibrary;
+};
+
+/**
+ * The taped function, evaluated with CppAD's operator overloading instead of the compiled library. The derivatives are
+ * computed with central finite differences. The copies of an interface share the fallback model, its evaluation is therefore
+ * serialized with a lock of the model.
+ *
+ * The Taylor coefficients are allocated in the constructor, which is called under the tape lock. After that, the zero order
+ * sweep of a tape without VecAD objects does not use CppAD's allocator, such that the models of different interfaces are
+ * evaluated in parallel. Tapes with VecAD objects also take the tape lock. The models of ocs2 do not use atomic functions,
+ * which would allocate as well.
+ */
+struct CppAdInterface::FallbackModel {
+  FallbackModel(std::unique_ptr<ad_fun_t> funPtr, SparseIndices jacobianSparseIndices, SparseIndices hessianSparseIndices)
+      : fun(std::move(funPtr)),
+        rangeDim(fun->Range()),
+        requiresTapeLock(fun->size_VecAD() > 0),
+        jacobianIndices(std::move(jacobianSparseIndices)),
+        hessianIndices(std::move(hessianSparseIndices)) {
+    fun->Forward(0, std::vector<ad_base_t>(fun->Domain(), ad_base_t(0.0)));
+  }
+
+  ~FallbackModel() {
+    std::lock_guard<std::recursive_mutex> lock(tapeMutex());
+    fun.reset();
+  }
+
+  /** Function value at the concatenated variables and parameters xp. */
+  vector_t getValue(const vector_t& xp) const {
+    const std::vector<ad_base_t> xpBase(xp.data(), xp.data() + xp.size());
+    std::unique_lock<std::recursive_mutex> tapeLock(tapeMutex(), std::defer_lock);
+    if (requiresTapeLock) {
+      tapeLock.lock();
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    const std::vector<ad_base_t> y = fun->Forward(0, xpBase);
+    vector_t value(y.size());
+    for (size_t i = 0; i < y.size(); i++) {
+      value(i) = y[i].getValue();
+    }
+    return value;
+  }
+
+  /** Jacobian w.r.t. the variables x. */
+  matrix_t getJacobian(const vector_t& x, const vector_t& p, scalar_t stepSize) const {
+    auto value = [&](const vector_t& var) -> vector_t { return getValue((vector_t(var.size() + p.size()) << var, p).finished()); };
+    return finiteDifferenceDerivative(value, x, stepSize);
+  }
+
+  /** Hessian of the weighted outputs w.r.t. the variables x. */
+  matrix_t getHessian(const vector_t& w, const vector_t& x, const vector_t& p) const {
+    auto weightedGradient = [&](const vector_t& var) -> vector_t { return getJacobian(var, p, secondOrderStepSize).transpose() * w; };
+    const matrix_t hessian = finiteDifferenceDerivative(weightedGradient, x, secondOrderStepSize);
+    return 0.5 * (hessian + hessian.transpose());
+  }
+
+  /** Derivative of the column-major vectorized Jacobian w.r.t. the variables x, i.e. one Hessian row of each output per row. */
+  matrix_t getJacobianDerivative(const vector_t& x, const vector_t& p) const {
+    auto vectorizedJacobian = [&](const vector_t& var) -> vector_t {
+      const matrix_t jacobian = getJacobian(var, p, secondOrderStepSize);
+      return Eigen::Map<const vector_t>(jacobian.data(), jacobian.size());
+    };
+    return finiteDifferenceDerivative(vectorizedJacobian, x, secondOrderStepSize);
+  }
+
+  std::unique_ptr<ad_fun_t> fun;
+  mutable std::mutex mutex;
+  size_t rangeDim;
+  bool requiresTapeLock;
+  SparseIndices jacobianIndices;
+  SparseIndices hessianIndices;
+};
+
+/**
+ * An evaluation announces itself in numGuardedEvaluations_ before it checks swapInProgress_, and trySwapToCompiledModel sets
+ * swapInProgress_ before it checks numGuardedEvaluations_. With sequentially consistent accesses, at least one of them sees the
+ * other: Either the swap backs off and is retried by a later call, or the evaluation waits until the swap has finished. The swap
+ * never waits, so nested guards of the same thread and guards held while taking other locks cannot deadlock.
+ */
+class CppAdInterface::EvaluationGuard {
+ public:
+  explicit EvaluationGuard(const CppAdInterface& adInterface) {
+    if (adInterface.swapPending_) {
+      adInterfacePtr_ = &adInterface;
+      ++adInterfacePtr_->numGuardedEvaluations_;
+      while (adInterfacePtr_->swapInProgress_) {
+        --adInterfacePtr_->numGuardedEvaluations_;
+        std::this_thread::yield();
+        ++adInterfacePtr_->numGuardedEvaluations_;
+      }
+    }
+  }
+
+  ~EvaluationGuard() {
+    if (adInterfacePtr_ != nullptr) {
+      --adInterfacePtr_->numGuardedEvaluations_;
+    }
+  }
+
+  EvaluationGuard(const EvaluationGuard&) = delete;
+  EvaluationGuard& operator=(const EvaluationGuard&) = delete;
+
+ private:
+  const CppAdInterface* adInterfacePtr_ = nullptr;
+};
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -60,17 +333,112 @@ CppAdInterface::CppAdInterface(ad_function_t adFunction, size_t variableDim, std
 /******************************************************************************************************/
 CppAdInterface::CppAdInterface(const CppAdInterface& rhs)
     : CppAdInterface(rhs.adFunction_, rhs.variableDim_, rhs.parameterDim_, rhs.modelName_, rhs.folderName_, rhs.compileFlags_) {
-  if (isLibraryAvailable()) {
+  EvaluationGuard guard(rhs);
+  compilerBackend_ = rhs.compilerBackend_;
+  generateBatchKernels_ = rhs.generateBatchKernels_;
+  if (rhs.sharedLibrary_ != nullptr) {
+    setSharedLibrary(rhs.sharedLibrary_);
+  } else if (rhs.fallbackModel_ != nullptr) {
+    pendingLibrary_ = rhs.pendingLibrary_;
+    compilationError_ = rhs.compilationError_;
+    setFallbackModel(rhs.fallbackModel_);
+  } else if (rhs.pendingLibrary_.valid()) {
+    pendingLibrary_ = rhs.pendingLibrary_;
+    compilationScope_ = rhs.compilationScope_;
+    compilationScope_->registerInterface(this);
+  } else if (compilerBackend_ == CompilerBackend::Gcc && isLibraryAvailable()) {
     loadModels(false);
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdInterface::~CppAdInterface() {
+  if (compilationScope_ != nullptr) {
+    compilationScope_->unregisterInterface(this);
+  }
+  if (swapPending_) {
+    unregisterFallbackInterface(this);
+  }
+  releaseModel();
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool verbose) {
+  rethrowCompilationError();
+  std::lock_guard<std::recursive_mutex> lock(tapeMutex());
+  if (compilerBackend_ == CompilerBackend::LlvmJit) {
+    jitCompileModels(tapeModel(), approximationOrder, verbose);
+    return;
+  }
+
   createFolderStructure();
 
+  auto fun = tapeModel();
+  auto cacheKey = computeCacheKey(*fun, approximationOrder);
+  compileModels(std::move(fun), approximationOrder, std::move(cacheKey), verbose);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::loadModels(bool verbose) {
+  if (verbose) {
+    std::cerr << "[CppAdInterface] Loading Shared Library: " << libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION
+              << std::endl;
+  }
+  std::unique_ptr<CppAD::cg::DynamicLib<scalar_t>> dynamicLib(
+      new CppAD::cg::LinuxDynamicLib<scalar_t>(libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION));
+  setSharedLibrary(std::make_shared<SharedLibrary>(std::move(dynamicLib)));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::loadModelsIfAvailable(ApproximationOrder approximationOrder, bool verbose) {
+  rethrowCompilationError();
+  std::unique_lock<std::recursive_mutex> lock(tapeMutex());
+  const auto* modelBundle = CppAdModelBundle::active();
+  const std::string bundleCacheKey = (modelBundle != nullptr) ? modelBundle->getCacheKey(modelName_) : std::string();
+  if (compilerBackend_ == CompilerBackend::LlvmJit || (bundleCacheKey.empty() && !isLibraryAvailable())) {
+    createModels(approximationOrder, verbose);
+    return;
+  }
+
+  // The cache key is computed without the tape lock, such that the interfaces of a warm start check their libraries in parallel
+  auto fun = tapeModel();
+  if (fun->size_VecAD() == 0) {
+    lock.unlock();
+  }
+  auto cacheKey = computeCacheKey(*fun, approximationOrder);
+  if (!lock.owns_lock()) {
+    lock.lock();
+  }
+  if (!bundleCacheKey.empty() && verbose) {
+    std::cerr << "[CppAdInterface] Model " << modelName_ << " in bundle " << modelBundle->bundleFile_
+              << (cacheKey == bundleCacheKey ? " is up to date, loading it." : " is outdated, ignoring it.") << std::endl;
+  }
+  if (cacheKey == bundleCacheKey) {
+    setSharedLibrary(modelBundle->sharedLibrary_);
+  } else if (cacheKey == readCacheKey()) {
+    loadModels(verbose);
+  } else {
+    if (verbose) {
+      std::cerr << "[CppAdInterface] Shared Library " << libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION
+                << " is outdated, recompiling." << std::endl;
+    }
+    createFolderStructure();
+    compileModels(std::move(fun), approximationOrder, std::move(cacheKey), verbose);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<CppAdInterface::ad_fun_t> CppAdInterface::tapeModel() {
   // set and declare independent variables and start tape recording
   ad_vector_t xp(variableDim_ + parameterDim_);
   xp.setOnes();  // Ones are better than zero, to prevent devision by zero in taping
@@ -85,72 +453,324 @@ void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool ve
   adFunction_(x, p, y);
   rangeDim_ = y.rows();
   // create f: xp -> y and stop tape recording
-  ad_fun_t fun(xp, y);
+  std::unique_ptr<ad_fun_t> fun(new ad_fun_t(xp, y));
   // Optimize the operation sequence
-  fun.optimize();
+  fun->optimize();
+  // Allocate the zero order Taylor coefficients, such that the zero order sweeps of computeCacheKey do not allocate
+  fun->Forward(0, std::vector<ad_base_t>(fun->Domain(), ad_base_t(1.0)));
+  return fun;
+}
 
-  // generates source code
-  CppAD::cg::ModelCSourceGen<scalar_t> sourceGen(fun, modelName_);
-  setApproximationOrder(approximationOrder, sourceGen, fun);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string CppAdInterface::computeCacheKey(ad_fun_t& fun, ApproximationOrder approximationOrder) const {
+  // The zero order operation graph is a canonical representation of the optimized tape. It is recorded by a forward sweep
+  // with CppADCodeGen variables, without generating any source. The nodes are numbered in the order of the sweep.
+  CppAD::cg::CodeHandler<scalar_t> handler;
+  std::vector<ad_base_t> xp(fun.Domain());
+  handler.makeVariables(xp);
+  const std::vector<ad_base_t> y = fun.Forward(0, xp);
 
-  // Compiler objects, compile to temporary shared library file to avoid interference between processes
-  CppAD::cg::ModelLibraryCSourceGen<scalar_t> libraryCSourceGen(sourceGen);
-  CppAD::cg::GccCompiler<scalar_t> gccCompiler;
-  CppAD::cg::DynamicModelLibraryProcessor<scalar_t> libraryProcessor(libraryCSourceGen, libraryName_ + tmpName_);
-  setCompilerOptions(gccCompiler);
+  uint64_t hash = 14695981039346656037ULL;  // FNV offset basis
+  hashCombine(hash, "cppadcg_operation_graph_1");
+  for (const auto* node : handler.getManagedNodes()) {
+    hashValue(hash, static_cast<int>(node->getOperationType()));
+    hashValue(hash, node->getInfo().size());
+    for (const auto info : node->getInfo()) {
+      hashValue(hash, info);
+    }
+    hashValue(hash, node->getArguments().size());
+    for (const auto& argument : node->getArguments()) {
+      if (argument.getOperation() != nullptr) {
+        hashValue(hash, argument.getOperation()->getHandlerPosition());
+      } else {
+        hashValue(hash, *argument.getParameter());
+      }
+    }
+  }
+  for (const auto& dependent : y) {
+    if (dependent.isVariable()) {
+      hashValue(hash, dependent.getOperationNode()->getHandlerPosition());
+    } else {
+      hashValue(hash, dependent.getValue());
+    }
+  }
+  // The Taylor coefficients refer to the nodes of the handler, they are overwritten before the handler is destroyed
+  fun.Forward(0, std::vector<ad_base_t>(fun.Domain(), ad_base_t(1.0)));
 
-  if (verbose) {
-    std::cerr << "[CppAdInterface] Compiling Shared Library: "
-              << libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << std::endl;
+  hashCombine(hash, std::to_string(static_cast<int>(approximationOrder)));
+  hashCombine(hash, std::to_string(variableDim_) + "_" + std::to_string(parameterDim_));
+  for (const auto& flag : compileFlags_) {
+    hashCombine(hash, flag);
+  }
+  if (generateBatchKernels_) {
+    hashCombine(hash, "batch_kernels_" + std::to_string(cppad_batch::kernelWidth));
   }
+  // a new CppAD or CppADCodeGen version can change the generated code
+  hashCombine(hash, CPPAD_PACKAGE_STRING);
+  hashCombine(hash, OCS2_CPPADCG_VERSION);
 
-  // Compile and store the library
-  dynamicLib_ = libraryProcessor.createDynamicLibrary(gccCompiler);
-  model_ = dynamicLib_->model(modelName_);
+  std::ostringstream key;
+  key << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return key.str();
+}
 
-  setSparsityNonzeros();
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string CppAdInterface::readCacheKey() const {
+  std::ifstream keyFile(libraryName_ + ".key");
+  std::string key;
+  keyFile >> key;
+  return key;
+}
 
-  // Rename generated library after loading
-  if (verbose) {
-    std::cerr << "[CppAdInterface] Renaming " << libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << " to "
-              << libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << std::endl;
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::compileModels(std::unique_ptr<ad_fun_t> fun, ApproximationOrder approximationOrder, std::string cacheKey,
+                                   bool verbose) {
+  finishCompilation();
+
+  // generates source code, compile to temporary shared library file to avoid interference between processes
+  auto compilation = makeModelCompilation(std::move(fun), modelName_, libraryName_ + tmpName_);
+  setApproximationOrder(approximationOrder, compilation->sourceGen, *compilation->fun);
+  setCompilerOptions(compilation->gccCompiler);
+
+  // CppAD tapes are not thread-safe, all code generation happens here such that the compilation only runs the compiler
+  SourceGenerator sourceGenerator(compilation->libraryGen);
+  sourceGenerator.modelSources(compilation->sourceGen);
+  sourceGenerator.librarySources();
+  if (generateBatchKernels_) {
+    const size_t nnzJacobian = (approximationOrder == ApproximationOrder::Zero)
+                                   ? 0
+                                   : cppad_sparsity::getNumberOfNonZeros(createJacobianSparsity(*compilation->fun));
+    addBatchKernelSources(sourceGenerator, compilation->sourceGen, compilation->libraryGen, modelName_, variableDim_ + parameterDim_,
+                          rangeDim_, nnzJacobian, verbose);
+  }
+
+  const std::string libraryFile = libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+  const std::string tmpLibraryFile = libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+  const std::string keyFile = libraryName_ + ".key";
+  const std::string tmpKeyFile = libraryName_ + tmpName_ + ".key";
+  // The compilation objects contain the tape, which must only be destroyed on this thread. They are owned by this function or by
+  // the scope, the task only uses them.
+  ModelCompilation* compilationPtr = compilation.get();
+  auto compile = [=]() {
+    if (verbose) {
+      std::cerr << "[CppAdInterface] Compiling Shared Library: " << tmpLibraryFile << std::endl;
+    }
+
+    // Compile and store the library
+    auto& compilation = *compilationPtr;
+    auto sharedLibrary = std::make_shared<SharedLibrary>(compilation.libraryProcessor.createDynamicLibrary(compilation.gccCompiler));
+
+    // Rename generated library after loading
+    if (verbose) {
+      std::cerr << "[CppAdInterface] Renaming " << tmpLibraryFile << " to " << libraryFile << std::endl;
+    }
+    boost::filesystem::rename(tmpLibraryFile, libraryFile);
+
+    // Store the cache key next to the library
+    {
+      std::ofstream keyStream(tmpKeyFile);
+      keyStream << cacheKey << std::endl;
+    }
+    boost::filesystem::rename(tmpKeyFile, keyFile);
+
+    return sharedLibrary;
+  };
+
+  auto* backgroundScope = CppAdBackgroundCompilation::active();
+  auto* scope = CppAdParallelCompilation::active();
+  if (backgroundScope != nullptr) {
+    auto fallbackModel = createFallbackModel(*compilation->fun, approximationOrder);
+    pendingLibrary_ = backgroundScope->submit([compile, compilation]() { return compile(); });
+    setFallbackModel(std::move(fallbackModel));
+  } else if (scope == nullptr) {
+    setSharedLibrary(compile());
+  } else {
+    pendingLibrary_ = scope->submit(std::move(compile), std::move(compilation));
+    compilationScope_ = scope;
+    compilationScope_->registerInterface(this);
   }
-  boost::filesystem::rename(libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION,
-                            libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void CppAdInterface::loadModels(bool verbose) {
-  if (verbose) {
-    std::cerr << "[CppAdInterface] Loading Shared Library: " << libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION
-              << std::endl;
+void CppAdInterface::finishCompilation() {
+  if (pendingLibrary_.valid()) {
+    auto pendingLibrary = std::move(pendingLibrary_);
+    pendingLibrary_ = {};
+    if (compilationScope_ != nullptr) {
+      compilationScope_->unregisterInterface(this);
+      compilationScope_ = nullptr;
+    }
+    setSharedLibrary(pendingLibrary.get());
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool CppAdInterface::trySwapToCompiledModel() {
+  if (!swapPending_ || pendingLibrary_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+    return false;
   }
-  dynamicLib_.reset(new CppAD::cg::LinuxDynamicLib<scalar_t>(libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION));
-  model_ = dynamicLib_->model(modelName_);
-  rangeDim_ = model_->Range();
 
-  setSparsityNonzeros();
+  // An instance that is evaluated or copied by another thread is left to a later call, see EvaluationGuard
+  swapInProgress_ = true;
+  if (numGuardedEvaluations_ > 0) {
+    swapInProgress_ = false;
+    return false;
+  }
+
+  // After a failed compilation, the fallback model stays in use and the error is kept for rethrowCompilationError
+  try {
+    finishCompilation();
+  } catch (...) {
+    compilationError_ = std::current_exception();
+    swapPending_ = false;
+    unregisterFallbackInterface(this);
+  }
+  swapInProgress_ = false;
+  return model_ != nullptr;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void CppAdInterface::loadModelsIfAvailable(ApproximationOrder approximationOrder, bool verbose) {
-  if (isLibraryAvailable()) {
-    loadModels(verbose);
-  } else {
-    createModels(approximationOrder, verbose);
+bool CppAdInterface::isCompiled() const {
+  EvaluationGuard guard(*this);
+  return model_ != nullptr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::rethrowCompilationError() {
+  if (compilationError_ != nullptr) {
+    const auto compilationError = compilationError_;
+    compilationError_ = nullptr;
+    std::rethrow_exception(compilationError);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_ptr<CppAdInterface::FallbackModel> CppAdInterface::createFallbackModel(ad_fun_t& fun,
+                                                                                   ApproximationOrder approximationOrder) const {
+  SparseIndices jacobianIndices;
+  SparseIndices hessianIndices;
+  switch (approximationOrder) {
+    case ApproximationOrder::Second:
+      hessianIndices = getSparseIndices(createHessianSparsity(fun));
+      // Intentional fall through
+    case ApproximationOrder::First:
+      jacobianIndices = getSparseIndices(createJacobianSparsity(fun));
+      // Intentional fall through
+    case ApproximationOrder::Zero:
+      break;
+    default:
+      throw std::runtime_error("CppAdInterface: Invalid approximation order");
+  }
+
+  // The tape of the compilation is only used by the code generation, the fallback model evaluates a copy
+  std::unique_ptr<ad_fun_t> fallbackFun(new ad_fun_t);
+  *fallbackFun = fun;
+  return std::make_shared<FallbackModel>(std::move(fallbackFun), std::move(jacobianIndices), std::move(hessianIndices));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::setFallbackModel(std::shared_ptr<FallbackModel> fallbackModel) {
+  releaseModel();
+  sharedLibrary_.reset();
+  forwardZeroBatch_ = BatchKernel();
+  sparseJacobianBatch_ = BatchKernel();
+
+  fallbackModel_ = std::move(fallbackModel);
+  rangeDim_ = fallbackModel_->rangeDim;
+  setSparsityPatterns(fallbackModel_->jacobianIndices, fallbackModel_->hessianIndices);
+  if (pendingLibrary_.valid() && !swapPending_) {
+    swapPending_ = true;
+    registerFallbackInterface(this);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::setCompilerBackend(CompilerBackend compilerBackend) {
+  if (!isCompilerBackendAvailable(compilerBackend)) {
+    throw std::runtime_error("[CppAdInterface] The LLVM JIT backend is not available, build ocs2_core with OCS2_CPPAD_LLVM_JIT=ON.");
+  }
+  compilerBackend_ = compilerBackend;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool CppAdInterface::isCompilerBackendAvailable(CompilerBackend compilerBackend) {
+  switch (compilerBackend) {
+    case CompilerBackend::Gcc:
+      return true;
+    case CompilerBackend::LlvmJit:
+#ifdef OCS2_CPPAD_LLVM_JIT
+      return true;
+#else
+      return false;
+#endif
+    default:
+      return false;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::jitCompileModels(std::unique_ptr<ad_fun_t> fun, ApproximationOrder approximationOrder, bool verbose) {
+#ifdef OCS2_CPPAD_LLVM_JIT
+  finishCompilation();
+
+  CppAD::cg::ModelCSourceGen<scalar_t> sourceGen(*fun, modelName_);
+  setApproximationOrder(approximationOrder, sourceGen, *fun);
+  CppAD::cg::ModelLibraryCSourceGen<scalar_t> libraryGen(sourceGen);
+  if (generateBatchKernels_) {
+    SourceGenerator sourceGenerator(libraryGen);
+    const size_t nnzJacobian =
+        (approximationOrder == ApproximationOrder::Zero) ? 0 : cppad_sparsity::getNumberOfNonZeros(createJacobianSparsity(*fun));
+    addBatchKernelSources(sourceGenerator, sourceGen, libraryGen, modelName_, variableDim_ + parameterDim_, rangeDim_, nnzJacobian,
+                          verbose);
+  }
+
+  if (verbose) {
+    std::cerr << "[CppAdInterface] JIT compiling model: " << modelName_ << std::endl;
   }
+
+  // LLVM is initialized globally on each call, the JIT compilation therefore always runs on the calling thread.
+  CppAD::cg::LlvmModelLibraryProcessor<scalar_t> libraryProcessor(libraryGen);
+  std::unique_ptr<CppAD::cg::ModelLibrary<scalar_t>> modelLibrary = libraryProcessor.create();
+  setSharedLibrary(std::make_shared<SharedLibrary>(std::move(modelLibrary)));
+#else
+  throw std::runtime_error("[CppAdInterface] The LLVM JIT backend is not available, build ocs2_core with OCS2_CPPAD_LLVM_JIT=ON.");
+#endif
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t CppAdInterface::getFunctionValue(const vector_t& x, const vector_t& p) const {
+  EvaluationGuard guard(*this);
   vector_t xp(variableDim_ + parameterDim_);
   xp << x, p;
+  if (useFallbackModel()) {
+    return fallbackModel_->getValue(xp);
+  }
 
   vector_t functionValue(model_->Range());
 
@@ -163,6 +783,11 @@ vector_t CppAdInterface::getFunctionValue(const vector_t& x, const vector_t& p)
 /******************************************************************************************************/
 /******************************************************************************************************/
 matrix_t CppAdInterface::getJacobian(const vector_t& x, const vector_t& p) const {
+  EvaluationGuard guard(*this);
+  if (useFallbackModel()) {
+    return fallbackModel_->getJacobian(x, p, firstOrderStepSize);
+  }
+
   // Concatenate input
   vector_t xp(variableDim_ + parameterDim_);
   xp << x, p;
@@ -190,6 +815,17 @@ matrix_t CppAdInterface::getJacobian(const vector_t& x, const vector_t& p) const
 /******************************************************************************************************/
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation(const vector_t& x, const vector_t& p) const {
+  EvaluationGuard guard(*this);
+  if (useFallbackModel()) {
+    const vector_t value = getFunctionValue(x, p);
+    const matrix_t jacobian = getJacobian(x, p);
+    ScalarFunctionQuadraticApproximation gnApprox;
+    gnApprox.f = 0.5 * value.squaredNorm();
+    gnApprox.dfdx.noalias() = jacobian.transpose() * value;
+    gnApprox.dfdxx.noalias() = jacobian.transpose() * jacobian;
+    return gnApprox;
+  }
+
   // Concatenate input
   vector_t xp(variableDim_ + parameterDim_);
   xp << x, p;
@@ -247,6 +883,7 @@ ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation
 /******************************************************************************************************/
 /******************************************************************************************************/
 matrix_t CppAdInterface::getHessian(size_t outputIndex, const vector_t& x, const vector_t& p) const {
+  EvaluationGuard guard(*this);
   vector_t w = vector_t::Zero(rangeDim_);
   w[outputIndex] = 1.0;
 
@@ -257,6 +894,11 @@ matrix_t CppAdInterface::getHessian(size_t outputIndex, const vector_t& x, const
 /******************************************************************************************************/
 /******************************************************************************************************/
 matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const vector_t& p) const {
+  EvaluationGuard guard(*this);
+  if (useFallbackModel()) {
+    return fallbackModel_->getHessian(w, x, p);
+  }
+
   // Concatenate input
   vector_t xp(variableDim_ + parameterDim_);
   xp << x, p;
@@ -285,6 +927,290 @@ matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const
   return hessian;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getQuadraticApproximation(const vector_t& x, const vector_t& p,
+                                               VectorFunctionQuadraticApproximation& approximation) const {
+  EvaluationGuard guard(*this);
+  if (useFallbackModel()) {
+    xpBuffer_.resize(variableDim_ + parameterDim_);
+    xpBuffer_ << x, p;
+    approximation.f = fallbackModel_->getValue(xpBuffer_);
+    approximation.dfdx = fallbackModel_->getJacobian(x, p, firstOrderStepSize);
+    const matrix_t jacobianDerivative = fallbackModel_->getJacobianDerivative(x, p);
+    approximation.dfdxx.resize(rangeDim_);
+    for (size_t i = 0; i < rangeDim_; i++) {
+      // Row (col * rangeDim + i) of the derivative is the derivative of the Jacobian entry (i, col)
+      Eigen::Map<const matrix_t, 0, Eigen::InnerStride<>> hessian(jacobianDerivative.data() + i, variableDim_, variableDim_,
+                                                                  Eigen::InnerStride<>(rangeDim_));
+      approximation.dfdxx[i] = 0.5 * (hessian + hessian.transpose());
+    }
+    return;
+  }
+
+  // Concatenate input
+  xpBuffer_.resize(variableDim_ + parameterDim_);
+  xpBuffer_ << x, p;
+  CppAD::cg::ArrayView<const scalar_t> xpArrayView(xpBuffer_.data(), xpBuffer_.size());
+
+  size_t const* rows;
+  size_t const* cols;
+  sparseBuffer_.resize(std::max(nnzJacobian_, nnzHessian_));
+
+  // Zero order
+  approximation.f.resize(rangeDim_);
+  CppAD::cg::ArrayView<scalar_t> valueArrayView(approximation.f.data(), rangeDim_);
+  model_->ForwardZero(xpArrayView, valueArrayView);
+
+  // First order
+  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseBuffer_.data(), nnzJacobian_);
+  model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+  if (static_cast<size_t>(approximation.dfdx.rows()) != rangeDim_ || static_cast<size_t>(approximation.dfdx.cols()) != variableDim_) {
+    approximation.dfdx.setZero(rangeDim_, variableDim_);
+  }
+  scalar_t* jacobianData = approximation.dfdx.data();
+  for (size_t k = 0; k < nnzJacobian_; k++) {
+    jacobianData[jacobianScatter_[k]] = sparseBuffer_[k];
+  }
+
+  // Second order, one weighted Hessian per output. The generated code only provides the weighted sum of the output Hessians.
+  CppAD::cg::ArrayView<scalar_t> sparseHessianArrayView(sparseBuffer_.data(), nnzHessian_);
+  weightBuffer_.setZero(rangeDim_);
+  CppAD::cg::ArrayView<const scalar_t> weightArrayView(weightBuffer_.data(), weightBuffer_.size());
+  approximation.dfdxx.resize(rangeDim_);
+  for (size_t i = 0; i < rangeDim_; i++) {
+    weightBuffer_(i) = 1.0;
+    model_->SparseHessian(xpArrayView, weightArrayView, sparseHessianArrayView, &rows, &cols);
+    weightBuffer_(i) = 0.0;
+
+    const matrix_t& hessian = approximation.dfdxx[i];
+    if (static_cast<size_t>(hessian.rows()) != variableDim_ || static_cast<size_t>(hessian.cols()) != variableDim_) {
+      approximation.dfdxx[i].setZero(variableDim_, variableDim_);
+    }
+    scalar_t* hessianData = approximation.dfdxx[i].data();
+    for (size_t k = 0; k < nnzHessian_; k++) {
+      hessianData[hessianScatter_[k].first] = sparseBuffer_[k];
+      hessianData[hessianScatter_[k].second] = sparseBuffer_[k];
+    }
+  }
+
+  assert(approximation.f.allFinite());
+  assert(approximation.dfdx.allFinite());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t CppAdInterface::packBatchInput(const matrix_t& xs, const matrix_t& ps, size_t start) const {
+  const size_t numPoints = std::min<size_t>(cppad_batch::kernelWidth, xs.cols() - start);
+  batchInput_.resize(cppad_batch::kernelWidth, variableDim_ + parameterDim_);
+  batchInput_.topLeftCorner(numPoints, variableDim_) = xs.middleCols(start, numPoints).transpose();
+  if (parameterDim_ > 0) {
+    batchInput_.topRightCorner(numPoints, parameterDim_) = ps.middleCols(start, numPoints).transpose();
+  }
+  // The last batch is filled up with the last point, such that all evaluated points are valid inputs
+  for (size_t k = numPoints; k < cppad_batch::kernelWidth; k++) {
+    batchInput_.row(k) = batchInput_.row(numPoints - 1);
+  }
+  return numPoints;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getFunctionValueBatch(const matrix_t& xs, const matrix_t& ps, matrix_t& values) const {
+  EvaluationGuard guard(*this);
+  assert(xs.rows() == static_cast<Eigen::Index>(variableDim_));
+  assert(ps.rows() == static_cast<Eigen::Index>(parameterDim_) && (parameterDim_ == 0 || ps.cols() == xs.cols()));
+  const size_t numPoints = xs.cols();
+  values.resize(rangeDim_, numPoints);
+
+  if (forwardZeroBatch_.kernel == nullptr) {
+    for (size_t i = 0; i < numPoints; i++) {
+      values.col(i) = getFunctionValue(xs.col(i), parameterDim_ > 0 ? vector_t(ps.col(i)) : vector_t(0));
+    }
+    return;
+  }
+
+  batchOutput_.resize(cppad_batch::kernelWidth, rangeDim_);
+  batchWork_.resize(forwardZeroBatch_.workSize);
+  for (size_t start = 0; start < numPoints; start += cppad_batch::kernelWidth) {
+    const size_t batchSize = packBatchInput(xs, ps, start);
+    forwardZeroBatch_.kernel(batchInput_.data(), batchOutput_.data(), batchWork_.data());
+    values.middleCols(start, batchSize) = batchOutput_.topRows(batchSize).transpose();
+  }
+
+  assert(values.allFinite());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getJacobianBatch(const matrix_t& xs, const matrix_t& ps, matrix_array_t& jacobians) const {
+  EvaluationGuard guard(*this);
+  assert(xs.rows() == static_cast<Eigen::Index>(variableDim_));
+  assert(ps.rows() == static_cast<Eigen::Index>(parameterDim_) && (parameterDim_ == 0 || ps.cols() == xs.cols()));
+  const size_t numPoints = xs.cols();
+  jacobians.resize(numPoints);
+
+  if (sparseJacobianBatch_.kernel == nullptr) {
+    for (size_t i = 0; i < numPoints; i++) {
+      jacobians[i] = getJacobian(xs.col(i), parameterDim_ > 0 ? vector_t(ps.col(i)) : vector_t(0));
+    }
+    return;
+  }
+
+  batchOutput_.resize(cppad_batch::kernelWidth, nnzJacobian_);
+  batchWork_.resize(sparseJacobianBatch_.workSize);
+  for (size_t start = 0; start < numPoints; start += cppad_batch::kernelWidth) {
+    const size_t batchSize = packBatchInput(xs, ps, start);
+    sparseJacobianBatch_.kernel(batchInput_.data(), batchOutput_.data(), batchWork_.data());
+
+    // The kernel returns the nonzeros in the order of the sparsity pattern
+    for (size_t k = 0; k < batchSize; k++) {
+      auto& jacobian = jacobians[start + k];
+      jacobian.setZero(rangeDim_, variableDim_);
+      scalar_t* jacobianData = jacobian.data();
+      for (size_t i = 0; i < nnzJacobian_; i++) {
+        jacobianData[jacobianScatter_[i]] = batchOutput_(k, i);
+      }
+      assert(jacobian.allFinite());
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getJacobianNonZeros(const vector_t& x, const vector_t& p, vector_t& values) const {
+  EvaluationGuard guard(*this);
+  if (useFallbackModel()) {
+    const matrix_t jacobian = getJacobian(x, p);
+    values.resize(nnzJacobian_);
+    for (size_t k = 0; k < nnzJacobian_; k++) {
+      values[k] = jacobian(jacobianIndices_.rows[k], jacobianIndices_.cols[k]);
+    }
+    return;
+  }
+
+  // Concatenate input
+  xpBuffer_.resize(variableDim_ + parameterDim_);
+  xpBuffer_ << x, p;
+  CppAD::cg::ArrayView<const scalar_t> xpArrayView(xpBuffer_.data(), xpBuffer_.size());
+
+  values.resize(nnzJacobian_);
+  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(values.data(), values.size());
+  size_t const* rows;
+  size_t const* cols;
+  model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+
+  assert(values.allFinite());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getHessianNonZeros(const vector_t& w, const vector_t& x, const vector_t& p, vector_t& values) const {
+  EvaluationGuard guard(*this);
+  if (useFallbackModel()) {
+    const matrix_t hessian = getHessian(w, x, p);
+    values.resize(nnzHessian_);
+    for (size_t k = 0; k < nnzHessian_; k++) {
+      values[k] = hessian(hessianIndices_.rows[k], hessianIndices_.cols[k]);
+    }
+    return;
+  }
+
+  // Concatenate input
+  xpBuffer_.resize(variableDim_ + parameterDim_);
+  xpBuffer_ << x, p;
+  CppAD::cg::ArrayView<const scalar_t> xpArrayView(xpBuffer_.data(), xpBuffer_.size());
+  CppAD::cg::ArrayView<const scalar_t> wArrayView(w.data(), w.size());
+
+  values.resize(nnzHessian_);
+  CppAD::cg::ArrayView<scalar_t> sparseHessianArrayView(values.data(), values.size());
+  size_t const* rows;
+  size_t const* cols;
+  model_->SparseHessian(xpArrayView, wArrayView, sparseHessianArrayView, &rows, &cols);
+
+  assert(values.allFinite());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getApproximationNonZeros(const vector_t& w, const vector_t& x, const vector_t& p, vector_t& value,
+                                              vector_t& jacobianValues, vector_t& hessianValues) const {
+  EvaluationGuard guard(*this);
+  if (useFallbackModel()) {
+    value = getFunctionValue(x, p);
+    getJacobianNonZeros(x, p, jacobianValues);
+    getHessianNonZeros(w, x, p, hessianValues);
+    return;
+  }
+
+  // Concatenate input
+  xpBuffer_.resize(variableDim_ + parameterDim_);
+  xpBuffer_ << x, p;
+  CppAD::cg::ArrayView<const scalar_t> xpArrayView(xpBuffer_.data(), xpBuffer_.size());
+  size_t const* rows;
+  size_t const* cols;
+
+  // Zero order
+  value.resize(rangeDim_);
+  CppAD::cg::ArrayView<scalar_t> valueArrayView(value.data(), value.size());
+  model_->ForwardZero(xpArrayView, valueArrayView);
+
+  // First order
+  jacobianValues.resize(nnzJacobian_);
+  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(jacobianValues.data(), jacobianValues.size());
+  model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+
+  // Second order
+  hessianValues.resize(nnzHessian_);
+  CppAD::cg::ArrayView<const scalar_t> wArrayView(w.data(), w.size());
+  CppAD::cg::ArrayView<scalar_t> sparseHessianArrayView(hessianValues.data(), hessianValues.size());
+  model_->SparseHessian(xpArrayView, wArrayView, sparseHessianArrayView, &rows, &cols);
+
+  assert(value.allFinite());
+  assert(jacobianValues.allFinite());
+  assert(hessianValues.allFinite());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdInterface::sparse_matrix_t CppAdInterface::getSparseJacobian(const vector_t& x, const vector_t& p) const {
+  EvaluationGuard guard(*this);
+  vector_t values;
+  getJacobianNonZeros(x, p, values);
+
+  sparse_matrix_t jacobian = jacobianPattern_;
+  scalar_t* jacobianData = jacobian.valuePtr();
+  for (size_t k = 0; k < nnzJacobian_; k++) {
+    jacobianData[jacobianPatternScatter_[k]] = values[k];
+  }
+  return jacobian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdInterface::sparse_matrix_t CppAdInterface::getSparseHessian(const vector_t& w, const vector_t& x, const vector_t& p) const {
+  EvaluationGuard guard(*this);
+  vector_t values;
+  getHessianNonZeros(w, x, p, values);
+
+  sparse_matrix_t hessian = hessianPattern_;
+  scalar_t* hessianData = hessian.valuePtr();
+  for (size_t k = 0; k < nnzHessian_; k++) {
+    hessianData[hessianPatternScatter_[k].first] = values[k];
+    hessianData[hessianPatternScatter_[k].second] = values[k];
+  }
+  return hessian;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -335,6 +1261,19 @@ void CppAdInterface::setCompilerOptions(CppAD::cg::GccCompiler<scalar_t>& compil
     compiler.addCompileLibFlag("-rdynamic");
   }
 
+  if (generateBatchKernels_) {
+    // The compile flags above are only used for linking, the sources are compiled with the default flags of the compiler. The
+    // batch kernels need the target flags to be vectorized for AVX2 or AVX-512.
+    if (!compileFlags_.empty()) {
+      compiler.setCompileFlags(compileFlags_);
+    }
+#if defined(__x86_64__) && defined(__GLIBC__)
+    // The vectorized math functions of the batch kernels are provided by libmvec, which the libm linker script only adds as needed.
+    compiler.addLinkFlag("--no-as-needed");
+    compiler.addLinkFlag("-lmvec");
+#endif
+  }
+
   compiler.setTemporaryFolder(tmpFolder_);
 
   // Save sources
@@ -366,12 +1305,147 @@ void CppAdInterface::setApproximationOrder(ApproximationOrder approximationOrder
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void CppAdInterface::setSparsityNonzeros() {
+void CppAdInterface::setSharedLibrary(std::shared_ptr<SharedLibrary> sharedLibrary) {
+  releaseModel();
+
+  sharedLibrary_ = std::move(sharedLibrary);
+  {
+    std::lock_guard<std::mutex> lock(sharedLibrary_->mutex);
+    model_ = sharedLibrary_->modelLibrary->model(modelName_);
+    loadBatchKernels();
+  }
+  const bool replacesFallbackModel = fallbackModel_ != nullptr;
+  if (replacesFallbackModel) {
+    fallbackModel_.reset();
+  }
+  rangeDim_ = model_->Range();
+
+  // The sparse derivatives are returned in the order of the sparsity patterns of the model
+  SparseIndices jacobianIndices;
   if (model_->isJacobianSparsityAvailable()) {
-    nnzJacobian_ = cppad_sparsity::getNumberOfNonZeros(model_->JacobianSparsitySet());
+    model_->JacobianSparsity(jacobianIndices.rows, jacobianIndices.cols);
   }
+  SparseIndices hessianIndices;
   if (model_->isHessianSparsityAvailable()) {
-    nnzHessian_ = cppad_sparsity::getNumberOfNonZeros(model_->HessianSparsitySet());
+    model_->HessianSparsity(hessianIndices.rows, hessianIndices.cols);
+  }
+
+  // The fallback model uses the patterns of the generated code, the indices handed out by getJacobianSparseIndices and
+  // getHessianSparseIndices therefore stay valid when the library replaces it
+  const bool samePatterns = jacobianIndices.rows == jacobianIndices_.rows && jacobianIndices.cols == jacobianIndices_.cols &&
+                            hessianIndices.rows == hessianIndices_.rows && hessianIndices.cols == hessianIndices_.cols;
+  if (!replacesFallbackModel || !samePatterns) {
+    setSparsityPatterns(std::move(jacobianIndices), std::move(hessianIndices));
+  }
+
+  // Cleared last, evaluations which do not see the pending swap anymore skip the EvaluationGuard
+  if (swapPending_) {
+    swapPending_ = false;
+    unregisterFallbackInterface(this);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::releaseModel() {
+  if (model_ != nullptr) {
+    std::lock_guard<std::mutex> lock(sharedLibrary_->mutex);
+    model_.reset();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::loadBatchKernels() {
+  forwardZeroBatch_ = BatchKernel();
+  sparseJacobianBatch_ = BatchKernel();
+
+  // Libraries compiled to shared objects and with the LLVM JIT both look up their functions by name
+  auto* functorLibrary = dynamic_cast<CppAD::cg::FunctorModelLibrary<scalar_t>*>(sharedLibrary_->modelLibrary.get());
+  if (functorLibrary == nullptr) {
+    return;
+  }
+
+  auto loadBatchKernel = [functorLibrary](const std::string& functionName) {
+    BatchKernel batchKernel;
+    void* kernel = functorLibrary->loadFunction(cppad_batch::getBatchKernelName(functionName), false);
+    void* workSize = functorLibrary->loadFunction(cppad_batch::getBatchWorkSizeName(functionName), false);
+    if (kernel != nullptr && workSize != nullptr) {
+      batchKernel.kernel = reinterpret_cast<cppad_batch::batch_kernel_t>(kernel);
+      batchKernel.workSize = reinterpret_cast<cppad_batch::batch_work_size_t>(workSize)();
+    }
+    return batchKernel;
+  };
+  forwardZeroBatch_ = loadBatchKernel(modelName_ + "_forward_zero");
+  sparseJacobianBatch_ = loadBatchKernel(modelName_ + "_sparse_jacobian");
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool CppAdInterface::hasBatchKernels() const {
+  EvaluationGuard guard(*this);
+  // The kernels are loaded together with the model, model_ is therefore set if a kernel is
+  if (forwardZeroBatch_.kernel == nullptr) {
+    return false;
+  }
+  return sparseJacobianBatch_.kernel != nullptr || !model_->isSparseJacobianAvailable();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::setSparsityPatterns(SparseIndices jacobianIndices, SparseIndices hessianIndices) {
+  jacobianIndices_ = std::move(jacobianIndices);
+  nnzJacobian_ = jacobianIndices_.rows.size();
+  jacobianScatter_.clear();
+  jacobianPatternScatter_.clear();
+  if (nnzJacobian_ > 0) {
+    std::vector<Eigen::Triplet<scalar_t>> triplets;
+    triplets.reserve(nnzJacobian_);
+    for (size_t k = 0; k < nnzJacobian_; k++) {
+      const auto row = jacobianIndices_.rows[k];
+      const auto col = jacobianIndices_.cols[k];
+      jacobianScatter_.push_back(col * rangeDim_ + row);
+      triplets.emplace_back(row, col, 0.0);
+    }
+    jacobianPattern_.resize(rangeDim_, variableDim_);
+    jacobianPattern_.setFromTriplets(triplets.begin(), triplets.end());
+    jacobianPattern_.makeCompressed();
+    for (size_t k = 0; k < nnzJacobian_; k++) {
+      const scalar_t* valuePtr = &jacobianPattern_.coeffRef(jacobianIndices_.rows[k], jacobianIndices_.cols[k]);
+      jacobianPatternScatter_.push_back(valuePtr - jacobianPattern_.valuePtr());
+    }
+  }
+
+  hessianIndices_ = std::move(hessianIndices);
+  nnzHessian_ = hessianIndices_.rows.size();
+  hessianScatter_.clear();
+  hessianPatternScatter_.clear();
+  if (nnzHessian_ > 0) {
+    std::vector<Eigen::Triplet<scalar_t>> triplets;
+    triplets.reserve(2 * nnzHessian_);
+    for (size_t k = 0; k < nnzHessian_; k++) {
+      const auto row = hessianIndices_.rows[k];
+      const auto col = hessianIndices_.cols[k];
+      hessianScatter_.emplace_back(col * variableDim_ + row, row * variableDim_ + col);
+      triplets.emplace_back(row, col, 0.0);
+      if (row != col) {
+        triplets.emplace_back(col, row, 0.0);
+      }
+    }
+    hessianPattern_.resize(variableDim_, variableDim_);
+    hessianPattern_.setFromTriplets(triplets.begin(), triplets.end());
+    hessianPattern_.makeCompressed();
+    for (size_t k = 0; k < nnzHessian_; k++) {
+      const auto row = hessianIndices_.rows[k];
+      const auto col = hessianIndices_.cols[k];
+      const scalar_t* upperPtr = &hessianPattern_.coeffRef(row, col);
+      const scalar_t* lowerPtr = &hessianPattern_.coeffRef(col, row);
+      hessianPatternScatter_.emplace_back(upperPtr - hessianPattern_.valuePtr(), lowerPtr - hessianPattern_.valuePtr());
+    }
   }
 }
 
@@ -393,4 +1467,346 @@ cppad_sparsity::SparsityPattern CppAdInterface::createHessianSparsity(ad_fun_t&
   return cppad_sparsity::getIntersection(trueSparsity, variableSparsity);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdParallelCompilation::CppAdParallelCompilation(size_t nThreads)
+    : threadPoolPtr_(new ThreadPool(nThreads)), previousScope_(active()) {
+  active() = this;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdParallelCompilation::~CppAdParallelCompilation() {
+  active() = previousScope_;
+  // The errors are kept by the interfaces and rethrown by their next createModels or loadModelsIfAvailable
+  try {
+    finish();
+  } catch (const std::exception& e) {
+    std::cerr << "[CppAdParallelCompilation] Compilation failed: " << e.what() << std::endl;
+  } catch (...) {
+    std::cerr << "[CppAdParallelCompilation] Compilation failed with an unknown error." << std::endl;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdParallelCompilation::finish() {
+  // wait for all compilations, including the ones whose interfaces were already destroyed
+  std::vector<std::pair<std::shared_future<std::shared_ptr<CppAdInterface::SharedLibrary>>, std::shared_ptr<void>>> submittedCompilations;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    submittedCompilations.swap(submittedCompilations_);
+  }
+  for (const auto& compilation : submittedCompilations) {
+    compilation.first.wait();
+  }
+
+  std::exception_ptr firstError;
+  while (true) {
+    CppAdInterface* adInterface;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (pendingInterfaces_.empty()) {
+        break;
+      }
+      adInterface = *pendingInterfaces_.begin();
+    }
+    try {
+      adInterface->finishCompilation();  // unregisters the interface, also on failure
+    } catch (...) {
+      adInterface->compilationError_ = std::current_exception();
+      if (!firstError) {
+        firstError = std::current_exception();
+      }
+    }
+  }
+  // release the compilation resources on this thread
+  submittedCompilations.clear();
+
+  if (firstError) {
+    std::rethrow_exception(firstError);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdParallelCompilation*& CppAdParallelCompilation::active() {
+  thread_local CppAdParallelCompilation* activeScope = nullptr;
+  return activeScope;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_future<std::shared_ptr<CppAdInterface::SharedLibrary>> CppAdParallelCompilation::submit(
+    std::function<std::shared_ptr<CppAdInterface::SharedLibrary>()> compilation, std::shared_ptr<void> resources) {
+  auto future = threadPoolPtr_->run([compilation](int) { return compilation(); }).share();
+  std::lock_guard<std::mutex> lock(mutex_);
+  submittedCompilations_.emplace_back(future, std::move(resources));
+  return future;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdParallelCompilation::registerInterface(CppAdInterface* adInterface) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  pendingInterfaces_.insert(adInterface);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdParallelCompilation::unregisterInterface(CppAdInterface* adInterface) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  pendingInterfaces_.erase(adInterface);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdBackgroundCompilation::CppAdBackgroundCompilation() : previousScope_(active()) {
+  active() = this;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdBackgroundCompilation::~CppAdBackgroundCompilation() {
+  active() = previousScope_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdBackgroundCompilation::wait() const {
+  for (const auto& compilation : submittedCompilations_) {
+    compilation.get();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdBackgroundCompilation*& CppAdBackgroundCompilation::active() {
+  thread_local CppAdBackgroundCompilation* activeScope = nullptr;
+  return activeScope;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_future<std::shared_ptr<CppAdInterface::SharedLibrary>> CppAdBackgroundCompilation::submit(
+    std::function<std::shared_ptr<CppAdInterface::SharedLibrary>()> compilation) {
+  auto future = std::async(std::launch::async, std::move(compilation)).share();
+  submittedCompilations_.push_back(future);
+  return future;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t swapCompiledCppAdModels() {
+  auto& registry = fallbackInterfaceRegistry();
+  if (registry.numInterfaces == 0) {
+    return 0;
+  }
+
+  // The replaced fallback models are destroyed after the registry lock is released, since their destruction takes the tape lock
+  std::vector<std::shared_ptr<CppAdInterface::FallbackModel>> replacedModels;
+  std::lock_guard<std::recursive_mutex> lock(registry.mutex);
+  const std::vector<CppAdInterface*> adInterfaces(registry.interfaces.begin(), registry.interfaces.end());
+  for (auto* adInterface : adInterfaces) {
+    auto fallbackModel = adInterface->fallbackModel_;
+    if (adInterface->trySwapToCompiledModel()) {
+      replacedModels.push_back(std::move(fallbackModel));
+    }
+  }
+  return replacedModels.size();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdModelBundle::CppAdModelBundle(std::string bundleFile) : bundleFile_(std::move(bundleFile)), previousScope_(active()) {
+  std::unique_ptr<CppAD::cg::LinuxDynamicLib<scalar_t>> dynamicLib(new CppAD::cg::LinuxDynamicLib<scalar_t>(bundleFile_));
+
+  using manifest_t = const char* (*)();
+  auto manifestFunction = reinterpret_cast<manifest_t>(dynamicLib->loadFunction(bundleManifestFunction, false));
+  if (manifestFunction == nullptr) {
+    throw std::runtime_error("[CppAdModelBundle] " + bundleFile_ + " is not a model bundle.");
+  }
+
+  // The manifest is a header line followed by the name and the cache key of each model
+  std::istringstream manifest(manifestFunction());
+  std::string format;
+  int version = 0;
+  manifest >> format >> version;
+  if (format != bundleFormat || version != bundleVersion) {
+    throw std::runtime_error("[CppAdModelBundle] " + bundleFile_ + " has an unsupported manifest format.");
+  }
+  const auto libraryModels = dynamicLib->getModelNames();
+  std::string modelName;
+  std::string cacheKey;
+  while (manifest >> modelName >> cacheKey) {
+    if (libraryModels.count(modelName) == 0) {
+      throw std::runtime_error("[CppAdModelBundle] The model " + modelName + " of the manifest is missing in " + bundleFile_);
+    }
+    cacheKeys_[modelName] = cacheKey;
+  }
+
+  sharedLibrary_ = std::make_shared<CppAdInterface::SharedLibrary>(std::move(dynamicLib));
+  active() = this;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdModelBundle::~CppAdModelBundle() {
+  active() = previousScope_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<std::string> CppAdModelBundle::getModelNames() const {
+  std::vector<std::string> modelNames;
+  for (const auto& entry : cacheKeys_) {
+    modelNames.push_back(entry.first);
+  }
+  return modelNames;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string CppAdModelBundle::getCacheKey(const std::string& modelName) const {
+  const auto entry = cacheKeys_.find(modelName);
+  return (entry != cacheKeys_.end()) ? entry->second : std::string();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdModelBundle::create(const std::string& modelFolder, std::vector<std::string> modelNames, const std::string& bundleFile,
+                              const std::vector<std::string>& compileFlags, bool verbose) {
+  namespace fs = boost::filesystem;
+  auto getGeneratedFolder = [&](const std::string& modelName) { return fs::path(modelFolder) / modelName / "cppad_generated"; };
+  auto readFile = [](const fs::path& path) {
+    std::ifstream file(path.string());
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+  };
+
+  if (modelNames.empty()) {
+    for (const auto& entry : fs::directory_iterator(modelFolder)) {
+      const std::string modelName = entry.path().filename().string();
+      if (fs::exists(getGeneratedFolder(modelName) / (modelName + "_lib.key"))) {
+        modelNames.push_back(modelName);
+      }
+    }
+    std::sort(modelNames.begin(), modelNames.end());
+  }
+  if (modelNames.empty()) {
+    throw std::runtime_error("[CppAdModelBundle] No model libraries found in " + modelFolder);
+  }
+
+  // The sources of a model are prefixed with its name. The library sources, except for the list of models, are the same for all
+  // libraries of a CppADCodeGen version and are taken from the first model.
+  std::map<std::string, std::string> sources;
+  std::ostringstream manifest;
+  manifest << bundleFormat << " " << bundleVersion << "\n";
+  std::ostringstream modelList;
+  for (const auto& modelName : modelNames) {
+    const fs::path generatedFolder = getGeneratedFolder(modelName);
+    std::istringstream keyFile(readFile(generatedFolder / (modelName + "_lib.key")));
+    std::string cacheKey;
+    keyFile >> cacheKey;
+    if (cacheKey.empty()) {
+      throw std::runtime_error("[CppAdModelBundle] No cache key found for the model " + modelName + " in " + generatedFolder.string());
+    }
+    manifest << modelName << " " << cacheKey << "\n";
+    modelList << (modelList.tellp() > 0 ? ", " : "") << "\"" << modelName << "\"";
+
+    for (const auto& entry : fs::directory_iterator(generatedFolder)) {
+      const std::string fileName = entry.path().filename().string();
+      if (entry.path().extension() != ".c") {
+        continue;
+      }
+      const bool isModelSource = fileName.compare(0, modelName.size() + 1, modelName + "_") == 0;
+      const bool isLibrarySource = !isModelSource && modelName == modelNames.front() && fileName != "cppad_cg_models.c";
+      if (isModelSource || isLibrarySource) {
+        sources[fileName] = readFile(entry.path());
+      }
+    }
+  }
+
+  std::ostringstream modelsSource;
+  modelsSource << "void cppad_cg_models(char const *const** names, int* count) {\n"
+               << "   static const char* const models[] = {" << modelList.str() << "};\n"
+               << "   *names = models;\n"
+               << "   *count = " << modelNames.size() << ";\n"
+               << "}\n";
+  sources["cppad_cg_models.c"] = modelsSource.str();
+
+  std::ostringstream manifestSource;
+  manifestSource << "const char* " << bundleManifestFunction << "(void) {\n"
+                 << "   return \"";
+  for (const char c : manifest.str()) {
+    if (c == '\n') {
+      manifestSource << "\\n";
+    } else {
+      manifestSource << c;
+    }
+  }
+  manifestSource << "\";\n"
+                 << "}\n";
+  sources[bundleManifestFunction + std::string(".c")] = manifestSource.str();
+
+  // Compile to a temporary file, such that a bundle that is in use is replaced atomically
+  const std::string tmpName = bundleFile + ".tmp" + std::to_string(getpid());
+  CppAD::cg::GccCompiler<scalar_t> compiler;
+  compiler.setCompileFlags(compileFlags);
+  compiler.setCompileLibFlags(compileFlags);
+  compiler.addCompileLibFlag("-shared");
+  compiler.addCompileLibFlag("-rdynamic");
+#if defined(__x86_64__) && defined(__GLIBC__)
+  const bool hasBatchKernels = std::any_of(sources.begin(), sources.end(), [](const std::pair<const std::string, std::string>& source) {
+    return source.first.find("_batch.c") != std::string::npos;
+  });
+  if (hasBatchKernels) {
+    // The vectorized math functions of the batch kernels are provided by libmvec
+    compiler.addLinkFlag("--no-as-needed");
+    compiler.addLinkFlag("-lmvec");
+  }
+#endif
+  compiler.setTemporaryFolder(tmpName);
+  if (verbose) {
+    std::cerr << "[CppAdModelBundle] Compiling " << modelNames.size() << " models to " << bundleFile << std::endl;
+  }
+  try {
+    compiler.compileSources(sources, true);
+    compiler.buildDynamic(tmpName + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
+  } catch (...) {
+    fs::remove_all(tmpName);
+    throw;
+  }
+  compiler.cleanup();
+  fs::rename(tmpName + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION, bundleFile);
+  fs::remove_all(tmpName);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdModelBundle*& CppAdModelBundle::active() {
+  thread_local CppAdModelBundle* activeScope = nullptr;
+  return activeScope;
+}
+
 }  // namespace ocs2
@@ -0,0 +1,62 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/automatic_differentiation/CppAdInterface.h>
+
+/**
+ * Bundles the CppAD model libraries of a model folder into a single shared library for deployment, see ocs2::CppAdModelBundle.
+ *
+ * Usage: ocs2_cppad_bundle <modelFolder> <bundleFile> [modelName...]
+ */
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    std::cerr << "Usage: " << argv[0] << " <modelFolder> <bundleFile> [modelName...]\n"
+              << "  Bundles the given models, or all models of the folder if none is given." << std::endl;
+    return 1;
+  }
+  const std::string modelFolder(argv[1]);
+  const std::string bundleFile(argv[2]);
+  const std::vector<std::string> modelNames(argv + 3, argv + argc);
+
+  try {
+    ocs2::CppAdModelBundle::create(modelFolder, modelNames, bundleFile);
+    const ocs2::CppAdModelBundle modelBundle(bundleFile);
+    for (const auto& modelName : modelBundle.getModelNames()) {
+      std::cerr << "  " << modelName << " (" << modelBundle.getCacheKey(modelName) << ")" << std::endl;
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "[ocs2_cppad_bundle] " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -108,17 +108,17 @@ VectorFunctionQuadraticApproximation StateConstraintCppAd::getQuadraticApproxima
   vector_t tapedTimeState(1 + stateDim);
   tapedTimeState << time, state;
 
-  constraint.f = adInterfacePtr_->getFunctionValue(tapedTimeState, params);
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeState, params);
-  constraint.dfdx = J.rightCols(stateDim);
+  adInterfacePtr_->getQuadraticApproximation(tapedTimeState, params, approximation_);
+
+  constraint.f = approximation_.f;
+  constraint.dfdx = approximation_.dfdx.rightCols(stateDim);
 
   const size_t numConstraints = constraint.f.rows();
   constraint.dfdxx.resize(numConstraints);
   constraint.dfdux.resize(numConstraints);
   constraint.dfduu.resize(numConstraints);
   for (int i = 0; i < numConstraints; i++) {
-    const matrix_t H = adInterfacePtr_->getHessian(i, tapedTimeState, params);
-    constraint.dfdxx[i] = H.bottomRightCorner(stateDim, stateDim);
+    constraint.dfdxx[i] = approximation_.dfdxx[i].bottomRightCorner(stateDim, stateDim);
   }
 
   return constraint;
@@ -115,8 +115,10 @@ VectorFunctionQuadraticApproximation StateInputConstraintCppAd::getQuadraticAppr
   vector_t tapedTimeStateInput(1 + stateDim + inputDim);
   tapedTimeStateInput << time, state, input;
 
-  constraint.f = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params);
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
+  adInterfacePtr_->getQuadraticApproximation(tapedTimeStateInput, params, approximation_);
+
+  constraint.f = approximation_.f;
+  const matrix_t& J = approximation_.dfdx;
   constraint.dfdx = J.middleCols(1, stateDim);
   constraint.dfdu = J.rightCols(inputDim);
 
@@ -125,7 +127,7 @@ VectorFunctionQuadraticApproximation StateInputConstraintCppAd::getQuadraticAppr
   constraint.dfdux.resize(numConstraints);
   constraint.dfduu.resize(numConstraints);
   for (int i = 0; i < numConstraints; i++) {
-    const matrix_t H = adInterfacePtr_->getHessian(i, tapedTimeStateInput, params);
+    const matrix_t& H = approximation_.dfdxx[i];
     constraint.dfdxx[i] = H.block(1, 1, stateDim, stateDim);
     constraint.dfdux[i] = H.block(1 + stateDim, 1, inputDim, stateDim);
     constraint.dfduu[i] = H.bottomRightCorner(inputDim, inputDim);
@@ -90,6 +90,13 @@ vector_t FeedforwardController::computeInput(scalar_t t, const vector_t& x) {
   return LinearInterpolation::interpolate(t, timeStamp_, uffArray_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FeedforwardController::computeInputInPlace(scalar_t t, const vector_t& x, vector_t& u, int& timeIntervalHint) {
+  LinearInterpolation::interpolate(LinearInterpolation::timeSegment(t, timeStamp_, timeIntervalHint), uffArray_, u);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -101,15 +108,18 @@ void FeedforwardController::flatten(const scalar_array_t& timeArray, const std::
     throw std::runtime_error("timeSize and dataSize must be equal in flatten method.");
   }
 
+  // the time array is sorted, its segments are resolved in a single sweep over the time stamps
+  std::vector<LinearInterpolation::index_alpha_t> indexAlphaArray;
+  LinearInterpolation::timeSegmentBatch(timeArray, timeStamp_, indexAlphaArray);
   for (size_t i = 0; i < timeSize; i++) {
-    flattenSingle(timeArray[i], *(flatArray2[i]));
+    flattenSingle(indexAlphaArray[i], *(flatArray2[i]));
   }
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void FeedforwardController::flattenSingle(scalar_t time, std::vector<float>& flatArray) const {
+void FeedforwardController::flattenSingle(LinearInterpolation::index_alpha_t indexAlpha, std::vector<float>& flatArray) const {
   /* Serialized feedforward controller:
    * data = [
    *   [ uff(t0)[:] ],
@@ -119,7 +129,7 @@ void FeedforwardController::flattenSingle(scalar_t time, std::vector<float>& fla
    * ]
    */
 
-  const vector_t uff = LinearInterpolation::interpolate(time, timeStamp_, uffArray_);
+  const vector_t uff = LinearInterpolation::interpolate(indexAlpha, uffArray_);
 
   flatArray = std::vector<float>(uff.data(), uff.data() + uff.rows());
 }
@@ -86,6 +86,30 @@ vector_t LinearController::computeInput(scalar_t t, const vector_t& x) {
   return uff;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearController::computeInputInPlace(scalar_t t, const vector_t& x, vector_t& u, int& timeIntervalHint) {
+  const auto indexAlpha = LinearInterpolation::timeSegment(t, timeStamp_, timeIntervalHint);
+  const int index = indexAlpha.first;
+  const scalar_t alpha = indexAlpha.second;
+
+  const bool canInterpolate = biasArray_.size() > 1 && biasArray_[index].size() == biasArray_[index + 1].size() &&
+                              gainArray_[index].rows() == gainArray_[index + 1].rows() &&
+                              gainArray_[index].cols() == gainArray_[index + 1].cols();
+  if (canInterpolate) {
+    // u = alpha * (k[i] * x + uff[i]) + (1 - alpha) * (k[i+1] * x + uff[i+1]), which avoids a temporary for the interpolated gain
+    u = alpha * biasArray_[index] + (1.0 - alpha) * biasArray_[index + 1];
+    u.noalias() += alpha * gainArray_[index] * x;
+    u.noalias() += (1.0 - alpha) * gainArray_[index + 1] * x;
+  } else {
+    // single data point or dimension change: snap to the closest data point as in LinearInterpolation::interpolate
+    const int closestIndex = (biasArray_.size() > 1 && alpha <= 0.5) ? index + 1 : index;
+    u = biasArray_[closestIndex];
+    u.noalias() += gainArray_[closestIndex] * x;
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -97,15 +121,18 @@ void LinearController::flatten(const scalar_array_t& timeArray, const std::vecto
     throw std::runtime_error("timeSize and dataSize must be equal in flatten method.");
   }
 
+  // the time array is sorted, its segments are resolved in a single sweep over the time stamps
+  std::vector<LinearInterpolation::index_alpha_t> indexAlphaArray;
+  LinearInterpolation::timeSegmentBatch(timeArray, timeStamp_, indexAlphaArray);
   for (size_t i = 0; i < timeSize; i++) {
-    flattenSingle(timeArray[i], *(flatArray2[i]));
+    flattenSingle(indexAlphaArray[i], *(flatArray2[i]));
   }
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void LinearController::flattenSingle(scalar_t time, std::vector<float>& flatArray) const {
+void LinearController::flattenSingle(LinearInterpolation::index_alpha_t indexAlpha, std::vector<float>& flatArray) const {
   /* Serialized linear controller:
    * data = [
    *   // t0
@@ -128,7 +155,6 @@ void LinearController::flattenSingle(scalar_t time, std::vector<float>& flatArra
    * ]
    */
 
-  const auto indexAlpha = LinearInterpolation::timeSegment(time, timeStamp_);
   const vector_t uff = LinearInterpolation::interpolate(indexAlpha, biasArray_);
   const matrix_t k = LinearInterpolation::interpolate(indexAlpha, gainArray_);
 
@@ -101,9 +101,10 @@ ScalarFunctionQuadraticApproximation QuadraticStateInputCost::getQuadraticApprox
 /******************************************************************************************************/
 std::pair<vector_t, vector_t> QuadraticStateInputCost::getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                               const TargetTrajectories& targetTrajectories) const {
-  const vector_t stateDeviation = state - targetTrajectories.getDesiredState(time);
-  const vector_t inputDeviation = input - targetTrajectories.getDesiredInput(time);
-  return {stateDeviation, inputDeviation};
+  auto deviation = targetTrajectories.getDesiredStateInput(time);
+  deviation.first = state - deviation.first;
+  deviation.second = input - deviation.second;
+  return deviation;
 }
 
 }  // namespace ocs2
@@ -78,10 +78,7 @@ ScalarFunctionQuadraticApproximation StateCostCollection::getQuadraticApproximat
   auto cost = (*firstActive)->getQuadraticApproximation(time, state, targetTrajectories, preComp);
   std::for_each(std::next(firstActive), terms_.end(), [&](const std::unique_ptr<StateCost>& costTerm) {
     if (costTerm->isActive(time)) {
-      const auto costTermApproximation = costTerm->getQuadraticApproximation(time, state, targetTrajectories, preComp);
-      cost.f += costTermApproximation.f;
-      cost.dfdx += costTermApproximation.dfdx;
-      cost.dfdxx += costTermApproximation.dfdxx;
+      costTerm->addQuadraticApproximation(time, state, targetTrajectories, preComp, cost);
     }
   });
 
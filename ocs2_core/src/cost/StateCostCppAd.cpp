@@ -81,15 +81,49 @@ ScalarFunctionQuadraticApproximation StateCostCppAd::getQuadraticApproximation(s
   vector_t tapedTimeState(1 + stateDim);
   tapedTimeState << time, state;
 
-  cost.f = adInterfacePtr_->getFunctionValue(tapedTimeState, params)(0);
+  adInterfacePtr_->getQuadraticApproximation(tapedTimeState, params, approximation_);
 
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeState, params);
-  cost.dfdx = J.rightCols(stateDim).transpose();
-
-  const matrix_t H = adInterfacePtr_->getHessian(0, tapedTimeState, params);
-  cost.dfdxx = H.bottomRightCorner(stateDim, stateDim);
+  cost.f = approximation_.f(0);
+  cost.dfdx = approximation_.dfdx.rightCols(stateDim).transpose();
+  cost.dfdxx = approximation_.dfdxx[0].bottomRightCorner(stateDim, stateDim);
 
   return cost;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateCostCppAd::addQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                               const PreComputation& preComp, ScalarFunctionQuadraticApproximation& cost) const {
+  const vector_t params = getParameters(time, targetTrajectories, preComp);
+  vector_t tapedTimeState(1 + state.rows());
+  tapedTimeState << time, state;
+
+  static const vector_t weights = vector_t::Ones(1);
+  adInterfacePtr_->getApproximationNonZeros(weights, tapedTimeState, params, value_, jacobianNonZeros_, hessianNonZeros_);
+  cost.f += value_(0);
+
+  // The taped variables are (time, state), derivatives w.r.t. time are skipped.
+  const auto& jacobianIndices = adInterfacePtr_->getJacobianSparseIndices();
+  for (Eigen::Index k = 0; k < jacobianNonZeros_.size(); k++) {
+    const size_t col = jacobianIndices.cols[k];
+    if (col > 0) {
+      cost.dfdx(col - 1) += jacobianNonZeros_[k];
+    }
+  }
+
+  // Upper triangular nonzeros, row <= col
+  const auto& hessianIndices = adInterfacePtr_->getHessianSparseIndices();
+  for (Eigen::Index k = 0; k < hessianNonZeros_.size(); k++) {
+    const size_t row = hessianIndices.rows[k];
+    const size_t col = hessianIndices.cols[k];
+    if (row > 0) {
+      cost.dfdxx(row - 1, col - 1) += hessianNonZeros_[k];
+      if (row != col) {
+        cost.dfdxx(col - 1, row - 1) += hessianNonZeros_[k];
+      }
+    }
+  }
+}
+
 }  // namespace ocs2
@@ -79,7 +79,7 @@ ScalarFunctionQuadraticApproximation StateInputCostCollection::getQuadraticAppro
   auto cost = (*firstActive)->getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
   std::for_each(std::next(firstActive), terms_.end(), [&](const std::unique_ptr<StateInputCost>& costTerm) {
     if (costTerm->isActive(time)) {
-      cost += costTerm->getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+      costTerm->addQuadraticApproximation(time, state, input, targetTrajectories, preComp, cost);
     }
   });
 
@@ -84,13 +84,15 @@ ScalarFunctionQuadraticApproximation StateInputCostCppAd::getQuadraticApproximat
   vector_t tapedTimeStateInput(1 + stateDim + inputDim);
   tapedTimeStateInput << time, state, input;
 
-  cost.f = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params)(0);
+  adInterfacePtr_->getQuadraticApproximation(tapedTimeStateInput, params, approximation_);
 
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
+  cost.f = approximation_.f(0);
+
+  const matrix_t& J = approximation_.dfdx;
   cost.dfdx = J.middleCols(1, stateDim).transpose();
   cost.dfdu = J.rightCols(inputDim).transpose();
 
-  const matrix_t H = adInterfacePtr_->getHessian(0, tapedTimeStateInput, params);
+  const matrix_t& H = approximation_.dfdxx[0];
   cost.dfdxx = H.block(1, 1, stateDim, stateDim);
   cost.dfdux = H.block(1 + stateDim, 1, inputDim, stateDim);
   cost.dfduu = H.bottomRightCorner(inputDim, inputDim);
@@ -98,4 +100,55 @@ ScalarFunctionQuadraticApproximation StateInputCostCppAd::getQuadraticApproximat
   return cost;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputCostCppAd::addQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                    const TargetTrajectories& targetTrajectories, const PreComputation& preComputation,
+                                                    ScalarFunctionQuadraticApproximation& cost) const {
+  const size_t stateDim = state.rows();
+  const vector_t params = getParameters(time, targetTrajectories, preComputation);
+  vector_t tapedTimeStateInput(1 + stateDim + input.rows());
+  tapedTimeStateInput << time, state, input;
+
+  static const vector_t weights = vector_t::Ones(1);
+  adInterfacePtr_->getApproximationNonZeros(weights, tapedTimeStateInput, params, value_, jacobianNonZeros_, hessianNonZeros_);
+  cost.f += value_(0);
+
+  // The taped variables are (time, state, input), derivatives w.r.t. time are skipped.
+  const auto& jacobianIndices = adInterfacePtr_->getJacobianSparseIndices();
+  for (Eigen::Index k = 0; k < jacobianNonZeros_.size(); k++) {
+    const size_t col = jacobianIndices.cols[k];
+    if (col == 0) {
+      continue;
+    } else if (col <= stateDim) {
+      cost.dfdx(col - 1) += jacobianNonZeros_[k];
+    } else {
+      cost.dfdu(col - 1 - stateDim) += jacobianNonZeros_[k];
+    }
+  }
+
+  // Upper triangular nonzeros, row <= col
+  const auto& hessianIndices = adInterfacePtr_->getHessianSparseIndices();
+  for (Eigen::Index k = 0; k < hessianNonZeros_.size(); k++) {
+    const size_t row = hessianIndices.rows[k];
+    const size_t col = hessianIndices.cols[k];
+    if (row == 0) {
+      continue;
+    } else if (col <= stateDim) {
+      cost.dfdxx(row - 1, col - 1) += hessianNonZeros_[k];
+      if (row != col) {
+        cost.dfdxx(col - 1, row - 1) += hessianNonZeros_[k];
+      }
+    } else if (row <= stateDim) {
+      cost.dfdux(col - 1 - stateDim, row - 1) += hessianNonZeros_[k];
+    } else {
+      cost.dfduu(row - 1 - stateDim, col - 1 - stateDim) += hessianNonZeros_[k];
+      if (row != col) {
+        cost.dfduu(col - 1 - stateDim, row - 1 - stateDim) += hessianNonZeros_[k];
+      }
+    }
+  }
+}
+
 }  // namespace ocs2
@@ -50,6 +50,18 @@ VectorFunctionLinearApproximation SystemDynamicsBase::linearApproximation(scalar
   return linearApproximation(t, x, u, *preCompPtr_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SystemDynamicsBase::linearApproximationBatch(const scalar_array_t& t, const vector_array_t& x, const vector_array_t& u,
+                                                  const std::vector<size_t>& indices,
+                                                  std::vector<VectorFunctionLinearApproximation>& approximations) {
+  for (const auto i : indices) {
+    assert(i < t.size() && i < x.size() && i < u.size() && i < approximations.size());
+    approximations[i] = linearApproximation(t[i], x[i], u[i]);
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
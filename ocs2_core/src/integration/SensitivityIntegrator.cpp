@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_core/integration/SensitivityIntegrator.h"
 
+#include <cassert>
 #include <unordered_map>
 
 #include <ocs2_core/integration/SensitivityIntegratorImpl.h>
@@ -89,6 +90,58 @@ SensitivityIntegratorType fromString(const std::string& name) {
   return integratorMap.at(name);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t getNumStages(SensitivityIntegratorType integratorType) {
+  switch (integratorType) {
+    case SensitivityIntegratorType::EULER:
+      return 1;
+    case SensitivityIntegratorType::RK2:
+      return 2;
+    case SensitivityIntegratorType::RK4:
+      return 4;
+    default:
+      throw std::runtime_error("Integrator of type " + toString(integratorType) + " not supported.");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void getStagePoint(SensitivityIntegratorType integratorType, size_t stage, scalar_t t, const vector_t& x, scalar_t dt,
+                   const vector_t& previousStageFlowMap, scalar_t& stageTime, vector_t& stageState) {
+  assert(0 < stage && stage < getNumStages(integratorType));
+  // RK2: t + dt. RK4: t + dt/2, t + dt/2, t + dt
+  const scalar_t stageStep = (integratorType == SensitivityIntegratorType::RK4 && stage < 3) ? dt / 2.0 : dt;
+  stageTime = t + stageStep;
+  stageState = x;
+  stageState.noalias() += stageStep * previousStageFlowMap;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void applyStageDiscretization(SensitivityIntegratorType integratorType, const vector_t& x, scalar_t dt,
+                              std::vector<std::vector<VectorFunctionLinearApproximation>>& stageApproximations, size_t index) {
+  assert(stageApproximations.size() >= getNumStages(integratorType));
+  auto& k1 = stageApproximations[0][index];
+  switch (integratorType) {
+    case SensitivityIntegratorType::EULER:
+      applyEulerSensitivityDiscretization(x, dt, k1);
+      break;
+    case SensitivityIntegratorType::RK2:
+      applyRk2SensitivityDiscretization(x, dt, k1, stageApproximations[1][index]);
+      break;
+    case SensitivityIntegratorType::RK4:
+      applyRk4SensitivityDiscretization(x, dt, k1, stageApproximations[1][index], stageApproximations[2][index],
+                                        stageApproximations[3][index]);
+      break;
+    default:
+      throw std::runtime_error("Integrator of type " + toString(integratorType) + " not supported.");
+  }
+}
+
 }  // namespace sensitivity_integrator
 
 }  // namespace ocs2
\ No newline at end of file
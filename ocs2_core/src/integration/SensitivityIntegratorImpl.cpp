@@ -29,8 +29,48 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_core/integration/SensitivityIntegratorImpl.h"
 
+#include "ocs2_core/FixedSizeTypes.h"
+
 namespace ocs2 {
 
+namespace {
+
+/**
+ * Assembles the RK4 sensitivities from the four stage linearizations with compile-time dimensions. The result is written to k1.
+ */
+template <int NX, int NU>
+void rk4SensitivityAssemblyFixedSize(const vector_t& x, scalar_t dt, VectorFunctionLinearApproximation& k1,
+                                     const VectorFunctionLinearApproximation& k2, const VectorFunctionLinearApproximation& k3,
+                                     const VectorFunctionLinearApproximation& k4) {
+  const scalar_t dt_halve = dt / 2.0;
+  const scalar_t dt_sixth = dt / 6.0;
+  const scalar_t dt_third = dt / 3.0;
+
+  const VectorFunctionLinearApproximationTpl<NX, NU> dk1(k1);
+  VectorFunctionLinearApproximationTpl<NX, NU> dk2(k2);
+  VectorFunctionLinearApproximationTpl<NX, NU> dk3(k3);
+  VectorFunctionLinearApproximationTpl<NX, NU> dk4(k4);
+
+  // Input sensitivity \dot{Su} = dfdx(t) Su + dfdu(t), with Su(0) = Zero()
+  dk2.dfdu.noalias() += dt_halve * dk2.dfdx * dk1.dfdu;
+  dk3.dfdu.noalias() += dt_halve * dk3.dfdx * dk2.dfdu;
+  dk4.dfdu.noalias() += dt * dk4.dfdx * dk3.dfdu;
+
+  // State sensitivity \dot{Sx} = dfdx(t) Sx, with Sx(0) = Identity()
+  // the aliased products are evaluated into temporaries on the stack
+  dk2.dfdx += dt_halve * dk2.dfdx * dk1.dfdx;
+  dk3.dfdx += dt_halve * dk3.dfdx * dk2.dfdx;
+  dk4.dfdx += dt * dk4.dfdx * dk3.dfdx;
+
+  // Assemble discrete approximation
+  k1.dfdx = dt_sixth * dk1.dfdx + dt_third * dk2.dfdx + dt_third * dk3.dfdx + dt_sixth * dk4.dfdx;
+  k1.dfdx.diagonal().array() += 1.0;  // plus Identity()
+  k1.dfdu = dt_sixth * dk1.dfdu + dt_third * dk2.dfdu + dt_third * dk3.dfdu + dt_sixth * dk4.dfdu;
+  k1.f = x + dt_sixth * dk1.f + dt_third * dk2.f + dt_third * dk3.f + dt_sixth * dk4.f;
+}
+
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -50,11 +90,18 @@ VectorFunctionLinearApproximation eulerSensitivityDiscretization(SystemDynamicsB
   // B_{k} = dt * dfdu
   // b_{k} = x_{n} + dt * f(x_{n},u_{n})
   auto continuousApproximation = system.linearApproximation(t, x, u);
+  applyEulerSensitivityDiscretization(x, dt, continuousApproximation);
+  return continuousApproximation;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void applyEulerSensitivityDiscretization(const vector_t& x, scalar_t dt, VectorFunctionLinearApproximation& continuousApproximation) {
   continuousApproximation.dfdx *= dt;
   continuousApproximation.dfdx.diagonal().array() += 1.0;  // plus Identity()
   continuousApproximation.dfdu *= dt;
   continuousApproximation.f = x + dt * continuousApproximation.f;
-  return continuousApproximation;
 }
 
 /******************************************************************************************************/
@@ -78,12 +125,21 @@ vector_t rk2Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 /******************************************************************************************************/
 VectorFunctionLinearApproximation rk2SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt) {
-  const scalar_t dt_halve = dt / 2.0;
-
   // System evaluations
   VectorFunctionLinearApproximation k1 = system.linearApproximation(t, x, u);
   VectorFunctionLinearApproximation k2 = system.linearApproximation(t + dt, x + dt * k1.f, u);
 
+  applyRk2SensitivityDiscretization(x, dt, k1, k2);
+  return k1;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void applyRk2SensitivityDiscretization(const vector_t& x, scalar_t dt, VectorFunctionLinearApproximation& k1,
+                                       VectorFunctionLinearApproximation& k2) {
+  const scalar_t dt_halve = dt / 2.0;
+
   // Input sensitivity \dot{Su} = dfdx(t) Su + dfdu(t), with Su(0) = Zero()
   // Re-use memory from k.dfdu as dkduk
   // dk1duk = k1.dfdu
@@ -100,7 +156,6 @@ VectorFunctionLinearApproximation rk2SensitivityDiscretization(SystemDynamicsBas
   k1.dfdx.diagonal().array() += 1.0;  // plus Identity()
   k1.dfdu = dt_halve * k1.dfdu + dt_halve * k2.dfdu;
   k1.f = x + dt_halve * k1.f + dt_halve * k2.f;
-  return k1;
 }
 
 /******************************************************************************************************/
@@ -130,8 +185,6 @@ vector_t rk4Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt) {
   const scalar_t dt_halve = dt / 2.0;
-  const scalar_t dt_sixth = dt / 6.0;
-  const scalar_t dt_third = dt / 3.0;
 
   // System evaluations
   VectorFunctionLinearApproximation k1 = system.linearApproximation(t, x, u);
@@ -142,6 +195,28 @@ VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBas
   tmpV = x + dt * k3.f;
   VectorFunctionLinearApproximation k4 = system.linearApproximation(t + dt, tmpV, u);
 
+  applyRk4SensitivityDiscretization(x, dt, k1, k2, k3, k4);
+  return k1;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void applyRk4SensitivityDiscretization(const vector_t& x, scalar_t dt, VectorFunctionLinearApproximation& k1,
+                                       VectorFunctionLinearApproximation& k2, VectorFunctionLinearApproximation& k3,
+                                       VectorFunctionLinearApproximation& k4) {
+  const scalar_t dt_halve = dt / 2.0;
+  const scalar_t dt_sixth = dt / 6.0;
+  const scalar_t dt_third = dt / 3.0;
+
+  // Problems with declared static dimensions use the fixed-size kernel
+  const bool isFixedSize = dispatchFixedSize(x.size(), k1.dfdu.cols(), [&](auto nx, auto nu) {
+    rk4SensitivityAssemblyFixedSize<decltype(nx)::value, decltype(nu)::value>(x, dt, k1, k2, k3, k4);
+  });
+  if (isFixedSize) {
+    return;
+  }
+
   // Input sensitivity \dot{Su} = dfdx(t) Su + dfdu(t), with Su(0) = Zero()
   // Re-use memory from k.dfdu as dkduk
   // dk1duk = k1.dfdu
@@ -165,7 +240,6 @@ VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBas
   k1.dfdx.diagonal().array() += 1.0;  // plus Identity()
   k1.dfdu = dt_sixth * k1.dfdu + dt_third * k2.dfdu + dt_third * k3.dfdu + dt_sixth * k4.dfdu;
   k1.f = x + dt_sixth * k1.f + dt_third * k2.f + dt_third * k3.f + dt_sixth * k4.f;
-  return k1;
 }
 
 }  // namespace ocs2
\ No newline at end of file
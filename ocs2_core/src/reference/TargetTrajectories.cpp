@@ -94,6 +94,20 @@ vector_t TargetTrajectories::getDesiredInput(scalar_t time) const {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+std::pair<vector_t, vector_t> TargetTrajectories::getDesiredStateInput(scalar_t time) const {
+  if (this->empty()) {
+    throw std::runtime_error("[TargetTrajectories] TargetTrajectories is empty!");
+  } else if (inputTrajectory.empty()) {
+    throw std::runtime_error("[TargetTrajectories] TargetTrajectories does not have inputTrajectory!");
+  } else {
+    const auto indexAlpha = LinearInterpolation::timeSegment(time, timeTrajectory);
+    return {LinearInterpolation::interpolate(indexAlpha, stateTrajectory), LinearInterpolation::interpolate(indexAlpha, inputTrajectory)};
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /***************************************************************************************************** */
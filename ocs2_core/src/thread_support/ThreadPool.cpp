@@ -27,20 +27,49 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
+#include <unordered_map>
+
 #include <ocs2_core/thread_support/SetThreadPriority.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 namespace ocs2 {
 
+namespace {
+// The pool and worker index of the current thread, used to detect nested calls and to push nested tasks to the own deque of a
+// work-stealing worker.
+thread_local const ThreadPool* currentThreadPoolPtr = nullptr;
+thread_local int currentWorkerIndex = -1;
+}  // unnamed namespace
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
-ThreadPool::ThreadPool(size_t nThreads, int priority) {
+ThreadPool::ThreadPool(size_t nThreads, int priority, Scheduler scheduler, std::vector<int> cpuSet, bool pinCallingThread)
+    : scheduler_(scheduler), cpuSet_(std::move(cpuSet)), pinCallingThread_(pinCallingThread) {
+  if (scheduler_ == Scheduler::WorkStealing) {
+    workerQueues_.reserve(nThreads);
+    injectionQueues_.reserve(nThreads);
+    for (size_t i = 0; i < nThreads; i++) {
+      workerQueues_.emplace_back(new WorkStealingQueue<TaskBase*>());
+      injectionQueues_.emplace_back(new BoundedMpmcQueue<TaskBase*>());
+    }
+  }
+
   workerThreads_.reserve(nThreads);
   for (size_t i = 0; i < nThreads; i++) {
-    workerThreads_.emplace_back(&ThreadPool::worker, this, i);
+    if (scheduler_ == Scheduler::WorkStealing) {
+      workerThreads_.emplace_back(&ThreadPool::workStealingWorker, this, i);
+    } else {
+      workerThreads_.emplace_back(&ThreadPool::worker, this, i);
+    }
     setThreadPriority(priority, workerThreads_.back());
   }
+
+  // pinned after all workers are launched such that getThreadCpuSet sees the final number of threads
+  for (size_t i = 0; i < nThreads; i++) {
+    setThreadAffinity(getThreadCpuSet(i), workerThreads_[i]);
+  }
 }
 
 /**************************************************************************************************/
@@ -57,12 +86,29 @@ ThreadPool::~ThreadPool() {
       thread.join();
     }
   }
+
+  // release the tasks that were not executed
+  for (auto& queuePtr : workerQueues_) {
+    TaskBase* task;
+    while (queuePtr->pop(task)) {
+      delete task;
+    }
+  }
+  for (auto& queuePtr : injectionQueues_) {
+    TaskBase* task;
+    while (queuePtr->pop(task)) {
+      delete task;
+    }
+  }
 }
 
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
 void ThreadPool::worker(int workerIndex) {
+  currentThreadPoolPtr = this;
+  currentWorkerIndex = workerIndex;
+
   while (true) {
     std::unique_ptr<ThreadPool::TaskBase> taskPtr;
     {
@@ -87,29 +133,250 @@ void ThreadPool::worker(int workerIndex) {
   }
 }
 
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::workStealingWorker(int workerIndex) {
+  currentThreadPoolPtr = this;
+  currentWorkerIndex = workerIndex;
+
+  while (true) {
+    auto taskPtr = findTask(workerIndex);
+    if (taskPtr) {
+      taskPtr->operator()(workerIndex);
+      continue;
+    }
+
+    // Nothing left to do, go to sleep. The sleeping counter is raised before the predicate is checked such that a concurrent
+    // producer either sees this worker sleeping and notifies it, or this worker sees the pending task.
+    std::unique_lock<std::mutex> lock(taskQueueLock_);
+    ++numSleepingWorkers_;
+    taskQueueCondition_.wait(lock, [this] { return numPendingTasks_ > 0 || stop_; });
+    --numSleepingWorkers_;
+
+    // exit condition
+    if (stop_) {
+      break;
+    }
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+std::unique_ptr<ThreadPool::TaskBase> ThreadPool::findTask(int workerIndex) {
+  const int numWorkers = static_cast<int>(workerQueues_.size());
+
+  while (numPendingTasks_ > 0) {
+    // own deque and injection slot, lock-free
+    TaskBase* task = nullptr;
+    if (workerQueues_[workerIndex]->pop(task) || injectionQueues_[workerIndex]->pop(task)) {
+      --numPendingTasks_;
+      return std::unique_ptr<TaskBase>(task);
+    }
+
+    // steal from the other workers, lock-free
+    for (int i = 1; i < numWorkers; ++i) {
+      const int victimIndex = (workerIndex + i) % numWorkers;
+      if (workerQueues_[victimIndex]->steal(task) || injectionQueues_[victimIndex]->pop(task)) {
+        --numPendingTasks_;
+        return std::unique_ptr<TaskBase>(task);
+      }
+    }
+
+    // tasks which did not fit into the injection slots
+    if (numQueuedOverflowTasks_ > 0) {
+      std::lock_guard<std::mutex> lock(taskQueueLock_);
+      if (!taskQueue_.empty()) {
+        std::unique_ptr<TaskBase> taskPtr = std::move(taskQueue_.front());
+        taskQueue_.pop();
+        --numQueuedOverflowTasks_;
+        --numPendingTasks_;
+        return taskPtr;
+      }
+    }
+
+    // a pending task is in flight (e.g. a steal which is about to fail), try again
+    std::this_thread::yield();
+  }
+
+  return nullptr;
+}
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
 void ThreadPool::runTask(std::unique_ptr<TaskBase> taskPtr) {
-  {
-    std::lock_guard<std::mutex> lock(taskQueueLock_);
-    taskQueue_.push(std::move(taskPtr));
+  if (scheduler_ == Scheduler::WorkStealing) {
+    // counted before it is published, such that a worker never takes an uncounted task
+    ++numPendingTasks_;
+    if (currentThreadPoolPtr == this) {
+      // nested task from one of our workers: push to its own deque without locking
+      workerQueues_[currentWorkerIndex]->push(taskPtr.release());
+    } else {
+      injectTask(taskPtr.release());
+    }
+    notifyWorkers(1);
+
+  } else {
+    {
+      std::lock_guard<std::mutex> lock(taskQueueLock_);
+      taskQueue_.push(std::move(taskPtr));
+    }
+    taskQueueCondition_.notify_one();
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::runTasks(std::vector<std::unique_ptr<TaskBase>> taskPtrs) {
+  const size_t numTasks = taskPtrs.size();
+
+  if (workerThreads_.empty()) {
+    // run on main thread
+    for (auto& taskPtr : taskPtrs) {
+      taskPtr->operator()(0);
+    }
+
+  } else if (scheduler_ == Scheduler::WorkStealing && currentThreadPoolPtr == this) {
+    // nested tasks from one of our workers: push to its own deque without locking
+    numPendingTasks_ += numTasks;
+    for (auto& taskPtr : taskPtrs) {
+      workerQueues_[currentWorkerIndex]->push(taskPtr.release());
+    }
+    notifyWorkers(numTasks);
+
+  } else if (scheduler_ == Scheduler::WorkStealing) {
+    // tasks from outside the pool: spread over the injection slots without locking
+    numPendingTasks_ += numTasks;
+    for (auto& taskPtr : taskPtrs) {
+      injectTask(taskPtr.release());
+    }
+    notifyWorkers(numTasks);
+
+  } else {
+    {
+      std::lock_guard<std::mutex> lock(taskQueueLock_);
+      for (auto& taskPtr : taskPtrs) {
+        taskQueue_.push(std::move(taskPtr));
+      }
+    }
+    for (size_t i = 0; i < std::min(numTasks, workerThreads_.size()); ++i) {
+      taskQueueCondition_.notify_one();
+    }
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::injectTask(TaskBase* task) {
+  const size_t numWorkers = injectionQueues_.size();
+  const size_t startIndex = nextInjectionIndex_++;
+  for (size_t i = 0; i < numWorkers; ++i) {
+    if (injectionQueues_[(startIndex + i) % numWorkers]->push(task)) {
+      return;
+    }
+  }
+
+  // all slots are full
+  ++numOverflowTasks_;
+  std::lock_guard<std::mutex> lock(taskQueueLock_);
+  taskQueue_.emplace(task);
+  ++numQueuedOverflowTasks_;
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::notifyWorkers(size_t numTasks) {
+  const size_t numSleeping = numSleepingWorkers_;
+  if (numSleeping > 0) {
+    // Taking the lock orders the notification after a worker which is about to sleep has entered the wait.
+    { std::lock_guard<std::mutex> lock(taskQueueLock_); }
+    if (numTasks >= numSleeping) {
+      taskQueueCondition_.notify_all();
+    } else {
+      for (size_t i = 0; i < numTasks; ++i) {
+        taskQueueCondition_.notify_one();
+      }
+    }
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+std::vector<int> ThreadPool::getThreadCpuSet(size_t threadIndex) const {
+  const size_t numParticipants = numThreads() + (pinCallingThread_ ? 1 : 0);
+  if (!cpuSet_.empty() && cpuSet_.size() >= numParticipants && threadIndex < cpuSet_.size()) {
+    return {cpuSet_[threadIndex]};  // dedicated core
+  } else {
+    return cpuSet_;  // shared cores
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::pinCallingThread() {
+  // nested calls from a worker thread keep the affinity of the worker
+  if (!pinCallingThread_ || cpuSet_.empty() || currentThreadPoolPtr == this) {
+    return;
+  }
+
+  const auto callingThreadId = std::this_thread::get_id();
+  if (pinnedCallingThreadId_.exchange(callingThreadId) != callingThreadId) {
+    setThisThreadAffinity(getThreadCpuSet(numThreads()));
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+bool ThreadPool::claimChunk(std::atomic_int& nextIndex, int end, int chunkSize, int numTasks, Chunking chunking, int& chunkBegin,
+                            int& chunkEnd) {
+  if (chunking == Chunking::Guided) {
+    chunkBegin = nextIndex.load();
+    do {
+      if (chunkBegin >= end) {
+        return false;
+      }
+      const int remaining = end - chunkBegin;
+      chunkEnd = chunkBegin + std::min(remaining, std::max(chunkSize, remaining / numTasks));
+    } while (!nextIndex.compare_exchange_weak(chunkBegin, chunkEnd));
+    return true;
+
+  } else {  // static and dynamic only differ in the chunk size
+    chunkBegin = nextIndex.fetch_add(chunkSize);
+    if (chunkBegin >= end) {
+      return false;
+    }
+    chunkEnd = std::min(chunkBegin + chunkSize, end);
+    return true;
   }
-  taskQueueCondition_.notify_one();
 }
 
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
 void ThreadPool::runParallel(std::function<void(int)> taskFunction, int N) {
+  pinCallingThread();
+
   // Launch tasks in helper threads
   std::vector<std::future<void>> futures;
   if (N > 1) {
     const int numHelpers = N - 1;
     futures.reserve(numHelpers);
+    std::vector<std::unique_ptr<TaskBase>> helperTasks;
+    helperTasks.reserve(numHelpers);
     for (int i = 0; i < numHelpers; ++i) {
-      futures.emplace_back(run(taskFunction));
+      auto taskPtr = std::make_unique<Task<std::function<void(int)>>>(taskFunction);
+      futures.emplace_back(taskPtr->packagedTask.get_future());
+      helperTasks.push_back(std::move(taskPtr));
     }
+    runTasks(std::move(helperTasks));
   }
 
   // Execute one instance in this thread.
@@ -122,4 +389,28 @@ void ThreadPool::runParallel(std::function<void(int)> taskFunction, int N) {
   }
 }
 
+namespace thread_pool {
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+std::string toString(ThreadPool::Scheduler scheduler) {
+  static const std::unordered_map<ThreadPool::Scheduler, std::string> schedulerMap = {
+      {ThreadPool::Scheduler::SharedQueue, "SharedQueue"}, {ThreadPool::Scheduler::WorkStealing, "WorkStealing"}};
+
+  return schedulerMap.at(scheduler);
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+ThreadPool::Scheduler fromString(const std::string& name) {
+  static const std::unordered_map<std::string, ThreadPool::Scheduler> schedulerMap = {
+      {"SharedQueue", ThreadPool::Scheduler::SharedQueue}, {"WorkStealing", ThreadPool::Scheduler::WorkStealing}};
+
+  return schedulerMap.at(name);
+}
+
+}  // namespace thread_pool
+
 }  // namespace ocs2
@@ -67,6 +67,22 @@ TEST(TestStateCostCppAd, getValue) {
   EXPECT_TRUE(approx.dfdxx.isApprox((ocs2::matrix_t(2, 2) << 1, 0, 0, 2).finished()));
 }
 
+TEST(TestStateCostCppAd, addQuadraticApproximation) {
+  TestStateCost cost;
+  const ocs2::TargetTrajectories desiredTrajectory;
+
+  const ocs2::scalar_t t = 0.0;
+  const ocs2::vector_t x = ocs2::vector_t::Random(2);
+
+  const auto approx = cost.getQuadraticApproximation(t, x, desiredTrajectory, ocs2::PreComputation());
+  auto accumulated = approx;
+  cost.addQuadraticApproximation(t, x, desiredTrajectory, ocs2::PreComputation(), accumulated);
+
+  EXPECT_NEAR(accumulated.f, 2.0 * approx.f, 1e-9);
+  EXPECT_TRUE(accumulated.dfdx.isApprox(2.0 * approx.dfdx));
+  EXPECT_TRUE(accumulated.dfdxx.isApprox(2.0 * approx.dfdxx));
+}
+
 class TestStateInputCost : public ocs2::StateInputCostCppAd {
  public:
   TestStateInputCost() { initialize(2, 1, 0, "TestStateInputCost", "/tmp/ocs2", true, false); }
@@ -109,6 +125,26 @@ TEST(TestStateInputCostCppAd, getValue) {
   EXPECT_TRUE(approx.dfdux.isApprox((ocs2::matrix_t(1, 2) << 1, 1).finished()));
 }
 
+TEST(TestStateInputCostCppAd, addQuadraticApproximation) {
+  TestStateInputCost cost;
+  const ocs2::TargetTrajectories desiredTrajectory;
+
+  const ocs2::scalar_t t = 0.0;
+  const ocs2::vector_t x = ocs2::vector_t::Random(2);
+  const ocs2::vector_t u = ocs2::vector_t::Random(1);
+
+  const auto approx = cost.getQuadraticApproximation(t, x, u, desiredTrajectory, ocs2::PreComputation());
+  auto accumulated = approx;
+  cost.addQuadraticApproximation(t, x, u, desiredTrajectory, ocs2::PreComputation(), accumulated);
+
+  EXPECT_NEAR(accumulated.f, 2.0 * approx.f, 1e-9);
+  EXPECT_TRUE(accumulated.dfdx.isApprox(2.0 * approx.dfdx));
+  EXPECT_TRUE(accumulated.dfdu.isApprox(2.0 * approx.dfdu));
+  EXPECT_TRUE(accumulated.dfdxx.isApprox(2.0 * approx.dfdxx));
+  EXPECT_TRUE(accumulated.dfduu.isApprox(2.0 * approx.dfduu));
+  EXPECT_TRUE(accumulated.dfdux.isApprox(2.0 * approx.dfdux));
+}
+
 class TestGNStateInputCost : public ocs2::StateInputCostGaussNewtonAd {
  public:
   TestGNStateInputCost() { initialize(2, 1, 0, "TestGNStateInputCost", "/tmp/ocs2", true, false); }
@@ -1,7 +1,14 @@
 
 
+#include <atomic>
+#include <thread>
+
+#include <boost/filesystem.hpp>
+
 #include <gtest/gtest.h>
 
+#include <ocs2_core/misc/Benchmark.h>
+
 #include "commonFixture.h"
 
 using namespace ocs2;
@@ -43,6 +50,175 @@ TEST_F(CppAdInterfaceParameterizedFixture, testModelGeneration) {
   ASSERT_TRUE(gnApproximation.dfdxx.isApprox(testJacobian(x, p).transpose() * testJacobian(x, p)));
 }
 
+TEST_F(CppAdInterfaceParameterizedFixture, quadraticApproximation) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelQuadraticApproximation");
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+
+  // The output is reused across evaluations, stale values must be overwritten
+  VectorFunctionQuadraticApproximation approximation;
+  for (int k = 0; k < 3; k++) {
+    const vector_t x = vector_t::Random(variableDim_);
+    const vector_t p = vector_t::Random(parameterDim_);
+    adInterface.getQuadraticApproximation(x, p, approximation);
+
+    ASSERT_TRUE(approximation.f.isApprox(testFun(x, p)));
+    ASSERT_TRUE(approximation.dfdx.isApprox(testJacobian(x, p)));
+    ASSERT_EQ(approximation.dfdxx.size(), rangeDim_);
+    for (size_t i = 0; i < rangeDim_; i++) {
+      ASSERT_TRUE(approximation.dfdxx[i].isApprox(testHessian(i, x, p)));
+    }
+  }
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, sparseDerivatives) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelSparseDerivatives");
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+  const vector_t x = vector_t::Random(variableDim_);
+  const vector_t p = vector_t::Random(parameterDim_);
+  const vector_t w = vector_t::Random(rangeDim_);
+
+  const matrix_t jacobian = adInterface.getJacobian(x, p);
+  const matrix_t hessian = adInterface.getHessian(w, x, p);
+  ASSERT_TRUE(matrix_t(adInterface.getSparseJacobian(x, p)).isApprox(jacobian));
+  ASSERT_TRUE(matrix_t(adInterface.getSparseHessian(w, x, p)).isApprox(hessian));
+
+  // Nonzero values and their indices
+  vector_t values;
+  adInterface.getJacobianNonZeros(x, p, values);
+  const auto& jacobianIndices = adInterface.getJacobianSparseIndices();
+  ASSERT_EQ(values.size(), jacobianIndices.rows.size());
+  ASSERT_EQ(values.size(), jacobianIndices.cols.size());
+  matrix_t scattered = matrix_t::Zero(rangeDim_, variableDim_);
+  for (Eigen::Index k = 0; k < values.size(); k++) {
+    scattered(jacobianIndices.rows[k], jacobianIndices.cols[k]) = values[k];
+  }
+  ASSERT_TRUE(scattered.isApprox(jacobian));
+
+  adInterface.getHessianNonZeros(w, x, p, values);
+  const auto& hessianIndices = adInterface.getHessianSparseIndices();
+  ASSERT_EQ(values.size(), hessianIndices.rows.size());
+  scattered.setZero(variableDim_, variableDim_);
+  for (Eigen::Index k = 0; k < values.size(); k++) {
+    ASSERT_LE(hessianIndices.rows[k], hessianIndices.cols[k]);
+    scattered(hessianIndices.rows[k], hessianIndices.cols[k]) = values[k];
+    scattered(hessianIndices.cols[k], hessianIndices.rows[k]) = values[k];
+  }
+  ASSERT_TRUE(scattered.isApprox(hessian));
+
+  // Fused evaluation
+  vector_t value, jacobianValues, hessianValues;
+  adInterface.getApproximationNonZeros(w, x, p, value, jacobianValues, hessianValues);
+  ASSERT_TRUE(value.isApprox(adInterface.getFunctionValue(x, p)));
+  adInterface.getJacobianNonZeros(x, p, values);
+  ASSERT_TRUE(jacobianValues.isApprox(values));
+  adInterface.getHessianNonZeros(w, x, p, values);
+  ASSERT_TRUE(hessianValues.isApprox(values));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, batchEvaluation) {
+  // A number of points that is not a multiple of the kernel width
+  const size_t numPoints = 2 * ocs2::cppad_batch::kernelWidth + 3;
+  const matrix_t xs = matrix_t::Random(variableDim_, numPoints);
+  const matrix_t ps = matrix_t::Random(parameterDim_, numPoints);
+
+  for (const bool batchKernels : {false, true}) {
+    ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelBatchEvaluation");
+    adInterface.setBatchKernels(batchKernels);
+    adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+    ASSERT_EQ(adInterface.hasBatchKernels(), batchKernels);
+
+    // copies share the batch kernels
+    const ocs2::CppAdInterface adInterfaceCopy(adInterface);
+    ASSERT_EQ(adInterfaceCopy.hasBatchKernels(), batchKernels);
+
+    matrix_t values;
+    matrix_array_t jacobians;
+    adInterfaceCopy.getFunctionValueBatch(xs, ps, values);
+    adInterfaceCopy.getJacobianBatch(xs, ps, jacobians);
+    ASSERT_EQ(values.cols(), numPoints);
+    ASSERT_EQ(jacobians.size(), numPoints);
+    for (size_t i = 0; i < numPoints; i++) {
+      ASSERT_TRUE(values.col(i).isApprox(testFun(xs.col(i), ps.col(i))));
+      ASSERT_TRUE(jacobians[i].isApprox(testJacobian(xs.col(i), ps.col(i))));
+    }
+  }
+}
+
+TEST(CppAdInterfaceBatch, conditionalExpressions) {
+  constexpr size_t variableDim = 3;
+  auto fun = [](const ad_vector_t& x, ad_vector_t& y) {
+    y.resize(2);
+    y(0) = CppAD::CondExpLt(x(0), x(1), sin(x(0)) * x(2), cos(x(1)) * x(2));
+    y(1) = x(0) * x(1) * x(2);
+  };
+  ocs2::CppAdInterface adInterface(fun, variableDim, "testModelBatchConditional");
+  adInterface.setBatchKernels(true);
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+  ASSERT_TRUE(adInterface.hasBatchKernels());
+
+  const size_t numPoints = ocs2::cppad_batch::kernelWidth + 1;
+  const matrix_t xs = matrix_t::Random(variableDim, numPoints);
+  matrix_t values;
+  matrix_array_t jacobians;
+  adInterface.getFunctionValueBatch(xs, matrix_t(0, numPoints), values);
+  adInterface.getJacobianBatch(xs, matrix_t(0, numPoints), jacobians);
+  for (size_t i = 0; i < numPoints; i++) {
+    ASSERT_TRUE(values.col(i).isApprox(adInterface.getFunctionValue(xs.col(i))));
+    ASSERT_TRUE(jacobians[i].isApprox(adInterface.getJacobian(xs.col(i))));
+  }
+}
+
+TEST(CppAdInterfaceBatch, mathFunctions) {
+  // The batch kernels are created from the generated C code, which silently falls back to point by point evaluation if the code
+  // generator emits a form that is not recognized. hasBatchKernels() requires the kernels of the value and of the Jacobian.
+  constexpr size_t variableDim = 3;
+  auto fun = [](const ad_vector_t& x, ad_vector_t& y) {
+    y.resize(6);
+    y(0) = sin(x(0)) * cos(x(1)) + tan(x(2));
+    y(1) = exp(x(0)) * log(1.0 + x(1) * x(1)) + sqrt(2.0 + x(2));
+    y(2) = pow(2.0 + x(0), x(1)) + atan(x(2));
+    y(3) = sinh(x(0)) + cosh(x(1)) * tanh(x(2));
+    y(4) = CppAD::CondExpGt(x(0), x(1), exp(x(2)), sin(x(0) * x(1)));
+    y(5) = x(0) * x(1) * x(2);
+  };
+  ocs2::CppAdInterface adInterface(fun, variableDim, "testModelBatchMathFunctions");
+  adInterface.setBatchKernels(true);
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, true);
+  ASSERT_TRUE(adInterface.hasBatchKernels()) << "The batch kernels fall back to point by point evaluation.";
+
+  const size_t numPoints = ocs2::cppad_batch::kernelWidth;
+  const matrix_t xs = 0.5 * matrix_t::Random(variableDim, numPoints);
+  matrix_t values;
+  matrix_array_t jacobians;
+  adInterface.getFunctionValueBatch(xs, matrix_t(0, numPoints), values);
+  adInterface.getJacobianBatch(xs, matrix_t(0, numPoints), jacobians);
+  for (size_t i = 0; i < numPoints; i++) {
+    ASSERT_TRUE(values.col(i).isApprox(adInterface.getFunctionValue(xs.col(i))));
+    ASSERT_TRUE(jacobians[i].isApprox(adInterface.getJacobian(xs.col(i))));
+  }
+}
+
+TEST(CppAdInterfaceBatch, unsupportedSource) {
+  const std::string functionName = "model_forward_zero";
+  const std::string supported =
+      "void model_forward_zero(double const *const * in,\n"
+      "                        double*const * out,\n"
+      "                        struct LangCAtomicFun atomicFun) {\n"
+      "   //independent variables\n"
+      "   const double* x = in[0];\n"
+      "   //dependent variables\n"
+      "   double* y = out[0];\n"
+      "   y[0] = sin(x[0]) * x[1];\n"
+      "}\n";
+  ASSERT_FALSE(ocs2::cppad_batch::createBatchKernelSource(supported, functionName, 2, 1).empty());
+
+  // Calls of atomic functions require the model library, and the function must be defined in the source
+  std::string atomicFunctionCall = supported;
+  atomicFunctionCall.insert(atomicFunctionCall.find("   y[0]"), "   atomicFun.forward(atomicFun.libModel, 0, 0, 0, tx, &ty);\n");
+  ASSERT_TRUE(ocs2::cppad_batch::createBatchKernelSource(atomicFunctionCall, functionName, 2, 1).empty());
+  ASSERT_TRUE(ocs2::cppad_batch::createBatchKernelSource(supported, "other_forward_zero", 2, 1).empty());
+}
+
 TEST_F(CppAdInterfaceParameterizedFixture, loadIfAvailable) {
   ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelLoadIfAvailable");
 
@@ -60,3 +236,426 @@ TEST_F(CppAdInterfaceParameterizedFixture, loadIfAvailable) {
   ASSERT_TRUE(gnApproximation.dfdx.isApprox(testJacobian(x, p).transpose() * testFun(x, p)));
   ASSERT_TRUE(gnApproximation.dfdxx.isApprox(testJacobian(x, p).transpose() * testJacobian(x, p)));
 }
+
+TEST_F(CppAdInterfaceParameterizedFixture, copySharesLoadedLibrary) {
+  const std::string modelName = "testModelCopySharesLibrary";
+  const std::string folderName = "/tmp/ocs2";
+  std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr(
+      new ocs2::CppAdInterface(funImpl, variableDim_, parameterDim_, modelName, folderName));
+  adInterfacePtr->createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+
+  // Remove the library from disk, copies can only work if they share the loaded library
+  const std::string libraryPath =
+      folderName + "/" + modelName + "/cppad_generated/" + modelName + "_lib" + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+  ASSERT_TRUE(boost::filesystem::remove(libraryPath));
+
+  constexpr size_t numCopies = 4;
+  std::vector<std::unique_ptr<ocs2::CppAdInterface>> copies;
+  for (size_t i = 0; i < numCopies; i++) {
+    copies.emplace_back(new ocs2::CppAdInterface(*adInterfacePtr));
+  }
+  adInterfacePtr.reset();
+
+  // Evaluate the copies concurrently
+  const vector_t x = vector_t::Random(variableDim_);
+  const vector_t p = vector_t::Random(parameterDim_);
+  std::vector<int> isCorrect(numCopies, 0);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < numCopies; i++) {
+    threads.emplace_back([&, i]() {
+      bool correct = true;
+      for (int k = 0; k < 100; k++) {
+        correct = correct && copies[i]->getFunctionValue(x, p).isApprox(testFun(x, p));
+        correct = correct && copies[i]->getJacobian(x, p).isApprox(testJacobian(x, p));
+        correct = correct && copies[i]->getHessian(0, x, p).isApprox(testHessian(0, x, p));
+      }
+      isCorrect[i] = correct ? 1 : 0;
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (size_t i = 0; i < numCopies; i++) {
+    EXPECT_EQ(isCorrect[i], 1) << "copy " << i;
+  }
+
+  // A copy of a copy stays valid after all other instances are destroyed
+  const ocs2::CppAdInterface copyOfCopy(*copies.back());
+  copies.clear();
+  ASSERT_TRUE(copyOfCopy.getFunctionValue(x, p).isApprox(testFun(x, p)));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, loadIfAvailableDetectsModelChange) {
+  const std::string modelName = "testModelCacheKey";
+  const std::string libraryPath = "/tmp/ocs2/" + modelName + "/cppad_generated/" + modelName + "_lib" +
+                                  CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+  const vector_t x = vector_t::Random(variableDim_);
+  const vector_t p = vector_t::Random(parameterDim_);
+
+  {
+    ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, modelName);
+    adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+  }
+  const auto lastWriteTime = boost::filesystem::last_write_time(libraryPath);
+
+  // The same model is loaded from disk
+  {
+    ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, modelName);
+    adInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+    ASSERT_TRUE(adInterface.getFunctionValue(x, p).isApprox(testFun(x, p)));
+    ASSERT_EQ(boost::filesystem::last_write_time(libraryPath), lastWriteTime);
+  }
+
+  // A modified model with the same name is recompiled
+  {
+    auto modifiedFun = [](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+      funImpl(x, p, y);
+      y *= ad_scalar_t(2.0);
+    };
+    ocs2::CppAdInterface adInterface(modifiedFun, variableDim_, parameterDim_, modelName);
+    adInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+    ASSERT_TRUE(adInterface.getFunctionValue(x, p).isApprox(2.0 * testFun(x, p)));
+    ASSERT_TRUE(adInterface.getJacobian(x, p).isApprox(2.0 * testJacobian(x, p)));
+  }
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, loadIfAvailableConcurrently) {
+  const std::string modelName = "testModelLoadConcurrently";
+  ocs2::CppAdInterface(funImpl, variableDim_, parameterDim_, modelName).createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+
+  // The cache keys of a warm start are computed in parallel
+  const vector_t x = vector_t::Random(variableDim_);
+  const vector_t p = vector_t::Random(parameterDim_);
+  constexpr size_t numThreads = 4;
+  std::vector<int> isCorrect(numThreads, 0);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < numThreads; i++) {
+    threads.emplace_back([&, i]() {
+      ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, modelName);
+      adInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::First, false);
+      isCorrect[i] = adInterface.getJacobian(x, p).isApprox(testJacobian(x, p)) ? 1 : 0;
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (size_t i = 0; i < numThreads; i++) {
+    EXPECT_EQ(isCorrect[i], 1) << "thread " << i;
+  }
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, parallelCompilation) {
+  constexpr size_t numModels = 3;
+  const vector_t x = vector_t::Random(variableDim_);
+  const vector_t p = vector_t::Random(parameterDim_);
+
+  std::vector<std::unique_ptr<ocs2::CppAdInterface>> adInterfaces;
+  {
+    ocs2::CppAdParallelCompilation parallelCompilation(numModels);
+    for (size_t i = 0; i < numModels; i++) {
+      const ad_scalar_t scaling(i + 1.0);
+      auto fun = [scaling](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+        funImpl(x, p, y);
+        y *= scaling;
+      };
+      adInterfaces.emplace_back(new ocs2::CppAdInterface(fun, variableDim_, parameterDim_, "testModelParallel" + std::to_string(i)));
+      adInterfaces.back()->createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+    }
+
+    // copy an interface before its library is compiled and destroy the original
+    adInterfaces.back().reset(new ocs2::CppAdInterface(*adInterfaces.back()));
+    parallelCompilation.finish();
+  }
+
+  for (size_t i = 0; i < numModels; i++) {
+    const scalar_t scaling = i + 1.0;
+    ASSERT_TRUE(adInterfaces[i]->getFunctionValue(x, p).isApprox(scaling * testFun(x, p)));
+    ASSERT_TRUE(adInterfaces[i]->getJacobian(x, p).isApprox(scaling * testJacobian(x, p)));
+    ASSERT_TRUE(adInterfaces[i]->getHessian(0, x, p).isApprox(scaling * testHessian(0, x, p)));
+  }
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, parallelCompilationFailure) {
+  // The compiler rejects the flag, such that the compilation fails
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelParallelFailure", "/tmp/ocs2", {"--ocs2-invalid-flag"});
+  {
+    ocs2::CppAdParallelCompilation parallelCompilation(1);
+    adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+    ASSERT_ANY_THROW(parallelCompilation.finish());
+  }
+
+  // The destructor only reports the failure
+  ocs2::CppAdInterface otherInterface(funImpl, variableDim_, parameterDim_, "testModelParallelFailureScope", "/tmp/ocs2",
+                                      {"--ocs2-invalid-flag"});
+  ASSERT_NO_THROW({
+    ocs2::CppAdParallelCompilation parallelCompilation(1);
+    otherInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+  });
+
+  // The failure is thrown once by the next creation of the models
+  ASSERT_ANY_THROW(adInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::First, false));
+  ASSERT_ANY_THROW(otherInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, backgroundCompilation) {
+  const vector_t x = vector_t::Random(variableDim_);
+  const vector_t p = vector_t::Random(parameterDim_);
+  const vector_t w = vector_t::Random(rangeDim_);
+  constexpr scalar_t tolerance = 1e-6;
+
+  std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr;
+  ocs2::CppAdBackgroundCompilation backgroundCompilation;
+  adInterfacePtr.reset(new ocs2::CppAdInterface(funImpl, variableDim_, parameterDim_, "testModelBackground"));
+  adInterfacePtr->createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+  const ocs2::CppAdInterface adInterfaceCopy(*adInterfacePtr);
+
+  // Until the compiled library is swapped in, the taped model is evaluated with finite differences
+  ASSERT_FALSE(adInterfaceCopy.isCompiled());
+  ASSERT_TRUE(adInterfaceCopy.getFunctionValue(x, p).isApprox(testFun(x, p)));
+  ASSERT_TRUE(adInterfaceCopy.getJacobian(x, p).isApprox(testJacobian(x, p), tolerance));
+  ASSERT_TRUE(adInterfaceCopy.getHessian(w, x, p).isApprox(w(0) * testHessian(0, x, p) + w(1) * testHessian(1, x, p), tolerance));
+  VectorFunctionQuadraticApproximation approximation;
+  adInterfaceCopy.getQuadraticApproximation(x, p, approximation);
+  ASSERT_TRUE(approximation.dfdx.isApprox(testJacobian(x, p), tolerance));
+  for (size_t i = 0; i < rangeDim_; i++) {
+    ASSERT_TRUE(approximation.dfdxx[i].isApprox(testHessian(i, x, p), tolerance));
+  }
+  vector_t fallbackJacobianNonZeros;
+  adInterfaceCopy.getJacobianNonZeros(x, p, fallbackJacobianNonZeros);
+  const auto fallbackJacobianIndices = adInterfaceCopy.getJacobianSparseIndices();
+
+  // The evaluation never switches the model, all copies switch together at the synchronization point
+  backgroundCompilation.wait();
+  ASSERT_TRUE(adInterfacePtr->getFunctionValue(x, p).isApprox(testFun(x, p)));
+  ASSERT_FALSE(adInterfacePtr->isCompiled());
+  ASSERT_EQ(ocs2::swapCompiledCppAdModels(), 2U);
+  ASSERT_TRUE(adInterfacePtr->isCompiled());
+  ASSERT_TRUE(adInterfaceCopy.isCompiled());
+  ASSERT_EQ(ocs2::swapCompiledCppAdModels(), 0U);
+  adInterfacePtr.reset();
+  ASSERT_TRUE(adInterfaceCopy.getJacobian(x, p).isApprox(testJacobian(x, p)));
+
+  // The fallback model returns the nonzeros in the order of the compiled library
+  vector_t jacobianNonZeros;
+  adInterfaceCopy.getJacobianNonZeros(x, p, jacobianNonZeros);
+  ASSERT_EQ(adInterfaceCopy.getJacobianSparseIndices().rows, fallbackJacobianIndices.rows);
+  ASSERT_EQ(adInterfaceCopy.getJacobianSparseIndices().cols, fallbackJacobianIndices.cols);
+  ASSERT_TRUE(jacobianNonZeros.isApprox(fallbackJacobianNonZeros, tolerance));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, backgroundCompilationConcurrentSwap) {
+  const vector_t x = vector_t::Random(variableDim_);
+  const vector_t p = vector_t::Random(parameterDim_);
+  constexpr scalar_t tolerance = 1e-6;
+
+  ocs2::CppAdBackgroundCompilation backgroundCompilation;
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelBackgroundConcurrentSwap");
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+  const ocs2::CppAdInterface adInterfaceCopy(adInterface);
+
+  // Another thread evaluates and copies the copy, e.g. like the MRT rollout, while this thread swaps the models
+  std::atomic_bool stop{false};
+  std::atomic_bool isCorrect{true};
+  std::thread evaluationThread([&]() {
+    vector_t jacobianNonZeros;
+    while (!stop) {
+      const bool correct = adInterfaceCopy.getFunctionValue(x, p).isApprox(testFun(x, p)) &&
+                           adInterfaceCopy.getJacobian(x, p).isApprox(testJacobian(x, p), tolerance) &&
+                           ocs2::CppAdInterface(adInterfaceCopy).getFunctionValue(x, p).isApprox(testFun(x, p));
+      adInterfaceCopy.getJacobianNonZeros(x, p, jacobianNonZeros);
+      if (!correct || jacobianNonZeros.size() != static_cast<Eigen::Index>(adInterfaceCopy.getJacobianSparseIndices().rows.size())) {
+        isCorrect = false;
+      }
+    }
+  });
+
+  // An interface which is in use is skipped and switched by a later call
+  backgroundCompilation.wait();
+  while (!adInterfaceCopy.isCompiled()) {
+    ocs2::swapCompiledCppAdModels();
+    std::this_thread::yield();
+  }
+  ASSERT_TRUE(adInterface.isCompiled());
+  stop = true;
+  evaluationThread.join();
+
+  ASSERT_TRUE(isCorrect);
+  ASSERT_EQ(ocs2::swapCompiledCppAdModels(), 0U);
+  ASSERT_TRUE(adInterfaceCopy.getJacobian(x, p).isApprox(testJacobian(x, p)));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, backgroundCompilationFailure) {
+  const vector_t x = vector_t::Random(variableDim_);
+  const vector_t p = vector_t::Random(parameterDim_);
+
+  // The compiler rejects the flag, such that the compilation fails
+  ocs2::CppAdBackgroundCompilation backgroundCompilation;
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelBackgroundFailure", "/tmp/ocs2",
+                                   {"--ocs2-invalid-flag"});
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+  ASSERT_ANY_THROW(backgroundCompilation.wait());
+
+  // The copies evaluate the taped model concurrently, the failure is not thrown by the evaluation
+  constexpr size_t numCopies = 4;
+  std::vector<std::unique_ptr<ocs2::CppAdInterface>> copies;
+  for (size_t i = 0; i < numCopies; i++) {
+    copies.emplace_back(new ocs2::CppAdInterface(adInterface));
+  }
+  std::vector<int> isCorrect(numCopies, 0);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < numCopies; i++) {
+    threads.emplace_back([&, i]() {
+      bool correct = true;
+      for (int k = 0; k < 10; k++) {
+        correct = correct && copies[i]->getFunctionValue(x, p).isApprox(testFun(x, p));
+        correct = correct && copies[i]->getJacobian(x, p).isApprox(testJacobian(x, p), 1e-6);
+      }
+      isCorrect[i] = correct ? 1 : 0;
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (size_t i = 0; i < numCopies; i++) {
+    EXPECT_EQ(isCorrect[i], 1) << "copy " << i;
+  }
+  ASSERT_NO_THROW(adInterface.getFunctionValue(x, p));
+  ASSERT_EQ(ocs2::swapCompiledCppAdModels(), 0U);
+  ASSERT_FALSE(adInterface.isCompiled());
+  ASSERT_FALSE(adInterface.trySwapToCompiledModel());
+
+  // The failure is thrown once by the next creation of the models
+  ASSERT_ANY_THROW(adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false));
+  ASSERT_TRUE(adInterface.getFunctionValue(x, p).isApprox(testFun(x, p)));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, modelBundle) {
+  const std::string modelFolder = "/tmp/ocs2/testModelBundle";
+  const std::string bundleFile = "/tmp/ocs2/testModelBundle.so";
+  const vector_t x = vector_t::Random(variableDim_);
+  const vector_t p = vector_t::Random(parameterDim_);
+  boost::filesystem::remove_all(modelFolder);
+
+  // Bundle two models, of which the second is scaled
+  auto scaledFun = [&](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+    funImpl(x, p, y);
+    y *= ad_scalar_t(2.0);
+  };
+  constexpr auto order = ocs2::CppAdInterface::ApproximationOrder::Second;
+  ocs2::CppAdInterface(funImpl, variableDim_, parameterDim_, "model", modelFolder).createModels(order, false);
+  ocs2::CppAdInterface(scaledFun, variableDim_, parameterDim_, "scaledModel", modelFolder).createModels(order, false);
+  ocs2::CppAdModelBundle::create(modelFolder, {}, bundleFile, {"-O2"}, false);
+  boost::filesystem::remove_all(modelFolder);
+
+  ocs2::CppAdModelBundle modelBundle(bundleFile);
+  ASSERT_EQ(modelBundle.getModelNames(), (std::vector<std::string>{"model", "scaledModel"}));
+
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "model", modelFolder);
+  ocs2::CppAdInterface scaledInterface(scaledFun, variableDim_, parameterDim_, "scaledModel", modelFolder);
+  adInterface.loadModelsIfAvailable(order, false);
+  scaledInterface.loadModelsIfAvailable(order, false);
+  ASSERT_FALSE(boost::filesystem::exists(modelFolder));
+  ASSERT_TRUE(adInterface.getFunctionValue(x, p).isApprox(testFun(x, p)));
+  ASSERT_TRUE(adInterface.getJacobian(x, p).isApprox(testJacobian(x, p)));
+  ASSERT_TRUE(adInterface.getHessian(1, x, p).isApprox(testHessian(1, x, p)));
+  ASSERT_TRUE(scaledInterface.getFunctionValue(x, p).isApprox(2.0 * testFun(x, p)));
+  ASSERT_TRUE(scaledInterface.getJacobian(x, p).isApprox(2.0 * testJacobian(x, p)));
+
+  // A model that changed since the bundle was created is compiled as usual
+  ocs2::CppAdInterface changedInterface(funImpl, variableDim_, parameterDim_, "scaledModel", modelFolder);
+  changedInterface.loadModelsIfAvailable(order, false);
+  ASSERT_TRUE(boost::filesystem::exists(modelFolder));
+  ASSERT_TRUE(changedInterface.getFunctionValue(x, p).isApprox(testFun(x, p)));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, llvmJitBackend) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelLlvmJit");
+#ifdef OCS2_CPPAD_LLVM_JIT
+  // built with OCS2_CPPAD_LLVM_JIT=ON, the backend has to be tested
+  ASSERT_TRUE(ocs2::CppAdInterface::isCompilerBackendAvailable(ocs2::CppAdInterface::CompilerBackend::LlvmJit));
+#endif
+  if (!ocs2::CppAdInterface::isCompilerBackendAvailable(ocs2::CppAdInterface::CompilerBackend::LlvmJit)) {
+    ASSERT_ANY_THROW(adInterface.setCompilerBackend(ocs2::CppAdInterface::CompilerBackend::LlvmJit));
+    std::cout << "LLVM JIT backend not available, skipping test." << std::endl;
+    return;
+  }
+
+  adInterface.setCompilerBackend(ocs2::CppAdInterface::CompilerBackend::LlvmJit);
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+  const ocs2::CppAdInterface adInterfaceCopy(adInterface);
+  const vector_t x = vector_t::Random(variableDim_);
+  const vector_t p = vector_t::Random(parameterDim_);
+
+  for (const ocs2::CppAdInterface* interfacePtr : std::vector<const ocs2::CppAdInterface*>{&adInterface, &adInterfaceCopy}) {
+    ASSERT_TRUE(interfacePtr->getFunctionValue(x, p).isApprox(testFun(x, p)));
+    ASSERT_TRUE(interfacePtr->getJacobian(x, p).isApprox(testJacobian(x, p)));
+    ASSERT_TRUE(interfacePtr->getHessian(0, x, p).isApprox(testHessian(0, x, p)));
+    ASSERT_TRUE(interfacePtr->getHessian(1, x, p).isApprox(testHessian(1, x, p)));
+  }
+}
+
+TEST(CppAdInterfaceBenchmark, compilerBackends) {
+  // A model with some coupling between the variables, such that the generated code is not trivial
+  constexpr size_t variableDim = 24;
+  auto fun = [](const ad_vector_t& x, ad_vector_t& y) {
+    y.resize(variableDim);
+    for (size_t i = 0; i < variableDim; i++) {
+      const size_t j = (i + 1) % variableDim;
+      y(i) = sin(x(i)) * cos(x(j)) + x(i) * x(j) * x(j) + exp(0.1 * x(i));
+    }
+  };
+
+  const vector_t x = vector_t::Random(variableDim);
+  constexpr int numEvaluations = 10000;
+
+  for (const auto compilerBackend : {ocs2::CppAdInterface::CompilerBackend::Gcc, ocs2::CppAdInterface::CompilerBackend::LlvmJit}) {
+    if (!ocs2::CppAdInterface::isCompilerBackendAvailable(compilerBackend)) {
+      continue;
+    }
+    const std::string name = (compilerBackend == ocs2::CppAdInterface::CompilerBackend::Gcc) ? "gcc" : "llvm-jit";
+
+    ocs2::benchmark::RepeatedTimer compileTimer;
+    ocs2::CppAdInterface adInterface(fun, variableDim, "testModelBenchmark");
+    adInterface.setCompilerBackend(compilerBackend);
+    compileTimer.startTimer();
+    adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+    compileTimer.endTimer();
+
+    ocs2::benchmark::RepeatedTimer jacobianTimer;
+    ocs2::benchmark::RepeatedTimer hessianTimer;
+    scalar_t sum = 0.0;
+    for (int i = 0; i < numEvaluations; i++) {
+      jacobianTimer.startTimer();
+      sum += adInterface.getJacobian(x).sum();
+      jacobianTimer.endTimer();
+
+      hessianTimer.startTimer();
+      sum += adInterface.getHessian(0, x).sum();
+      hessianTimer.endTimer();
+    }
+    ASSERT_TRUE(std::isfinite(sum));
+
+    ocs2::benchmark::RepeatedTimer separateTimer;
+    ocs2::benchmark::RepeatedTimer fusedTimer;
+    VectorFunctionQuadraticApproximation approximation;
+    for (int i = 0; i < numEvaluations; i++) {
+      separateTimer.startTimer();
+      sum += adInterface.getFunctionValue(x).sum();
+      sum += adInterface.getJacobian(x).sum();
+      for (size_t j = 0; j < variableDim; j++) {
+        sum += adInterface.getHessian(j, x).sum();
+      }
+      separateTimer.endTimer();
+
+      fusedTimer.startTimer();
+      adInterface.getQuadraticApproximation(x, vector_t(0), approximation);
+      fusedTimer.endTimer();
+    }
+    ASSERT_TRUE(std::isfinite(sum));
+
+    std::cout << "[" << name << "] compilation: " << compileTimer.getLastIntervalInMilliseconds() << " [ms], jacobian: "
+              << 1e3 * jacobianTimer.getAverageInMilliseconds() << " [us], hessian: " << 1e3 * hessianTimer.getAverageInMilliseconds()
+              << " [us], value/jacobian/hessians separate: " << 1e3 * separateTimer.getAverageInMilliseconds()
+              << " [us], fused: " << 1e3 * fusedTimer.getAverageInMilliseconds() << " [us]" << std::endl;
+  }
+}
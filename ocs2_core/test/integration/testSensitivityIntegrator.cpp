@@ -184,6 +184,37 @@ TEST(test_sensitivity_integrator, rk4Sensitivity) {
   ASSERT_TRUE(rk4LinearizedDynamics.dfdu.isApprox(rk4dynamics_check.dfdu));
 }
 
+TEST(test_sensitivity_integrator, rk4SensitivityDynamicSize) {
+  // (3, 2) is not listed in OCS2_FIXED_SIZE_DIMENSIONS, hence the dynamic-size path is used
+  const ocs2::matrix_t A = ocs2::matrix_t::Random(3, 3);
+  const ocs2::matrix_t B = ocs2::matrix_t::Random(3, 2);
+  ocs2::LinearSystemDynamics system(A, B);
+  ocs2::scalar_t t = 0.5;
+  ocs2::vector_t x = ocs2::vector_t::Random(3);
+  ocs2::vector_t u = ocs2::vector_t::Random(2);
+  ocs2::scalar_t dt = 0.1;
+
+  // For linear time-invariant systems, RK4 is the 4th order Taylor expansion of the matrix exponential
+  const ocs2::matrix_t Ad = A * dt;
+  ocs2::matrix_t expAd = ocs2::matrix_t::Identity(3, 3);
+  ocs2::matrix_t term = ocs2::matrix_t::Identity(3, 3);
+  ocs2::matrix_t intExpAd = ocs2::matrix_t::Identity(3, 3);  // sum_{k} (A dt)^k / (k+1)!
+  for (int k = 1; k <= 4; k++) {
+    term = term * Ad / k;
+    expAd += term;
+    if (k < 4) {
+      intExpAd += term / (k + 1);
+    }
+  }
+
+  auto rk4SensitivityDiscretization = ocs2::selectDynamicsSensitivityDiscretization(ocs2::SensitivityIntegratorType::RK4);
+  auto rk4Discretization = ocs2::selectDynamicsDiscretization(ocs2::SensitivityIntegratorType::RK4);
+  const auto rk4LinearizedDynamics = rk4SensitivityDiscretization(system, t, x, u, dt);
+  ASSERT_TRUE(rk4LinearizedDynamics.f.isApprox(rk4Discretization(system, t, x, u, dt)));
+  ASSERT_TRUE(rk4LinearizedDynamics.dfdx.isApprox(expAd));
+  ASSERT_TRUE(rk4LinearizedDynamics.dfdu.isApprox(intExpAd * B * dt));
+}
+
 TEST(test_sensitivity_integrator, vsBoostRK4) {
   auto system = getSystem();
   ocs2::scalar_t t = 0.5;
@@ -210,3 +241,36 @@ TEST(test_sensitivity_integrator, vsBoostRK4) {
   // Check
   ASSERT_TRUE(rk4ForwardDynamics.isApprox(boostRk4ForwardDynamics));
 }
+
+TEST(test_sensitivity_integrator, stageWiseSensitivity) {
+  auto system = getSystem();
+  ocs2::scalar_t t = 0.5;
+  ocs2::vector_t x = ocs2::vector_t::Random(2);
+  ocs2::vector_t u = ocs2::vector_t::Random(1);
+  ocs2::scalar_t dt = 0.1;
+
+  for (auto type : {ocs2::SensitivityIntegratorType::EULER, ocs2::SensitivityIntegratorType::RK2, ocs2::SensitivityIntegratorType::RK4}) {
+    const auto sensitivityDiscretization = ocs2::selectDynamicsSensitivityDiscretization(type);
+    const auto linearizedDynamics = sensitivityDiscretization(*system, t, x, u, dt);
+
+    // Linearize stage by stage, one interval at index 1
+    const size_t numStages = ocs2::sensitivity_integrator::getNumStages(type);
+    const std::vector<size_t> indices{1};
+    ocs2::scalar_array_t stageTimes{0.0, t};
+    ocs2::vector_array_t stageStates{x, x};
+    const ocs2::vector_array_t inputs{u, u};
+    std::vector<std::vector<ocs2::VectorFunctionLinearApproximation>> stageApproximations(
+        numStages, std::vector<ocs2::VectorFunctionLinearApproximation>(2));
+    system->linearApproximationBatch(stageTimes, stageStates, inputs, indices, stageApproximations[0]);
+    for (size_t s = 1; s < numStages; s++) {
+      ocs2::sensitivity_integrator::getStagePoint(type, s, t, x, dt, stageApproximations[s - 1][1].f, stageTimes[1], stageStates[1]);
+      system->linearApproximationBatch(stageTimes, stageStates, inputs, indices, stageApproximations[s]);
+    }
+    ocs2::sensitivity_integrator::applyStageDiscretization(type, x, dt, stageApproximations, 1);
+
+    const auto& stageWiseDynamics = stageApproximations[0][1];
+    ASSERT_TRUE(stageWiseDynamics.f.isApprox(linearizedDynamics.f)) << ocs2::sensitivity_integrator::toString(type);
+    ASSERT_TRUE(stageWiseDynamics.dfdx.isApprox(linearizedDynamics.dfdx)) << ocs2::sensitivity_integrator::toString(type);
+    ASSERT_TRUE(stageWiseDynamics.dfdu.isApprox(linearizedDynamics.dfdu)) << ocs2::sensitivity_integrator::toString(type);
+  }
+}
@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <iostream>
+#include <random>
 
+#include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/misc/LinearInterpolation.h>
 #include <Eigen/Dense>
 
@@ -132,3 +135,154 @@ TEST(testLinearInterpolation, testDifferentEigenSizes) {
   result = ocs2::LinearInterpolation::interpolate(1.1, times, data);
   EXPECT_TRUE(result.isApprox(data[1]));
 }
+
+TEST(testLinearInterpolation, testInterpolateBatch) {
+  using pair_t = std::pair<double, Eigen::VectorXd>;
+  const std::vector<double> timeArray{0.0, 1.0, 1.0, 2.0, 3.0};
+  std::vector<Eigen::VectorXd> dataArray;
+  std::vector<pair_t> pairArray;
+  for (const auto t : timeArray) {
+    dataArray.push_back(Eigen::VectorXd::Constant(3, t));
+    pairArray.emplace_back(-t, Eigen::VectorXd::Constant(2, 2.0 * t));
+  }
+
+  // sorted and unsorted queries
+  for (const auto& queryTimes : {std::vector<double>{-1.0, 0.0, 0.5, 1.0, 1.0, 1.5, 2.9, 3.0, 4.0},
+                                 std::vector<double>{2.5, 0.3, 1.0, -1.0, 4.0, 1.7}}) {
+    std::vector<ocs2::LinearInterpolation::index_alpha_t> indexAlphaArray;
+    ocs2::LinearInterpolation::timeSegmentBatch(queryTimes, timeArray, indexAlphaArray);
+
+    std::vector<Eigen::VectorXd> result;
+    ocs2::LinearInterpolation::interpolateBatch(queryTimes, timeArray, dataArray, result);
+
+    std::vector<Eigen::VectorXd> resultSubfield;
+    ocs2::LinearInterpolation::interpolateBatch(
+        queryTimes, timeArray, pairArray, [](const std::vector<pair_t>& v, size_t n) -> const Eigen::VectorXd& { return v[n].second; },
+        resultSubfield);
+
+    ASSERT_EQ(indexAlphaArray.size(), queryTimes.size());
+    ASSERT_EQ(result.size(), queryTimes.size());
+    ASSERT_EQ(resultSubfield.size(), queryTimes.size());
+    for (size_t i = 0; i < queryTimes.size(); i++) {
+      const auto indexAlpha = ocs2::LinearInterpolation::timeSegment(queryTimes[i], timeArray);
+      EXPECT_EQ(indexAlphaArray[i].first, indexAlpha.first);
+      EXPECT_DOUBLE_EQ(indexAlphaArray[i].second, indexAlpha.second);
+      EXPECT_TRUE(result[i].isApprox(ocs2::LinearInterpolation::interpolate(queryTimes[i], timeArray, dataArray)));
+      EXPECT_TRUE(resultSubfield[i].isApprox(2.0 * result[i].head(2)));
+    }
+  }
+}
+
+TEST(testLinearInterpolation, testInterpolateFields) {
+  using pair_t = std::pair<double, Eigen::MatrixXd>;
+  const std::vector<double> timeArray{0.0, 1.0, 2.0};
+  std::vector<pair_t> pairArray;
+  for (const auto t : timeArray) {
+    pairArray.emplace_back(t, Eigen::MatrixXd::Constant(2, 3, -t));
+  }
+  const auto first = [](const std::vector<pair_t>& v, size_t n) -> const double& { return v[n].first; };
+  const auto second = [](const std::vector<pair_t>& v, size_t n) -> const Eigen::MatrixXd& { return v[n].second; };
+
+  for (const auto t : {-0.5, 0.0, 0.25, 1.0, 1.6, 2.0, 3.0}) {
+    const auto indexAlpha = ocs2::LinearInterpolation::timeSegment(t, timeArray);
+    double scalarResult;
+    Eigen::MatrixXd matrixResult;
+    ocs2::LinearInterpolation::interpolateFields(indexAlpha, pairArray, ocs2::LinearInterpolation::field(first, scalarResult),
+                                                 ocs2::LinearInterpolation::field(second, matrixResult));
+    EXPECT_DOUBLE_EQ(scalarResult, ocs2::LinearInterpolation::interpolate(indexAlpha, pairArray, first));
+    EXPECT_TRUE(matrixResult.isApprox(ocs2::LinearInterpolation::interpolate(indexAlpha, pairArray, second)));
+  }
+
+  // single data point
+  const std::vector<pair_t> singlePairArray{pairArray[1]};
+  double scalarResult;
+  ocs2::LinearInterpolation::interpolateFields(ocs2::LinearInterpolation::timeSegment(0.5, {1.0}), singlePairArray,
+                                               ocs2::LinearInterpolation::field(first, scalarResult));
+  EXPECT_DOUBLE_EQ(scalarResult, 1.0);
+}
+
+TEST(testInterpolationCursor, sameAsTimeSegment) {
+  // time array with event times (repeated time stamps)
+  std::vector<double> timeArray;
+  for (int i = 0; i < 200; i++) {
+    timeArray.push_back(0.01 * i);
+    if (i % 50 == 0) {
+      timeArray.push_back(0.01 * i);
+    }
+  }
+
+  // queries inside the range, on the nodes, and outside of the range
+  std::vector<double> queryTimes;
+  for (int i = -10; i < 2100; i++) {
+    queryTimes.push_back(0.001 * i);
+  }
+  queryTimes.insert(queryTimes.end(), timeArray.begin(), timeArray.end());
+  std::sort(queryTimes.begin(), queryTimes.end());
+
+  auto checkQueries = [&](ocs2::LinearInterpolation::InterpolationCursor& cursor) {
+    for (const auto t : queryTimes) {
+      const auto expected = ocs2::LinearInterpolation::timeSegment(t, timeArray);
+      const auto indexAlpha = cursor.timeSegment(t);
+      ASSERT_EQ(indexAlpha.first, expected.first) << "time: " << t;
+      ASSERT_DOUBLE_EQ(indexAlpha.second, expected.second) << "time: " << t;
+    }
+  };
+
+  ocs2::LinearInterpolation::InterpolationCursor cursor(timeArray);
+
+  // forward
+  checkQueries(cursor);
+
+  // backward
+  std::reverse(queryTimes.begin(), queryTimes.end());
+  checkQueries(cursor);
+
+  // random access
+  std::mt19937 generator(0);
+  std::shuffle(queryTimes.begin(), queryTimes.end(), generator);
+  checkQueries(cursor);
+
+  // reset to a different array
+  const std::vector<double> otherTimeArray{0.0, 1.0};
+  cursor.reset(otherTimeArray);
+  EXPECT_EQ(cursor.timeSegment(0.5).first, 0);
+  EXPECT_DOUBLE_EQ(cursor.timeSegment(0.5).second, 0.5);
+}
+
+TEST(testInterpolationCursor, benchmark) {
+  const int numTimeStamps = 1000;
+  const int numQueries = 100 * numTimeStamps;
+  const int numRepetitions = 20;
+
+  std::vector<double> timeArray(numTimeStamps);
+  for (int i = 0; i < numTimeStamps; i++) {
+    timeArray[i] = 0.001 * i;
+  }
+  std::vector<double> queryTimes(numQueries);
+  for (int i = 0; i < numQueries; i++) {
+    queryTimes[i] = timeArray.back() * i / (numQueries - 1);
+  }
+
+  ocs2::benchmark::RepeatedTimer timeSegmentTimer;
+  ocs2::benchmark::RepeatedTimer cursorTimer;
+  double sum = 0.0;  // prevents the loops from being optimized away
+  for (int n = 0; n < numRepetitions; n++) {
+    timeSegmentTimer.startTimer();
+    for (const auto t : queryTimes) {
+      sum += ocs2::LinearInterpolation::timeSegment(t, timeArray).second;
+    }
+    timeSegmentTimer.endTimer();
+
+    ocs2::LinearInterpolation::InterpolationCursor cursor(timeArray);
+    cursorTimer.startTimer();
+    for (const auto t : queryTimes) {
+      sum -= cursor.timeSegment(t).second;
+    }
+    cursorTimer.endTimer();
+  }
+  EXPECT_NEAR(sum, 0.0, 1e-6);
+
+  std::cout << "Sequential lookup of " << numQueries << " times in " << numTimeStamps << " time stamps:\n";
+  std::cout << "timeSegment : " << 1e6 * timeSegmentTimer.getAverageInMilliseconds() / numQueries << " ns per query\n";
+  std::cout << "cursor      : " << 1e6 * cursorTimer.getAverageInMilliseconds() / numQueries << " ns per query\n";
+}
@@ -104,6 +104,34 @@ TEST(testLookup, findIntervalInTimeArray) {
   ASSERT_EQ(findIntervalInTimeArray(timeArrayEmpty, 1.0), 0);
 }
 
+TEST(testLookup, findIntervalInTimeArrayWithHint) {
+  // includes repeated times
+  const std::vector<double> timeArray{-1.0, 0.0, 0.5, 0.5, 1.0, 2.0, 3.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0};
+  const std::vector<double> queryTimes{-2.0, -1.0, -0.5, 0.0, 0.25, 0.5, 0.75, 1.0, 2.5, 3.0, 3.5, 4.0, 7.5, 9.0, 10.0};
+  const int numIntervals = timeArray.size();
+
+  // any hint, including out of range hints, gives the same result as the plain lookup
+  for (const auto time : queryTimes) {
+    for (int hint = -3; hint <= numIntervals + 2; hint++) {
+      ASSERT_EQ(findIntervalInTimeArray(timeArray, time, hint), findIntervalInTimeArray(timeArray, time)) << time << ", " << hint;
+    }
+  }
+
+  // empty array
+  ASSERT_EQ(findIntervalInTimeArray(std::vector<double>{}, 1.0, 3), 0);
+
+  // galloping over long distances in both directions
+  std::vector<double> longTimeArray;
+  for (int i = 0; i < 1000; i++) {
+    longTimeArray.push_back(0.5 * (i / 3));  // every time stamp appears 3 times
+  }
+  for (const auto time : {-1.0, 0.0, 0.2, 10.0, 10.25, 100.0, 166.5, 200.0}) {
+    for (const int hint : {-1, 0, 1, 7, 50, 500, 997, 999}) {
+      ASSERT_EQ(findIntervalInTimeArray(longTimeArray, time, hint), findIntervalInTimeArray(longTimeArray, time)) << time << ", " << hint;
+    }
+  }
+}
+
 TEST(testLookup, findActiveIntervalInTimeArray) {
   // Normal case
   std::vector<double> timeArray{-1.0, 2.0, 3.0};
@@ -0,0 +1,68 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include <ocs2_core/misc/Benchmark.h>
+
+using namespace ocs2;
+
+TEST(testTimeBudget, unlimited) {
+  benchmark::TimeBudget timeBudget;
+  timeBudget.start(0.0);
+  ASSERT_FALSE(timeBudget.isLimited());
+  ASSERT_TRUE(timeBudget.fits(1e9));
+}
+
+TEST(testTimeBudget, limited) {
+  benchmark::TimeBudget timeBudget;
+  timeBudget.start(1000.0);
+  ASSERT_TRUE(timeBudget.isLimited());
+  ASSERT_TRUE(timeBudget.fits(1.0));
+  ASSERT_FALSE(timeBudget.fits(2000.0));
+
+  timeBudget.start(1.0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  ASSERT_LT(timeBudget.getRemainingInMilliseconds(), 0.0);
+  ASSERT_FALSE(timeBudget.fits(0.0));
+}
+
+TEST(testTimeBudget, predictDuration) {
+  benchmark::RepeatedTimer timedPhase;
+  benchmark::RepeatedTimer untimedPhase;
+  timedPhase.startTimer();
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  timedPhase.endTimer();
+
+  const scalar_t duration = benchmark::TimeBudget::predictDurationInMilliseconds({&timedPhase, &untimedPhase});
+  ASSERT_DOUBLE_EQ(duration, timedPhase.getLastIntervalInMilliseconds());
+  ASSERT_GE(duration, 2.0);
+}
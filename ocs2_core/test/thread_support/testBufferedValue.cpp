@@ -59,13 +59,12 @@ TEST(testBufferedValue, moveCount) {
   ASSERT_EQ(bufferedValue.get().getCount(), 1);
 
   /*
-   * A new value can be set with two moves:
-   *  - 1 into the buffer.
-   *  - 1 from the buffer to the active value.
+   * A new value can be set with a single move into the buffer.
+   * Activating the buffered value only swaps the buffer slots.
    */
   MoveCounter newCounter{};
   bufferedValue.setBuffer(std::move(newCounter));
   const bool isUpdated = bufferedValue.updateFromBuffer();
   ASSERT_TRUE(isUpdated);
-  ASSERT_EQ(bufferedValue.get().getCount(), 2);
+  ASSERT_EQ(bufferedValue.get().getCount(), 1);
 }
\ No newline at end of file
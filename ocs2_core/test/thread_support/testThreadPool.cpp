@@ -1,4 +1,10 @@
 #include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+
+#include <pthread.h>
+
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 using namespace ocs2;
@@ -121,3 +127,286 @@ TEST(testThreadPool, testMoveOnlyTask) {
 
   EXPECT_EQ(result.get(), 3.14);
 }
+
+TEST(testThreadPool, testWorkStealingRunMultiple) {
+  ThreadPool pool(3, 0, ThreadPool::Scheduler::WorkStealing);
+  std::atomic_int counter;
+  counter = 0;
+
+  for (int i = 0; i < 100; i++) {
+    pool.runParallel([&](int) { counter++; }, 42);
+  }
+
+  EXPECT_EQ(counter, 4200);
+}
+
+TEST(testThreadPool, testWorkStealingWorkerIndex) {
+  const size_t nThreads = 3;
+  ThreadPool pool(nThreads, 0, ThreadPool::Scheduler::WorkStealing);
+
+  // Each index is only used by one thread at a time, so the per-worker counters need no synchronization.
+  std::vector<int> counters(nThreads + 1, 0);
+  std::atomic_bool indexInRange{true};
+  pool.runParallel(
+      [&](int workerIndex) {
+        if (workerIndex < 0 || workerIndex > static_cast<int>(nThreads)) {
+          indexInRange = false;
+        } else {
+          counters[workerIndex]++;
+        }
+      },
+      1000);
+
+  EXPECT_TRUE(indexInRange);
+  EXPECT_EQ(std::accumulate(counters.begin(), counters.end(), 0), 1000);
+}
+
+TEST(testThreadPool, testWorkStealingNestedTasks) {
+  ThreadPool pool(4, 0, ThreadPool::Scheduler::WorkStealing);
+  std::atomic_int counter;
+  counter = 0;
+
+  // Tasks spawned from a worker are pushed to the worker's own deque and stolen by the others.
+  auto fut = pool.run([&](int) {
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 100; i++) {
+      futures.push_back(pool.run([&](int) { counter++; }));
+    }
+    return futures;
+  });
+
+  for (auto& f : fut.get()) {
+    f.get();
+  }
+  EXPECT_EQ(counter, 100);
+}
+
+TEST(testThreadPool, testWorkStealingExternalSubmission) {
+  const size_t nThreads = 3;
+  ThreadPool pool(nThreads, 0, ThreadPool::Scheduler::WorkStealing);
+
+  // Batches from outside the pool, as submitted by the solvers, are served from the lock-free injection slots.
+  std::atomic_bool indexInRange{true};
+  std::atomic_int counter{0};
+  auto checkIndex = [&](int workerIndex) {
+    if (workerIndex < 0 || workerIndex > static_cast<int>(nThreads)) {
+      indexInRange = false;
+    }
+  };
+  for (int i = 0; i < 100; i++) {
+    pool.runParallel(
+        [&](int workerIndex) {
+          checkIndex(workerIndex);
+          counter++;
+        },
+        nThreads + 1);
+    pool.parallelFor(0, 50, 1, [&](int workerIndex, int) {
+      checkIndex(workerIndex);
+      counter++;
+    });
+  }
+
+  EXPECT_TRUE(indexInRange);
+  EXPECT_EQ(counter, 100 * static_cast<int>(nThreads + 1 + 50));
+  EXPECT_EQ(pool.numOverflowTasks(), 0u);
+
+  // more tasks than fit into the injection slots go through the overflow queue
+  std::vector<std::future<void>> futures;
+  for (int i = 0; i < 1000; i++) {
+    futures.push_back(pool.run([&](int workerIndex) {
+      checkIndex(workerIndex);
+      counter++;
+    }));
+  }
+  for (auto& f : futures) {
+    f.get();
+  }
+
+  EXPECT_TRUE(indexInRange);
+  EXPECT_EQ(counter, 100 * static_cast<int>(nThreads + 1 + 50) + 1000);
+}
+
+TEST(testThreadPool, testBoundedMpmcQueue) {
+  BoundedMpmcQueue<int*> queue(5);
+  ASSERT_EQ(queue.capacity(), 8u);
+
+  // FIFO order, push fails when full
+  std::vector<int> data(1000);
+  for (size_t i = 0; i < queue.capacity(); i++) {
+    ASSERT_TRUE(queue.push(&data[i]));
+  }
+  EXPECT_FALSE(queue.push(&data.back()));
+  int* item = nullptr;
+  for (size_t i = 0; i < queue.capacity(); i++) {
+    ASSERT_TRUE(queue.pop(item));
+    EXPECT_EQ(item, &data[i]);
+  }
+  EXPECT_FALSE(queue.pop(item));
+
+  // concurrent producers and consumers transfer every element exactly once
+  std::atomic_int nextPush{0};
+  std::atomic_int numPopped{0};
+  auto producer = [&]() {
+    int i;
+    while ((i = nextPush++) < static_cast<int>(data.size())) {
+      while (!queue.push(&data[i])) {
+        std::this_thread::yield();
+      }
+    }
+  };
+  auto consumer = [&]() {
+    int* popped;
+    while (numPopped < static_cast<int>(data.size())) {
+      if (queue.pop(popped)) {
+        (*popped)++;
+        numPopped++;
+      }
+    }
+  };
+  std::thread producer1(producer);
+  std::thread producer2(producer);
+  std::thread consumer1(consumer);
+  std::thread consumer2(consumer);
+  producer1.join();
+  producer2.join();
+  consumer1.join();
+  consumer2.join();
+
+  EXPECT_EQ(std::count(data.begin(), data.end(), 1), static_cast<std::ptrdiff_t>(data.size()));
+}
+
+TEST(testThreadPool, testWorkStealingQueue) {
+  WorkStealingQueue<int*> queue(2);
+  std::vector<int> data(1000);
+  for (auto& d : data) {
+    queue.push(&d);
+  }
+  EXPECT_EQ(queue.size(), data.size());
+
+  // owner pops LIFO, thief steals FIFO
+  int* item = nullptr;
+  ASSERT_TRUE(queue.pop(item));
+  EXPECT_EQ(item, &data.back());
+  ASSERT_TRUE(queue.steal(item));
+  EXPECT_EQ(item, &data.front());
+
+  // concurrent pop and steal take every element exactly once
+  std::atomic_int numTaken{2};
+  auto thief = [&]() {
+    int* stolen;
+    while (numTaken < static_cast<int>(data.size())) {
+      if (queue.steal(stolen)) {
+        (*stolen)++;
+        numTaken++;
+      }
+    }
+  };
+  std::thread thief1(thief);
+  std::thread thief2(thief);
+  int* popped;
+  while (queue.pop(popped)) {
+    (*popped)++;
+    numTaken++;
+  }
+  thief1.join();
+  thief2.join();
+
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(std::count(std::next(data.begin()), std::prev(data.end()), 1), static_cast<std::ptrdiff_t>(data.size()) - 2);
+}
+
+TEST(testThreadPool, testParallelFor) {
+  using Chunking = ThreadPool::Chunking;
+  for (const auto scheduler : {ThreadPool::Scheduler::SharedQueue, ThreadPool::Scheduler::WorkStealing}) {
+    ThreadPool pool(3, 0, scheduler);
+    for (const auto chunking : {Chunking::Static, Chunking::Guided, Chunking::Dynamic}) {
+      for (const int grainSize : {1, 4, 1000}) {
+        // every index is visited exactly once
+        std::vector<int> visits(101, 0);
+        std::atomic_bool indexInRange{true};
+        pool.parallelFor(
+            5, 101, grainSize,
+            [&](int workerIndex, int i) {
+              if (workerIndex < 0 || workerIndex > static_cast<int>(pool.numThreads()) || i < 5 || i >= 101) {
+                indexInRange = false;
+              } else {
+                visits[i]++;
+              }
+            },
+            chunking);
+
+        EXPECT_TRUE(indexInRange);
+        EXPECT_EQ(std::count(visits.begin(), std::next(visits.begin(), 5), 0), 5);
+        EXPECT_EQ(std::count(std::next(visits.begin(), 5), visits.end(), 1), 96);
+      }
+    }
+  }
+}
+
+TEST(testThreadPool, testParallelForEmptyRange) {
+  ThreadPool pool(2);
+  std::atomic_int counter{0};
+  pool.parallelFor(3, 3, 1, [&](int, int) { counter++; });
+  pool.parallelFor(3, 1, 1, [&](int, int) { counter++; });
+  EXPECT_EQ(counter, 0);
+}
+
+TEST(testThreadPool, testParallelForNoThreads) {
+  ThreadPool pool(0);
+  std::vector<int> workerIndices;
+  pool.parallelFor(0, 10, 1, [&](int workerIndex, int) { workerIndices.push_back(workerIndex); });
+  EXPECT_EQ(workerIndices, std::vector<int>(10, 0));
+}
+
+TEST(testThreadPool, testCpuAffinity) {
+  const auto getAffinity = [] {
+    cpu_set_t cpuMask;
+    CPU_ZERO(&cpuMask);
+    pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuMask);
+    std::vector<int> cpuSet;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &cpuMask)) {
+        cpuSet.push_back(cpu);
+      }
+    }
+    return cpuSet;
+  };
+
+  // only use the cores that are available to this process
+  const std::vector<int> availableCpus = getAffinity();
+  ASSERT_FALSE(availableCpus.empty());
+  const std::vector<int> cpuSet{availableCpus.front()};
+
+  // run from a separate thread such that the test thread is not pinned
+  std::thread callingThread([&] {
+    ThreadPool pool(2, 0, ThreadPool::Scheduler::SharedQueue, cpuSet, true);
+    EXPECT_EQ(pool.cpuSet(), cpuSet);
+
+    std::vector<std::vector<int>> affinities(pool.numThreads() + 1);
+    pool.runParallel([&](int workerIndex) { affinities[workerIndex] = getAffinity(); }, 1);
+    EXPECT_EQ(affinities.back(), cpuSet);
+
+    for (size_t i = 0; i < pool.numThreads(); i++) {
+      pool.run([&](int workerIndex) { affinities[workerIndex] = getAffinity(); }).get();
+    }
+    for (const auto& affinity : affinities) {
+      if (!affinity.empty()) {
+        EXPECT_EQ(affinity, cpuSet);
+      }
+    }
+  });
+  callingThread.join();
+
+  // the pool without a cpu set leaves the affinity unchanged
+  ThreadPool pool(1);
+  std::vector<int> workerAffinity;
+  pool.run([&](int) { workerAffinity = getAffinity(); }).get();
+  EXPECT_EQ(workerAffinity, availableCpus);
+}
+
+TEST(testThreadPool, testSchedulerName) {
+  for (const auto scheduler : {ThreadPool::Scheduler::SharedQueue, ThreadPool::Scheduler::WorkStealing}) {
+    EXPECT_EQ(thread_pool::fromString(thread_pool::toString(scheduler)), scheduler);
+  }
+  EXPECT_THROW(thread_pool::fromString("NoScheduler"), std::out_of_range);
+}
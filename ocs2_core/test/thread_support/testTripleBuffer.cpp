@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ocs2_core/thread_support/TripleBuffer.h>
+
+TEST(testTripleBuffer, basicSetGet) {
+  ocs2::TripleBuffer<std::string> tripleBuffer(std::string("init"));
+  ASSERT_EQ(tripleBuffer.get(), "init");
+
+  // nothing published
+  ASSERT_FALSE(tripleBuffer.updateFromBuffer());
+  ASSERT_EQ(tripleBuffer.get(), "init");
+
+  // publish, but not yet consumed
+  tripleBuffer.setBuffer("update");
+  ASSERT_EQ(tripleBuffer.get(), "init");
+
+  ASSERT_TRUE(tripleBuffer.updateFromBuffer());
+  ASSERT_EQ(tripleBuffer.get(), "update");
+  ASSERT_FALSE(tripleBuffer.updateFromBuffer());
+  ASSERT_EQ(tripleBuffer.get(), "update");
+
+  // only the latest published value is consumed
+  tripleBuffer.setBuffer("first");
+  tripleBuffer.getWriteBuffer() = "second";
+  tripleBuffer.publish();
+  ASSERT_TRUE(tripleBuffer.updateFromBuffer());
+  ASSERT_EQ(tripleBuffer.get(), "second");
+  ASSERT_FALSE(tripleBuffer.updateFromBuffer());
+
+  tripleBuffer.reset();
+  ASSERT_EQ(tripleBuffer.get(), "");
+  ASSERT_FALSE(tripleBuffer.updateFromBuffer());
+}
+
+TEST(testTripleBuffer, concurrentProducerConsumer) {
+  constexpr int numValues = 100000;
+  ocs2::TripleBuffer<std::vector<int>> tripleBuffer(std::vector<int>(8, -1));
+
+  std::thread producer([&] {
+    for (int i = 0; i < numValues; i++) {
+      auto& value = tripleBuffer.getWriteBuffer();
+      value.assign(8, i);
+      tripleBuffer.publish();
+    }
+  });
+
+  // the consumer must always see a complete value, and the values must be increasing
+  int last = -1;
+  bool isConsistent = true;
+  while (last < numValues - 1) {
+    if (tripleBuffer.updateFromBuffer()) {
+      const auto& value = tripleBuffer.get();
+      isConsistent = isConsistent && value.size() == 8 && std::all_of(value.begin(), value.end(), [&](int v) { return v == value[0]; });
+      isConsistent = isConsistent && value[0] > last;
+      last = value[0];
+    }
+  }
+  producer.join();
+
+  EXPECT_TRUE(isConsistent);
+  EXPECT_EQ(last, numValues - 1);
+}
@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/Integrator.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
 
 #include "ocs2_ddp/search_strategy/StrategySettings.h"
 
@@ -68,9 +69,17 @@ struct Settings {
   size_t nThreads_ = 1;
   /** Priority of threads used in the multi-threading scheme. */
   int threadPriority_ = 99;
+  /** Strategy used by the thread pool to distribute the tasks over the threads. */
+  ThreadPool::Scheduler threadScheduler_ = ThreadPool::Scheduler::SharedQueue;
+  /** CPU cores to pin the threads to (one core per thread if there are enough). No pinning if empty. */
+  std::vector<int> cpuSet_;
+  /** Whether to also pin the thread which calls the solver. */
+  bool pinCallingThread_ = false;
 
   /** Maximum number of iterations of DDP. */
   size_t maxNumIterations_ = 15;
+  /** Wall-clock budget of a run() call in [s], 0 for no limit. No iteration is started if it is predicted to exceed the budget. */
+  scalar_t maxRunTime_ = 0.0;
   /** This value determines the termination condition based on the minimum relative changes of the cost. */
   scalar_t minRelCost_ = 1e-3;
   /** This value determines the tolerance of constraint's ISE (Integral of Square Error). */
@@ -79,6 +79,9 @@ class GaussNewtonDDP : public SolverBase {
 
   size_t getNumIterations() const override { return totalNumIterations_; }
 
+  /** Whether the iterations of the last run() call stopped because the next one was predicted to exceed settings.maxRunTime_ */
+  bool isTimeBudgetExhausted() const { return isTimeBudgetExhausted_; }
+
   scalar_t getFinalTime() const override { return finalTime_; }
 
   const OptimalControlProblem& getOptimalControlProblem() const override { return optimalControlProblemStock_.front(); }
@@ -125,6 +128,17 @@ class GaussNewtonDDP : public SolverBase {
     threadPool_.runParallel([&](int) { taskFunction(); }, N);
   }
 
+  /**
+   * Helper to run a loop in parallel (blocking). The iterations are distributed in chunks over the threads.
+   *
+   * @param [in] begin: first index of the loop
+   * @param [in] end: one past the last index of the loop
+   * @param [in] taskFunction: loop body, called as taskFunction(workerIndex, i) with workerIndex in [0, nThreads - 1]
+   */
+  void parallelFor(int begin, int end, std::function<void(int, int)> taskFunction) {
+    threadPool_.parallelFor(begin, end, 1, std::move(taskFunction));
+  }
+
   /**
    * Takes the following steps: (1) Computes the Hessian of the Hamiltonian (i.e., Hm) (2) Based on Hm, it calculates
    * the range space and the null space projections of the input-state equality constraints. (3) Based on these two
@@ -351,7 +365,6 @@ class GaussNewtonDDP : public SolverBase {
 
   // multi-threading helper variables
   std::atomic_size_t nextTaskId_{0};
-  std::atomic_size_t nextTimeIndex_{0};
 
   scalar_t initTime_ = 0.0;
   scalar_t finalTime_ = 0.0;
@@ -366,6 +379,7 @@ class GaussNewtonDDP : public SolverBase {
   ThreadPool threadPool_;
 
   unsigned long long int totalNumIterations_{0};
+  bool isTimeBudgetExhausted_ = false;
 
   PerformanceIndex performanceIndex_;
   std::vector<PerformanceIndex> performanceIndexHistory_;
@@ -400,6 +414,7 @@ class GaussNewtonDDP : public SolverBase {
   benchmark::RepeatedTimer computeControllerTimer_;
   benchmark::RepeatedTimer searchStrategyTimer_;
   benchmark::RepeatedTimer totalDualSolutionTimer_;
+  benchmark::TimeBudget runTimeBudget_;  // budget of the current run() call, predicted from the timers above
 };
 
 }  // namespace ocs2
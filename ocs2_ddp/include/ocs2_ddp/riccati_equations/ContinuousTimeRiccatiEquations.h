@@ -238,6 +238,9 @@ class ContinuousTimeRiccatiEquations final : public OdeBase {
   const std::vector<riccati_modification::Data>* riccatiModificationPtr_ = nullptr;
   scalar_array_t eventTimes_;
 
+  // the integrator queries the time stamps sequentially (backward in time)
+  LinearInterpolation::InterpolationCursor timeStampCursor_;
+
   ContinuousTimeRiccatiData continuousTimeRiccatiData_;
 };
 
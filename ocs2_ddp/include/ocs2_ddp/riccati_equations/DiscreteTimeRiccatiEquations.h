@@ -76,8 +76,10 @@ class DiscreteTimeRiccatiEquations {
    * @param [in] reducedFormRiccati: The reduced form of the Riccati equation is yield by assuming that Hessein of
    * the Hamiltonian is positive definite. In this case, the computation of Riccati equation is more efficient.
    * @param [in] isRiskSensitive: Neither the risk sensitive variant is used or not.
+   * @param [in] useFixedSizeKernels: Whether to use the compile-time fixed-size kernel when the problem dimensions are
+   * listed in OCS2_FIXED_SIZE_DIMENSIONS (see ocs2_core/FixedSizeTypes.h).
    */
-  explicit DiscreteTimeRiccatiEquations(bool reducedFormRiccati, bool isRiskSensitive = false);
+  explicit DiscreteTimeRiccatiEquations(bool reducedFormRiccati, bool isRiskSensitive = false, bool useFixedSizeKernels = true);
 
   /**
    * Default destructor.
@@ -127,6 +129,18 @@ class DiscreteTimeRiccatiEquations {
                       const vector_t& SvNext, const scalar_t& sNext, DiscreteTimeRiccatiData& dreCache, matrix_t& projectedKm,
                       vector_t& projectedLv, matrix_t& Sm, vector_t& Sv, scalar_t& s) const;
 
+  /**
+   * Same as computeMapILQR, but with compile-time state and input dimensions. The intermediate terms live on the stack,
+   * hence no cache is required.
+   *
+   * @tparam NX: The state dimension.
+   * @tparam NU: The projected input dimension.
+   */
+  template <int NX, int NU>
+  void computeMapILQRFixedSize(const ModelData& projectedModelData, const riccati_modification::Data& riccatiModification,
+                               const matrix_t& SmNext, const vector_t& SvNext, const scalar_t& sNext, matrix_t& projectedKm,
+                               vector_t& projectedLv, matrix_t& Sm, vector_t& Sv, scalar_t& s) const;
+
   /**
    * Computes one step Riccati difference equations for ILEG formulation.
    *
@@ -149,6 +163,7 @@ class DiscreteTimeRiccatiEquations {
  private:
   bool reducedFormRiccati_;
   bool isRiskSensitive_;
+  bool useFixedSizeKernels_;
   scalar_t riskSensitiveCoeff_ = 0.0;
 
   DiscreteTimeRiccatiData discreteTimeRiccatiData_;
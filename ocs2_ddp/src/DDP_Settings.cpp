@@ -69,8 +69,14 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
 
   loadData::loadPtreeValue(pt, settings.nThreads_, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority_, fieldName + ".threadPriority", verbose);
+  auto schedulerName = thread_pool::toString(settings.threadScheduler_);
+  loadData::loadPtreeValue(pt, schedulerName, fieldName + ".threadScheduler", verbose);
+  settings.threadScheduler_ = thread_pool::fromString(schedulerName);
+  loadData::loadStdVector(filename, fieldName + ".cpuSet", settings.cpuSet_, verbose);
+  loadData::loadPtreeValue(pt, settings.pinCallingThread_, fieldName + ".pinCallingThread", verbose);
 
   loadData::loadPtreeValue(pt, settings.maxNumIterations_, fieldName + ".maxNumIterations", verbose);
+  loadData::loadPtreeValue(pt, settings.maxRunTime_, fieldName + ".maxRunTime", verbose);
   loadData::loadPtreeValue(pt, settings.minRelCost_, fieldName + ".minRelCost", verbose);
   loadData::loadPtreeValue(pt, settings.constraintTolerance_, fieldName + ".constraintTolerance", verbose);
 
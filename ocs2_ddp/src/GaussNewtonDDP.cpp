@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <algorithm>
 #include <numeric>
 
+#include <ocs2_core/automatic_differentiation/CppAdModelSwap.h>
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/integration/TrapezoidalIntegration.h>
 #include <ocs2_core/misc/LinearAlgebra.h>
@@ -53,7 +54,9 @@ namespace ocs2 {
 /******************************************************************************************************/
 GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalControlProblem& optimalControlProblem,
                                const Initializer& initializer)
-    : ddpSettings_(std::move(ddpSettings)), threadPool_(std::max(ddpSettings_.nThreads_, size_t(1)) - 1, ddpSettings_.threadPriority_) {
+    : ddpSettings_(std::move(ddpSettings)),
+      threadPool_(std::max(ddpSettings_.nThreads_, size_t(1)) - 1, ddpSettings_.threadPriority_, ddpSettings_.threadScheduler_,
+                  ddpSettings_.cpuSet_, ddpSettings_.pinCallingThread_) {
   Eigen::setNbThreads(1);  // no multithreading within Eigen.
   Eigen::initParallel();
 
@@ -188,6 +191,7 @@ void GaussNewtonDDP::reset() {
   avgTimeStepFP_ = 0.0;
   avgTimeStepBP_ = 0.0;
   totalNumIterations_ = 0;
+  isTimeBudgetExhausted_ = false;
   performanceIndexHistory_.clear();
 
   // benchmarking timers
@@ -266,15 +270,17 @@ ScalarFunctionQuadraticApproximation GaussNewtonDDP::getValueFunctionImpl(
   // result
   ScalarFunctionQuadraticApproximation valueFunction;
   const auto indexAlpha = LinearInterpolation::timeSegment(time, primalSolution.timeTrajectory_);
-  valueFunction.f = LinearInterpolation::interpolate(
+  LinearInterpolation::interpolateFields(
       indexAlpha, valueFunctionTrajectory,
-      +[](const std::vector<ocs2::ScalarFunctionQuadraticApproximation>& vec, size_t ind) -> const scalar_t& { return vec[ind].f; });
-  valueFunction.dfdx = LinearInterpolation::interpolate(
-      indexAlpha, valueFunctionTrajectory,
-      +[](const std::vector<ocs2::ScalarFunctionQuadraticApproximation>& vec, size_t ind) -> const vector_t& { return vec[ind].dfdx; });
-  valueFunction.dfdxx = LinearInterpolation::interpolate(
-      indexAlpha, valueFunctionTrajectory,
-      +[](const std::vector<ocs2::ScalarFunctionQuadraticApproximation>& vec, size_t ind) -> const matrix_t& { return vec[ind].dfdxx; });
+      LinearInterpolation::field(
+          +[](const std::vector<ocs2::ScalarFunctionQuadraticApproximation>& vec, size_t ind) -> const scalar_t& { return vec[ind].f; },
+          valueFunction.f),
+      LinearInterpolation::field(
+          +[](const std::vector<ocs2::ScalarFunctionQuadraticApproximation>& vec, size_t ind) -> const vector_t& { return vec[ind].dfdx; },
+          valueFunction.dfdx),
+      LinearInterpolation::field(
+          +[](const std::vector<ocs2::ScalarFunctionQuadraticApproximation>& vec, size_t ind) -> const matrix_t& { return vec[ind].dfdxx; },
+          valueFunction.dfdxx));
 
   // Re-center around query state
   const vector_t xNominal = LinearInterpolation::interpolate(indexAlpha, primalSolution.stateTrajectory_);
@@ -344,18 +350,17 @@ vector_t GaussNewtonDDP::getStateInputEqualityConstraintLagrangianImpl(scalar_t
   const auto indexAlpha = LinearInterpolation::timeSegment(time, primalData.primalSolution.timeTrajectory_);
   const vector_t xNominal = LinearInterpolation::interpolate(indexAlpha, primalData.primalSolution.stateTrajectory_);
 
-  const matrix_t Bm = LinearInterpolation::interpolate(indexAlpha, primalData.modelDataTrajectory, model_data::dynamics_dfdu);
-  const matrix_t Pm = LinearInterpolation::interpolate(indexAlpha, primalData.modelDataTrajectory, model_data::cost_dfdux);
-  const vector_t Rv = LinearInterpolation::interpolate(indexAlpha, primalData.modelDataTrajectory, model_data::cost_dfdu);
-
-  const vector_t EvProjected =
-      LinearInterpolation::interpolate(indexAlpha, dualData.projectedModelDataTrajectory, model_data::stateInputEqConstraint_f);
-  const matrix_t CmProjected =
-      LinearInterpolation::interpolate(indexAlpha, dualData.projectedModelDataTrajectory, model_data::stateInputEqConstraint_dfdx);
-  const matrix_t Hm =
-      LinearInterpolation::interpolate(indexAlpha, dualData.riccatiModificationTrajectory, riccati_modification::hamiltonianHessian);
-  const matrix_t DmDagger =
-      LinearInterpolation::interpolate(indexAlpha, dualData.riccatiModificationTrajectory, riccati_modification::constraintRangeProjector);
+  using LinearInterpolation::field;
+  matrix_t Bm, Pm, CmProjected, Hm, DmDagger;
+  vector_t Rv, EvProjected;
+  LinearInterpolation::interpolateFields(indexAlpha, primalData.modelDataTrajectory, field(model_data::dynamics_dfdu, Bm),
+                                         field(model_data::cost_dfdux, Pm), field(model_data::cost_dfdu, Rv));
+  LinearInterpolation::interpolateFields(indexAlpha, dualData.projectedModelDataTrajectory,
+                                         field(model_data::stateInputEqConstraint_f, EvProjected),
+                                         field(model_data::stateInputEqConstraint_dfdx, CmProjected));
+  LinearInterpolation::interpolateFields(indexAlpha, dualData.riccatiModificationTrajectory,
+                                         field(riccati_modification::hamiltonianHessian, Hm),
+                                         field(riccati_modification::constraintRangeProjector, DmDagger));
 
   const vector_t deltaX = state - xNominal;
   const vector_t costate = getValueFunction(time, state).dfdx;
@@ -594,15 +599,10 @@ void GaussNewtonDDP::calculateController() {
   unoptimizedController_.biasArray_.resize(N);
   unoptimizedController_.deltaBiasArray_.resize(N);
 
-  nextTimeIndex_ = 0;
-  auto task = [this, N] {
-    int timeIndex;
-    // get next time index (atomic)
-    while ((timeIndex = nextTimeIndex_++) < N) {
-      calculateControllerWorker(timeIndex, nominalPrimalData_, nominalDualData_, unoptimizedController_);
-    }
+  auto task = [this](int workerIndex, int timeIndex) {
+    calculateControllerWorker(timeIndex, nominalPrimalData_, nominalDualData_, unoptimizedController_);
   };
-  runParallel(task, ddpSettings_.nThreads_);
+  parallelFor(0, N, task);
 
   // Since the controller for the last timestamp is invalid, if the last time is not the event time, use the control policy of the second to
   // last time for the last time
@@ -659,46 +659,38 @@ void GaussNewtonDDP::approximateOptimalControlProblem() {
   nominalPrimalData_.modelDataEventTimes.clear();
   nominalPrimalData_.modelDataEventTimes.resize(NE);
   if (NE > 0) {
-    nextTimeIndex_ = 0;
-    nextTaskId_ = 0;
-    auto task = [this, NE]() {
-      const size_t taskId = nextTaskId_++;  // assign task ID (atomic)
-
-      // timeIndex is atomic
-      int timeIndex;
-      while ((timeIndex = nextTimeIndex_++) < NE) {
-        ModelData& modelData = nominalPrimalData_.modelDataEventTimes[timeIndex];
-        const size_t preEventIndex = nominalPrimalData_.primalSolution.postEventIndices_[timeIndex] - 1;
-        const auto& time = nominalPrimalData_.primalSolution.timeTrajectory_[preEventIndex];
-        const auto& state = nominalPrimalData_.primalSolution.stateTrajectory_[preEventIndex];
-        const auto& multiplier = nominalDualData_.dualSolution.preJumps[timeIndex];
-
-        // approximate LQ for the pre-event node
-        ocs2::approximatePreJumpLQ(optimalControlProblemStock_[taskId], time, state, multiplier, modelData);
-
-        // checking the numerical properties
-        if (ddpSettings_.checkNumericalStability_) {
-          const auto errSize = checkSize(modelData, state.rows(), 0);
-          if (!errSize.empty()) {
-            throw std::runtime_error("[GaussNewtonDDP::approximateOptimalControlProblem] Mismatch in dimensions at intermediate time: " +
-                                     std::to_string(time) + "\n" + errSize);
-          }
-          const std::string errProperties =
-              checkDynamicsProperties(modelData) + checkCostProperties(modelData) + checkConstraintProperties(modelData);
-          if (!errProperties.empty()) {
-            throw std::runtime_error("[GaussNewtonDDP::approximateOptimalControlProblem] Ill-posed problem at event time: " +
-                                     std::to_string(time) + "\n" + errProperties);
-          }
+    auto task = [this](int workerIndex, int timeIndex) {
+      ModelData& modelData = nominalPrimalData_.modelDataEventTimes[timeIndex];
+      const size_t preEventIndex = nominalPrimalData_.primalSolution.postEventIndices_[timeIndex] - 1;
+      const auto& time = nominalPrimalData_.primalSolution.timeTrajectory_[preEventIndex];
+      const auto& state = nominalPrimalData_.primalSolution.stateTrajectory_[preEventIndex];
+      const auto& multiplier = nominalDualData_.dualSolution.preJumps[timeIndex];
+
+      // approximate LQ for the pre-event node
+      ocs2::approximatePreJumpLQ(optimalControlProblemStock_[workerIndex], time, state, multiplier, modelData);
+
+      // checking the numerical properties
+      if (ddpSettings_.checkNumericalStability_) {
+        const auto errSize = checkSize(modelData, state.rows(), 0);
+        if (!errSize.empty()) {
+          throw std::runtime_error("[GaussNewtonDDP::approximateOptimalControlProblem] Mismatch in dimensions at intermediate time: " +
+                                   std::to_string(time) + "\n" + errSize);
         }
-
-        // shift Hessian
-        if (ddpSettings_.strategy_ == search_strategy::Type::LINE_SEARCH) {
-          hessian_correction::shiftHessian(ddpSettings_.lineSearch_.hessianCorrectionStrategy, modelData.cost.dfdxx,
-                                           ddpSettings_.lineSearch_.hessianCorrectionMultiple);
+        const std::string errProperties =
+            checkDynamicsProperties(modelData) + checkCostProperties(modelData) + checkConstraintProperties(modelData);
+        if (!errProperties.empty()) {
+          throw std::runtime_error("[GaussNewtonDDP::approximateOptimalControlProblem] Ill-posed problem at event time: " +
+                                   std::to_string(time) + "\n" + errProperties);
         }
       }
+
+      // shift Hessian
+      if (ddpSettings_.strategy_ == search_strategy::Type::LINE_SEARCH) {
+        hessian_correction::shiftHessian(ddpSettings_.lineSearch_.hessianCorrectionStrategy, modelData.cost.dfdxx,
+                                         ddpSettings_.lineSearch_.hessianCorrectionMultiple);
+      }
     };
-    runParallel(task, ddpSettings_.nThreads_);
+    parallelFor(0, NE, task);
   }
 
   /*
@@ -991,6 +983,9 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
     ocp.targetTrajectoriesPtr = &this->getReferenceManager().getTargetTrajectories();
   }
 
+  // the budget includes the initialization
+  runTimeBudget_.start(1e3 * ddpSettings_.maxRunTime_);
+
   // initialize parameters
   initTime_ = initTime;
   initState_ = initState;
@@ -1024,6 +1019,7 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
 
   // convergence variables of the main loop
   bool isConverged = false;
+  bool isTimeBudgetExhausted = false;
   std::string convergenceInfo;
 
   // DDP main loop
@@ -1034,6 +1030,9 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
       std::cerr << "\n###################\n";
     }
 
+    // between iterations no model is evaluated, background compiled AD models are swapped in here
+    swapCompiledCppAdModels();
+
     // nominal --> nominal: constructs the LQ problem around the nominal trajectories
     linearQuadraticApproximationTimer_.startTimer();
     approximateOptimalControlProblem();
@@ -1069,7 +1068,13 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
         !initialSolutionExists, *std::prev(performanceIndexHistory_.end(), 2), performanceIndexHistory_.back());
     initialSolutionExists = true;
 
-    if (isConverged || (totalNumIterations_ - initIteration) == ddpSettings_.maxNumIterations_) {
+    // whether the next iteration is predicted to exceed the time budget, the optimized solution is then the best one found so far
+    const scalar_t iterationDuration = benchmark::TimeBudget::predictDurationInMilliseconds(
+        {&linearQuadraticApproximationTimer_, &backwardPassTimer_, &computeControllerTimer_, &searchStrategyTimer_,
+         &totalDualSolutionTimer_});
+    isTimeBudgetExhausted = !runTimeBudget_.fits(iterationDuration);
+
+    if (isConverged || (totalNumIterations_ - initIteration) == ddpSettings_.maxNumIterations_ || isTimeBudgetExhausted) {
       break;
 
     } else {
@@ -1085,6 +1090,9 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
     }
   }  // end of while loop
 
+  isTimeBudgetExhausted_ =
+      !isConverged && (totalNumIterations_ - initIteration) != ddpSettings_.maxNumIterations_ && isTimeBudgetExhausted;
+
   // display
   if (ddpSettings_.displayInfo_ || ddpSettings_.displayShortSummary_) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
@@ -1100,6 +1108,9 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
     } else if (totalNumIterations_ - initIteration == ddpSettings_.maxNumIterations_) {
       std::cerr << "The algorithm has terminated as: \n";
       std::cerr << "    * The maximum number of iterations (i.e., " << ddpSettings_.maxNumIterations_ << ") has reached." << std::endl;
+    } else if (isTimeBudgetExhausted) {
+      std::cerr << "The algorithm has terminated as: \n";
+      std::cerr << "    * The next iteration would exceed the time budget (i.e., " << ddpSettings_.maxRunTime_ << " [s])." << std::endl;
     } else {
       std::cerr << "The algorithm has terminated for an unknown reason!" << std::endl;
     }
@@ -88,47 +88,40 @@ void ILQR::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDat
   modelDataTrajectory.clear();
   modelDataTrajectory.resize(timeTrajectory.size());
 
-  nextTimeIndex_ = 0;
-  nextTaskId_ = 0;
-  auto task = [&]() {
-    size_t taskId = nextTaskId_++;  // assign task ID (atomic)
-
-    ModelData continuousTimeModelData;
-
-    // get next time index is atomic
-    size_t timeIndex;
-    while ((timeIndex = nextTimeIndex_++) < timeTrajectory.size()) {
-      // approximate continuous LQ for the given time index
-      ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
-                                      inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], continuousTimeModelData);
-
-      // checking the numerical properties
-      if (settings().checkNumericalStability_) {
-        const auto errSize = checkSize(continuousTimeModelData, stateTrajectory[timeIndex].rows(), inputTrajectory[timeIndex].rows());
-        if (!errSize.empty()) {
-          throw std::runtime_error("[ILQR::approximateIntermediateLQ] Mismatch in dimensions at intermediate time: " +
-                                   std::to_string(timeTrajectory[timeIndex]) + "\n" + errSize);
-        }
-        const auto errProperties = checkDynamicsProperties(continuousTimeModelData) + checkCostProperties(continuousTimeModelData) +
-                                   checkConstraintProperties(continuousTimeModelData);
-        if (!errProperties.empty()) {
-          throw std::runtime_error("[ILQR::approximateIntermediateLQ] Ill-posed problem at intermediate time: " +
-                                   std::to_string(timeTrajectory[timeIndex]) + "\n" + errProperties);
-        }
+  std::vector<ModelData> continuousTimeModelDataStock(settings().nThreads_);  // one buffer per worker
+  auto task = [&](int workerIndex, int timeIndex) {
+    ModelData& continuousTimeModelData = continuousTimeModelDataStock[workerIndex];
+
+    // approximate continuous LQ for the given time index
+    ocs2::approximateIntermediateLQ(optimalControlProblemStock_[workerIndex], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
+                                    inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], continuousTimeModelData);
+
+    // checking the numerical properties
+    if (settings().checkNumericalStability_) {
+      const auto errSize = checkSize(continuousTimeModelData, stateTrajectory[timeIndex].rows(), inputTrajectory[timeIndex].rows());
+      if (!errSize.empty()) {
+        throw std::runtime_error("[ILQR::approximateIntermediateLQ] Mismatch in dimensions at intermediate time: " +
+                                 std::to_string(timeTrajectory[timeIndex]) + "\n" + errSize);
       }
-
-      // discretize LQ problem
-      const scalar_t timeStep = (timeIndex + 1 < timeTrajectory.size()) ? (timeTrajectory[timeIndex + 1] - timeTrajectory[timeIndex]) : 0.0;
-      if (!numerics::almost_eq(timeStep, 0.0)) {
-        discreteLQWorker(*optimalControlProblemStock_[taskId].dynamicsPtr, timeTrajectory[timeIndex], stateTrajectory[timeIndex],
-                         inputTrajectory[timeIndex], timeStep, continuousTimeModelData, modelDataTrajectory[timeIndex]);
-      } else {
-        modelDataTrajectory[timeIndex] = continuousTimeModelData;
+      const auto errProperties = checkDynamicsProperties(continuousTimeModelData) + checkCostProperties(continuousTimeModelData) +
+                                 checkConstraintProperties(continuousTimeModelData);
+      if (!errProperties.empty()) {
+        throw std::runtime_error("[ILQR::approximateIntermediateLQ] Ill-posed problem at intermediate time: " +
+                                 std::to_string(timeTrajectory[timeIndex]) + "\n" + errProperties);
       }
     }
+
+    // discretize LQ problem
+    const scalar_t timeStep = (timeIndex + 1 < timeTrajectory.size()) ? (timeTrajectory[timeIndex + 1] - timeTrajectory[timeIndex]) : 0.0;
+    if (!numerics::almost_eq(timeStep, 0.0)) {
+      discreteLQWorker(*optimalControlProblemStock_[workerIndex].dynamicsPtr, timeTrajectory[timeIndex], stateTrajectory[timeIndex],
+                       inputTrajectory[timeIndex], timeStep, continuousTimeModelData, modelDataTrajectory[timeIndex]);
+    } else {
+      modelDataTrajectory[timeIndex] = continuousTimeModelData;
+    }
   };
 
-  runParallel(task, settings().nThreads_);
+  parallelFor(0, timeTrajectory.size(), task);
 }
 
 /******************************************************************************************************/
@@ -121,6 +121,7 @@ void ContinuousTimeRiccatiEquations::setData(const scalar_array_t* timeStampPtr,
   projectedModelDataPtr_ = projectedModelDataPtr;
   modelDataEventTimesPtr_ = modelDataEventTimesPtr;
   riccatiModificationPtr_ = riccatiModificationPtr;
+  timeStampCursor_.reset(*timeStampPtr);
 
   eventTimes_.clear();
   eventTimes_.reserve(eventsPastTheEndIndecesPtr->size());
@@ -152,7 +153,7 @@ vector_t ContinuousTimeRiccatiEquations::computeJumpMap(scalar_t z, const vector
 vector_t ContinuousTimeRiccatiEquations::computeFlowMap(scalar_t z, const vector_t& allSs) {
   // index
   const scalar_t t = -z;  // denormalized time
-  const auto indexAlpha = LinearInterpolation::timeSegment(t, *timeStampPtr_);
+  const auto indexAlpha = timeStampCursor_.timeSegment(t);
 
   convert2Matrix(allSs, continuousTimeRiccatiData_.Sm_, continuousTimeRiccatiData_.Sv_, continuousTimeRiccatiData_.s_);
   if (isRiskSensitive_) {
@@ -180,28 +181,18 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
    * because of vectorization
    */
 
-  // Hv
-  creCache.projectedHv_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamicsBias);
-  // Am
-  creCache.projectedAm_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamics_dfdx);
-  // Bm
-  creCache.projectedBm_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamics_dfdu);
-  // q
-  ds = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_f);
-  // Qv
-  dSv = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdx);
-  // Qm
-  dSm = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdxx);
-  // Rv
-  creCache.projectedGv_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdu);
-  // Pm
-  creCache.projectedGm_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdux);
-  // delatQm
-  creCache.deltaQm_ = LinearInterpolation::interpolate(indexAlpha, *riccatiModificationPtr_, riccati_modification::deltaQm);
-  // delatGm
-  creCache.projectedKm_ = LinearInterpolation::interpolate(indexAlpha, *riccatiModificationPtr_, riccati_modification::deltaGm);
-  // delatGv
-  creCache.projectedLv_ = LinearInterpolation::interpolate(indexAlpha, *riccatiModificationPtr_, riccati_modification::deltaGv);
+  // Hv, Am, Bm, q, Qv, Qm, Rv, Pm
+  using LinearInterpolation::field;
+  LinearInterpolation::interpolateFields(indexAlpha, *projectedModelDataPtr_, field(model_data::dynamicsBias, creCache.projectedHv_),
+                                         field(model_data::dynamics_dfdx, creCache.projectedAm_),
+                                         field(model_data::dynamics_dfdu, creCache.projectedBm_), field(model_data::cost_f, ds),
+                                         field(model_data::cost_dfdx, dSv), field(model_data::cost_dfdxx, dSm),
+                                         field(model_data::cost_dfdu, creCache.projectedGv_),
+                                         field(model_data::cost_dfdux, creCache.projectedGm_));
+  // delatQm, delatGm, delatGv
+  LinearInterpolation::interpolateFields(indexAlpha, *riccatiModificationPtr_, field(riccati_modification::deltaQm, creCache.deltaQm_),
+                                         field(riccati_modification::deltaGm, creCache.projectedKm_),
+                                         field(riccati_modification::deltaGv, creCache.projectedLv_));
 
   // projectedGm = projectedPm + projectedBm^T * Sm [COMPLEXITY: nx^2 * np]
   creCache.projectedGm_.noalias() += creCache.projectedBm_.transpose() * Sm;
@@ -29,13 +29,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_ddp/riccati_equations/DiscreteTimeRiccatiEquations.h>
 
+#include <ocs2_core/FixedSizeTypes.h>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-DiscreteTimeRiccatiEquations::DiscreteTimeRiccatiEquations(bool reducedFormRiccati, bool isRiskSensitive)
-    : reducedFormRiccati_(reducedFormRiccati), isRiskSensitive_(isRiskSensitive) {}
+DiscreteTimeRiccatiEquations::DiscreteTimeRiccatiEquations(bool reducedFormRiccati, bool isRiskSensitive, bool useFixedSizeKernels)
+    : reducedFormRiccati_(reducedFormRiccati), isRiskSensitive_(isRiskSensitive), useFixedSizeKernels_(useFixedSizeKernels) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -54,8 +56,16 @@ void DiscreteTimeRiccatiEquations::computeMap(const ModelData& projectedModelDat
     computeMapILEG(projectedModelData, riccatiModification, SmNext, SvNext, sNext, discreteTimeRiccatiData_, projectedKm, projectedLv, Sm,
                    Sv, s);
   } else {
-    computeMapILQR(projectedModelData, riccatiModification, SmNext, SvNext, sNext, discreteTimeRiccatiData_, projectedKm, projectedLv, Sm,
-                   Sv, s);
+    const int stateDim = projectedModelData.dynamics.dfdx.cols();
+    const int inputDim = projectedModelData.dynamics.dfdu.cols();
+    const bool isFixedSize = useFixedSizeKernels_ && dispatchFixedSize(stateDim, inputDim, [&](auto nx, auto nu) {
+      computeMapILQRFixedSize<decltype(nx)::value, decltype(nu)::value>(projectedModelData, riccatiModification, SmNext, SvNext, sNext,
+                                                                        projectedKm, projectedLv, Sm, Sv, s);
+    });
+    if (!isFixedSize) {
+      computeMapILQR(projectedModelData, riccatiModification, SmNext, SvNext, sNext, discreteTimeRiccatiData_, projectedKm, projectedLv,
+                     Sm, Sv, s);
+    }
   }
 }
 
@@ -153,6 +163,91 @@ void DiscreteTimeRiccatiEquations::computeMapILQR(const ModelData& projectedMode
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <int NX, int NU>
+void DiscreteTimeRiccatiEquations::computeMapILQRFixedSize(const ModelData& projectedModelData,
+                                                           const riccati_modification::Data& riccatiModification, const matrix_t& SmNext,
+                                                           const vector_t& SvNext, const scalar_t& sNext, matrix_t& projectedKm,
+                                                           vector_t& projectedLv, matrix_t& Sm, vector_t& Sv, scalar_t& s) const {
+  using state_vector_t = Eigen::Matrix<scalar_t, NX, 1>;
+  using state_matrix_t = Eigen::Matrix<scalar_t, NX, NX>;
+  using input_vector_t = Eigen::Matrix<scalar_t, NU, 1>;
+  using input_matrix_t = Eigen::Matrix<scalar_t, NU, NU>;
+  using input_state_matrix_t = Eigen::Matrix<scalar_t, NU, NX>;
+  using state_input_matrix_t = Eigen::Matrix<scalar_t, NX, NU>;
+
+  // only the Jacobians of the dynamics are used, the affine term is given by dynamicsBias
+  const auto projectedAm = fixedSizeMap<NX, NX>(projectedModelData.dynamics.dfdx);
+  const auto projectedBm = fixedSizeMap<NX, NU>(projectedModelData.dynamics.dfdu);
+  const ScalarFunctionQuadraticApproximationTpl<NX, NU> cost(projectedModelData.cost);
+  const auto dynamicsBias = fixedSizeMap<NX, 1>(projectedModelData.dynamicsBias);
+  const auto SmNextFixed = fixedSizeMap<NX, NX>(SmNext);
+  const auto SvNextFixed = fixedSizeMap<NX, 1>(SvNext);
+
+  // precomputation (1)
+  const state_vector_t Sm_projectedHv = SmNextFixed * dynamicsBias;
+  const state_matrix_t Sm_projectedAm = SmNextFixed * projectedAm;
+  const state_input_matrix_t Sm_projectedBm = SmNextFixed * projectedBm;
+  const state_vector_t Sv_plus_Sm_projectedHv = SvNextFixed + Sm_projectedHv;
+
+  // projectedGm = projectedPm + projectedBm^T * Sm * projectedAm
+  input_state_matrix_t projectedGm = cost.dfdux;
+  projectedGm.noalias() += projectedBm.transpose() * Sm_projectedAm;
+
+  // projectedGv = projectedRv + projectedBm^T * (Sv + Sm * projectedHv)
+  input_vector_t projectedGv = cost.dfdu;
+  projectedGv.noalias() += projectedBm.transpose() * Sv_plus_Sm_projectedHv;
+
+  // projected feedback and feedforward
+  const input_state_matrix_t KmFixed = -projectedGm - fixedSizeMap<NU, NX>(riccatiModification.deltaGm_);
+  const input_vector_t LvFixed = -projectedGv - fixedSizeMap<NU, 1>(riccatiModification.deltaGv_);
+
+  // precomputation (2)
+  const state_matrix_t projectedKm_T_projectedGm = KmFixed.transpose() * projectedGm;
+
+  // Sm = Qm + deltaQm + Am^T * Sm * Am
+  state_matrix_t SmFixed = cost.dfdxx + fixedSizeMap<NX, NX>(riccatiModification.deltaQm_);
+  SmFixed.noalias() += Sm_projectedAm.transpose() * projectedAm;
+  // Sv = Qv + Am^T * (Sv + Sm * Hv) + Gm^T * Lv
+  state_vector_t SvFixed = cost.dfdx;
+  SvFixed.noalias() += projectedAm.transpose() * Sv_plus_Sm_projectedHv;
+  SvFixed.noalias() += projectedGm.transpose() * LvFixed;
+  // s = s + q + Hv^T * (Sv + Sm * Hv) - 0.5 Hv^T * Sm * Hv
+  s = sNext + cost.f;
+  s += dynamicsBias.dot(Sv_plus_Sm_projectedHv);
+  s -= 0.5 * dynamicsBias.dot(Sm_projectedHv);
+
+  if (reducedFormRiccati_) {
+    // += Km^T * Gm + Gm^T * Km
+    SmFixed += projectedKm_T_projectedGm;
+    // += 0.5 Lv^T Gv
+    s += 0.5 * LvFixed.dot(projectedGv);
+  } else {
+    // projectedHm
+    input_matrix_t projectedHm = cost.dfduu;
+    projectedHm.noalias() += Sm_projectedBm.transpose() * projectedBm;
+    const input_state_matrix_t projectedHm_projectedKm = projectedHm * KmFixed;
+    const input_vector_t projectedHm_projectedLv = projectedHm * LvFixed;
+
+    // += Km^T * Gm + Gm^T * Km + Km^T * Hm * Km
+    SmFixed += projectedKm_T_projectedGm + projectedKm_T_projectedGm.transpose();
+    SmFixed.noalias() += KmFixed.transpose() * projectedHm_projectedKm;
+    // += Km^T * Gv + Km^T * Hm * Lv
+    SvFixed.noalias() += KmFixed.transpose() * projectedGv;
+    SvFixed.noalias() += projectedHm_projectedKm.transpose() * LvFixed;
+    // += Lv^T Gv + 0.5 Lv^T Hm Lv
+    s += LvFixed.dot(projectedGv);
+    s += 0.5 * LvFixed.dot(projectedHm_projectedLv);
+  }
+
+  projectedKm = KmFixed;
+  projectedLv = LvFixed;
+  Sm = SmFixed;
+  Sv = SvFixed;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
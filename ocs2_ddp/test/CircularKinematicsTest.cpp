@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <boost/filesystem.hpp>
 
+#include <ocs2_core/NumericTraits.h>
 #include <ocs2_core/initialization/DefaultInitializer.h>
 #include <ocs2_ddp/ILQR.h>
 #include <ocs2_ddp/SLQ.h>
@@ -210,6 +211,45 @@ TEST_P(CircularKinematicsTest, ILQR) {
   performanceIndexTest(ddpSettings, performanceIndex);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_P(CircularKinematicsTest, maxRunTime) {
+  const auto algorithm = ocs2::ddp::Algorithm::SLQ;
+
+  // ddp settings
+  auto ddpSettings = getSettings(algorithm, getNumThreads(), getSearchStrategy());
+
+  // dynamics and rollout
+  const ocs2::CircularKinematicsSystem systemDynamics;
+  const ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings(algorithm));
+
+  // without a time budget the solver converges after more than one iteration
+  ocs2::SLQ referenceDdp(ddpSettings, rollout, problem, *initializerPtr);
+  referenceDdp.run(startTime, initState, finalTime);
+  ASSERT_FALSE(referenceDdp.isTimeBudgetExhausted());
+  ASSERT_GT(referenceDdp.getNumIterations(), 1u);
+  ASSERT_LT(referenceDdp.getNumIterations(), ddpSettings.maxNumIterations_);
+
+  // the budget is exhausted after the first iteration, which always runs
+  ddpSettings.maxRunTime_ = 1e-6;
+  ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.run(startTime, initState, finalTime);
+  ASSERT_TRUE(ddp.isTimeBudgetExhausted());
+  ASSERT_EQ(ddp.getNumIterations(), 1u);
+
+  // the solution of the first iteration is returned
+  const auto primalSolution = ddp.primalSolution(finalTime);
+  ASSERT_TRUE(primalSolution.stateTrajectory_.front().isApprox(initState));
+  ASSERT_NEAR(primalSolution.timeTrajectory_.front(), startTime, ocs2::numeric_traits::weakEpsilon<ocs2::scalar_t>());
+  ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.back(), finalTime);
+  ASSERT_TRUE(primalSolution.controllerPtr_ != nullptr);
+  for (size_t i = 0; i < primalSolution.timeTrajectory_.size(); i++) {
+    ASSERT_TRUE(primalSolution.stateTrajectory_[i].allFinite());
+    ASSERT_TRUE(primalSolution.inputTrajectory_[i].allFinite());
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
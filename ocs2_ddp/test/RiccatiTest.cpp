@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/misc/LinearAlgebra.h>
 #include <ocs2_core/misc/randomMatrices.h>
 #include <ocs2_ddp/riccati_equations/ContinuousTimeRiccatiEquations.h>
+#include <ocs2_ddp/riccati_equations/DiscreteTimeRiccatiEquations.h>
 
 class RiccatiInitializer {
  public:
@@ -104,6 +105,40 @@ TEST(RiccatiTest, compareImplementations) {
   EXPECT_LE((dSdz_precompute - dSdz_noPrecompute).array().abs().maxCoeff(), 1e-9);
 }
 
+TEST(RiccatiTest, compareDiscreteTimeFixedSize) {
+  // (4, 1) is one of the dimensions listed in OCS2_FIXED_SIZE_DIMENSIONS
+  constexpr int STATE_DIM = 4;
+  constexpr int INPUT_DIM = 1;
+
+  RiccatiInitializer ri(STATE_DIM, INPUT_DIM);
+  const auto& projectedModelData = ri.projectedModelDataTrajectory.front();
+  auto riccatiModification = ri.riccatiModificationTrajectory.front();
+  riccatiModification.deltaGm_.setRandom();
+  riccatiModification.deltaGv_.setRandom();
+
+  const ocs2::matrix_t SmNext = ocs2::LinearAlgebra::generateSPDmatrix<ocs2::matrix_t>(STATE_DIM);
+  const ocs2::vector_t SvNext = ocs2::vector_t::Random(STATE_DIM);
+  const ocs2::scalar_t sNext = 0.5;
+
+  for (const bool reducedFormRiccati : {true, false}) {
+    ocs2::DiscreteTimeRiccatiEquations riccatiDynamicSize(reducedFormRiccati, false, false);
+    ocs2::DiscreteTimeRiccatiEquations riccatiFixedSize(reducedFormRiccati, false, true);
+
+    ocs2::matrix_t Km, Km_fixed, Sm, Sm_fixed;
+    ocs2::vector_t Lv, Lv_fixed, Sv, Sv_fixed;
+    ocs2::scalar_t s, s_fixed;
+    riccatiDynamicSize.computeMap(projectedModelData, riccatiModification, SmNext, SvNext, sNext, Km, Lv, Sm, Sv, s);
+    riccatiFixedSize.computeMap(projectedModelData, riccatiModification, SmNext, SvNext, sNext, Km_fixed, Lv_fixed, Sm_fixed, Sv_fixed,
+                                s_fixed);
+
+    EXPECT_TRUE(Km.isApprox(Km_fixed));
+    EXPECT_TRUE(Lv.isApprox(Lv_fixed));
+    EXPECT_TRUE(Sm.isApprox(Sm_fixed));
+    EXPECT_TRUE(Sv.isApprox(Sv_fixed));
+    EXPECT_NEAR(s, s_fixed, 1e-9);
+  }
+}
+
 TEST(RiccatiTest, testFlattenSMatrix) {
   const int stateDim = 4;
   using riccati_t = ocs2::ContinuousTimeRiccatiEquations;
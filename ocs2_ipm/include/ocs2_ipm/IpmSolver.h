@@ -29,11 +29,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
+
 #include <ocs2_core/initialization/Initializer.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
+#include <ocs2_oc/multiple_shooting/BatchDynamicsDiscretization.h>
+#include <ocs2_oc/multiple_shooting/Initialization.h>
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
 #include <ocs2_oc/multiple_shooting/Transcription.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
@@ -73,6 +77,9 @@ class IpmSolver : public SolverBase {
 
   size_t getNumIterations() const override { return totalNumIterations_; }
 
+  /** Reason why the iterations of the last run() call stopped */
+  ipm::Convergence getConvergence() const { return convergence_; }
+
   const OptimalControlProblem& getOptimalControlProblem() const override { return ocpDefinitions_.front(); }
 
   const PerformanceIndex& getPerformanceIndeces() const override { return getIterationsLog().back(); };
@@ -110,8 +117,8 @@ class IpmSolver : public SolverBase {
     runImpl(initTime, initState, finalTime);
   }
 
-  /** Run a task in parallel with settings.nThreads */
-  void runParallel(std::function<void(int)> taskFunction);
+  /** Run taskFunction(workerId, i) for i in [begin, end) in parallel with settings.nThreads */
+  void parallelFor(int begin, int end, std::function<void(int, int)> taskFunction);
 
   /** Get profiling information as a string */
   std::string getBenchmarkingInformation() const;
@@ -129,6 +136,12 @@ class IpmSolver : public SolverBase {
                                      scalar_t barrierParam, vector_array_t& slackStateIneq, vector_array_t& dualStateIneq,
                                      vector_array_t& slackStateInputIneq, vector_array_t& dualStateInputIneq);
 
+  /** Overwrites the initialized slack, dual, costate, and projection multiplier trajectories on the shared nodes with the previous ones */
+  void shiftInteriorPointTrajectories(const multiple_shooting::HorizonShift& horizonShift,
+                                      const std::vector<AnnotatedTime>& timeDiscretization, vector_array_t& slackStateIneq,
+                                      vector_array_t& dualStateIneq, vector_array_t& slackStateInputIneq,
+                                      vector_array_t& dualStateInputIneq, vector_array_t& lmd, vector_array_t& nu) const;
+
   /** Creates QP around t, x(t), u(t). Returns performance metrics at the current {t, x(t), u(t)} */
   PerformanceIndex setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
                                             const vector_array_t& u, const vector_array_t& lmd, const vector_array_t& nu,
@@ -136,10 +149,21 @@ class IpmSolver : public SolverBase {
                                             const vector_array_t& slackStateInputIneq, const vector_array_t& dualStateIneq,
                                             const vector_array_t& dualStateInputIneq, std::vector<Metrics>& metrics);
 
-  /** Computes only the performance metrics at the current {t, x(t), u(t)} */
-  PerformanceIndex computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                      const vector_array_t& u, scalar_t barrierParam, const vector_array_t& slackStateIneq,
-                                      const vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics);
+  /** A linesearch candidate {x(t), u(t), slackStateIneq(t), slackStateInputIneq(t)} with its metrics */
+  struct LinesearchCandidate {
+    scalar_t stepSize = 0.0;
+    vector_array_t x, u;
+    vector_array_t slackStateIneq, slackStateInputIneq;
+    std::vector<Metrics> metrics;
+    PerformanceIndex performance;
+  };
+
+  /**
+   * Computes only the performance metrics of the first numCandidates linesearch candidates at their {t, x(t), u(t)}. The nodes of all
+   * candidates are distributed over the threads, such that the candidates are evaluated concurrently.
+   */
+  void computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, scalar_t barrierParam,
+                          std::vector<LinesearchCandidate>& candidates, size_t numCandidates);
 
   /** Returns solution of the QP subproblem in delta coordinates: */
   struct OcpSubproblemSolution {
@@ -167,7 +191,9 @@ class IpmSolver : public SolverBase {
   PrimalSolution toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u);
 
   /** Decides on the step to take and overrides given trajectories {x(t), u(t), slackStateIneq(t), slackStateInputIneq(t)}
-   * <- {x(t) + a*dx(t), u(t) + a*du(t), slackStateIneq(t) + a*dslackStateIneq(t), slackStateInputIneq(t) + a*dslackStateInputIneq(t)} */
+   * <- {x(t) + a*dx(t), u(t) + a*du(t), slackStateIneq(t) + a*dslackStateIneq(t), slackStateInputIneq(t) + a*dslackStateInputIneq(t)}.
+   * The step sizes are tried in batches of settings.numLinesearchCandidates, the largest step size of a batch that the filter accepts is
+   * taken. */
   ipm::StepInfo takePrimalStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
                                const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
                                vector_array_t& u, scalar_t barrierParam, vector_array_t& slackStateIneq,
@@ -188,6 +214,7 @@ class IpmSolver : public SolverBase {
   const ipm::Settings settings_;
   DynamicsDiscretizer discretizer_;
   DynamicsSensitivityDiscretizer sensitivityDiscretizer_;
+  multiple_shooting::BatchDynamicsDiscretization batchDynamicsDiscretization_;  // used if settings.dynamicsBatchSize > 1
   std::vector<OptimalControlProblem> ocpDefinitions_;
   std::unique_ptr<Initializer> initializerPtr_;
   FilterLinesearch filterLinesearch_;
@@ -207,6 +234,9 @@ class IpmSolver : public SolverBase {
 
   // Value function in absolute state coordinates (without the constant value)
   std::vector<ScalarFunctionQuadraticApproximation> valueFunction_;
+  // Interval of the previous getValueFunction query, such that the sequential queries of a tracking controller take O(1). The hint only
+  // affects the search cost, hence concurrent queries may overwrite each other's hint.
+  mutable std::atomic_int valueFunctionIntervalHint_{0};
 
   // LQ approximation
   std::vector<ScalarFunctionQuadraticApproximation> lagrangian_;
@@ -222,6 +252,9 @@ class IpmSolver : public SolverBase {
   // Lagrange multipliers
   std::vector<multiple_shooting::ProjectionMultiplierCoefficients> projectionMultiplierCoefficients_;
 
+  // Linesearch candidates, one per concurrently evaluated step size. They persist across iterations such that their memory is reused.
+  std::vector<LinesearchCandidate> linesearchCandidates_;
+
   // Iteration performance log
   std::vector<PerformanceIndex> performanceIndeces_;
 
@@ -230,11 +263,13 @@ class IpmSolver : public SolverBase {
 
   // Benchmarking
   size_t totalNumIterations_{0};
+  ipm::Convergence convergence_ = ipm::Convergence::FALSE;
   benchmark::RepeatedTimer initializationTimer_;
   benchmark::RepeatedTimer linearQuadraticApproximationTimer_;
   benchmark::RepeatedTimer solveQpTimer_;
   benchmark::RepeatedTimer linesearchTimer_;
   benchmark::RepeatedTimer computeControllerTimer_;
+  benchmark::TimeBudget runTimeBudget_;  // budget of the current run() call, predicted from the timers above
 };
 
 }  // namespace ocs2
@@ -51,9 +51,11 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   }
 
   loadData::loadPtreeValue(pt, settings.ipmIteration, fieldName + ".ipmIteration", verbose);
+  loadData::loadPtreeValue(pt, settings.maxRunTime, fieldName + ".maxRunTime", verbose);
   loadData::loadPtreeValue(pt, settings.deltaTol, fieldName + ".deltaTol", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_decay, fieldName + ".alpha_decay", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_min, fieldName + ".alpha_min", verbose);
+  loadData::loadPtreeValue(pt, settings.numLinesearchCandidates, fieldName + ".numLinesearchCandidates", verbose);
   loadData::loadPtreeValue(pt, settings.gamma_c, fieldName + ".gamma_c", verbose);
   loadData::loadPtreeValue(pt, settings.g_max, fieldName + ".g_max", verbose);
   loadData::loadPtreeValue(pt, settings.g_min, fieldName + ".g_min", verbose);
@@ -66,6 +68,7 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   auto integratorName = sensitivity_integrator::toString(settings.integratorType);
   loadData::loadPtreeValue(pt, integratorName, fieldName + ".integratorType", verbose);
   settings.integratorType = sensitivity_integrator::fromString(integratorName);
+  loadData::loadPtreeValue(pt, settings.dynamicsBatchSize, fieldName + ".dynamicsBatchSize", verbose);
   loadData::loadPtreeValue(pt, settings.initialBarrierParameter, fieldName + ".initialBarrierParameter", verbose);
   loadData::loadPtreeValue(pt, settings.targetBarrierParameter, fieldName + ".targetBarrierParameter", verbose);
   loadData::loadPtreeValue(pt, settings.barrierReductionCostTol, fieldName + ".barrierReductionCostTol ", verbose);
@@ -83,6 +86,11 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.printLinesearch, fieldName + ".printLinesearch", verbose);
   loadData::loadPtreeValue(pt, settings.nThreads, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority, fieldName + ".threadPriority", verbose);
+  auto schedulerName = thread_pool::toString(settings.threadScheduler);
+  loadData::loadPtreeValue(pt, schedulerName, fieldName + ".threadScheduler", verbose);
+  settings.threadScheduler = thread_pool::fromString(schedulerName);
+  loadData::loadStdVector(filename, fieldName + ".cpuSet", settings.cpuSet, verbose);
+  loadData::loadPtreeValue(pt, settings.pinCallingThread, fieldName + ".pinCallingThread", verbose);
 
   if (settings.initialSlackLowerBound <= 0.0) {
     throw std::runtime_error("[MultipleShootingIpmSettings] initialSlackLowerBound must be positive!");
@@ -29,10 +29,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_ipm/IpmSolver.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <numeric>
 
+#include <ocs2_core/automatic_differentiation/CppAdModelSwap.h>
 #include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
 #include <ocs2_oc/multiple_shooting/Helpers.h>
 #include <ocs2_oc/multiple_shooting/Initialization.h>
@@ -65,8 +67,10 @@ ipm::Settings rectifySettings(const OptimalControlProblem& ocp, ipm::Settings&&
 
 IpmSolver::IpmSolver(ipm::Settings settings, const OptimalControlProblem& optimalControlProblem, const Initializer& initializer)
     : settings_(rectifySettings(optimalControlProblem, std::move(settings))),
+      batchDynamicsDiscretization_(settings_.integratorType, settings_.dynamicsBatchSize),
       hpipmInterface_(OcpSize(), settings_.hpipmSettings),
-      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority) {
+      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority, settings_.threadScheduler,
+                  settings_.cpuSet, settings_.pinCallingThread) {
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
 
@@ -87,6 +91,7 @@ IpmSolver::IpmSolver(ipm::Settings settings, const OptimalControlProblem& optima
   filterLinesearch_.g_min = settings_.g_min;
   filterLinesearch_.gamma_c = settings_.gamma_c;
   filterLinesearch_.armijoFactor = settings_.armijoFactor;
+  linesearchCandidates_.resize(std::max<size_t>(settings_.numLinesearchCandidates, 1));
 }
 
 IpmSolver::~IpmSolver() {
@@ -103,10 +108,12 @@ void IpmSolver::reset() {
   slackIneqTrajectory_.clear();
   dualIneqTrajectory_.clear();
   valueFunction_.clear();
+  valueFunctionIntervalHint_ = 0;
   performanceIndeces_.clear();
 
   // reset timers
   totalNumIterations_ = 0;
+  convergence_ = ipm::Convergence::FALSE;
   initializationTimer_.reset();
   linearQuadraticApproximationTimer_.reset();
   solveQpTimer_.reset();
@@ -157,7 +164,9 @@ ScalarFunctionQuadraticApproximation IpmSolver::getValueFunction(scalar_t time,
     throw std::runtime_error("[IpmSolver] Value function is empty! Is createValueFunction true and did the solver run?");
   } else {
     // Interpolation
-    const auto indexAlpha = LinearInterpolation::timeSegment(time, primalSolution_.timeTrajectory_);
+    int intervalHint = valueFunctionIntervalHint_.load(std::memory_order_relaxed);
+    const auto indexAlpha = LinearInterpolation::timeSegment(time, primalSolution_.timeTrajectory_, intervalHint);
+    valueFunctionIntervalHint_.store(intervalHint, std::memory_order_relaxed);
 
     ScalarFunctionQuadraticApproximation valueFunction;
     using T = std::vector<ocs2::ScalarFunctionQuadraticApproximation>;
@@ -201,6 +210,8 @@ MultiplierCollection IpmSolver::getIntermediateDualSolution(scalar_t time) const
 }
 
 void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  runTimeBudget_.start(1e3 * settings_.maxRunTime);  // the budget includes the initialization
+
   if (settings_.printSolverStatus || settings_.printLinesearch) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     std::cerr << "\n+++++++++++++ IPM solver is initialized ++++++++++++++";
@@ -227,7 +238,12 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     std::ignore = trajectorySpread(oldModeSchedule, newModeSchedule, primalSolution_);
   }
   vector_array_t x, u;
-  multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  const auto horizonShift = multiple_shooting::findHorizonShift(timeDiscretization, primalSolution_);
+  if (horizonShift.isValid()) {
+    multiple_shooting::shiftStateInputTrajectories(horizonShift, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  } else {
+    multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  }
 
   // Initialize the slack and dual variables of the interior point method
   if (!slackIneqTrajectory_.timeTrajectory.empty()) {
@@ -245,6 +261,12 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     initializeCostateTrajectory(timeDiscretization, x, lmd);
     initializeProjectionMultiplierTrajectory(timeDiscretization, nu);
   }
+
+  // Reuse the previous iterate verbatim on the nodes shared with the previous horizon
+  if (horizonShift.isValid()) {
+    shiftInteriorPointTrajectories(horizonShift, timeDiscretization, slackStateIneq, dualStateIneq, slackStateInputIneq, dualStateInputIneq,
+                                   lmd, nu);
+  }
   initializationTimer_.endTimer();
 
   // Bookkeeping
@@ -257,6 +279,8 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     if (settings_.printSolverStatus || settings_.printLinesearch) {
       std::cerr << "\nIPM iteration: " << iter << " (barrier parameter: " << barrierParam << ")\n";
     }
+    // between iterations no model is evaluated, background compiled AD models are swapped in here
+    swapCompiledCppAdModels();
 
     // Make QP approximation
     linearQuadraticApproximationTimer_.startTimer();
@@ -294,6 +318,8 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     ++totalNumIterations_;
   }
 
+  convergence_ = convergence;
+
   computeControllerTimer_.startTimer();
   primalSolution_ = toPrimalSolution(timeDiscretization, std::move(x), std::move(u));
   costateTrajectory_ = std::move(lmd);
@@ -311,32 +337,33 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   }
 }
 
-void IpmSolver::runParallel(std::function<void(int)> taskFunction) {
-  threadPool_.runParallel(std::move(taskFunction), settings_.nThreads);
+void IpmSolver::parallelFor(int begin, int end, std::function<void(int, int)> taskFunction) {
+  threadPool_.parallelFor(begin, end, 1, std::move(taskFunction));
 }
 
 void IpmSolver::initializeCostateTrajectory(const std::vector<AnnotatedTime>& timeDiscretization, const vector_array_t& stateTrajectory,
                                             vector_array_t& costateTrajectory) const {
-  costateTrajectory.clear();
-  costateTrajectory.reserve(stateTrajectory.size());
-
   // Determine till when to use the previous solution
   const auto interpolateTill =
       primalSolution_.timeTrajectory_.size() < 2 ? timeDiscretization.front().time : primalSolution_.timeTrajectory_.back();
 
-  const scalar_t initTime = getIntervalStart(timeDiscretization[0]);
-  if (initTime < interpolateTill) {
-    costateTrajectory.push_back(LinearInterpolation::interpolate(initTime, primalSolution_.timeTrajectory_, costateTrajectory_));
+  scalar_array_t queryTimes(stateTrajectory.size());
+  queryTimes[0] = getIntervalStart(timeDiscretization[0]);
+  for (int i = 1; i < stateTrajectory.size(); i++) {
+    queryTimes[i] = getIntervalEnd(timeDiscretization[i]);
+  }
+
+  // interpolate the previous solution in a single sweep over its time trajectory
+  if (queryTimes[0] < interpolateTill) {
+    LinearInterpolation::interpolateBatch(queryTimes, primalSolution_.timeTrajectory_, costateTrajectory_, costateTrajectory);
   } else {
-    costateTrajectory.push_back(vector_t::Zero(stateTrajectory[0].size()));
+    costateTrajectory.resize(stateTrajectory.size());
   }
 
-  for (int i = 1; i < stateTrajectory.size(); i++) {
-    const auto time = getIntervalEnd(timeDiscretization[i]);
-    if (time < interpolateTill) {  // interpolate previous solution
-      costateTrajectory.push_back(LinearInterpolation::interpolate(time, primalSolution_.timeTrajectory_, costateTrajectory_));
-    } else {  // Initialize with zero
-      costateTrajectory.push_back(vector_t::Zero(stateTrajectory[i].size()));
+  // Initialize with zero after the previous solution
+  for (int i = 0; i < stateTrajectory.size(); i++) {
+    if (queryTimes[i] >= interpolateTill) {
+      costateTrajectory[i].setZero(stateTrajectory[i].size());
     }
   }
 }
@@ -440,7 +467,7 @@ void IpmSolver::initializeSlackDualTrajectory(const std::vector<AnnotatedTime>&
         std::tie(slackStateIneq[i], slackStateInputIneq[i]) =
             ipm::fromMultiplierCollection(getIntermediateDualSolutionAtTime(slackIneqTrajectory_, time));
         std::tie(dualStateIneq[i], dualStateInputIneq[i]) =
-            ipm::fromMultiplierCollection(getIntermediateDualSolutionAtTime(slackIneqTrajectory_, time));
+            ipm::fromMultiplierCollection(getIntermediateDualSolutionAtTime(dualIneqTrajectory_, time));
       } else {
         std::tie(slackStateIneq[i], slackStateInputIneq[i]) = ipm::initializeIntermediateSlackVariable(
             ocpDefinition, time, x[i], u[i], settings_.initialSlackLowerBound, settings_.initialSlackMarginRate);
@@ -467,6 +494,54 @@ void IpmSolver::initializeSlackDualTrajectory(const std::vector<AnnotatedTime>&
   }
 }
 
+void IpmSolver::shiftInteriorPointTrajectories(const multiple_shooting::HorizonShift& horizonShift,
+                                               const std::vector<AnnotatedTime>& timeDiscretization, vector_array_t& slackStateIneq,
+                                               vector_array_t& dualStateIneq, vector_array_t& slackStateInputIneq,
+                                               vector_array_t& dualStateInputIneq, vector_array_t& lmd, vector_array_t& nu) const {
+  const int firstSharedNode = horizonShift.firstSharedNode;
+  const int numSharedNodes = horizonShift.numSharedNodes;
+
+  // The initialization determines the sizes, a previous value is only taken if the number of constraints did not change
+  auto copyIfSizeMatches = [](const vector_t& previousValue, vector_t& value) {
+    if (previousValue.size() == value.size()) {
+      value = previousValue;
+    }
+  };
+
+  // Slack and dual variables of the shared intervals, the state-only inequality constraints at the initial node stay disabled
+  const auto& previousPostEventIndices = slackIneqTrajectory_.postEventIndices;
+  const bool isSlackDualShiftable = previousPostEventIndices == primalSolution_.postEventIndices_ &&
+                                    slackIneqTrajectory_.intermediates.size() == primalSolution_.timeTrajectory_.size();
+  for (int i = 0; isSlackDualShiftable && i + 1 < numSharedNodes; i++) {
+    const size_t previousIndex = firstSharedNode + i;
+    if (timeDiscretization[i].event == AnnotatedTime::Event::PreEvent) {
+      const auto eventIt = std::upper_bound(previousPostEventIndices.cbegin(), previousPostEventIndices.cend(), previousIndex);
+      const size_t eventIndex = std::distance(previousPostEventIndices.cbegin(), eventIt);
+      copyIfSizeMatches(ipm::fromMultiplierCollection(slackIneqTrajectory_.preJumps[eventIndex]).first, slackStateIneq[i]);
+      copyIfSizeMatches(ipm::fromMultiplierCollection(dualIneqTrajectory_.preJumps[eventIndex]).first, dualStateIneq[i]);
+    } else {
+      const auto previousSlack = ipm::fromMultiplierCollection(slackIneqTrajectory_.intermediates[previousIndex]);
+      const auto previousDual = ipm::fromMultiplierCollection(dualIneqTrajectory_.intermediates[previousIndex]);
+      if (i > 0) {
+        copyIfSizeMatches(previousSlack.first, slackStateIneq[i]);
+        copyIfSizeMatches(previousDual.first, dualStateIneq[i]);
+      }
+      copyIfSizeMatches(previousSlack.second, slackStateInputIneq[i]);
+      copyIfSizeMatches(previousDual.second, dualStateInputIneq[i]);
+    }
+  }
+
+  // Costates of the shared nodes and projection multipliers of the shared intervals
+  if (settings_.computeLagrangeMultipliers) {
+    for (int i = 0; i < numSharedNodes && firstSharedNode + i < costateTrajectory_.size(); i++) {
+      copyIfSizeMatches(costateTrajectory_[firstSharedNode + i], lmd[i]);
+    }
+    for (int i = 0; i + 1 < numSharedNodes && firstSharedNode + i < projectionMultiplierTrajectory_.size(); i++) {
+      copyIfSizeMatches(projectionMultiplierTrajectory_[firstSharedNode + i], nu[i]);
+    }
+  }
+}
+
 IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta_x0, scalar_t barrierParam,
                                                            const vector_array_t& slackStateIneq, const vector_array_t& dualStateIneq,
                                                            const vector_array_t& slackStateInputIneq,
@@ -510,51 +585,9 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
   scalar_array_t primalStepSizes(settings_.nThreads, 1.0);
   scalar_array_t dualStepSizes(settings_.nThreads, 1.0);
 
-  std::atomic_int timeIndex{0};
-  auto parallelTask = [&](int workerId) {
-    // Get worker specific resources
-    vector_t tmp;  // 1 temporary for re-use for projection.
-
-    int i = timeIndex++;
-    while (i < N) {
-      deltaSlackStateIneq[i] = ipm::retrieveSlackDirection(stateIneqConstraints_[i], deltaXSol[i], barrierParam, slackStateIneq[i]);
-      deltaDualStateIneq[i] = ipm::retrieveDualDirection(barrierParam, slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i]);
-      deltaSlackStateInputIneq[i] =
-          ipm::retrieveSlackDirection(stateInputIneqConstraints_[i], deltaXSol[i], deltaUSol[i], barrierParam, slackStateInputIneq[i]);
-      deltaDualStateInputIneq[i] =
-          ipm::retrieveDualDirection(barrierParam, slackStateInputIneq[i], dualStateInputIneq[i], deltaSlackStateInputIneq[i]);
-      primalStepSizes[workerId] = std::min(
-          {primalStepSizes[workerId],
-           ipm::fractionToBoundaryStepSize(slackStateIneq[i], deltaSlackStateIneq[i], settings_.fractionToBoundaryMargin),
-           ipm::fractionToBoundaryStepSize(slackStateInputIneq[i], deltaSlackStateInputIneq[i], settings_.fractionToBoundaryMargin)});
-      dualStepSizes[workerId] = std::min(
-          {dualStepSizes[workerId],
-           ipm::fractionToBoundaryStepSize(dualStateIneq[i], deltaDualStateIneq[i], settings_.fractionToBoundaryMargin),
-           ipm::fractionToBoundaryStepSize(dualStateInputIneq[i], deltaDualStateInputIneq[i], settings_.fractionToBoundaryMargin)});
-
-      // Extract Newton directions of the costate
-      if (settings_.computeLagrangeMultipliers) {
-        deltaLmdSol[i + 1] = valueFunction_[i + 1].dfdx;
-        deltaLmdSol[i + 1].noalias() += valueFunction_[i + 1].dfdxx * deltaXSol[i + 1];
-      }
-      if (constraintsProjection_[i].f.size() > 0) {
-        // Extract Newton directions of the Lagrange multiplier associated with the state-input equality constraints
-        if (settings_.computeLagrangeMultipliers) {
-          deltaNuSol[i] = projectionMultiplierCoefficients_[i].f;
-          deltaNuSol[i].noalias() += projectionMultiplierCoefficients_[i].dfdx * deltaXSol[i];
-          deltaNuSol[i].noalias() += projectionMultiplierCoefficients_[i].dfdu * deltaUSol[i];
-          deltaNuSol[i].noalias() += projectionMultiplierCoefficients_[i].dfdcostate * deltaLmdSol[i + 1];
-        }
-        // Re-map the projected input back to the original space.
-        tmp.noalias() = constraintsProjection_[i].dfdu * deltaUSol[i];
-        deltaUSol[i] = tmp + constraintsProjection_[i].f;
-        deltaUSol[i].noalias() += constraintsProjection_[i].dfdx * deltaXSol[i];
-      }
-
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
+  std::vector<vector_t> tmp(settings_.nThreads);  // 1 temporary per worker for re-use for projection.
+  auto parallelTask = [&](int workerId, int i) {
+    if (i == N) {
       deltaSlackStateIneq[i] = ipm::retrieveSlackDirection(stateIneqConstraints_[i], deltaXSol[i], barrierParam, slackStateIneq[i]);
       deltaDualStateIneq[i] = ipm::retrieveDualDirection(barrierParam, slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i]);
       primalStepSizes[workerId] =
@@ -567,9 +600,44 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
         deltaLmdSol[0] = valueFunction_[0].dfdx;
         deltaLmdSol[0].noalias() += valueFunction_[i].dfdxx * deltaXSol[0];
       }
+      return;
+    }
+
+    deltaSlackStateIneq[i] = ipm::retrieveSlackDirection(stateIneqConstraints_[i], deltaXSol[i], barrierParam, slackStateIneq[i]);
+    deltaDualStateIneq[i] = ipm::retrieveDualDirection(barrierParam, slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i]);
+    deltaSlackStateInputIneq[i] =
+        ipm::retrieveSlackDirection(stateInputIneqConstraints_[i], deltaXSol[i], deltaUSol[i], barrierParam, slackStateInputIneq[i]);
+    deltaDualStateInputIneq[i] =
+        ipm::retrieveDualDirection(barrierParam, slackStateInputIneq[i], dualStateInputIneq[i], deltaSlackStateInputIneq[i]);
+    primalStepSizes[workerId] = std::min(
+        {primalStepSizes[workerId],
+         ipm::fractionToBoundaryStepSize(slackStateIneq[i], deltaSlackStateIneq[i], settings_.fractionToBoundaryMargin),
+         ipm::fractionToBoundaryStepSize(slackStateInputIneq[i], deltaSlackStateInputIneq[i], settings_.fractionToBoundaryMargin)});
+    dualStepSizes[workerId] = std::min(
+        {dualStepSizes[workerId],
+         ipm::fractionToBoundaryStepSize(dualStateIneq[i], deltaDualStateIneq[i], settings_.fractionToBoundaryMargin),
+         ipm::fractionToBoundaryStepSize(dualStateInputIneq[i], deltaDualStateInputIneq[i], settings_.fractionToBoundaryMargin)});
+
+    // Extract Newton directions of the costate
+    if (settings_.computeLagrangeMultipliers) {
+      deltaLmdSol[i + 1] = valueFunction_[i + 1].dfdx;
+      deltaLmdSol[i + 1].noalias() += valueFunction_[i + 1].dfdxx * deltaXSol[i + 1];
+    }
+    if (constraintsProjection_[i].f.size() > 0) {
+      // Extract Newton directions of the Lagrange multiplier associated with the state-input equality constraints
+      if (settings_.computeLagrangeMultipliers) {
+        deltaNuSol[i] = projectionMultiplierCoefficients_[i].f;
+        deltaNuSol[i].noalias() += projectionMultiplierCoefficients_[i].dfdx * deltaXSol[i];
+        deltaNuSol[i].noalias() += projectionMultiplierCoefficients_[i].dfdu * deltaUSol[i];
+        deltaNuSol[i].noalias() += projectionMultiplierCoefficients_[i].dfdcostate * deltaLmdSol[i + 1];
+      }
+      // Re-map the projected input back to the original space.
+      tmp[workerId].noalias() = constraintsProjection_[i].dfdu * deltaUSol[i];
+      deltaUSol[i] = tmp[workerId] + constraintsProjection_[i].f;
+      deltaUSol[i].noalias() += constraintsProjection_[i].dfdx * deltaXSol[i];
     }
   };
-  runParallel(std::move(parallelTask));
+  parallelFor(0, N + 1, std::move(parallelTask));
 
   solution.maxPrimalStepSize = *std::min_element(primalStepSizes.begin(), primalStepSizes.end());
   solution.maxDualStepSize = *std::min_element(dualStepSizes.begin(), dualStepSizes.end());
@@ -622,76 +690,18 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
   constraintsSize_.resize(N + 1);
   metrics.resize(N + 1);
 
-  std::atomic_int timeIndex{0};
-  auto parallelTask = [&](int workerId) {
+  // Linearize the dynamics of the intermediate nodes together, stage by stage
+  const bool batchDynamics = settings_.dynamicsBatchSize > 1;
+  if (batchDynamics) {
+    batchDynamicsDiscretization_.update(threadPool_, ocpDefinitions_, time, x, u);
+  }
+
+  auto parallelTask = [&](int workerId, int i) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
-        performance[workerId] += ipm::computePerformanceIndex(result, barrierParam, slackStateIneq[i]);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i].resize(0, x[i].size());
-        stateIneqConstraints_[i] = std::move(result.ineqConstraints);
-        stateInputIneqConstraints_[i].resize(0, x[i].size());
-        constraintsProjection_[i].resize(0, x[i].size());
-        projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
-        constraintsSize_[i] = std::move(result.constraintsSize);
-        if (settings_.computeLagrangeMultipliers) {
-          lagrangian_[i] = multiple_shooting::evaluateLagrangianEventNode(lmd[i], lmd[i + 1], std::move(result.cost), dynamics_[i]);
-        } else {
-          lagrangian_[i] = std::move(result.cost);
-        }
-
-        ipm::condenseIneqConstraints(barrierParam, slackStateIneq[i], dualStateIneq[i], stateIneqConstraints_[i], lagrangian_[i]);
-        performance[workerId].dualFeasibilitiesSSE += multiple_shooting::evaluateDualFeasibilities(lagrangian_[i]);
-        performance[workerId].dualFeasibilitiesSSE +=
-            ipm::evaluateComplementarySlackness(barrierParam, slackStateIneq[i], dualStateIneq[i]);
-      } else {
-        // Normal, intermediate node
-        const scalar_t ti = getIntervalStart(time[i]);
-        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        // Disable the state-only inequality constraints at the initial node
-        if (i == 0) {
-          result.stateIneqConstraints.setZero(0, x[i].size());
-          std::fill(result.constraintsSize.stateIneq.begin(), result.constraintsSize.stateIneq.end(), 0);
-        }
-        metrics[i] = multiple_shooting::computeMetrics(result);
-        performance[workerId] += ipm::computePerformanceIndex(result, dt, barrierParam, slackStateIneq[i], slackStateInputIneq[i]);
-        multiple_shooting::projectTranscription(result, settings_.computeLagrangeMultipliers);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
-        stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
-        stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
-        constraintsProjection_[i] = std::move(result.constraintsProjection);
-        projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
-        constraintsSize_[i] = std::move(result.constraintsSize);
-        if (settings_.computeLagrangeMultipliers) {
-          lagrangian_[i] = multiple_shooting::evaluateLagrangianIntermediateNode(lmd[i], lmd[i + 1], nu[i], std::move(result.cost),
-                                                                                 dynamics_[i], stateInputEqConstraints_[i]);
-        } else {
-          lagrangian_[i] = std::move(result.cost);
-        }
-
-        ipm::condenseIneqConstraints(barrierParam, slackStateIneq[i], dualStateIneq[i], stateIneqConstraints_[i], lagrangian_[i]);
-        ipm::condenseIneqConstraints(barrierParam, slackStateInputIneq[i], dualStateInputIneq[i], stateInputIneqConstraints_[i],
-                                     lagrangian_[i]);
-        performance[workerId].dualFeasibilitiesSSE += multiple_shooting::evaluateDualFeasibilities(lagrangian_[i]);
-        performance[workerId].dualFeasibilitiesSSE +=
-            ipm::evaluateComplementarySlackness(barrierParam, slackStateIneq[i], dualStateIneq[i]);
-        performance[workerId].dualFeasibilitiesSSE +=
-            ipm::evaluateComplementarySlackness(barrierParam, slackStateInputIneq[i], dualStateInputIneq[i]);
-      }
-
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
+    if (i == N) {
+      // Terminal node
       const scalar_t tN = getIntervalStart(time[N]);
       auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
       metrics[i] = multiple_shooting::computeMetrics(result);
@@ -707,9 +717,70 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
       ipm::condenseIneqConstraints(barrierParam, slackStateIneq[N], dualStateIneq[N], stateIneqConstraints_[N], lagrangian_[N]);
       performance[workerId].dualFeasibilitiesSSE += multiple_shooting::evaluateDualFeasibilities(lagrangian_[N]);
       performance[workerId].dualFeasibilitiesSSE += ipm::evaluateComplementarySlackness(barrierParam, slackStateIneq[N], dualStateIneq[N]);
+    } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      // Event node
+      auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
+      metrics[i] = multiple_shooting::computeMetrics(result);
+      performance[workerId] += ipm::computePerformanceIndex(result, barrierParam, slackStateIneq[i]);
+      dynamics_[i] = std::move(result.dynamics);
+      stateInputEqConstraints_[i].resize(0, x[i].size());
+      stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+      stateInputIneqConstraints_[i].resize(0, x[i].size());
+      constraintsProjection_[i].resize(0, x[i].size());
+      projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
+      constraintsSize_[i] = std::move(result.constraintsSize);
+      if (settings_.computeLagrangeMultipliers) {
+        lagrangian_[i] = multiple_shooting::evaluateLagrangianEventNode(lmd[i], lmd[i + 1], std::move(result.cost), dynamics_[i]);
+      } else {
+        lagrangian_[i] = std::move(result.cost);
+      }
+
+      ipm::condenseIneqConstraints(barrierParam, slackStateIneq[i], dualStateIneq[i], stateIneqConstraints_[i], lagrangian_[i]);
+      performance[workerId].dualFeasibilitiesSSE += multiple_shooting::evaluateDualFeasibilities(lagrangian_[i]);
+      performance[workerId].dualFeasibilitiesSSE +=
+          ipm::evaluateComplementarySlackness(barrierParam, slackStateIneq[i], dualStateIneq[i]);
+    } else {
+      // Normal, intermediate node
+      const scalar_t ti = getIntervalStart(time[i]);
+      const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+      auto result =
+          batchDynamics
+              ? multiple_shooting::setupIntermediateNode(ocpDefinition, batchDynamicsDiscretization_.getDiscreteDynamics(i), ti, dt, x[i],
+                                                         x[i + 1], u[i])
+              : multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
+      // Disable the state-only inequality constraints at the initial node
+      if (i == 0) {
+        result.stateIneqConstraints.setZero(0, x[i].size());
+        std::fill(result.constraintsSize.stateIneq.begin(), result.constraintsSize.stateIneq.end(), 0);
+      }
+      metrics[i] = multiple_shooting::computeMetrics(result);
+      performance[workerId] += ipm::computePerformanceIndex(result, dt, barrierParam, slackStateIneq[i], slackStateInputIneq[i]);
+      multiple_shooting::projectTranscription(result, settings_.computeLagrangeMultipliers);
+      dynamics_[i] = std::move(result.dynamics);
+      stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
+      stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
+      stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
+      constraintsProjection_[i] = std::move(result.constraintsProjection);
+      projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
+      constraintsSize_[i] = std::move(result.constraintsSize);
+      if (settings_.computeLagrangeMultipliers) {
+        lagrangian_[i] = multiple_shooting::evaluateLagrangianIntermediateNode(lmd[i], lmd[i + 1], nu[i], std::move(result.cost),
+                                                                               dynamics_[i], stateInputEqConstraints_[i]);
+      } else {
+        lagrangian_[i] = std::move(result.cost);
+      }
+
+      ipm::condenseIneqConstraints(barrierParam, slackStateIneq[i], dualStateIneq[i], stateIneqConstraints_[i], lagrangian_[i]);
+      ipm::condenseIneqConstraints(barrierParam, slackStateInputIneq[i], dualStateInputIneq[i], stateInputIneqConstraints_[i],
+                                   lagrangian_[i]);
+      performance[workerId].dualFeasibilitiesSSE += multiple_shooting::evaluateDualFeasibilities(lagrangian_[i]);
+      performance[workerId].dualFeasibilitiesSSE +=
+          ipm::evaluateComplementarySlackness(barrierParam, slackStateIneq[i], dualStateIneq[i]);
+      performance[workerId].dualFeasibilitiesSSE +=
+          ipm::evaluateComplementarySlackness(barrierParam, slackStateInputIneq[i], dualStateInputIneq[i]);
     }
   };
-  runParallel(std::move(parallelTask));
+  parallelFor(0, N + 1, std::move(parallelTask));
 
   // Account for initial state in performance
   const vector_t initDynamicsViolation = initState - x.front();
@@ -723,58 +794,69 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
   return totalPerformance;
 }
 
-PerformanceIndex IpmSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                               const vector_array_t& u, scalar_t barrierParam, const vector_array_t& slackStateIneq,
-                                               const vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics) {
+void IpmSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, scalar_t barrierParam,
+                                   std::vector<LinesearchCandidate>& candidates, size_t numCandidates) {
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
-  metrics.resize(N + 1);
+  const int numNodes = N + 1;
+  for (size_t c = 0; c < numCandidates; c++) {
+    candidates[c].metrics.resize(N + 1);
+  }
 
-  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
-  std::atomic_int timeIndex{0};
-  auto parallelTask = [&](int workerId) {
+  // one performance index per candidate and worker
+  std::vector<PerformanceIndex> performance(numCandidates * settings_.nThreads, PerformanceIndex());
+  auto parallelTask = [&](int workerId, int k) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        performance[workerId] += ipm::toPerformanceIndex(metrics[i], barrierParam, slackStateIneq[i]);
-      } else {
-        // Normal, intermediate node
-        const scalar_t ti = getIntervalStart(time[i]);
-        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        const bool enableStateInequalityConstraints = (i > 0);
-        metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        // Disable the state-only inequality constraints at the initial node
-        if (i == 0) {
-          metrics[i].stateIneqConstraint.clear();
-        }
-        performance[workerId] += ipm::toPerformanceIndex(metrics[i], dt, barrierParam, slackStateIneq[i], slackStateInputIneq[i]);
-      }
-
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
+    // Task k is the node i of candidate c
+    const size_t c = k / numNodes;
+    const int i = k % numNodes;
+    const auto& x = candidates[c].x;
+    const auto& u = candidates[c].u;
+    const auto& slackStateIneq = candidates[c].slackStateIneq;
+    const auto& slackStateInputIneq = candidates[c].slackStateInputIneq;
+    auto& metrics = candidates[c].metrics;
+    auto& candidatePerformance = performance[c * settings_.nThreads + workerId];
+
+    if (i == N) {
+      // Terminal node
       const scalar_t tN = getIntervalStart(time[N]);
       metrics[N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
-      performance[workerId] += ipm::toPerformanceIndex(metrics[N], barrierParam, slackStateIneq[N]);
+      candidatePerformance += ipm::toPerformanceIndex(metrics[N], barrierParam, slackStateIneq[N]);
+    } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      // Event node
+      metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
+      candidatePerformance += ipm::toPerformanceIndex(metrics[i], barrierParam, slackStateIneq[i]);
+    } else {
+      // Normal, intermediate node
+      const scalar_t ti = getIntervalStart(time[i]);
+      const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+      metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
+      // Disable the state-only inequality constraints at the initial node
+      if (i == 0) {
+        metrics[i].stateIneqConstraint.clear();
+      }
+      candidatePerformance += ipm::toPerformanceIndex(metrics[i], dt, barrierParam, slackStateIneq[i], slackStateInputIneq[i]);
     }
   };
-  runParallel(std::move(parallelTask));
-
-  // Account for initial state in performance
-  const vector_t initDynamicsViolation = initState - x.front();
-  metrics.front().dynamicsViolation += initDynamicsViolation;
-  performance.front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
-
-  // Sum performance of the threads
-  PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
-  totalPerformance.merit = totalPerformance.cost + totalPerformance.equalityLagrangian + totalPerformance.inequalityLagrangian;
-  return totalPerformance;
+  parallelFor(0, static_cast<int>(numCandidates) * numNodes, std::move(parallelTask));
+
+  for (size_t c = 0; c < numCandidates; c++) {
+    auto& candidate = candidates[c];
+    const auto performanceBegin = std::next(performance.begin(), c * settings_.nThreads);
+    const auto performanceEnd = std::next(performanceBegin, settings_.nThreads);
+
+    // Account for initial state in performance
+    const vector_t initDynamicsViolation = initState - candidate.x.front();
+    candidate.metrics.front().dynamicsViolation += initDynamicsViolation;
+    performanceBegin->dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+
+    // Sum performance of the threads
+    candidate.performance = std::accumulate(std::next(performanceBegin), performanceEnd, *performanceBegin);
+    candidate.performance.merit = candidate.performance.cost + candidate.performance.equalityLagrangian +
+                                  candidate.performance.inequalityLagrangian;
+  }
 }
 
 ipm::StepInfo IpmSolver::takePrimalStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
@@ -805,66 +887,81 @@ ipm::StepInfo IpmSolver::takePrimalStep(const PerformanceIndex& baseline, const
   const auto deltaUnorm = multiple_shooting::trajectoryNorm(du);
   const auto deltaXnorm = multiple_shooting::trajectoryNorm(dx);
 
+  // the candidates are written to the persistent buffers of the solver
+  auto& candidates = linesearchCandidates_;
+  for (auto& candidate : candidates) {
+    candidate.x.resize(x.size());
+    candidate.u.resize(u.size());
+    candidate.slackStateIneq.resize(slackStateIneq.size());
+    candidate.slackStateInputIneq.resize(slackStateInputIneq.size());
+  }
+
   scalar_t alpha = subproblemSolution.maxPrimalStepSize;
-  vector_array_t xNew(x.size());
-  vector_array_t uNew(u.size());
-  vector_array_t slackStateIneqNew(slackStateIneq.size());
-  vector_array_t slackStateInputIneqNew(slackStateInputIneq.size());
-  std::vector<Metrics> metricsNew(metrics.size());
-  do {
-    // Compute step
-    multiple_shooting::incrementTrajectory(u, du, alpha, uNew);
-    multiple_shooting::incrementTrajectory(x, dx, alpha, xNew);
-    multiple_shooting::incrementTrajectory(slackStateIneq, deltaSlackStateIneq, alpha, slackStateIneqNew);
-    multiple_shooting::incrementTrajectory(slackStateInputIneq, deltaSlackStateInputIneq, alpha, slackStateInputIneqNew);
-
-    // Compute cost and constraints
-    const PerformanceIndex performanceNew =
-        computePerformance(timeDiscretization, initState, xNew, uNew, barrierParam, slackStateIneqNew, slackStateInputIneqNew, metricsNew);
-
-    // Step acceptance and record step type
-    bool stepAccepted;
-    StepType stepType;
-    std::tie(stepAccepted, stepType) =
-        filterLinesearch_.acceptStep(baseline, performanceNew, alpha * subproblemSolution.armijoDescentMetric);
-
-    if (settings_.printLinesearch) {
-      std::cerr << "Step size: " << alpha << ", Step Type: " << toString(stepType)
-                << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
-      std::cerr << "|dx| = " << alpha * deltaXnorm << "\t|du| = " << alpha * deltaUnorm << "\n";
-      std::cerr << performanceNew << "\n";
-    }
+  bool isStepTooSmall = false;
+  bool hasCandidates = true;
+  while (hasCandidates) {
+    // Compute the steps of the next batch of candidates
+    size_t numCandidates = 0;
+    while (hasCandidates && numCandidates < candidates.size()) {
+      auto& candidate = candidates[numCandidates++];
+      candidate.stepSize = alpha;
+      multiple_shooting::incrementTrajectory(u, du, alpha, candidate.u);
+      multiple_shooting::incrementTrajectory(x, dx, alpha, candidate.x);
+      multiple_shooting::incrementTrajectory(slackStateIneq, deltaSlackStateIneq, alpha, candidate.slackStateIneq);
+      multiple_shooting::incrementTrajectory(slackStateInputIneq, deltaSlackStateInputIneq, alpha, candidate.slackStateInputIneq);
 
-    if (stepAccepted) {  // Return if step accepted
-      x = std::move(xNew);
-      u = std::move(uNew);
-      slackStateIneq = std::move(slackStateIneqNew);
-      slackStateInputIneq = std::move(slackStateInputIneqNew);
-      metrics = std::move(metricsNew);
-
-      // Prepare step info
-      ipm::StepInfo stepInfo;
-      stepInfo.primalStepSize = alpha;
-      stepInfo.stepType = stepType;
-      stepInfo.dx_norm = alpha * deltaXnorm;
-      stepInfo.du_norm = alpha * deltaUnorm;
-      stepInfo.performanceAfterStep = performanceNew;
-      stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(performanceNew);
-      return stepInfo;
-
-    } else {  // Try smaller step
+      // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
       alpha *= settings_.alpha_decay;
+      isStepTooSmall = alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol;
+      hasCandidates = !isStepTooSmall && alpha >= settings_.alpha_min;
+    }
 
-      // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
-      if (alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol) {
-        if (settings_.printLinesearch) {
-          std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
-                    << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
-        }
-        break;
+    // Compute cost and constraints of all candidates of the batch
+    computePerformance(timeDiscretization, initState, barrierParam, candidates, numCandidates);
+
+    // Step acceptance in the order of decreasing step size, such that the largest accepted step is taken
+    for (size_t c = 0; c < numCandidates; c++) {
+      auto& candidate = candidates[c];
+      const scalar_t stepSize = candidate.stepSize;
+      const PerformanceIndex& performanceNew = candidate.performance;
+
+      bool stepAccepted;
+      StepType stepType;
+      std::tie(stepAccepted, stepType) =
+          filterLinesearch_.acceptStep(baseline, performanceNew, stepSize * subproblemSolution.armijoDescentMetric);
+
+      if (settings_.printLinesearch) {
+        std::cerr << "Step size: " << stepSize << ", Step Type: " << toString(stepType)
+                  << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
+        std::cerr << "|dx| = " << stepSize * deltaXnorm << "\t|du| = " << stepSize * deltaUnorm << "\n";
+        std::cerr << performanceNew << "\n";
+      }
+
+      if (stepAccepted) {  // Return if step accepted
+        // swap such that the buffers of the previous iterate are reused for the next candidate
+        x.swap(candidate.x);
+        u.swap(candidate.u);
+        slackStateIneq.swap(candidate.slackStateIneq);
+        slackStateInputIneq.swap(candidate.slackStateInputIneq);
+        metrics.swap(candidate.metrics);
+
+        // Prepare step info
+        ipm::StepInfo stepInfo;
+        stepInfo.primalStepSize = stepSize;
+        stepInfo.stepType = stepType;
+        stepInfo.dx_norm = stepSize * deltaXnorm;
+        stepInfo.du_norm = stepSize * deltaUnorm;
+        stepInfo.performanceAfterStep = performanceNew;
+        stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(performanceNew);
+        return stepInfo;
       }
     }
-  } while (alpha >= settings_.alpha_min);
+  }
+
+  if (isStepTooSmall && settings_.printLinesearch) {
+    std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
+              << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
+  }
 
   // Alpha_min reached -> Don't take a step
   ipm::StepInfo stepInfo;
@@ -925,6 +1022,10 @@ ipm::Convergence IpmSolver::checkConvergence(int iteration, scalar_t barrierPara
              barrierParam <= settings_.targetBarrierParameter) {
     // Converged because the change in primal variables is below the specified tolerance
     return Convergence::PRIMAL;
+  } else if (!runTimeBudget_.fits(benchmark::TimeBudget::predictDurationInMilliseconds(
+                 {&linearQuadraticApproximationTimer_, &solveQpTimer_, &linesearchTimer_, &computeControllerTimer_}))) {
+    // Terminated because the next iteration and the controller computation are predicted to exceed the time budget
+    return Convergence::TIME;
   } else {
     // None of the above convergence criteria were met -> not converged.
     return Convergence::FALSE;
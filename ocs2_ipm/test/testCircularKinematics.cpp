@@ -128,6 +128,66 @@ TEST(test_circular_kinematics, solve_projected_EqConstraints) {
   }
 }
 
+TEST(test_circular_kinematics, maxRunTime) {
+  // optimal control problem
+  OptimalControlProblem problem = createCircularKinematicsProblem("/tmp/ocs2/ipm_test_generated");
+
+  // Initializer
+  DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  auto settings = []() {
+    ipm::Settings s;
+    s.dt = 0.01;
+    s.ipmIteration = 1000;
+    s.useFeedbackPolicy = true;
+    s.printSolverStatistics = false;
+    s.printSolverStatus = false;
+    s.printLinesearch = false;
+    s.nThreads = 1;
+    s.initialBarrierParameter = 1.0e-02;
+    s.targetBarrierParameter = 1.0e-04;
+    s.barrierLinearDecreaseFactor = 0.2;
+    s.barrierSuperlinearDecreasePower = 1.5;
+    s.fractionToBoundaryMargin = 0.995;
+    return s;
+  }();
+
+  // Additional problem definitions
+  const scalar_t startTime = 0.0;
+  const scalar_t finalTime = 1.0;
+  const vector_t initState = (vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Without a time budget the solver converges after more than one iteration
+  IpmSolver referenceSolver(settings, problem, zeroInitializer);
+  referenceSolver.run(startTime, initState, finalTime);
+  ASSERT_NE(referenceSolver.getConvergence(), ipm::Convergence::TIME);
+  ASSERT_NE(referenceSolver.getConvergence(), ipm::Convergence::ITERATIONS);
+  ASSERT_GT(referenceSolver.getNumIterations(), 1u);
+
+  // The budget is exhausted after the first iteration, which always runs
+  settings.maxRunTime = 1e-6;
+  IpmSolver solver(settings, problem, zeroInitializer);
+  solver.run(startTime, initState, finalTime);
+  ASSERT_EQ(solver.getConvergence(), ipm::Convergence::TIME);
+  ASSERT_EQ(solver.getNumIterations(), 1u);
+
+  // The solution of the first iteration is returned
+  const auto primalSolution = solver.primalSolution(finalTime);
+  ASSERT_TRUE(primalSolution.stateTrajectory_.front().isApprox(initState));
+  ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.front(), startTime);
+  ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.back(), finalTime);
+  ASSERT_TRUE(primalSolution.controllerPtr_ != nullptr);
+  for (int i = 0; i < primalSolution.timeTrajectory_.size() - 1; i++) {
+    const auto t = primalSolution.timeTrajectory_[i];
+    const auto& x = primalSolution.stateTrajectory_[i];
+    const auto& u = primalSolution.inputTrajectory_[i];
+    ASSERT_TRUE(x.allFinite());
+    ASSERT_TRUE(u.allFinite());
+    ASSERT_TRUE(u.isApprox(primalSolution.controllerPtr_->computeInput(t, x)));
+  }
+}
+
 TEST(test_circular_kinematics, solve_projected_EqConstraints_IneqConstraints) {
   constexpr size_t STATE_DIM = 2;
   constexpr size_t INPUT_DIM = 2;
@@ -67,6 +67,13 @@ class MPC_BASE {
    */
   virtual bool run(scalar_t currentTime, const vector_t& currentState);
 
+  /**
+   * Prepares the next run() call while waiting for the next state, see prepareController(). The time of the next call is predicted
+   * from the interval between the last two run() calls, or from settings().mpcDesiredFrequency_ after the first call. Nothing is
+   * prepared if neither is available. This should be called after the policy of the last run() call is published.
+   */
+  void prepare();
+
   /** Gets a pointer to the underlying solver used in the MPC. */
   virtual SolverBase* getSolverPtr() = 0;
 
@@ -89,11 +96,22 @@ class MPC_BASE {
    */
   virtual void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) = 0;
 
+  /**
+   * Does the part of the next calculateController() call which does not depend on the initial state, e.g. the preparation phase of a
+   * real-time iteration scheme. By default, nothing is prepared.
+   *
+   * @param [in] initTime: The predicted initial time of the next call.
+   * @param [in] finalTime: The predicted final time of the next call.
+   */
+  virtual void prepareController(scalar_t initTime, scalar_t finalTime) {}
+
   /** Whether this is the first iteration of MPC or not. */
   bool isFirstMpcRun() const { return initRun_; }
 
  private:
   bool initRun_ = true;
+  scalar_t lastRunTime_ = 0.0;
+  scalar_t runInterval_ = 0.0;  // time between the last two run() calls
   const mpc::Settings mpcSettings_;
 
   benchmark::RepeatedTimer mpcTimer_;
@@ -33,11 +33,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <csignal>
 #include <ctime>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <thread>
 
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/model_data/Multiplier.h>
+#include <ocs2_core/thread_support/TripleBuffer.h>
 #include "ocs2_mpc/MPC_BASE.h"
 #include "ocs2_mpc/MRT_BASE.h"
 
@@ -59,6 +61,10 @@ class MPC_MRT_Interface final : public MRT_BASE {
 
   void resetMpcNode(const TargetTrajectories& initTargetTrajectories) override;
 
+  /**
+   * Sets the observation for the next advanceMpc() call. This method is thread-safe. Concurrent calls are serialized among each other,
+   * but never wait for advanceMpc().
+   */
   void setCurrentObservation(const SystemObservation& currentObservation) override;
 
   /*
@@ -126,9 +132,9 @@ class MPC_MRT_Interface final : public MRT_BASE {
   MPC_BASE& mpc_;
   benchmark::RepeatedTimer mpcTimer_;
 
-  // MPC inputs
-  SystemObservation currentObservation_;
-  std::mutex observationMutex_;
+  // MPC inputs, written by setCurrentObservation() and read by advanceMpc()
+  TripleBuffer<SystemObservation> observationBuffer_;
+  std::mutex observationWriteMutex_;  //!< serializes the producers of observationBuffer_
 };
 
 }  // namespace ocs2
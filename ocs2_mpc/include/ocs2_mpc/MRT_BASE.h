@@ -33,14 +33,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <atomic>
 #include <cstddef>
+#include <limits>
 #include <memory>
-#include <mutex>
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/ControllerBase.h>
 #include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_core/reference/ModeSchedule.h>
 #include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_core/thread_support/TripleBuffer.h>
 #include <ocs2_oc/oc_data/PerformanceIndex.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 #include <ocs2_oc/rollout/RolloutBase.h>
@@ -54,15 +55,21 @@ namespace ocs2 {
 /**
  * This class implements core MRT (Model Reference Tracking) functionality.
  * The responsibility of filling the buffer variables is left to the deriving classes.
+ *
+ * The policy is handed over from the thread calling moveToBuffer() to the thread calling updatePolicy() through a wait-free triple
+ * buffer, so neither of the two threads ever blocks on the other. moveToBuffer() and updatePolicy() must each be called from one
+ * thread at a time.
  */
 class MRT_BASE {
  public:
-  MRT_BASE();
+  MRT_BASE() = default;
 
   virtual ~MRT_BASE() = default;
 
   /**
-   * Resets the class to its instantiated state.
+   * Resets the class to its instantiated state: the active policy and all policies received so far are discarded.
+   * This method may be called while policies are moved to the buffer. A policy received after the reset becomes active with the
+   * next call of updatePolicy().
    */
   void reset();
 
@@ -76,7 +83,7 @@ class MRT_BASE {
   /**
    * Whether the initial MPC policy has been already received.
    */
-  bool initialPolicyReceived() const { return policyReceivedEver_; }
+  bool initialPolicyReceived() const;
 
   /**
    * @brief setCurrentObservation notifies MPC of a new state
@@ -116,6 +123,8 @@ class MRT_BASE {
 
   /**
    * @brief Evaluates the controller
+   * This method does not allocate memory once the outputs have the right size, and the time lookup is O(1) for monotonically
+   * increasing query times.
    *
    * @param [in] currentTime: the query time.
    * @param [in] currentState: the query state.
@@ -163,31 +172,34 @@ class MRT_BASE {
                     std::unique_ptr<PerformanceIndex> performanceIndicesPtr);
 
  private:
-  /** Calls modifyActiveSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
+  /** The MPC output of one iteration */
+  struct Policy {
+    std::unique_ptr<CommandData> commandPtr;
+    std::unique_ptr<PrimalSolution> primalSolutionPtr;
+    std::unique_ptr<PerformanceIndex> performanceIndicesPtr;
+    size_t resetCount = 0;  // number of resets before the policy has been received
+  };
+
+  /** Returns the active policy, or a policy without data if reset() has been called since the active policy has been received. */
+  const Policy& getActivePolicy() const;
+
+  /** Calls modifyActiveSolution on all mrt observers. This function is called from the thread calling updatePolicy() */
   void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution);
 
-  /** Calls modifyBufferedSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
+  /** Calls modifyBufferedSolution on all mrt observers. This function is called from the thread calling moveToBuffer() */
   void modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer);
 
-  // flags on state of the class
-  std::atomic_bool policyReceivedEver_;
-  bool newPolicyInBuffer_;  // whether a new policy is waiting to be swapped in
+  // number of calls to reset() and the number of resets before the last policy has been received
+  std::atomic_size_t resetCount_{0};
+  std::atomic_size_t publishedResetCount_{std::numeric_limits<size_t>::max()};
 
-  // variables related to the MPC output
-  std::unique_ptr<CommandData> activeCommandPtr_;
-  std::unique_ptr<CommandData> bufferCommandPtr_;
-  std::unique_ptr<PrimalSolution> activePrimalSolutionPtr_;
-  std::unique_ptr<PrimalSolution> bufferPrimalSolutionPtr_;
-  std::unique_ptr<PerformanceIndex> activePerformanceIndicesPtr_;
-  std::unique_ptr<PerformanceIndex> bufferPerformanceIndicesPtr_;
-
-  // thread safety
-  mutable std::mutex bufferMutex_;  // for policy variables with the prefix (buffer*)
-  const size_t mrtTrylockWarningThreshold_ = 5;
-  size_t mrtTrylockWarningCount_;
+  // variables related to the MPC output, the active policy is the read slot of the buffer
+  TripleBuffer<Policy> policyBuffer_;
 
   // variables needed for policy evaluation
   std::unique_ptr<RolloutBase> rolloutPtr_;
+  int controllerTimeIntervalHint_ = 0;  // time interval of the last controller evaluation
+  int stateTimeIntervalHint_ = 0;       // time interval of the last state trajectory interpolation
 
   std::vector<std::shared_ptr<MrtObserver>> observerPtrArray_;
 };
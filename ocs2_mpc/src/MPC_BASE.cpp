@@ -43,6 +43,8 @@ MPC_BASE::MPC_BASE(mpc::Settings mpcSettings) : mpcSettings_(std::move(mpcSettin
 /******************************************************************************************************/
 void MPC_BASE::reset() {
   initRun_ = true;
+  lastRunTime_ = 0.0;
+  runInterval_ = 0.0;
   mpcTimer_.reset();
   getSolverPtr()->reset();
 }
@@ -74,6 +76,10 @@ bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
   // calculate the MPC policy
   calculateController(currentTime, currentState, finalTime);
 
+  // record the call interval for the prediction of the next call
+  runInterval_ = initRun_ ? 0.0 : std::max(currentTime - lastRunTime_, scalar_t(0.0));
+  lastRunTime_ = currentTime;
+
   // set initRun flag to false
   initRun_ = false;
 
@@ -89,4 +95,28 @@ bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
   return true;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_BASE::prepare() {
+  // nothing to prepare without a previous solution
+  if (initRun_) {
+    return;
+  }
+
+  // the interval is only known after the second run() call, before that the desired MPC frequency is the best guess
+  scalar_t interval = runInterval_;
+  if (interval <= 0.0 && mpcSettings_.mpcDesiredFrequency_ > 0.0) {
+    interval = 1.0 / mpcSettings_.mpcDesiredFrequency_;
+  }
+  if (interval <= 0.0) {
+    return;  // the time of the next call cannot be predicted
+  }
+
+  const scalar_t nextTime = lastRunTime_ + interval;
+  if (nextTime < getSolverPtr()->getFinalTime()) {
+    prepareController(nextTime, nextTime + mpcSettings_.timeHorizon_);
+  }
+}
+
 }  // namespace ocs2
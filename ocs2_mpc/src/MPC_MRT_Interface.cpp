@@ -54,8 +54,9 @@ void MPC_MRT_Interface::resetMpcNode(const TargetTrajectories& initTargetTraject
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MPC_MRT_Interface::setCurrentObservation(const SystemObservation& currentObservation) {
-  std::lock_guard<std::mutex> lock(observationMutex_);
-  currentObservation_ = currentObservation;
+  // the triple buffer has a single producer slot, concurrent callers (e.g. a ROS callback and a user thread) take turns
+  std::lock_guard<std::mutex> lock(observationWriteMutex_);
+  observationBuffer_.setBuffer(currentObservation);
 }
 
 /******************************************************************************************************/
@@ -79,11 +80,9 @@ void MPC_MRT_Interface::advanceMpc() {
   // measure the delay in running MPC
   mpcTimer_.startTimer();
 
-  SystemObservation currentObservation;
-  {
-    std::lock_guard<std::mutex> lock(observationMutex_);
-    currentObservation = currentObservation_;
-  }
+  // take the latest observation, the previous one is kept if no new observation was set
+  observationBuffer_.updateFromBuffer();
+  const SystemObservation& currentObservation = observationBuffer_.get();
 
   bool controllerIsUpdated = mpc_.run(currentObservation.time, currentObservation.state);
   if (!controllerIsUpdated) {
@@ -110,6 +109,9 @@ void MPC_MRT_Interface::advanceMpc() {
     std::cerr << "\n###   Average : " << mpcTimer_.getAverageInMilliseconds() << "[ms].";
     std::cerr << "\n###   Latest  : " << mpcTimer_.getLastIntervalInMilliseconds() << "[ms]." << std::endl;
   }
+
+  // the policy is in the buffer, prepare the next call
+  mpc_.prepare();
 }
 
 /******************************************************************************************************/
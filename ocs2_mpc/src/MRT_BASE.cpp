@@ -36,34 +36,34 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-MRT_BASE::MRT_BASE() {
-  reset();
+void MRT_BASE::reset() {
+  // Invalidates the active and all buffered policies. The buffer itself is left to the producer and consumer threads.
+  ++resetCount_;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void MRT_BASE::reset() {
-  std::lock_guard<std::mutex> lock(bufferMutex_);
-
-  policyReceivedEver_ = false;
-  newPolicyInBuffer_ = false;
-  mrtTrylockWarningCount_ = 0;
-
-  activeCommandPtr_.reset();
-  bufferCommandPtr_.reset();
-  activePrimalSolutionPtr_.reset();
-  bufferPrimalSolutionPtr_.reset();
-  activePerformanceIndicesPtr_.reset();
-  bufferPerformanceIndicesPtr_.reset();
+bool MRT_BASE::initialPolicyReceived() const {
+  return publishedResetCount_ == resetCount_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const MRT_BASE::Policy& MRT_BASE::getActivePolicy() const {
+  static const Policy emptyPolicy;
+  const auto& activePolicy = policyBuffer_.get();
+  return (activePolicy.resetCount == resetCount_) ? activePolicy : emptyPolicy;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 const CommandData& MRT_BASE::getCommand() const {
-  if (activeCommandPtr_ != nullptr) {
-    return *activeCommandPtr_;
+  const auto& activeCommandPtr = getActivePolicy().commandPtr;
+  if (activeCommandPtr != nullptr) {
+    return *activeCommandPtr;
   } else {
     throw std::runtime_error("[MRT_BASE::getCommand] updatePolicy() should be called first!");
   }
@@ -73,8 +73,9 @@ const CommandData& MRT_BASE::getCommand() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 const PrimalSolution& MRT_BASE::getPolicy() const {
-  if (activePrimalSolutionPtr_ != nullptr) {
-    return *activePrimalSolutionPtr_;
+  const auto& activePrimalSolutionPtr = getActivePolicy().primalSolutionPtr;
+  if (activePrimalSolutionPtr != nullptr) {
+    return *activePrimalSolutionPtr;
   } else {
     throw std::runtime_error("[MRT_BASE::getPolicy] updatePolicy() should be called first!");
   }
@@ -84,8 +85,9 @@ const PrimalSolution& MRT_BASE::getPolicy() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 const PerformanceIndex& MRT_BASE::getPerformanceIndices() const {
-  if (activePerformanceIndicesPtr_ != nullptr) {
-    return *activePerformanceIndicesPtr_;
+  const auto& activePerformanceIndicesPtr = getActivePolicy().performanceIndicesPtr;
+  if (activePerformanceIndicesPtr != nullptr) {
+    return *activePerformanceIndicesPtr;
   } else {
     throw std::runtime_error("[MRT_BASE::getPerformanceIndices] updatePolicy() should be called first!");
   }
@@ -102,20 +104,22 @@ void MRT_BASE::initRollout(const RolloutBase* rolloutPtr) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_BASE::evaluatePolicy(scalar_t currentTime, const vector_t& currentState, vector_t& mpcState, vector_t& mpcInput, size_t& mode) {
-  if (activePrimalSolutionPtr_ == nullptr) {
+  const auto& activePrimalSolutionPtr = getActivePolicy().primalSolutionPtr;
+  if (activePrimalSolutionPtr == nullptr) {
     throw std::runtime_error("[MRT_BASE::evaluatePolicy] updatePolicy() should be called first!");
   }
 
-  if (currentTime > activePrimalSolutionPtr_->timeTrajectory_.back()) {
+  if (currentTime > activePrimalSolutionPtr->timeTrajectory_.back()) {
     std::cerr << "The requested currentTime is greater than the received plan: " << std::to_string(currentTime) << ">"
-              << std::to_string(activePrimalSolutionPtr_->timeTrajectory_.back()) << "\n";
+              << std::to_string(activePrimalSolutionPtr->timeTrajectory_.back()) << "\n";
   }
 
-  mpcInput = activePrimalSolutionPtr_->controllerPtr_->computeInput(currentTime, currentState);
-  mpcState =
-      LinearInterpolation::interpolate(currentTime, activePrimalSolutionPtr_->timeTrajectory_, activePrimalSolutionPtr_->stateTrajectory_);
+  // in-place evaluation with time hints: no memory allocation once mpcState and mpcInput have the right size
+  activePrimalSolutionPtr->controllerPtr_->computeInputInPlace(currentTime, currentState, mpcInput, controllerTimeIntervalHint_);
+  const auto indexAlpha = LinearInterpolation::timeSegment(currentTime, activePrimalSolutionPtr->timeTrajectory_, stateTimeIntervalHint_);
+  LinearInterpolation::interpolate(indexAlpha, activePrimalSolutionPtr->stateTrajectory_, mpcState);
 
-  mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(currentTime);
+  mode = activePrimalSolutionPtr->modeSchedule_.modeAtTime(currentTime);
 }
 
 /******************************************************************************************************/
@@ -127,13 +131,14 @@ void MRT_BASE::rolloutPolicy(scalar_t currentTime, const vector_t& currentState,
     throw std::runtime_error("[MRT_BASE::rolloutPolicy] rollout class is not set! Use initRollout() to initialize it!");
   }
 
-  if (activePrimalSolutionPtr_ == nullptr) {
+  const auto& activePrimalSolutionPtr = getActivePolicy().primalSolutionPtr;
+  if (activePrimalSolutionPtr == nullptr) {
     throw std::runtime_error("[MRT_BASE::rolloutPolicy] updatePolicy() should be called first!");
   }
 
-  if (currentTime > activePrimalSolutionPtr_->timeTrajectory_.back()) {
+  if (currentTime > activePrimalSolutionPtr->timeTrajectory_.back()) {
     std::cerr << "The requested currentTime is greater than the received plan: " << std::to_string(currentTime) << ">"
-              << std::to_string(activePrimalSolutionPtr_->timeTrajectory_.back()) << "\n";
+              << std::to_string(activePrimalSolutionPtr->timeTrajectory_.back()) << "\n";
   }
 
   // perform a rollout
@@ -141,42 +146,34 @@ void MRT_BASE::rolloutPolicy(scalar_t currentTime, const vector_t& currentState,
   size_array_t postEventIndicesStock;
   vector_array_t stateTrajectory, inputTrajectory;
   const scalar_t finalTime = currentTime + timeStep;
-  rolloutPtr_->run(currentTime, currentState, finalTime, activePrimalSolutionPtr_->controllerPtr_.get(),
-                   activePrimalSolutionPtr_->modeSchedule_, timeTrajectory, postEventIndicesStock, stateTrajectory, inputTrajectory);
+  rolloutPtr_->run(currentTime, currentState, finalTime, activePrimalSolutionPtr->controllerPtr_.get(),
+                   activePrimalSolutionPtr->modeSchedule_, timeTrajectory, postEventIndicesStock, stateTrajectory, inputTrajectory);
 
   mpcState = stateTrajectory.back();
   mpcInput = inputTrajectory.back();
 
-  mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(finalTime);
+  mode = activePrimalSolutionPtr->modeSchedule_.modeAtTime(finalTime);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 bool MRT_BASE::updatePolicy() {
-  std::unique_lock<std::mutex> lock(bufferMutex_, std::try_to_lock);
-  if (lock.owns_lock()) {
-    mrtTrylockWarningCount_ = 0;
-    if (newPolicyInBuffer_) {
-      // update the active solution from buffer
-      activeCommandPtr_.swap(bufferCommandPtr_);
-      activePrimalSolutionPtr_.swap(bufferPrimalSolutionPtr_);
-      activePerformanceIndicesPtr_.swap(bufferPerformanceIndicesPtr_);
-      newPolicyInBuffer_ = false;  // make sure we don't swap in the old policy again
-
-      modifyActiveSolution(*activeCommandPtr_, *activePrimalSolutionPtr_);
-      return true;
-    } else {
-      return false;  // No policy update: the buffer contains nothing new.
-    }
-  } else {
-    ++mrtTrylockWarningCount_;
-    if (mrtTrylockWarningCount_ > mrtTrylockWarningThreshold_) {
-      std::cerr << "[MRT_BASE::updatePolicy] failed to lock the policyBufferMutex for " << mrtTrylockWarningCount_
-                << " consecutive times.\n";
-    }
-    return false;  // No policy update: the lock could not be acquired.
+  // update the active solution from buffer (wait-free)
+  if (!policyBuffer_.updateFromBuffer()) {
+    return false;  // No policy update: the buffer contains nothing new.
   }
+
+  // A policy published before the last reset() is not activated. It stays in the read slot, where getActivePolicy() ignores it.
+  auto& activePolicy = policyBuffer_.get();
+  if (activePolicy.resetCount != resetCount_) {
+    return false;
+  }
+
+  controllerTimeIntervalHint_ = 0;
+  stateTimeIntervalHint_ = 0;
+  modifyActiveSolution(*activePolicy.commandPtr, *activePolicy.primalSolutionPtr);
+  return true;
 }
 
 /******************************************************************************************************/
@@ -196,17 +193,21 @@ void MRT_BASE::moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::un
     throw std::runtime_error("[MRT_BASE::moveToBuffer] performanceIndicesPtr cannot be a null pointer!");
   }
 
-  std::lock_guard<std::mutex> lk(bufferMutex_);
-  // use swap such that the old objects are destroyed after releasing the lock.
-  bufferCommandPtr_.swap(commandDataPtr);
-  bufferPrimalSolutionPtr_.swap(primalSolutionPtr);
-  bufferPerformanceIndicesPtr_.swap(performanceIndicesPtr);
+  // the policy is stamped with the reset count before being published, such that a concurrent reset() discards it
+  const size_t resetCount = resetCount_;
+
+  // The write slot holds an old policy which is released here, i.e. in this thread rather than in the thread calling updatePolicy().
+  auto& bufferPolicy = policyBuffer_.getWriteBuffer();
+  bufferPolicy.resetCount = resetCount;
+  bufferPolicy.commandPtr = std::move(commandDataPtr);
+  bufferPolicy.primalSolutionPtr = std::move(primalSolutionPtr);
+  bufferPolicy.performanceIndicesPtr = std::move(performanceIndicesPtr);
 
   // allow user to modify the buffer
-  modifyBufferedSolution(*bufferCommandPtr_, *bufferPrimalSolutionPtr_);
+  modifyBufferedSolution(*bufferPolicy.commandPtr, *bufferPolicy.primalSolutionPtr);
 
-  newPolicyInBuffer_ = true;
-  policyReceivedEver_ = true;
+  policyBuffer_.publish();
+  publishedResetCount_ = resetCount;
 }
 
 /******************************************************************************************************/
@@ -0,0 +1,170 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+// Eigen checks every dynamic allocation of the code in this file against Eigen::internal::set_is_malloc_allowed()
+#define EIGEN_RUNTIME_NO_MALLOC
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+#include "ocs2_mpc/MRT_BASE.h"
+
+using namespace ocs2;
+
+/*
+ * The libraries are compiled without EIGEN_RUNTIME_NO_MALLOC. To also catch the allocations done inside the libraries (Eigen, std
+ * containers, operator new), malloc is interposed and counted. Both Eigen and the default operator new allocate through malloc.
+ */
+extern "C" void* __libc_malloc(size_t size);
+
+namespace {
+std::atomic_bool countAllocations{false};
+std::atomic<size_t> numAllocations{0};
+
+/** MRT which receives the policies directly from the test */
+class TestMrt final : public MRT_BASE {
+ public:
+  void resetMpcNode(const TargetTrajectories& initTargetTrajectories) override {}
+  void setCurrentObservation(const SystemObservation& observation) override {}
+
+  void receivePolicy(std::unique_ptr<PrimalSolution> primalSolutionPtr) {
+    moveToBuffer(std::unique_ptr<CommandData>(new CommandData), std::move(primalSolutionPtr),
+                 std::unique_ptr<PerformanceIndex>(new PerformanceIndex));
+  }
+};
+}  // unnamed namespace
+
+extern "C" void* malloc(size_t size) {
+  if (countAllocations) {
+    ++numAllocations;
+  }
+  return __libc_malloc(size);
+}
+
+class MrtNoMallocTest : public ::testing::Test {
+ protected:
+  static constexpr size_t N = 50;
+  static constexpr int stateDim = 12;
+  static constexpr int inputDim = 6;
+
+  MrtNoMallocTest() : modeSchedule({0.3, 0.6}, {0, 1, 2}) {
+    for (size_t i = 0; i < N; i++) {
+      timeTrajectory.push_back(i / static_cast<scalar_t>(N - 1));
+      stateTrajectory.push_back(vector_t::Random(stateDim));
+      bias.push_back(vector_t::Random(inputDim));
+      gain.push_back(matrix_t::Random(inputDim, stateDim));
+    }
+    // repeated time stamp at an event
+    timeTrajectory[N / 2] = timeTrajectory[N / 2 - 1];
+
+    // monotonically increasing query times at 1kHz up to the end of the policy, including a restart to check the backward lookup
+    for (int k = 0; k <= 1000; k++) {
+      queryTimes.push_back(std::min(-0.01 + 1.01 * k / 1000.0, timeTrajectory.back()));
+    }
+    queryTimes.push_back(0.25);
+    queryTimes.push_back(0.75);
+  }
+
+  /** Sends the policy of the controller to an MRT, then activates and evaluates it through MRT_BASE */
+  void checkNoMalloc(std::unique_ptr<ControllerBase> controllerPtr) {
+    const vector_t x = vector_t::Random(stateDim);
+
+    // reference result with the allocating interface
+    std::vector<vector_t> expectedInputs, expectedStates;
+    for (const auto t : queryTimes) {
+      expectedInputs.push_back(controllerPtr->computeInput(t, x));
+      expectedStates.push_back(LinearInterpolation::interpolate(t, timeTrajectory, stateTrajectory));
+    }
+
+    std::unique_ptr<PrimalSolution> primalSolutionPtr(new PrimalSolution);
+    primalSolutionPtr->timeTrajectory_ = timeTrajectory;
+    primalSolutionPtr->stateTrajectory_ = stateTrajectory;
+    primalSolutionPtr->modeSchedule_ = modeSchedule;
+    primalSolutionPtr->controllerPtr_ = std::move(controllerPtr);
+
+    TestMrt mrt;
+    // warm-up with an earlier policy: allocates the outputs
+    vector_t mpcState, mpcInput;
+    size_t mode = 0;
+    mrt.receivePolicy(std::unique_ptr<PrimalSolution>(new PrimalSolution(*primalSolutionPtr)));
+    ASSERT_TRUE(mrt.updatePolicy());
+    mrt.evaluatePolicy(queryTimes.front(), x, mpcState, mpcInput, mode);
+    mrt.receivePolicy(std::move(primalSolutionPtr));
+
+    bool isCorrect = true;
+    Eigen::internal::set_is_malloc_allowed(false);
+    numAllocations = 0;
+    countAllocations = true;
+    const bool policyUpdated = mrt.updatePolicy();
+    for (size_t k = 0; k < queryTimes.size(); k++) {
+      mrt.evaluatePolicy(queryTimes[k], x, mpcState, mpcInput, mode);
+      isCorrect = isCorrect && mpcInput.isApprox(expectedInputs[k]) && mpcState.isApprox(expectedStates[k]);
+    }
+    countAllocations = false;
+    Eigen::internal::set_is_malloc_allowed(true);
+
+    EXPECT_TRUE(policyUpdated);
+    EXPECT_EQ(numAllocations, 0);
+    EXPECT_TRUE(isCorrect);
+    EXPECT_EQ(mode, modeSchedule.modeAtTime(queryTimes.back()));
+  }
+
+  scalar_array_t timeTrajectory;
+  vector_array_t stateTrajectory;
+  vector_array_t bias;
+  matrix_array_t gain;
+  ModeSchedule modeSchedule;
+  scalar_array_t queryTimes;
+};
+
+constexpr size_t MrtNoMallocTest::N;
+constexpr int MrtNoMallocTest::stateDim;
+constexpr int MrtNoMallocTest::inputDim;
+
+TEST_F(MrtNoMallocTest, linearController) {
+  checkNoMalloc(std::unique_ptr<ControllerBase>(new LinearController(timeTrajectory, bias, gain)));
+}
+
+TEST_F(MrtNoMallocTest, feedforwardController) {
+  checkNoMalloc(std::unique_ptr<ControllerBase>(new FeedforwardController(timeTrajectory, bias)));
+}
+
+TEST_F(MrtNoMallocTest, singleNode) {
+  timeTrajectory = {timeTrajectory.back()};
+  stateTrajectory = {stateTrajectory.front()};
+  checkNoMalloc(std::unique_ptr<ControllerBase>(new LinearController(timeTrajectory, {bias.front()}, {gain.front()})));
+}
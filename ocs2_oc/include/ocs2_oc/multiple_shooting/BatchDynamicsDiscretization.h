@@ -0,0 +1,87 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_oc/oc_data/TimeDiscretization.h"
+#include "ocs2_oc/oc_problem/OptimalControlProblem.h"
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+/**
+ * Linearizes and discretizes the dynamics of the intermediate nodes of a multiple shooting problem with
+ * SystemDynamicsBase::linearApproximationBatch, batchSize nodes per call. The Runge-Kutta discretizations are evaluated stage by stage:
+ * stage s is linearized for all nodes before stage s + 1, whose points depend on the flow maps of stage s. The batches, the stage
+ * points, and the stage linearizations are kept across calls.
+ */
+class BatchDynamicsDiscretization {
+ public:
+  /**
+   * Constructor
+   * @param integratorType : The sensitivity discretization of the intervals
+   * @param batchSize : The number of nodes per call of SystemDynamicsBase::linearApproximationBatch
+   */
+  BatchDynamicsDiscretization(SensitivityIntegratorType integratorType, size_t batchSize);
+
+  /**
+   * Discretizes the dynamics of all intermediate nodes.
+   *
+   * @param threadPool : The pool which linearizes the batches in parallel
+   * @param ocpDefinitions : One problem per worker of the pool, its dynamics linearize the batches of the worker
+   * @param time : The annotated time trajectory
+   * @param x : The state trajectory
+   * @param u : The input trajectory
+   */
+  void update(ThreadPool& threadPool, std::vector<OptimalControlProblem>& ocpDefinitions, const std::vector<AnnotatedTime>& time,
+              const vector_array_t& x, const vector_array_t& u);
+
+  /**
+   * Discretized dynamics of the intermediate node i of the last update in the form x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k},
+   * see DynamicsSensitivityDiscretizer.
+   */
+  const VectorFunctionLinearApproximation& getDiscreteDynamics(int i) const { return stageApproximations_.front()[i]; }
+
+ private:
+  SensitivityIntegratorType integratorType_;
+  size_t batchSize_;
+
+  size_t numBatches_ = 0;
+  std::vector<std::vector<size_t>> batches_;                                      // node indices of the batches
+  std::vector<scalar_array_t> stageTimes_;                                        // [stage][node]
+  std::vector<vector_array_t> stageStates_;                                       // [stage][node], stage 0 is at the node state
+  std::vector<std::vector<VectorFunctionLinearApproximation>> stageApproximations_;  // [stage][node]
+};
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
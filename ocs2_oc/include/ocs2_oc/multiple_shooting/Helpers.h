@@ -111,5 +111,15 @@ PrimalSolution toPrimalSolution(const std::vector<AnnotatedTime>& time, ModeSche
  */
 ProblemMetrics toProblemMetrics(const std::vector<AnnotatedTime>& time, std::vector<Metrics>&& metrics);
 
+/**
+ * Same as toProblemMetrics(time, metrics), but copies the metrics into the given ProblemMetrics. The memory of problemMetrics is reused,
+ * such that a persistent metrics array is not consumed and a persistent ProblemMetrics is not reallocated when the sizes do not change.
+ *
+ * @param [in] time : The annotated time trajectory
+ * @param [in] metrics: The metrics array.
+ * @param [out] problemMetrics: The ProblemMetrics.
+ */
+void toProblemMetrics(const std::vector<AnnotatedTime>& time, const std::vector<Metrics>& metrics, ProblemMetrics& problemMetrics);
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
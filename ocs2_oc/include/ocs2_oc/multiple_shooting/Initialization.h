@@ -94,5 +94,45 @@ void initializeStateInputTrajectories(const vector_t& initState, const std::vect
                                       const PrimalSolution& primalSolution, Initializer& initializer, vector_array_t& stateTrajectory,
                                       vector_array_t& inputTrajectory);
 
+/**
+ * The leading nodes of a time discretization which coincide with the nodes of a previous solution, see findHorizonShift().
+ * The node i < numSharedNodes coincides with the node (firstSharedNode + i) of the previous solution.
+ */
+struct HorizonShift {
+  int firstSharedNode = 0;
+  int numSharedNodes = 0;
+
+  /** Whether the time discretization is a time-shift of the previous one. */
+  bool isValid() const { return numSharedNodes > 1; }
+};
+
+/**
+ * Checks if a time discretization is a time-shift of the one of the previous solution, which is the case for a receding horizon that
+ * moved by a multiple of the discretization step. The nodes of both discretizations then coincide on the overlapping horizon, including
+ * the event nodes. The terminal nodes are not shared since their interval and constraints differ.
+ *
+ * @param [in] timeDiscretization : The annotated time trajectory
+ * @param [in] primalSolution : previous solution
+ * @param [in] tolerance : The tolerance on the time of the coinciding nodes
+ * @return The shared nodes, invalid if the time discretization is not a time-shift of the previous one.
+ */
+HorizonShift findHorizonShift(const std::vector<AnnotatedTime>& timeDiscretization, const PrimalSolution& primalSolution,
+                              scalar_t tolerance = 1e-6);
+
+/**
+ * Initializes the state-input trajectories by shifting the previous solution. The state and input of the shared nodes and intervals are
+ * copied verbatim, only the appended tail is initialized with the initializer.
+ *
+ * @param [in] horizonShift : The shared nodes, must be valid
+ * @param [in] timeDiscretization : The annotated time trajectory
+ * @param [in] primalSolution : previous solution
+ * @param [in] initializer : System initializer
+ * @param [out] stateTrajectory : The initialized state trajectory
+ * @param [out] inputTrajectory : The initialized input trajectory
+ */
+void shiftStateInputTrajectories(const HorizonShift& horizonShift, const std::vector<AnnotatedTime>& timeDiscretization,
+                                 const PrimalSolution& primalSolution, Initializer& initializer, vector_array_t& stateTrajectory,
+                                 vector_array_t& inputTrajectory);
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
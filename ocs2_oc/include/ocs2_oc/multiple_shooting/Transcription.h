@@ -78,6 +78,22 @@ struct Transcription {
 Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer,
                                     scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u);
 
+/**
+ * Compute the multiple shooting transcription for a single intermediate node from given discretized dynamics of the interval, e.g.
+ * computed for all nodes together with BatchDynamicsDiscretization.
+ *
+ * @param optimalControlProblem : Definition of the optimal control problem
+ * @param discreteDynamics : Linear approximation of the discretized dynamics, x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}.
+ * @param t : Start of the discrete interval
+ * @param dt : Duration of the interval
+ * @param x : State at start of the interval
+ * @param x_next : State at the end of the interval
+ * @param u : Input, taken to be constant across the interval.
+ * @return multiple shooting transcription for this node.
+ */
+Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem, const VectorFunctionLinearApproximation& discreteDynamics,
+                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u);
+
 /**
  * Apply the state-input equality constraint projection for a single intermediate node transcription.
  *
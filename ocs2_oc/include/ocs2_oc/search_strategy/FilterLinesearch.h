@@ -42,7 +42,7 @@ namespace ocs2 {
  * step acceptance criteria with c = costs, g = the norm of constraint violation, and w = [x; u]
  */
 struct FilterLinesearch {
-  enum class StepType { UNKNOWN, CONSTRAINT, DUAL, COST, ZERO };
+  enum class StepType { UNKNOWN, CONSTRAINT, DUAL, COST, ZERO, FULL };  // FULL: full step taken without linesearch
 
   scalar_t g_max = 1e6;          // (1): IF g{i+1} > g_max REQUIRE g{i+1} < (1-gamma_c) * g{i}
   scalar_t g_min = 1e-6;         // (2): ELSE IF (g{i} < g_min AND g{i+1} < g_min AND dc/dw'{i} * delta_w < 0) REQUIRE Armijo condition
@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <ocs2_core/Types.h>
+#include <ocs2_core/misc/Lookup.h>
 #include <ocs2_core/reference/ModeSchedule.h>
 
 namespace ocs2 {
@@ -122,12 +123,20 @@ class TrajectorySpreading final {
    * @return An array containing post event indices of the given event time.
    */
   size_array_t findPostEventIndices(const scalar_array_t& eventTimes, const scalar_array_t& timeTrajectory) const {
+    // the event times are sorted, hence each search starts from the interval of the previous event
+    int intervalHint = 0;
     size_array_t postEventIndices(eventTimes.size());
     for (std::size_t i = 0; i < eventTimes.size(); i++) {
       if (i == eventTimes.size() - 1 && eventTimes[i] == timeTrajectory.back()) {
         postEventIndices[i] = timeTrajectory.size() - 1;
       } else {
-        postEventIndices[i] = upperBoundIndex(timeTrajectory, eventTimes[i]);
+        intervalHint = lookup::findIntervalInTimeArray(timeTrajectory, eventTimes[i], intervalHint);
+        // same as upperBoundIndex: skip the time stamps which are equal to the event time
+        size_t postEventIndex = intervalHint + 1;
+        while (postEventIndex < timeTrajectory.size() && timeTrajectory[postEventIndex] <= eventTimes[i]) {
+          ++postEventIndex;
+        }
+        postEventIndices[i] = postEventIndex;
       }
     }
     return postEventIndices;
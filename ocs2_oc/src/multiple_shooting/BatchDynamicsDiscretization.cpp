@@ -0,0 +1,100 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/multiple_shooting/BatchDynamicsDiscretization.h"
+
+#include <algorithm>
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+BatchDynamicsDiscretization::BatchDynamicsDiscretization(SensitivityIntegratorType integratorType, size_t batchSize)
+    : integratorType_(integratorType), batchSize_(std::max<size_t>(batchSize, 1)) {}
+
+void BatchDynamicsDiscretization::update(ThreadPool& threadPool, std::vector<OptimalControlProblem>& ocpDefinitions,
+                                         const std::vector<AnnotatedTime>& time, const vector_array_t& x, const vector_array_t& u) {
+  const int N = static_cast<int>(time.size()) - 1;
+  const size_t numStages = sensitivity_integrator::getNumStages(integratorType_);
+
+  // Batches of intermediate nodes, the event nodes use the jump map
+  numBatches_ = 0;
+  for (int i = 0; i < N; i++) {
+    if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      continue;
+    }
+    if (numBatches_ == 0 || batches_[numBatches_ - 1].size() == batchSize_) {
+      if (batches_.size() == numBatches_) {
+        batches_.emplace_back();
+        batches_.back().reserve(batchSize_);
+      }
+      batches_[numBatches_++].clear();
+    }
+    batches_[numBatches_ - 1].push_back(i);
+  }
+
+  stageTimes_.resize(numStages);
+  stageStates_.resize(numStages);
+  stageApproximations_.resize(numStages);
+  for (size_t s = 0; s < numStages; s++) {
+    stageTimes_[s].resize(N);
+    stageStates_[s].resize(s > 0 ? N : 0);
+    stageApproximations_[s].resize(N);
+  }
+
+  for (size_t s = 0; s < numStages; s++) {
+    auto stageTask = [&](int workerId, int batch) {
+      const auto& nodes = batches_[batch];
+      for (const auto i : nodes) {
+        const scalar_t ti = getIntervalStart(time[i]);
+        if (s == 0) {
+          stageTimes_[0][i] = ti;
+        } else {
+          const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+          sensitivity_integrator::getStagePoint(integratorType_, s, ti, x[i], dt, stageApproximations_[s - 1][i].f, stageTimes_[s][i],
+                                                stageStates_[s][i]);
+        }
+      }
+
+      const vector_array_t& stageState = (s == 0) ? x : stageStates_[s];
+      ocpDefinitions[workerId].dynamicsPtr->linearApproximationBatch(stageTimes_[s], stageState, u, nodes, stageApproximations_[s]);
+
+      // All stages of the batch are available after the last one
+      if (s + 1 == numStages) {
+        for (const auto i : nodes) {
+          const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+          sensitivity_integrator::applyStageDiscretization(integratorType_, x[i], dt, stageApproximations_, i);
+        }
+      }
+    };
+    threadPool.parallelFor(0, static_cast<int>(numBatches_), 1, stageTask);
+  }
+}
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
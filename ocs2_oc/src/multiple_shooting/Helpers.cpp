@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/multiple_shooting/Helpers.h"
 
+#include <algorithm>
+
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/control/LinearController.h>
 
@@ -143,5 +145,30 @@ ProblemMetrics toProblemMetrics(const std::vector<AnnotatedTime>& time, std::vec
   return problemMetrics;
 }
 
+void toProblemMetrics(const std::vector<AnnotatedTime>& time, const std::vector<Metrics>& metrics, ProblemMetrics& problemMetrics) {
+  assert(time.size() > 1);
+  assert(metrics.size() == time.size());
+
+  // Problem horizon
+  const int N = static_cast<int>(time.size()) - 1;
+
+  // resize
+  const auto numPreJumps =
+      std::count_if(time.cbegin(), time.cbegin() + N, [](const AnnotatedTime& t) { return t.event == AnnotatedTime::Event::PreEvent; });
+  problemMetrics.preJumps.resize(numPreJumps);
+  problemMetrics.intermediates.resize(N - numPreJumps);
+  problemMetrics.final = metrics.back();
+
+  auto preJumpItr = problemMetrics.preJumps.begin();
+  auto intermediateItr = problemMetrics.intermediates.begin();
+  for (int i = 0; i < N; ++i) {
+    if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      *preJumpItr++ = metrics[i];
+    } else {
+      *intermediateItr++ = metrics[i];
+    }
+  }
+}
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
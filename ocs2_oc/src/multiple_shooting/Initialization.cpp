@@ -29,17 +29,33 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/multiple_shooting/Initialization.h"
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
 namespace ocs2 {
 namespace multiple_shooting {
 
+namespace {
+/** Reconstructs the event annotation of a node of a primal solution from its post-event indices. */
+AnnotatedTime::Event getNodeEvent(const size_array_t& postEventIndices, size_t index) {
+  if (std::binary_search(postEventIndices.cbegin(), postEventIndices.cend(), index)) {
+    return AnnotatedTime::Event::PostEvent;
+  } else if (std::binary_search(postEventIndices.cbegin(), postEventIndices.cend(), index + 1)) {
+    return AnnotatedTime::Event::PreEvent;
+  } else {
+    return AnnotatedTime::Event::None;
+  }
+}
+}  // unnamed namespace
+
 void initializeStateInputTrajectories(const vector_t& initState, const std::vector<AnnotatedTime>& timeDiscretization,
                                       const PrimalSolution& primalSolution, Initializer& initializer, vector_array_t& stateTrajectory,
                                       vector_array_t& inputTrajectory) {
   const int N = static_cast<int>(timeDiscretization.size()) - 1;  // // size of the input trajectory
-  stateTrajectory.clear();
-  stateTrajectory.reserve(N + 1);
-  inputTrajectory.clear();
-  inputTrajectory.reserve(N);
+  // the nodes are written in place, such that the memory of the given trajectories is reused if the sizes do not change
+  stateTrajectory.resize(N + 1);
+  inputTrajectory.resize(N);
 
   // Determine till when to use the previous solution
   scalar_t interpolateStateTill = timeDiscretization.front().time;
@@ -52,28 +68,102 @@ void initializeStateInputTrajectories(const vector_t& initState, const std::vect
   // Initial state
   const scalar_t initTime = getIntervalStart(timeDiscretization[0]);
   if (initTime < interpolateStateTill) {
-    stateTrajectory.push_back(LinearInterpolation::interpolate(initTime, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_));
+    LinearInterpolation::interpolate(initTime, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_, stateTrajectory[0]);
   } else {
-    stateTrajectory.push_back(initState);
+    stateTrajectory[0] = initState;
   }
 
   for (int i = 0; i < N; i++) {
     if (timeDiscretization[i].event == AnnotatedTime::Event::PreEvent) {
       // Event Node
-      inputTrajectory.push_back(vector_t());  // no input at event node
-      stateTrajectory.push_back(initializeEventNode(timeDiscretization[i].time, stateTrajectory.back()));
+      inputTrajectory[i].resize(0);  // no input at event node
+      stateTrajectory[i + 1] = initializeEventNode(timeDiscretization[i].time, stateTrajectory[i]);
     } else {
       // Intermediate node
       const scalar_t time = getIntervalStart(timeDiscretization[i]);
       const scalar_t nextTime = getIntervalEnd(timeDiscretization[i + 1]);
-      vector_t input, nextState;
       if (time > interpolateInputTill || nextTime > interpolateStateTill) {  // Using initializer
-        std::tie(input, nextState) = initializeIntermediateNode(initializer, time, nextTime, stateTrajectory.back());
+        initializer.compute(time, stateTrajectory[i], nextTime, inputTrajectory[i], stateTrajectory[i + 1]);
       } else {  // interpolate previous solution
-        std::tie(input, nextState) = initializeIntermediateNode(primalSolution, time, nextTime);
+        LinearInterpolation::interpolate(time, primalSolution.timeTrajectory_, primalSolution.inputTrajectory_, inputTrajectory[i]);
+        LinearInterpolation::interpolate(nextTime, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_, stateTrajectory[i + 1]);
       }
-      inputTrajectory.push_back(std::move(input));
-      stateTrajectory.push_back(std::move(nextState));
+    }
+  }
+}
+
+HorizonShift findHorizonShift(const std::vector<AnnotatedTime>& timeDiscretization, const PrimalSolution& primalSolution,
+                              scalar_t tolerance) {
+  const auto& previousTime = primalSolution.timeTrajectory_;
+  const int N = static_cast<int>(timeDiscretization.size()) - 1;
+  const int previousN = static_cast<int>(previousTime.size()) - 1;
+
+  auto coincide = [&](int i, int previousIndex) {
+    return std::abs(timeDiscretization[i].time - previousTime[previousIndex]) <= tolerance &&
+           timeDiscretization[i].event == getNodeEvent(primalSolution.postEventIndices_, previousIndex);
+  };
+
+  // Find the node of the previous solution which coincides with the first node, there are two nodes at the same time for events
+  const scalar_t initTime = timeDiscretization.front().time;
+  int firstSharedNode = std::lower_bound(previousTime.cbegin(), previousTime.cend(), initTime - tolerance) - previousTime.cbegin();
+  while (firstSharedNode < previousN && previousTime[firstSharedNode] <= initTime + tolerance && !coincide(0, firstSharedNode)) {
+    ++firstSharedNode;
+  }
+  if (firstSharedNode >= previousN || !coincide(0, firstSharedNode)) {
+    return {};
+  }
+
+  // The shared nodes, the terminal nodes are excluded
+  int numSharedNodes = 1;
+  while (numSharedNodes < N && firstSharedNode + numSharedNodes < previousN && coincide(numSharedNodes, firstSharedNode + numSharedNodes)) {
+    ++numSharedNodes;
+  }
+
+  // The discretizations have to coincide on the whole overlapping horizon
+  if (numSharedNodes < N && firstSharedNode + numSharedNodes < previousN) {
+    return {};
+  }
+
+  HorizonShift horizonShift;
+  horizonShift.firstSharedNode = firstSharedNode;
+  horizonShift.numSharedNodes = numSharedNodes;
+  return horizonShift;
+}
+
+void shiftStateInputTrajectories(const HorizonShift& horizonShift, const std::vector<AnnotatedTime>& timeDiscretization,
+                                 const PrimalSolution& primalSolution, Initializer& initializer, vector_array_t& stateTrajectory,
+                                 vector_array_t& inputTrajectory) {
+  assert(horizonShift.isValid());
+  const int N = static_cast<int>(timeDiscretization.size()) - 1;  // size of the input trajectory
+  // the nodes are written in place, such that the memory of the given trajectories is reused if the sizes do not change
+  stateTrajectory.resize(N + 1);
+  inputTrajectory.resize(N);
+
+  // Copy the shared nodes and the intervals between them
+  const int numSharedNodes = horizonShift.numSharedNodes;
+  for (int i = 0; i < numSharedNodes; i++) {
+    const int previousIndex = horizonShift.firstSharedNode + i;
+    stateTrajectory[i] = primalSolution.stateTrajectory_[previousIndex];
+    if (i + 1 < numSharedNodes) {
+      if (timeDiscretization[i].event == AnnotatedTime::Event::PreEvent) {
+        inputTrajectory[i].resize(0);  // no input at event node
+      } else {
+        inputTrajectory[i] = primalSolution.inputTrajectory_[previousIndex];
+      }
+    }
+  }
+
+  // Initialize the appended tail
+  for (int i = numSharedNodes - 1; i < N; i++) {
+    if (timeDiscretization[i].event == AnnotatedTime::Event::PreEvent) {
+      // Event Node
+      inputTrajectory[i].resize(0);  // no input at event node
+      stateTrajectory[i + 1] = initializeEventNode(timeDiscretization[i].time, stateTrajectory[i]);
+    } else {
+      // Intermediate node
+      const scalar_t time = getIntervalStart(timeDiscretization[i]);
+      const scalar_t nextTime = getIntervalEnd(timeDiscretization[i + 1]);
+      initializer.compute(time, stateTrajectory[i], nextTime, inputTrajectory[i], stateTrajectory[i + 1]);
     }
   }
 }
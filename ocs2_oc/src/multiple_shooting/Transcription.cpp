@@ -37,23 +37,21 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 namespace multiple_shooting {
 
-Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer,
-                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u) {
-  // Results and short-hand notation
-  Transcription transcription;
+namespace {
+
+/**
+ * Computes the cost and constraint terms of the transcription of an intermediate node.
+ */
+void setupIntermediateNodeCostAndConstraints(OptimalControlProblem& optimalControlProblem, scalar_t t, scalar_t dt, const vector_t& x,
+                                             const vector_t& u, Transcription& transcription) {
+  // Short-hand notation
   auto& cost = transcription.cost;
-  auto& dynamics = transcription.dynamics;
   auto& constraintsSize = transcription.constraintsSize;
   auto& stateEqConstraints = transcription.stateEqConstraints;
   auto& stateInputEqConstraints = transcription.stateInputEqConstraints;
   auto& stateIneqConstraints = transcription.stateIneqConstraints;
   auto& stateInputIneqConstraints = transcription.stateInputIneqConstraints;
 
-  // Dynamics
-  // Discretization returns x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
-  dynamics = sensitivityDiscretizer(*optimalControlProblem.dynamicsPtr, t, x, u, dt);
-  dynamics.f -= x_next;  // make it dx_{k+1} = ...
-
   // Precomputation for other terms
   constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Approximation;
   optimalControlProblem.preComputationPtr->request(request, t, x, u);
@@ -89,7 +87,34 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
     stateInputIneqConstraints =
         optimalControlProblem.inequalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr);
   }
+}
+
+}  // unnamed namespace
+
+Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer,
+                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u) {
+  Transcription transcription;
+
+  // Dynamics
+  // Discretization returns x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+  auto& dynamics = transcription.dynamics;
+  dynamics = sensitivityDiscretizer(*optimalControlProblem.dynamicsPtr, t, x, u, dt);
+  dynamics.f -= x_next;  // make it dx_{k+1} = ...
+
+  setupIntermediateNodeCostAndConstraints(optimalControlProblem, t, dt, x, u, transcription);
+  return transcription;
+}
+
+Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem, const VectorFunctionLinearApproximation& discreteDynamics,
+                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u) {
+  Transcription transcription;
+
+  // Dynamics
+  auto& dynamics = transcription.dynamics;
+  dynamics = discreteDynamics;
+  dynamics.f -= x_next;  // make it dx_{k+1} = ...
 
+  setupIntermediateNodeCostAndConstraints(optimalControlProblem, t, dt, x, u, transcription);
   return transcription;
 }
 
@@ -67,6 +67,8 @@ std::string toString(const FilterLinesearch::StepType& stepType) {
       return "Dual";
     case StepType::ZERO:
       return "Zero";
+    case StepType::FULL:
+      return "Full";
     case StepType::UNKNOWN:
     default:
       return "Unknown";
@@ -0,0 +1,128 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/initialization/DefaultInitializer.h>
+
+#include <ocs2_oc/multiple_shooting/Helpers.h>
+#include <ocs2_oc/multiple_shooting/Initialization.h>
+
+using namespace ocs2;
+
+namespace {
+constexpr int nx = 3;
+constexpr int nu = 2;
+constexpr scalar_t dt = 0.1;
+
+/** Creates a primal solution on the given discretization with a distinct state and input at each node */
+PrimalSolution getPrimalSolution(const std::vector<AnnotatedTime>& timeDiscretization) {
+  const int N = static_cast<int>(timeDiscretization.size()) - 1;
+  vector_array_t x(N + 1);
+  vector_array_t u(N);
+  for (int i = 0; i < N; i++) {
+    x[i] = vector_t::Constant(nx, timeDiscretization[i].time);
+    const bool isEventNode = timeDiscretization[i].event == AnnotatedTime::Event::PreEvent;
+    u[i] = isEventNode ? vector_t() : vector_t::Constant(nu, -timeDiscretization[i].time);
+  }
+  x[N] = vector_t::Constant(nx, timeDiscretization[N].time);
+  return multiple_shooting::toPrimalSolution(timeDiscretization, ModeSchedule(), std::move(x), std::move(u));
+}
+}  // unnamed namespace
+
+TEST(testInitialization, shift) {
+  const scalar_array_t eventTimes{0.55, 1.25};
+  const auto previousDiscretization = timeDiscretizationWithEvents(0.0, 1.0, dt, eventTimes);
+  const auto previousSolution = getPrimalSolution(previousDiscretization);
+
+  // the horizon moved by three steps, the second event is only in the new horizon
+  const auto timeDiscretization = timeDiscretizationWithEvents(0.3, 1.3, dt, eventTimes);
+  const auto horizonShift = multiple_shooting::findHorizonShift(timeDiscretization, previousSolution);
+  ASSERT_TRUE(horizonShift.isValid());
+  EXPECT_EQ(horizonShift.firstSharedNode, 3);
+  EXPECT_EQ(horizonShift.firstSharedNode + horizonShift.numSharedNodes, static_cast<int>(previousDiscretization.size()) - 1);
+
+  DefaultInitializer initializer(nu);
+  vector_array_t x, u;
+  multiple_shooting::shiftStateInputTrajectories(horizonShift, timeDiscretization, previousSolution, initializer, x, u);
+  ASSERT_EQ(x.size(), timeDiscretization.size());
+  ASSERT_EQ(u.size(), timeDiscretization.size() - 1);
+
+  // the shared nodes are copied
+  for (int i = 0; i < horizonShift.numSharedNodes; i++) {
+    const int previousIndex = horizonShift.firstSharedNode + i;
+    EXPECT_TRUE(x[i].isApprox(previousSolution.stateTrajectory_[previousIndex]));
+    if (i + 1 < horizonShift.numSharedNodes) {
+      if (timeDiscretization[i].event == AnnotatedTime::Event::PreEvent) {
+        EXPECT_EQ(u[i].size(), 0);
+      } else {
+        EXPECT_TRUE(u[i].isApprox(previousSolution.inputTrajectory_[previousIndex]));
+      }
+    }
+  }
+
+  // the tail is initialized by the initializer, which holds the state with zero input
+  const int lastSharedNode = horizonShift.numSharedNodes - 1;
+  for (size_t i = lastSharedNode; i < u.size(); i++) {
+    EXPECT_TRUE(x[i + 1].isApprox(x[lastSharedNode]));
+    if (timeDiscretization[i].event != AnnotatedTime::Event::PreEvent) {
+      EXPECT_TRUE(u[i].isZero());
+    }
+  }
+}
+
+TEST(testInitialization, shiftToEvent) {
+  const scalar_array_t eventTimes{0.55};
+  const auto previousDiscretization = timeDiscretizationWithEvents(0.35, 1.35, dt, eventTimes);
+  const auto previousSolution = getPrimalSolution(previousDiscretization);
+
+  // the new horizon starts at the event, its first node is the post-event node of the previous solution
+  const auto timeDiscretization = timeDiscretizationWithEvents(0.55, 1.55, dt, eventTimes);
+  const auto horizonShift = multiple_shooting::findHorizonShift(timeDiscretization, previousSolution);
+  ASSERT_TRUE(horizonShift.isValid());
+  EXPECT_EQ(previousDiscretization[horizonShift.firstSharedNode].event, AnnotatedTime::Event::PostEvent);
+}
+
+TEST(testInitialization, noShift) {
+  const scalar_array_t eventTimes{0.55};
+  const auto previousDiscretization = timeDiscretizationWithEvents(0.0, 1.0, dt, eventTimes);
+  const auto previousSolution = getPrimalSolution(previousDiscretization);
+
+  // the horizon moved by a fraction of the step
+  const auto shiftedByFraction = timeDiscretizationWithEvents(0.25, 1.25, dt, eventTimes);
+  EXPECT_FALSE(multiple_shooting::findHorizonShift(shiftedByFraction, previousSolution).isValid());
+
+  // the event moved
+  const auto eventMoved = timeDiscretizationWithEvents(0.3, 1.3, dt, {0.65});
+  EXPECT_FALSE(multiple_shooting::findHorizonShift(eventMoved, previousSolution).isValid());
+
+  // no overlap
+  const auto noOverlap = timeDiscretizationWithEvents(2.0, 3.0, dt, eventTimes);
+  EXPECT_FALSE(multiple_shooting::findHorizonShift(noOverlap, previousSolution).isValid());
+}
@@ -62,9 +62,11 @@ class PinocchioCentroidalDynamicsAD final {
    * @param [in] recompileLibraries : If true, the model library will be newly compiled. If false, an existing library will be loaded if
    *                                  available.
    * @param [in] verbose : print information.
+   * @param [in] batchKernels : If true, the model library also provides the batch kernels used by getLinearApproximationBatch.
    */
   PinocchioCentroidalDynamicsAD(const PinocchioInterface& pinocchioInterface, const CentroidalModelInfo& info, const std::string& modelName,
-                                const std::string& modelFolder = "/tmp/ocs2", bool recompileLibraries = true, bool verbose = false);
+                                const std::string& modelFolder = "/tmp/ocs2", bool recompileLibraries = true, bool verbose = false,
+                                bool batchKernels = false);
 
   /** Copy Constructor */
   PinocchioCentroidalDynamicsAD(const PinocchioCentroidalDynamicsAD& rhs);
@@ -89,11 +91,28 @@ class PinocchioCentroidalDynamicsAD final {
    */
   VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input) const;
 
+  /**
+   * Computes first order approximations of the system flow map at a batch of points. The points are evaluated together if the
+   * model library provides batch kernels, otherwise one by one. See SystemDynamicsBase::linearApproximationBatch.
+   *
+   * @param time: time trajectory
+   * @param state: system state trajectory
+   * @param input: system input trajectory
+   * @param indices: indices of the points of the batch in the trajectories
+   * @param [out] approximations: linear approximation of system flow map x_dot = f(x, u), only written at the batch indices
+   */
+  void getLinearApproximationBatch(const scalar_array_t& time, const vector_array_t& state, const vector_array_t& input,
+                                   const std::vector<size_t>& indices, std::vector<VectorFunctionLinearApproximation>& approximations) const;
+
  private:
   ad_vector_t getValueCppAd(PinocchioInterfaceCppAd& pinocchioInterfaceCppAd, const CentroidalModelPinocchioMappingCppAd& mapping,
                             const ad_vector_t& state, const ad_vector_t& input);
 
   std::unique_ptr<CppAdInterface> systemFlowMapCppAdInterfacePtr_;
+  // Packed points and outputs of getLinearApproximationBatch, kept across calls
+  mutable matrix_t batchStateInput_;
+  mutable matrix_t batchValues_;
+  mutable matrix_array_t batchJacobians_;
 };
 
 }  // namespace ocs2
@@ -36,6 +36,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <pinocchio/algorithm/centroidal-derivatives.hpp>
 #include <pinocchio/algorithm/centroidal.hpp>
 #include <pinocchio/algorithm/frames.hpp>
+#include <pinocchio/algorithm/jacobian.hpp>
 
 namespace ocs2 {
 
@@ -151,13 +152,21 @@ template <typename SCALAR_T>
 Eigen::Matrix<SCALAR_T, 3, Eigen::Dynamic> getTranslationalJacobianComToContactPointInWorldFrame(
     const PinocchioInterfaceTpl<SCALAR_T>& interface, const CentroidalModelInfoTpl<SCALAR_T>& info, size_t contactIndex) {
   const auto& model = interface.getModel();
-  auto data = interface.getData();
-  Eigen::Matrix<SCALAR_T, 6, Eigen::Dynamic> jacobianWorldToContactPointInWorldFrame;
-  jacobianWorldToContactPointInWorldFrame.setZero(6, info.generalizedCoordinatesNum);
-  pinocchio::getFrameJacobian(model, data, info.endEffectorFrameIndices[contactIndex], pinocchio::LOCAL_WORLD_ALIGNED,
-                              jacobianWorldToContactPointInWorldFrame);
-  Eigen::Matrix<SCALAR_T, 3, Eigen::Dynamic> J_com = getCentroidalMomentumMatrix(interface).template topRows<3>() / info.robotMass;
-  return (jacobianWorldToContactPointInWorldFrame.template topRows<3>() - J_com);
+  const auto& data = interface.getData();
+  const auto frameIndex = info.endEffectorFrameIndices[contactIndex];
+  const auto jointIndex = model.frames[frameIndex].parent;
+
+  // Shift the Jacobian of the parent joint to the contact point. Unlike getFrameJacobian(), this does not require a copy of data.
+  Eigen::Matrix<SCALAR_T, 6, Eigen::Dynamic> jacobianWorldToJointInWorldFrame;
+  jacobianWorldToJointInWorldFrame.setZero(6, info.generalizedCoordinatesNum);
+  pinocchio::getJointJacobian(model, data, jointIndex, pinocchio::LOCAL_WORLD_ALIGNED, jacobianWorldToJointInWorldFrame);
+  const Eigen::Matrix<SCALAR_T, 3, 1> positionJointToContactPointInWorldFrame =
+      data.oMf[frameIndex].translation() - data.oMi[jointIndex].translation();
+
+  Eigen::Matrix<SCALAR_T, 3, Eigen::Dynamic> J = jacobianWorldToJointInWorldFrame.template topRows<3>();
+  J.noalias() -= skewSymmetricMatrix(positionJointToContactPointInWorldFrame) * jacobianWorldToJointInWorldFrame.template bottomRows<3>();
+  J -= getCentroidalMomentumMatrix(interface).template topRows<3>() / info.robotMass;
+  return J;
 }
 
 /******************************************************************************************************/
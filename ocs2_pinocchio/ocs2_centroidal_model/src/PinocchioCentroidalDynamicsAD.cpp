@@ -39,7 +39,7 @@ namespace ocs2 {
 /******************************************************************************************************/
 PinocchioCentroidalDynamicsAD::PinocchioCentroidalDynamicsAD(const PinocchioInterface& pinocchioInterface, const CentroidalModelInfo& info,
                                                              const std::string& modelName, const std::string& modelFolder,
-                                                             bool recompileLibraries, bool verbose) {
+                                                             bool recompileLibraries, bool verbose, bool batchKernels) {
   auto systemFlowMapFunc = [&](const ad_vector_t& x, ad_vector_t& y) {
     // initialize CppAD interface
     auto pinocchioInterfaceCppAd = pinocchioInterface.toCppAd();
@@ -55,6 +55,7 @@ PinocchioCentroidalDynamicsAD::PinocchioCentroidalDynamicsAD(const PinocchioInte
 
   systemFlowMapCppAdInterfacePtr_.reset(
       new CppAdInterface(systemFlowMapFunc, info.stateDim + info.inputDim, modelName + "_systemFlowMap", modelFolder));
+  systemFlowMapCppAdInterfacePtr_->setBatchKernels(batchKernels);
 
   if (recompileLibraries) {
     systemFlowMapCppAdInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
@@ -115,4 +116,34 @@ VectorFunctionLinearApproximation PinocchioCentroidalDynamicsAD::getLinearApprox
   return approx;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioCentroidalDynamicsAD::getLinearApproximationBatch(const scalar_array_t& time, const vector_array_t& state,
+                                                                const vector_array_t& input, const std::vector<size_t>& indices,
+                                                                std::vector<VectorFunctionLinearApproximation>& approximations) const {
+  const size_t numPoints = indices.size();
+  if (numPoints == 0) {
+    return;
+  }
+
+  const auto stateDim = state[indices.front()].rows();
+  const auto inputDim = input[indices.front()].rows();
+  batchStateInput_.resize(stateDim + inputDim, numPoints);
+  for (size_t k = 0; k < numPoints; k++) {
+    batchStateInput_.col(k) << state[indices[k]], input[indices[k]];
+  }
+
+  const matrix_t noParameters(0, numPoints);
+  systemFlowMapCppAdInterfacePtr_->getFunctionValueBatch(batchStateInput_, noParameters, batchValues_);
+  systemFlowMapCppAdInterfacePtr_->getJacobianBatch(batchStateInput_, noParameters, batchJacobians_);
+
+  for (size_t k = 0; k < numPoints; k++) {
+    auto& approximation = approximations[indices[k]];
+    approximation.f = batchValues_.col(k);
+    approximation.dfdx = batchJacobians_[k].leftCols(stateDim);
+    approximation.dfdu = batchJacobians_[k].rightCols(inputDim);
+  }
+}
+
 }  // namespace ocs2
@@ -46,6 +46,9 @@ enum anymal : size_t {
 
 static const std::vector<std::string> anymal3DofContactNames = {"LF_FOOT", "RF_FOOT", "LH_FOOT", "RH_FOOT"};
 static const std::vector<std::string> anymal6DofContactNames = {};
+// the hind feet as six-DoF contacts, such that the contact wrenches follow the contact forces in the input
+static const std::vector<std::string> anymalMixed3DofContactNames = {"LF_FOOT", "RF_FOOT"};
+static const std::vector<std::string> anymalMixed6DofContactNames = {"LH_FOOT", "RH_FOOT"};
 static const std::string anymalUrdfFile = ocs2::robotic_assets::getPath() + "/resources/anymal_c/urdf/anymal.urdf";
 
 inline ocs2::vector_t getInitialState() {
@@ -51,11 +51,12 @@ class TestAnymalCentroidalModel : public ::testing::TestWithParam<CentroidalMode
     pinocchioInterfacePtr.reset(new PinocchioInterface(createPinocchioInterface(anymalUrdfFile)));
   }
 
-  CentroidalModelInfo createInfo(CentroidalModelType type) const {
+  CentroidalModelInfo createInfo(CentroidalModelType type, const std::vector<std::string>& threeDofContactNames = anymal3DofContactNames,
+                                 const std::vector<std::string>& sixDofContactNames = anymal6DofContactNames) const {
     const size_t nq = pinocchioInterfacePtr->getModel().nq;
     const size_t numJoints = nq - 6;
-    return createCentroidalModelInfo(*pinocchioInterfacePtr, type, getInitialState().tail(numJoints), anymal3DofContactNames,
-                                     anymal6DofContactNames);
+    return createCentroidalModelInfo(*pinocchioInterfacePtr, type, getInitialState().tail(numJoints), threeDofContactNames,
+                                     sixDofContactNames);
   }
 
   std::unique_ptr<CentroidalModelPinocchioMapping> createMapping(CentroidalModelType type) const {
@@ -123,6 +124,51 @@ TEST_P(TestAnymalCentroidalModel, dynamis_flowMap) {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_P(TestAnymalCentroidalModel, dynamics_flowMap_sixDofContacts) {
+  const CentroidalModelType type = GetParam();
+  const auto info = createInfo(type, anymalMixed3DofContactNames, anymalMixed6DofContactNames);
+  ASSERT_EQ(info.numThreeDofContacts, anymalMixed3DofContactNames.size());
+  ASSERT_EQ(info.numSixDofContacts, anymalMixed6DofContactNames.size());
+  ASSERT_GT(info.numSixDofContacts, 0u);
+
+  CentroidalModelPinocchioMapping mapping(info);
+  mapping.setPinocchioInterface(*pinocchioInterfacePtr);
+
+  // Analytical model
+  PinocchioCentroidalDynamics anymalDynamics(info);
+  anymalDynamics.setPinocchioInterface(*pinocchioInterfacePtr);
+
+  // CppAD model
+  const std::string modelName = "TestAnymal" + toString(type) + "SixDofContactsAd";
+  PinocchioCentroidalDynamicsAD anymalDynamicsAd(*pinocchioInterfacePtr, info, modelName);
+
+  for (size_t i = 0; i < numTests; i++) {
+    const scalar_t time = 0.0;
+    const vector_t state = 10.0 * vector_t::Random(info.stateDim);
+    const vector_t input = 10000.0 * vector_t::Random(info.inputDim);
+
+    const vector_t qPinocchio = mapping.getPinocchioJointPosition(state);
+    updateCentroidalDynamics(*pinocchioInterfacePtr, info, qPinocchio);
+
+    const auto stateDerivative = anymalDynamics.getValue(time, state, input);
+    const auto stateDerivativeAd = anymalDynamicsAd.getValue(time, state, input);
+
+    const vector_t vPinocchio = mapping.getPinocchioJointVelocity(state, input);
+    updateCentroidalDynamicsDerivatives(*pinocchioInterfacePtr, info, qPinocchio, vPinocchio);
+
+    const auto linearApproximation = anymalDynamics.getLinearApproximation(time, state, input);
+    const auto linearApproximationAd = anymalDynamicsAd.getLinearApproximation(time, state, input);
+
+    EXPECT_TRUE(stateDerivative.isApprox(stateDerivativeAd, tol));
+    EXPECT_TRUE(linearApproximationAd.f.isApprox(linearApproximation.f, tol));
+    EXPECT_TRUE(linearApproximationAd.dfdx.isApprox(linearApproximation.dfdx, tol));
+    EXPECT_TRUE(linearApproximationAd.dfdu.isApprox(linearApproximation.dfdu, tol));
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -0,0 +1,109 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include <ocs2_core/PreComputation.h>
+
+#include <ocs2_pinocchio_interface/PinocchioInterface.h>
+#include <ocs2_pinocchio_interface/PinocchioStateInputMapping.h>
+
+namespace ocs2 {
+
+/**
+ * Pre-computation of the pinocchio kinematics shared by the pinocchio-based cost and constraint terms, e.g.
+ * PinocchioEndEffectorKinematics or PinocchioSphereKinematics.
+ *
+ * On requests of the cost, constraint, or soft constraint terms, the data is updated with:
+ *   pinocchio::forwardKinematics(model, data, q)
+ *   pinocchio::updateFramePlacements(model, data)
+ * and additionally on requests of the approximation with:
+ *   pinocchio::computeJointJacobians(model, data, q)
+ *
+ * Each algorithm is computed at most once per configuration q, so repeated requests at the same node, e.g. of the approximation
+ * and of the metrics, only update what is missing. Derived classes can cache their own algorithms with setConfiguration(),
+ * isUpdated() and setUpdated(). The data must only be modified through this class, otherwise the cache is stale.
+ */
+class PinocchioPreComputation : public PreComputation {
+ public:
+  /** Pinocchio algorithms cached for the current configuration. Derived classes can define flags starting from CustomAlgorithm. */
+  enum Algorithm : unsigned {
+    ForwardKinematics = 1u << 0,  // pinocchio::forwardKinematics and pinocchio::updateFramePlacements
+    JointJacobians = 1u << 1,     // pinocchio::computeJointJacobians
+    CustomAlgorithm = 1u << 2,
+  };
+
+  /**
+   * Constructor
+   * @param [in] pinocchioInterface : The pinocchio interface, internally keeps a copy.
+   * @param [in] mapping : Mapping from the OCS2 state to the pinocchio configuration.
+   */
+  PinocchioPreComputation(PinocchioInterface pinocchioInterface, const PinocchioStateInputMapping<scalar_t>& mapping);
+
+  ~PinocchioPreComputation() override = default;
+  PinocchioPreComputation* clone() const override { return new PinocchioPreComputation(*this); }
+
+  void request(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) override;
+  void requestPreJump(RequestSet request, scalar_t t, const vector_t& x) override;
+  void requestFinal(RequestSet request, scalar_t t, const vector_t& x) override;
+
+  PinocchioInterface& getPinocchioInterface() { return pinocchioInterface_; }
+  const PinocchioInterface& getPinocchioInterface() const { return pinocchioInterface_; }
+  const PinocchioStateInputMapping<scalar_t>& getPinocchioMapping() const { return *mappingPtr_; }
+
+ protected:
+  PinocchioPreComputation(const PinocchioPreComputation& rhs);
+
+  /**
+   * Updates the kinematics of the terms, the algorithms that are already up to date for q are skipped.
+   * @param [in] q : The pinocchio configuration.
+   * @param [in] computeJacobians : Whether the joint Jacobians are required.
+   */
+  void updateKinematics(const vector_t& q, bool computeJacobians);
+
+  /** Sets the configuration of the cached algorithms. The cache is cleared if q differs from the current configuration. */
+  void setConfiguration(const vector_t& q);
+
+  /** Whether all the given algorithms are up to date for the current configuration. */
+  bool isUpdated(unsigned algorithms) const { return (updatedAlgorithms_ & algorithms) == algorithms; }
+
+  /** Marks algorithms as up to date for the current configuration. */
+  void setUpdated(unsigned algorithms) { updatedAlgorithms_ |= algorithms; }
+
+ private:
+  PinocchioInterface pinocchioInterface_;
+  std::unique_ptr<PinocchioStateInputMapping<scalar_t>> mappingPtr_;
+
+  vector_t configuration_;
+  unsigned updatedAlgorithms_ = 0;
+};
+
+}  // namespace ocs2
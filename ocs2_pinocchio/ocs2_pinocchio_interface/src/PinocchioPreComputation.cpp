@@ -0,0 +1,119 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>  // forward declarations must be included first.
+
+#include "ocs2_pinocchio_interface/PinocchioPreComputation.h"
+
+#include <pinocchio/algorithm/frames.hpp>
+#include <pinocchio/algorithm/jacobian.hpp>
+#include <pinocchio/algorithm/kinematics.hpp>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PinocchioPreComputation::PinocchioPreComputation(PinocchioInterface pinocchioInterface, const PinocchioStateInputMapping<scalar_t>& mapping)
+    : pinocchioInterface_(std::move(pinocchioInterface)), mappingPtr_(mapping.clone()) {
+  mappingPtr_->setPinocchioInterface(pinocchioInterface_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PinocchioPreComputation::PinocchioPreComputation(const PinocchioPreComputation& rhs)
+    : PreComputation(rhs),
+      pinocchioInterface_(rhs.pinocchioInterface_),
+      mappingPtr_(rhs.mappingPtr_->clone()),
+      configuration_(rhs.configuration_),
+      updatedAlgorithms_(rhs.updatedAlgorithms_) {
+  mappingPtr_->setPinocchioInterface(pinocchioInterface_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioPreComputation::request(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) {
+  if (request.containsAny(Request::Cost + Request::Constraint + Request::SoftConstraint)) {
+    updateKinematics(mappingPtr_->getPinocchioJointPosition(x), request.contains(Request::Approximation));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioPreComputation::requestPreJump(RequestSet request, scalar_t t, const vector_t& x) {
+  if (request.containsAny(Request::Cost + Request::Constraint + Request::SoftConstraint)) {
+    updateKinematics(mappingPtr_->getPinocchioJointPosition(x), request.contains(Request::Approximation));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioPreComputation::requestFinal(RequestSet request, scalar_t t, const vector_t& x) {
+  if (request.containsAny(Request::Cost + Request::Constraint + Request::SoftConstraint)) {
+    updateKinematics(mappingPtr_->getPinocchioJointPosition(x), request.contains(Request::Approximation));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioPreComputation::updateKinematics(const vector_t& q, bool computeJacobians) {
+  const auto& model = pinocchioInterface_.getModel();
+  auto& data = pinocchioInterface_.getData();
+
+  setConfiguration(q);
+  if (computeJacobians && !isUpdated(JointJacobians)) {
+    // also computes the joint placements of the forward kinematics
+    pinocchio::computeJointJacobians(model, data, q);
+    if (!isUpdated(ForwardKinematics)) {
+      pinocchio::updateFramePlacements(model, data);
+    }
+    setUpdated(ForwardKinematics | JointJacobians);
+  } else if (!isUpdated(ForwardKinematics)) {
+    pinocchio::forwardKinematics(model, data, q);
+    pinocchio::updateFramePlacements(model, data);
+    setUpdated(ForwardKinematics);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioPreComputation::setConfiguration(const vector_t& q) {
+  if (configuration_.size() != q.size() || configuration_ != q) {
+    configuration_ = q;
+    updatedAlgorithms_ = 0;
+  }
+}
+
+}  // namespace ocs2
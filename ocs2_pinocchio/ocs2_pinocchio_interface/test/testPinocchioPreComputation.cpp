@@ -0,0 +1,138 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+#include <pinocchio/fwd.hpp>
+
+#include <pinocchio/algorithm/frames.hpp>
+#include <pinocchio/algorithm/jacobian.hpp>
+#include <pinocchio/algorithm/kinematics.hpp>
+
+#include <ocs2_pinocchio_interface/PinocchioPreComputation.h>
+#include <ocs2_pinocchio_interface/urdf.h>
+
+#include <gtest/gtest.h>
+
+#include "ManipulatorArmUrdf.h"
+
+namespace {
+
+class IdentityMapping final : public ocs2::PinocchioStateInputMapping<ocs2::scalar_t> {
+ public:
+  IdentityMapping() = default;
+  ~IdentityMapping() override = default;
+  IdentityMapping* clone() const override { return new IdentityMapping(*this); }
+
+  ocs2::vector_t getPinocchioJointPosition(const ocs2::vector_t& state) const override { return state; }
+
+  ocs2::vector_t getPinocchioJointVelocity(const ocs2::vector_t& state, const ocs2::vector_t& input) const override { return input; }
+
+  std::pair<ocs2::matrix_t, ocs2::matrix_t> getOcs2Jacobian(const ocs2::vector_t& state, const ocs2::matrix_t& Jq,
+                                                            const ocs2::matrix_t& Jv) const override {
+    return {Jq, Jv};
+  }
+};
+
+}  // unnamed namespace
+
+class TestPinocchioPreComputation : public ::testing::Test {
+ public:
+  TestPinocchioPreComputation()
+      : pinocchioInterface(ocs2::getPinocchioInterfaceFromUrdfString(manipulatorArmUrdf)),
+        preComputation(pinocchioInterface, IdentityMapping()) {
+    x.resize(6);
+    x << 2.5, -1.0, 1.5, 0.0, 1.0, 0.0;
+    u.setOnes(6);
+    frameId = pinocchioInterface.getModel().getFrameId("WRIST_2");
+  }
+
+  ocs2::vector_t x;  // state
+  ocs2::vector_t u;  // input
+  pinocchio::FrameIndex frameId;
+
+  ocs2::PinocchioInterface pinocchioInterface;  // reference
+  ocs2::PinocchioPreComputation preComputation;
+};
+
+TEST_F(TestPinocchioPreComputation, kinematics) {
+  const auto& model = pinocchioInterface.getModel();
+  auto& data = pinocchioInterface.getData();
+  pinocchio::forwardKinematics(model, data, x);
+  pinocchio::updateFramePlacements(model, data);
+  pinocchio::computeJointJacobians(model, data, x);
+
+  ocs2::matrix_t J = ocs2::matrix_t::Zero(6, model.nv);
+  pinocchio::getFrameJacobian(model, data, frameId, pinocchio::LOCAL_WORLD_ALIGNED, J);
+
+  preComputation.request(ocs2::Request::Cost + ocs2::Request::Approximation, 0.0, x, u);
+  const auto& preCompModel = preComputation.getPinocchioInterface().getModel();
+  auto& preCompData = preComputation.getPinocchioInterface().getData();
+  ocs2::matrix_t preCompJ = ocs2::matrix_t::Zero(6, model.nv);
+  pinocchio::getFrameJacobian(preCompModel, preCompData, frameId, pinocchio::LOCAL_WORLD_ALIGNED, preCompJ);
+
+  EXPECT_TRUE(preCompData.oMf[frameId].isApprox(data.oMf[frameId]));
+  EXPECT_TRUE(preCompJ.isApprox(J));
+}
+
+TEST_F(TestPinocchioPreComputation, dynamicsRequest) {
+  const auto& data = preComputation.getPinocchioInterface().getData();
+  const pinocchio::SE3 initialPlacement = data.oMf[frameId];
+
+  // the kinematics are only required by the terms
+  preComputation.request(ocs2::Request::Dynamics + ocs2::Request::Approximation, 0.0, x, u);
+  EXPECT_TRUE(data.oMf[frameId].isApprox(initialPlacement));
+
+  preComputation.requestFinal(ocs2::Request::Cost, 0.0, x);
+  EXPECT_FALSE(data.oMf[frameId].isApprox(initialPlacement));
+}
+
+TEST_F(TestPinocchioPreComputation, memoization) {
+  auto& data = preComputation.getPinocchioInterface().getData();
+
+  preComputation.request(ocs2::Request::Cost + ocs2::Request::Approximation, 0.0, x, u);
+  const pinocchio::SE3 placement = data.oMf[frameId];
+
+  // the data is not updated again for the same configuration
+  data.oMf[frameId].setIdentity();
+  preComputation.request(ocs2::Request::Constraint + ocs2::Request::Approximation, 0.0, x, u);
+  preComputation.requestPreJump(ocs2::Request::SoftConstraint, 0.0, x);
+  EXPECT_TRUE(data.oMf[frameId].isIdentity());
+
+  // a new configuration updates the data
+  const ocs2::vector_t xNew = x + ocs2::vector_t::Constant(x.size(), 0.1);
+  preComputation.request(ocs2::Request::Cost, 0.0, xNew, u);
+  EXPECT_FALSE(data.oMf[frameId].isIdentity());
+  EXPECT_FALSE(data.oMf[frameId].isApprox(placement));
+
+  // the cache is copied along with the data
+  preComputation.request(ocs2::Request::Cost, 0.0, x, u);
+  std::unique_ptr<ocs2::PinocchioPreComputation> clonePtr(preComputation.clone());
+  clonePtr->getPinocchioInterface().getData().oMf[frameId].setIdentity();
+  clonePtr->request(ocs2::Request::Cost, 0.0, x, u);
+  EXPECT_TRUE(clonePtr->getPinocchioInterface().getData().oMf[frameId].isIdentity());
+  EXPECT_TRUE(data.oMf[frameId].isApprox(placement));
+}
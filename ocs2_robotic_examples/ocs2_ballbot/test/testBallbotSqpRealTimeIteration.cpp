@@ -0,0 +1,148 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <memory>
+#include <random>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_oc/rollout/RolloutBase.h>
+#include <ocs2_sqp/SqpMpc.h>
+
+#include <ocs2_ballbot/BallbotInterface.h>
+#include <ocs2_ballbot/package_path.h>
+
+using namespace ocs2;
+using namespace ballbot;
+
+namespace {
+
+struct ClosedLoopResult {
+  benchmark::RepeatedTimer latencyTimer;      // from the state to the policy, i.e. MPC_BASE::run()
+  benchmark::RepeatedTimer preparationTimer;  // MPC_BASE::prepare()
+  size_t numRuns = 0;
+  size_t numRealTimeIterations = 0;  // runs which only did the feedback phase
+  vector_t finalState;
+};
+
+/**
+ * Runs the SQP MPC in closed loop with the rollout of the ballbot. The ballbot has to move 1 meter along the x-axis.
+ * The MPC is called every 1 / mpcDesiredFrequency seconds, with a uniformly distributed offset of up to timeJitter seconds.
+ */
+ClosedLoopResult runClosedLoop(bool realTimeIteration, scalar_t timeJitter = 0.0) {
+  const std::string taskFile = ballbot::getPath() + "/config/mpc/task.info";
+  const std::string libFolder = ballbot::getPath() + "/auto_generated";
+  BallbotInterface interface(taskFile, libFolder);
+
+  auto sqpSettings = interface.sqpSettings();
+  sqpSettings.realTimeIteration = realTimeIteration;
+  sqpSettings.printSolverStatistics = false;
+  sqpSettings.enableLogging = false;
+  SqpMpc mpc(interface.mpcSettings(), std::move(sqpSettings), interface.getOptimalControlProblem(), interface.getInitializer());
+  mpc.getSolverPtr()->setReferenceManager(interface.getReferenceManagerPtr());
+  std::unique_ptr<RolloutBase> rolloutPtr(interface.getRollout().clone());
+
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 5.0;
+  const scalar_t mpcPeriod = 1.0 / interface.mpcSettings().mpcDesiredFrequency_;
+
+  vector_t goalState = vector_t::Zero(STATE_DIM);
+  goalState(0) = 1.0;
+  interface.getReferenceManagerPtr()->setTargetTrajectories(TargetTrajectories({initTime}, {goalState}, {vector_t::Zero(INPUT_DIM)}));
+
+  std::mt19937 randomGenerator(0);
+  std::uniform_real_distribution<scalar_t> jitterDistribution(-timeJitter, timeJitter);
+
+  ClosedLoopResult result;
+  scalar_t time = initTime;
+  vector_t state = vector_t::Zero(STATE_DIM);
+  PrimalSolution policy;
+  while (time < finalTime) {
+    result.latencyTimer.startTimer();
+    mpc.run(time, state);
+    result.latencyTimer.endTimer();
+    mpc.getSolverPtr()->getPrimalSolution(time + mpcPeriod, &policy);
+
+    result.preparationTimer.startTimer();
+    mpc.prepare();
+    result.preparationTimer.endTimer();
+
+    // apply the policy until the next MPC call
+    const scalar_t nextTime = time + mpcPeriod + jitterDistribution(randomGenerator);
+    scalar_array_t timeTrajectory;
+    size_array_t postEventIndices;
+    vector_array_t stateTrajectory;
+    vector_array_t inputTrajectory;
+    state = rolloutPtr->run(time, state, nextTime, policy.controllerPtr_.get(), policy.modeSchedule_, timeTrajectory, postEventIndices,
+                            stateTrajectory, inputTrajectory);
+    time = nextTime;
+  }
+
+  result.numRuns = result.latencyTimer.getNumTimedIntervals();
+  result.numRealTimeIterations = mpc.getSolverPtr()->getNumRealTimeIterations();
+  result.finalState = std::move(state);
+  return result;
+}
+
+void printResult(const std::string& name, const ClosedLoopResult& result) {
+  std::cout << name << "\n"
+            << "\tLatency     : " << result.latencyTimer.getAverageInMilliseconds() << " [ms] average, "
+            << result.latencyTimer.getMaxIntervalInMilliseconds() << " [ms] max\n"
+            << "\tPreparation : " << result.preparationTimer.getAverageInMilliseconds() << " [ms] average\n"
+            << "\tFinal state : " << result.finalState.transpose() << "\n";
+}
+
+}  // unnamed namespace
+
+TEST(BallbotSqpRealTimeIteration, closedLoop) {
+  const auto sqpResult = runClosedLoop(false);
+  const auto rtiResult = runClosedLoop(true);
+  printResult("SQP", sqpResult);
+  printResult("SQP-RTI", rtiResult);
+
+  // without RTI every run is a full SQP. With RTI, all runs after the first one are prepared and only do the feedback phase
+  EXPECT_EQ(sqpResult.numRealTimeIterations, 0u);
+  EXPECT_EQ(rtiResult.numRealTimeIterations, rtiResult.numRuns - 1);
+
+  // both reach the goal within 10 cm
+  EXPECT_NEAR(sqpResult.finalState(0), 1.0, 0.1);
+  EXPECT_NEAR(rtiResult.finalState(0), 1.0, 0.1);
+}
+
+TEST(BallbotSqpRealTimeIteration, closedLoopWithJitter) {
+  // the calls miss the predicted time by up to 40% of the MPC period, which is less than the discretization step of the SQP
+  const auto rtiResult = runClosedLoop(true, 0.004);
+  printResult("SQP-RTI with jitter", rtiResult);
+
+  // the prepared QP is re-timed to the actual call time instead of being discarded
+  EXPECT_GT(rtiResult.numRealTimeIterations, 0u);
+  EXPECT_NEAR(rtiResult.finalState(0), 1.0, 0.1);
+}
@@ -0,0 +1,179 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <iostream>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_ddp/riccati_equations/DiscreteTimeRiccatiEquations.h>
+#include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
+
+#include "ocs2_cartpole/CartPoleInterface.h"
+#include "ocs2_cartpole/package_path.h"
+
+using namespace ocs2;
+using namespace cartpole;
+
+class TestCartpoleFixedSizeKernels : public testing::Test {
+ protected:
+  static constexpr size_t numNodes = 100;
+  static constexpr scalar_t dt = 0.02;
+
+  TestCartpoleFixedSizeKernels() {
+    const std::string taskFile = ocs2::cartpole::getPath() + "/config/mpc/task.info";
+    const std::string libFolder = ocs2::cartpole::getPath() + "/auto_generated";
+    cartPoleInterfacePtr.reset(new CartPoleInterface(taskFile, libFolder, false /*verbose*/));
+
+    auto& problem = cartPoleInterfacePtr->optimalControlProblem();
+    targetTrajectories = TargetTrajectories({0.0}, {cartPoleInterfacePtr->getInitialTarget()}, {vector_t::Zero(INPUT_DIM)});
+    problem.targetTrajectoriesPtr = &targetTrajectories;
+
+    // discrete-time LQ approximation along a random trajectory
+    const auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+    modelDataTrajectory.resize(numNodes);
+    for (size_t k = 0; k < numNodes; k++) {
+      const scalar_t t = k * dt;
+      const vector_t x = vector_t::Random(STATE_DIM);
+      const vector_t u = vector_t::Random(INPUT_DIM);
+      problem.preComputationPtr->request(Request::Cost + Request::Dynamics + Request::Approximation, t, x, u);
+
+      auto& modelData = modelDataTrajectory[k];
+      modelData.time = t;
+      modelData.stateDim = STATE_DIM;
+      modelData.inputDim = INPUT_DIM;
+      modelData.dynamics = sensitivityDiscretizer(*problem.dynamicsPtr, t, x, u, dt);
+      modelData.dynamicsBias = modelData.dynamics.f - x;
+      modelData.cost = approximateCost(problem, t, x, u);
+      modelData.cost *= dt;
+    }
+
+    riccatiModification.deltaQm_.setZero(STATE_DIM, STATE_DIM);
+    riccatiModification.deltaGm_.setZero(INPUT_DIM, STATE_DIM);
+    riccatiModification.deltaGv_.setZero(INPUT_DIM);
+  }
+
+  /** Runs a full backward pass over the horizon. */
+  void backwardPass(DiscreteTimeRiccatiEquations& riccati) {
+    SmTrajectory.resize(numNodes + 1);
+    SvTrajectory.resize(numNodes + 1);
+    sTrajectory.resize(numNodes + 1);
+    KmTrajectory.resize(numNodes);
+    LvTrajectory.resize(numNodes);
+
+    SmTrajectory[numNodes] = matrix_t::Identity(STATE_DIM, STATE_DIM);
+    SvTrajectory[numNodes] = vector_t::Zero(STATE_DIM);
+    sTrajectory[numNodes] = 0.0;
+    for (int k = numNodes - 1; k >= 0; k--) {
+      riccati.computeMap(modelDataTrajectory[k], riccatiModification, SmTrajectory[k + 1], SvTrajectory[k + 1], sTrajectory[k + 1],
+                         KmTrajectory[k], LvTrajectory[k], SmTrajectory[k], SvTrajectory[k], sTrajectory[k]);
+    }
+  }
+
+  std::unique_ptr<CartPoleInterface> cartPoleInterfacePtr;
+  TargetTrajectories targetTrajectories;
+  std::vector<ModelData> modelDataTrajectory;
+  riccati_modification::Data riccatiModification;
+
+  matrix_array_t SmTrajectory;
+  vector_array_t SvTrajectory;
+  scalar_array_t sTrajectory;
+  matrix_array_t KmTrajectory;
+  vector_array_t LvTrajectory;
+};
+
+constexpr size_t TestCartpoleFixedSizeKernels::numNodes;
+constexpr scalar_t TestCartpoleFixedSizeKernels::dt;
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(TestCartpoleFixedSizeKernels, riccatiBackwardPass) {
+  constexpr size_t numRepeats = 1000;
+  constexpr scalar_t tol = 1e-9;
+
+  for (const bool reducedFormRiccati : {true, false}) {
+    DiscreteTimeRiccatiEquations riccatiDynamicSize(reducedFormRiccati, false, false /*useFixedSizeKernels*/);
+    DiscreteTimeRiccatiEquations riccatiFixedSize(reducedFormRiccati, false, true /*useFixedSizeKernels*/);
+
+    benchmark::RepeatedTimer dynamicSizeTimer;
+    for (size_t i = 0; i < numRepeats; i++) {
+      dynamicSizeTimer.startTimer();
+      backwardPass(riccatiDynamicSize);
+      dynamicSizeTimer.endTimer();
+    }
+    const auto SmDynamicSize = SmTrajectory;
+    const auto SvDynamicSize = SvTrajectory;
+    const auto sDynamicSize = sTrajectory;
+    const auto KmDynamicSize = KmTrajectory;
+
+    benchmark::RepeatedTimer fixedSizeTimer;
+    for (size_t i = 0; i < numRepeats; i++) {
+      fixedSizeTimer.startTimer();
+      backwardPass(riccatiFixedSize);
+      fixedSizeTimer.endTimer();
+    }
+
+    for (size_t k = 0; k < numNodes; k++) {
+      EXPECT_TRUE(SmTrajectory[k].isApprox(SmDynamicSize[k], tol)) << "Sm mismatch at node " << k;
+      EXPECT_TRUE(SvTrajectory[k].isApprox(SvDynamicSize[k], tol)) << "Sv mismatch at node " << k;
+      EXPECT_NEAR(sTrajectory[k], sDynamicSize[k], tol * (1.0 + std::abs(sDynamicSize[k]))) << "s mismatch at node " << k;
+      EXPECT_TRUE(KmTrajectory[k].isApprox(KmDynamicSize[k], tol)) << "Km mismatch at node " << k;
+    }
+
+    std::cout << "Cartpole discrete-time Riccati backward pass over " << numNodes << " nodes (reducedFormRiccati: " << std::boolalpha
+              << reducedFormRiccati << ")\n"
+              << "  dynamic-size [ms]: " << dynamicSizeTimer.getAverageInMilliseconds() << "\n"
+              << "  fixed-size   [ms]: " << fixedSizeTimer.getAverageInMilliseconds() << "\n";
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(TestCartpoleFixedSizeKernels, rk4SensitivityDiscretization) {
+  constexpr size_t numRepeats = 10000;
+
+  auto& dynamics = *cartPoleInterfacePtr->optimalControlProblem().dynamicsPtr;
+  const auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+  const vector_t x = vector_t::Random(STATE_DIM);
+  const vector_t u = vector_t::Random(INPUT_DIM);
+
+  benchmark::RepeatedTimer timer;
+  for (size_t i = 0; i < numRepeats; i++) {
+    timer.startTimer();
+    const auto discreteDynamics = sensitivityDiscretizer(dynamics, 0.0, x, u, dt);
+    timer.endTimer();
+    ASSERT_EQ(discreteDynamics.dfdx.rows(), STATE_DIM);
+  }
+
+  std::cout << "Cartpole RK4 sensitivity discretization (fixed-size assembly) [ms]: " << timer.getAverageInMilliseconds() << "\n";
+}
@@ -32,8 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <memory>
 #include <string>
 
-#include <ocs2_core/PreComputation.h>
-#include <ocs2_pinocchio_interface/PinocchioInterface.h>
+#include <ocs2_pinocchio_interface/PinocchioPreComputation.h>
 
 #include <ocs2_centroidal_model/CentroidalModelPinocchioMapping.h>
 
@@ -44,11 +43,24 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 namespace legged_robot {
 
-/** Callback for caching and reference update */
-class LeggedRobotPreComputation : public PreComputation {
+/**
+ * Callback for caching and reference update. The terms of the legged robot use CppAD kinematics, the pinocchio data is only
+ * updated for the analytical dynamics.
+ */
+class LeggedRobotPreComputation : public PinocchioPreComputation {
  public:
+  /**
+   * Constructor
+   * @param [in] pinocchioInterface : The pinocchio interface, internally keeps a copy.
+   * @param [in] info : The centroidal model information.
+   * @param [in] swingTrajectoryPlanner : The swing trajectory planner.
+   * @param [in] settings : The model settings.
+   * @param [in] analyticalDynamics : If true, the pinocchio data is updated for the analytical dynamics (LeggedRobotDynamics)
+   *                                  on requests of the dynamics.
+   */
   LeggedRobotPreComputation(PinocchioInterface pinocchioInterface, CentroidalModelInfo info,
-                            const SwingTrajectoryPlanner& swingTrajectoryPlanner, ModelSettings settings);
+                            const SwingTrajectoryPlanner& swingTrajectoryPlanner, ModelSettings settings,
+                            bool analyticalDynamics = false);
   ~LeggedRobotPreComputation() override = default;
 
   LeggedRobotPreComputation* clone() const override;
@@ -57,14 +69,17 @@ class LeggedRobotPreComputation : public PreComputation {
 
   const std::vector<EndEffectorLinearConstraint::Config>& getEeNormalVelocityConstraintConfigs() const { return eeNormalVelConConfigs_; }
 
-  PinocchioInterface& getPinocchioInterface() { return pinocchioInterface_; }
-  const PinocchioInterface& getPinocchioInterface() const { return pinocchioInterface_; }
-
  private:
+  enum : unsigned { CentroidalDynamics = CustomAlgorithm << 0, CentroidalDynamicsDerivatives = CustomAlgorithm << 1 };
+
   LeggedRobotPreComputation(const LeggedRobotPreComputation& other) = default;
 
-  PinocchioInterface pinocchioInterface_;
+  /** Updates the centroidal dynamics and, if requested, its derivatives. Both are cached like the kinematics. */
+  void updateCentroidalModel(const vector_t& x, const vector_t& u, bool computeDerivatives);
+
   CentroidalModelInfo info_;
+  const bool analyticalDynamics_;
+  vector_t centroidalDerivativesVelocity_;
   const SwingTrajectoryPlanner* swingTrajectoryPlannerPtr_;
   const ModelSettings settings_;
 
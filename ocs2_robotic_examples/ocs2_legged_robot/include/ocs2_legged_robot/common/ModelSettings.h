@@ -46,6 +46,9 @@ struct ModelSettings {
   bool verboseCppAd = true;
   bool recompileLibrariesCppAd = true;
   std::string modelFolderCppAd = "/tmp/ocs2";
+  bool batchKernelsCppAd = false;  // generates kernels that linearize the dynamics at several nodes per call
+  bool backgroundCompilationCppAd = false;  // compiles in the background and uses finite differences until the libraries are ready
+  std::string modelBundleCppAd;  // bundle created by ocs2_cppad_bundle, used if recompileLibrariesCppAd is false
 
   // This is only used to get names for the knees and to check urdf for extra joints that need to be fixed.
   std::vector<std::string> jointNames{"LF_HAA", "LF_HFE", "LF_KFE", "RF_HAA", "RF_HFE", "RF_KFE",
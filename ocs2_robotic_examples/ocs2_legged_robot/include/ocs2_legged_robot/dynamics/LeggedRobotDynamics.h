@@ -0,0 +1,68 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/dynamics/SystemDynamicsBase.h>
+
+#include <ocs2_centroidal_model/PinocchioCentroidalDynamics.h>
+
+#include "ocs2_legged_robot/LeggedRobotPreComputation.h"
+
+namespace ocs2 {
+namespace legged_robot {
+
+/**
+ * Centroidal dynamics with analytical derivatives. Unlike LeggedRobotDynamicsAD, it does not need code generation. The pinocchio
+ * data is updated by a LeggedRobotPreComputation that is constructed with analyticalDynamics set to true.
+ */
+class LeggedRobotDynamics final : public SystemDynamicsBase {
+ public:
+  /**
+   * Constructor
+   * @param [in] info : The centroidal model information.
+   * @param [in] preComputation : The pre-computation of the optimal control problem, internally keeps a copy.
+   */
+  LeggedRobotDynamics(const CentroidalModelInfo& info, const LeggedRobotPreComputation& preComputation);
+
+  ~LeggedRobotDynamics() override = default;
+  LeggedRobotDynamics* clone() const override { return new LeggedRobotDynamics(*this); }
+
+  vector_t computeFlowMap(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp) override;
+  VectorFunctionLinearApproximation linearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                        const PreComputation& preComp) override;
+
+ private:
+  LeggedRobotDynamics(const LeggedRobotDynamics& rhs) = default;
+
+  PinocchioCentroidalDynamics pinocchioCentroidalDynamics_;
+};
+
+}  // namespace legged_robot
+}  // namespace ocs2
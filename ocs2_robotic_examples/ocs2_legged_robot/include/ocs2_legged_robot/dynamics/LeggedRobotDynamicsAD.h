@@ -50,6 +50,8 @@ class LeggedRobotDynamicsAD final : public SystemDynamicsBase {
   vector_t computeFlowMap(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp) override;
   VectorFunctionLinearApproximation linearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                         const PreComputation& preComp) override;
+  void linearApproximationBatch(const scalar_array_t& time, const vector_array_t& state, const vector_array_t& input,
+                                const std::vector<size_t>& indices, std::vector<VectorFunctionLinearApproximation>& approximations) override;
 
  private:
   LeggedRobotDynamicsAD(const LeggedRobotDynamicsAD& rhs) = default;
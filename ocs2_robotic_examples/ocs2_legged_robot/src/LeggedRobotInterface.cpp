@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_centroidal_model/AccessHelperFunctions.h>
 #include <ocs2_centroidal_model/CentroidalModelPinocchioMapping.h>
 #include <ocs2_centroidal_model/ModelHelperFunctions.h>
+#include <ocs2_core/automatic_differentiation/CppAdInterface.h>
 #include <ocs2_core/misc/Display.h>
 #include <ocs2_core/soft_constraint/StateInputSoftConstraint.h>
 #include <ocs2_oc/synchronized_module/SolverSynchronizedModule.h>
@@ -52,6 +53,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_legged_robot/constraint/ZeroForceConstraint.h"
 #include "ocs2_legged_robot/constraint/ZeroVelocityConstraintCppAd.h"
 #include "ocs2_legged_robot/cost/LeggedRobotQuadraticTrackingCost.h"
+#include "ocs2_legged_robot/dynamics/LeggedRobotDynamics.h"
 #include "ocs2_legged_robot/dynamics/LeggedRobotDynamicsAD.h"
 
 // Boost
@@ -100,8 +102,20 @@ LeggedRobotInterface::LeggedRobotInterface(const std::string& taskFile, const st
   ipmSettings_ = ipm::loadSettings(taskFile, "ipm", verbose);
   rolloutSettings_ = rollout::loadSettings(taskFile, "rollout", verbose);
 
-  // OptimalConrolProblem
-  setupOptimalConrolProblem(taskFile, urdfFile, referenceFile, verbose);
+  // OptimalConrolProblem, the CppAD libraries of all models are compiled in parallel, or in the background such that the
+  // interface is usable right away. Models that are up to date in the bundle are loaded from it instead.
+  std::unique_ptr<CppAdModelBundle> modelBundlePtr;
+  if (!modelSettings_.modelBundleCppAd.empty()) {
+    modelBundlePtr.reset(new CppAdModelBundle(modelSettings_.modelBundleCppAd));
+  }
+  if (modelSettings_.backgroundCompilationCppAd) {
+    CppAdBackgroundCompilation backgroundCompilation;
+    setupOptimalConrolProblem(taskFile, urdfFile, referenceFile, verbose);
+  } else {
+    CppAdParallelCompilation parallelCompilation;
+    setupOptimalConrolProblem(taskFile, urdfFile, referenceFile, verbose);
+    parallelCompilation.finish();
+  }
 
   // initial state
   initialState_.setZero(centroidalModelInfo_.stateDim);
@@ -138,7 +152,10 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
   loadData::loadCppDataType(taskFile, "legged_robot_interface.useAnalyticalGradientsDynamics", useAnalyticalGradientsDynamics);
   std::unique_ptr<SystemDynamicsBase> dynamicsPtr;
   if (useAnalyticalGradientsDynamics) {
-    throw std::runtime_error("[LeggedRobotInterface::setupOptimalConrolProblem] The analytical dynamics class is not yet implemented!");
+    // the dynamics keep their own copy of the pre-computation for the rollouts
+    const LeggedRobotPreComputation preComputation(*pinocchioInterfacePtr_, centroidalModelInfo_,
+                                                   *referenceManagerPtr_->getSwingTrajectoryPlanner(), modelSettings_, true);
+    dynamicsPtr.reset(new LeggedRobotDynamics(centroidalModelInfo_, preComputation));
   } else {
     const std::string modelName = "dynamics";
     dynamicsPtr.reset(new LeggedRobotDynamicsAD(*pinocchioInterfacePtr_, centroidalModelInfo_, modelName, modelSettings_));
@@ -192,7 +209,8 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
 
   // Pre-computation
   problemPtr_->preComputationPtr.reset(new LeggedRobotPreComputation(*pinocchioInterfacePtr_, centroidalModelInfo_,
-                                                                     *referenceManagerPtr_->getSwingTrajectoryPlanner(), modelSettings_));
+                                                                     *referenceManagerPtr_->getSwingTrajectoryPlanner(), modelSettings_,
+                                                                     useAnalyticalGradientsDynamics));
 
   // Rollout
   rolloutPtr_.reset(new TimeTriggeredRollout(*problemPtr_->dynamicsPtr, rolloutSettings_));
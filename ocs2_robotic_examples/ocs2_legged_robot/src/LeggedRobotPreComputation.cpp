@@ -35,6 +35,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/misc/Numerics.h>
 
+#include <ocs2_centroidal_model/ModelHelperFunctions.h>
+
 #include <ocs2_legged_robot/LeggedRobotPreComputation.h>
 
 namespace ocs2 {
@@ -44,9 +46,11 @@ namespace legged_robot {
 /******************************************************************************************************/
 /******************************************************************************************************/
 LeggedRobotPreComputation::LeggedRobotPreComputation(PinocchioInterface pinocchioInterface, CentroidalModelInfo info,
-                                                     const SwingTrajectoryPlanner& swingTrajectoryPlanner, ModelSettings settings)
-    : pinocchioInterface_(std::move(pinocchioInterface)),
+                                                     const SwingTrajectoryPlanner& swingTrajectoryPlanner, ModelSettings settings,
+                                                     bool analyticalDynamics)
+    : PinocchioPreComputation(std::move(pinocchioInterface), CentroidalModelPinocchioMapping(info)),
       info_(std::move(info)),
+      analyticalDynamics_(analyticalDynamics),
       swingTrajectoryPlannerPtr_(&swingTrajectoryPlanner),
       settings_(std::move(settings)) {
   eeNormalVelConConfigs_.resize(info_.numThreeDofContacts);
@@ -63,6 +67,10 @@ LeggedRobotPreComputation* LeggedRobotPreComputation::clone() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void LeggedRobotPreComputation::request(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) {
+  if (analyticalDynamics_ && request.contains(Request::Dynamics)) {
+    updateCentroidalModel(x, u, request.contains(Request::Approximation));
+  }
+
   if (!request.containsAny(Request::Cost + Request::Constraint + Request::SoftConstraint)) {
     return;
   }
@@ -86,5 +94,30 @@ void LeggedRobotPreComputation::request(RequestSet request, scalar_t t, const ve
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LeggedRobotPreComputation::updateCentroidalModel(const vector_t& x, const vector_t& u, bool computeDerivatives) {
+  auto& pinocchioInterface = getPinocchioInterface();
+  const auto& mapping = getPinocchioMapping();
+
+  const vector_t q = mapping.getPinocchioJointPosition(x);
+  setConfiguration(q);
+  if (!isUpdated(CentroidalDynamics)) {
+    updateCentroidalDynamics(pinocchioInterface, info_, q);
+    setUpdated(CentroidalDynamics | ForwardKinematics);
+  }
+
+  if (computeDerivatives) {
+    // unlike the kinematics, the derivatives depend on the velocities
+    const vector_t v = mapping.getPinocchioJointVelocity(x, u);
+    if (!isUpdated(CentroidalDynamicsDerivatives) || v != centroidalDerivativesVelocity_) {
+      updateCentroidalDynamicsDerivatives(pinocchioInterface, info_, q, v);
+      centroidalDerivativesVelocity_ = v;
+      setUpdated(CentroidalDynamicsDerivatives | JointJacobians);
+    }
+  }
+}
+
 }  // namespace legged_robot
 }  // namespace ocs2
@@ -54,6 +54,9 @@ ModelSettings loadModelSettings(const std::string& filename, const std::string&
   loadData::loadPtreeValue(pt, modelSettings.verboseCppAd, fieldName + ".verboseCppAd", verbose);
   loadData::loadPtreeValue(pt, modelSettings.recompileLibrariesCppAd, fieldName + ".recompileLibrariesCppAd", verbose);
   loadData::loadPtreeValue(pt, modelSettings.modelFolderCppAd, fieldName + ".modelFolderCppAd", verbose);
+  loadData::loadPtreeValue(pt, modelSettings.batchKernelsCppAd, fieldName + ".batchKernelsCppAd", verbose);
+  loadData::loadPtreeValue(pt, modelSettings.backgroundCompilationCppAd, fieldName + ".backgroundCompilationCppAd", verbose);
+  loadData::loadPtreeValue(pt, modelSettings.modelBundleCppAd, fieldName + ".modelBundleCppAd", verbose);
 
   if (verbose) {
     std::cerr << " #### =============================================================================" << std::endl;
@@ -38,7 +38,8 @@ namespace legged_robot {
 LeggedRobotDynamicsAD::LeggedRobotDynamicsAD(const PinocchioInterface& pinocchioInterface, const CentroidalModelInfo& info,
                                              const std::string& modelName, const ModelSettings& modelSettings)
     : pinocchioCentroidalDynamicsAd_(pinocchioInterface, info, modelName, modelSettings.modelFolderCppAd,
-                                     modelSettings.recompileLibrariesCppAd, modelSettings.verboseCppAd) {}
+                                     modelSettings.recompileLibrariesCppAd, modelSettings.verboseCppAd,
+                                     modelSettings.batchKernelsCppAd) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -55,5 +56,14 @@ VectorFunctionLinearApproximation LeggedRobotDynamicsAD::linearApproximation(sca
   return pinocchioCentroidalDynamicsAd_.getLinearApproximation(time, state, input);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LeggedRobotDynamicsAD::linearApproximationBatch(const scalar_array_t& time, const vector_array_t& state, const vector_array_t& input,
+                                                     const std::vector<size_t>& indices,
+                                                     std::vector<VectorFunctionLinearApproximation>& approximations) {
+  pinocchioCentroidalDynamicsAd_.getLinearApproximationBatch(time, state, input, indices, approximations);
+}
+
 }  // namespace legged_robot
 }  // namespace ocs2
@@ -0,0 +1,108 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <iostream>
+
+#include <ocs2_core/misc/Benchmark.h>
+
+#include "ocs2_legged_robot/LeggedRobotPreComputation.h"
+#include "ocs2_legged_robot/common/ModelSettings.h"
+#include "ocs2_legged_robot/dynamics/LeggedRobotDynamics.h"
+#include "ocs2_legged_robot/dynamics/LeggedRobotDynamicsAD.h"
+#include "ocs2_legged_robot/test/AnymalFactoryFunctions.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+class TestLeggedRobotDynamics : public ::testing::TestWithParam<CentroidalModelType> {
+ public:
+  TestLeggedRobotDynamics() {
+    modelSettings.verboseCppAd = false;
+    referenceManagerPtr = createReferenceManager(centroidalModelInfo.numThreeDofContacts);
+  }
+
+  ModelSettings modelSettings;
+  std::unique_ptr<PinocchioInterface> pinocchioInterfacePtr = createAnymalPinocchioInterface();
+  const CentroidalModelInfo centroidalModelInfo = createAnymalCentroidalModelInfo(*pinocchioInterfacePtr, GetParam());
+  std::shared_ptr<SwitchedModelReferenceManager> referenceManagerPtr;
+};
+
+TEST_P(TestLeggedRobotDynamics, compareWithAd) {
+  const std::string modelName = "dynamics_" + toString(GetParam());
+  const LeggedRobotPreComputation preComputation(*pinocchioInterfacePtr, centroidalModelInfo,
+                                                 *referenceManagerPtr->getSwingTrajectoryPlanner(), modelSettings, true);
+  LeggedRobotDynamics analyticalDynamics(centroidalModelInfo, preComputation);
+
+  benchmark::RepeatedTimer codegenTimer;
+  codegenTimer.startTimer();
+  LeggedRobotDynamicsAD adDynamics(*pinocchioInterfacePtr, centroidalModelInfo, modelName, modelSettings);
+  codegenTimer.endTimer();
+
+  // the overloads without pre-computation are hidden in the derived classes
+  SystemDynamicsBase& dynamics = analyticalDynamics;
+  SystemDynamicsBase& dynamicsAd = adDynamics;
+
+  // copies update their own pre-computation
+  std::unique_ptr<SystemDynamicsBase> dynamicsCopyPtr(dynamics.clone());
+
+  constexpr int numTests = 100;
+  benchmark::RepeatedTimer analyticalTimer;
+  benchmark::RepeatedTimer adTimer;
+  for (int i = 0; i < numTests; i++) {
+    const scalar_t t = 0.0;
+    const vector_t x = vector_t::Random(centroidalModelInfo.stateDim);
+    const vector_t u = 100.0 * vector_t::Random(centroidalModelInfo.inputDim);
+
+    analyticalTimer.startTimer();
+    const auto approximation = dynamics.linearApproximation(t, x, u);
+    analyticalTimer.endTimer();
+    adTimer.startTimer();
+    const auto approximationAd = dynamicsAd.linearApproximation(t, x, u);
+    adTimer.endTimer();
+
+    constexpr scalar_t tol = 1e-6;
+    EXPECT_TRUE(dynamics.computeFlowMap(t, x, u).isApprox(approximationAd.f, tol));
+    EXPECT_TRUE(approximation.f.isApprox(approximationAd.f, tol));
+    EXPECT_TRUE(approximation.dfdx.isApprox(approximationAd.dfdx, tol));
+    EXPECT_TRUE(approximation.dfdu.isApprox(approximationAd.dfdu, tol));
+    EXPECT_TRUE(dynamicsCopyPtr->linearApproximation(t, x, u).dfdx.isApprox(approximation.dfdx));
+  }
+
+  std::cout << "[" << toString(GetParam()) << "]\n";
+  std::cout << "  Code generation and compilation of the AD dynamics: " << codegenTimer.getLastIntervalInMilliseconds() << " [ms]\n";
+  std::cout << "  Linear approximation, analytical: " << analyticalTimer.getAverageInMilliseconds() << " [ms] average, "
+            << analyticalTimer.getMaxIntervalInMilliseconds() << " [ms] max\n";
+  std::cout << "  Linear approximation, AD: " << adTimer.getAverageInMilliseconds() << " [ms] average, "
+            << adTimer.getMaxIntervalInMilliseconds() << " [ms] max\n";
+}
+
+INSTANTIATE_TEST_CASE_P(TestLeggedRobotDynamicsWithParam, TestLeggedRobotDynamics,
+                        ::testing::Values(CentroidalModelType::FullCentroidalDynamics, CentroidalModelType::SingleRigidBodyDynamics),
+                        [](const testing::TestParamInfo<TestLeggedRobotDynamics::ParamType>& info) { return toString(info.param); });
@@ -0,0 +1,137 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_oc/rollout/RolloutBase.h>
+#include <ocs2_robotic_assets/package_path.h>
+#include <ocs2_sqp/SqpMpc.h>
+
+#include "ocs2_legged_robot/LeggedRobotInterface.h"
+#include "ocs2_legged_robot/package_path.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+namespace {
+const std::string URDF_FILE = ocs2::robotic_assets::getPath() + "/resources/anymal_c/urdf/anymal.urdf";
+const std::string TASK_FILE = ocs2::legged_robot::getPath() + "/config/mpc/" + "task.info";
+const std::string REFERENCE_FILE = ocs2::legged_robot::getPath() + "/config/command/" + "reference.info";
+
+struct ClosedLoopResult {
+  benchmark::RepeatedTimer latencyTimer;      // from the state to the policy, i.e. MPC_BASE::run()
+  benchmark::RepeatedTimer preparationTimer;  // MPC_BASE::prepare()
+  size_t numRuns = 0;
+  size_t numRealTimeIterations = 0;  // runs which only did the feedback phase
+  vector_t initialState;
+  vector_t finalState;
+};
+
+/**
+ * Runs the SQP MPC in closed loop with the rollout of the centroidal model while the robot stands at its initial pose.
+ */
+ClosedLoopResult runClosedLoop(bool realTimeIteration) {
+  LeggedRobotInterface interface(TASK_FILE, URDF_FILE, REFERENCE_FILE);
+
+  auto sqpSettings = interface.sqpSettings();
+  sqpSettings.realTimeIteration = realTimeIteration;
+  sqpSettings.printSolverStatistics = false;
+  sqpSettings.enableLogging = false;
+  SqpMpc mpc(interface.mpcSettings(), std::move(sqpSettings), interface.getOptimalControlProblem(), interface.getInitializer());
+  mpc.getSolverPtr()->setReferenceManager(interface.getReferenceManagerPtr());
+  std::unique_ptr<RolloutBase> rolloutPtr(interface.getRollout().clone());
+
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 2.0;
+  const scalar_t mpcPeriod = 1.0 / interface.mpcSettings().mpcDesiredFrequency_;
+
+  ClosedLoopResult result;
+  result.initialState = interface.getInitialState();
+  const vector_t zeroInput = vector_t::Zero(interface.getCentroidalModelInfo().inputDim);
+  interface.getReferenceManagerPtr()->setTargetTrajectories(TargetTrajectories({initTime}, {result.initialState}, {zeroInput}));
+
+  scalar_t time = initTime;
+  vector_t state = result.initialState;
+  PrimalSolution policy;
+  while (time < finalTime) {
+    result.latencyTimer.startTimer();
+    mpc.run(time, state);
+    result.latencyTimer.endTimer();
+    mpc.getSolverPtr()->getPrimalSolution(time + mpcPeriod, &policy);
+
+    result.preparationTimer.startTimer();
+    mpc.prepare();
+    result.preparationTimer.endTimer();
+
+    // apply the policy until the next MPC call
+    scalar_array_t timeTrajectory;
+    size_array_t postEventIndices;
+    vector_array_t stateTrajectory;
+    vector_array_t inputTrajectory;
+    state = rolloutPtr->run(time, state, time + mpcPeriod, policy.controllerPtr_.get(), policy.modeSchedule_, timeTrajectory,
+                            postEventIndices, stateTrajectory, inputTrajectory);
+    time += mpcPeriod;
+  }
+
+  result.numRuns = result.latencyTimer.getNumTimedIntervals();
+  result.numRealTimeIterations = mpc.getSolverPtr()->getNumRealTimeIterations();
+  result.finalState = std::move(state);
+  return result;
+}
+
+void printResult(const std::string& name, const ClosedLoopResult& result) {
+  std::cout << name << "\n"
+            << "\tLatency     : " << result.latencyTimer.getAverageInMilliseconds() << " [ms] average, "
+            << result.latencyTimer.getMaxIntervalInMilliseconds() << " [ms] max\n"
+            << "\tPreparation : " << result.preparationTimer.getAverageInMilliseconds() << " [ms] average\n"
+            << "\tBase drift  : " << (result.finalState - result.initialState).segment<6>(6).transpose() << "\n";
+}
+}  // unnamed namespace
+
+TEST(LeggedRobotSqpRealTimeIteration, closedLoop) {
+  const auto sqpResult = runClosedLoop(false);
+  const auto rtiResult = runClosedLoop(true);
+  printResult("SQP", sqpResult);
+  printResult("SQP-RTI", rtiResult);
+
+  // without RTI every run is a full SQP. With RTI, the runs after the first one only do the feedback phase, unless the events within the
+  // horizon changed since the preparation
+  EXPECT_EQ(sqpResult.numRealTimeIterations, 0u);
+  EXPECT_GT(rtiResult.numRealTimeIterations, rtiResult.numRuns / 2);
+
+  // the base pose is the 6 states after the normalized centroidal momentum, the base stays within 5 cm of the initial position
+  EXPECT_TRUE(rtiResult.finalState.allFinite());
+  EXPECT_LT((sqpResult.finalState - sqpResult.initialState).segment<3>(6).norm(), 0.05);
+  EXPECT_LT((rtiResult.finalState - rtiResult.initialState).segment<3>(6).norm(), 0.05);
+}
@@ -0,0 +1,187 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_oc/multiple_shooting/Transcription.h>
+#include <ocs2_robotic_assets/package_path.h>
+
+#include "ocs2_legged_robot/LeggedRobotInterface.h"
+#include "ocs2_legged_robot/dynamics/LeggedRobotDynamicsAD.h"
+#include "ocs2_legged_robot/package_path.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+namespace {
+const std::string URDF_FILE = ocs2::robotic_assets::getPath() + "/resources/anymal_c/urdf/anymal.urdf";
+const std::string TASK_FILE = ocs2::legged_robot::getPath() + "/config/mpc/" + "task.info";
+const std::string REFERENCE_FILE = ocs2::legged_robot::getPath() + "/config/command/" + "reference.info";
+}  // unnamed namespace
+
+/**
+ * Compares the wall time of the multiple shooting LQ approximation of the legged robot for different ways of dispatching the nodes
+ * over the ThreadPool: one node per task (the historical behaviour), statically partitioned ranges and guided chunks.
+ */
+class TestLqApproximationDispatch : public ::testing::Test {
+ protected:
+  static constexpr int N = 100;
+  static constexpr scalar_t dt = 0.01;
+  static constexpr size_t nThreads = 4;
+  static constexpr int numRepetitions = 20;
+
+  TestLqApproximationDispatch()
+      : interface(TASK_FILE, URDF_FILE, REFERENCE_FILE),
+        sensitivityDiscretizer(selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4)) {
+    const vector_t initState = interface.getInitialState();
+    const vector_t zeroInput = vector_t::Zero(interface.getCentroidalModelInfo().inputDim);
+    interface.getReferenceManagerPtr()->setTargetTrajectories(TargetTrajectories({0.0}, {initState}, {zeroInput}));
+    interface.getReferenceManagerPtr()->preSolverRun(0.0, N * dt, initState);
+
+    ocpDefinitions.resize(nThreads, interface.getOptimalControlProblem());
+    for (auto& ocpDefinition : ocpDefinitions) {
+      ocpDefinition.targetTrajectoriesPtr = &interface.getReferenceManagerPtr()->getTargetTrajectories();
+    }
+
+    x.assign(N + 1, initState);
+    u.assign(N, zeroInput);
+    transcriptions.resize(N);
+  }
+
+  void benchmarkDispatch(const std::string& name, ThreadPool::Scheduler scheduler, int grainSize, ThreadPool::Chunking chunking) {
+    ThreadPool threadPool(nThreads - 1, 0, scheduler);
+    auto task = [&](int workerId, int i) {
+      transcriptions[i] =
+          multiple_shooting::setupIntermediateNode(ocpDefinitions[workerId], sensitivityDiscretizer, i * dt, dt, x[i], x[i + 1], u[i]);
+    };
+
+    benchmark::RepeatedTimer timer;
+    for (int rep = 0; rep < numRepetitions; rep++) {
+      timer.startTimer();
+      threadPool.parallelFor(0, N, grainSize, task, chunking);
+      timer.endTimer();
+    }
+
+    std::cout << name << ": " << timer.getAverageInMilliseconds() << " [ms] average, " << timer.getMaxIntervalInMilliseconds()
+              << " [ms] max\n";
+
+    for (const auto& transcription : transcriptions) {
+      ASSERT_EQ(transcription.dynamics.dfdx.rows(), x.front().size());
+    }
+  }
+
+  LeggedRobotInterface interface;
+  DynamicsSensitivityDiscretizer sensitivityDiscretizer;
+  std::vector<OptimalControlProblem> ocpDefinitions;
+  vector_array_t x;
+  vector_array_t u;
+  std::vector<multiple_shooting::Transcription> transcriptions;
+};
+
+constexpr int TestLqApproximationDispatch::N;
+constexpr scalar_t TestLqApproximationDispatch::dt;
+constexpr size_t TestLqApproximationDispatch::nThreads;
+constexpr int TestLqApproximationDispatch::numRepetitions;
+
+TEST_F(TestLqApproximationDispatch, sharedQueue) {
+  benchmarkDispatch("SharedQueue per node", ThreadPool::Scheduler::SharedQueue, 1, ThreadPool::Chunking::Dynamic);
+  benchmarkDispatch("SharedQueue static", ThreadPool::Scheduler::SharedQueue, 1, ThreadPool::Chunking::Static);
+  benchmarkDispatch("SharedQueue guided", ThreadPool::Scheduler::SharedQueue, 1, ThreadPool::Chunking::Guided);
+}
+
+TEST_F(TestLqApproximationDispatch, workStealing) {
+  benchmarkDispatch("WorkStealing per node", ThreadPool::Scheduler::WorkStealing, 1, ThreadPool::Chunking::Dynamic);
+  benchmarkDispatch("WorkStealing static", ThreadPool::Scheduler::WorkStealing, 1, ThreadPool::Chunking::Static);
+  benchmarkDispatch("WorkStealing guided", ThreadPool::Scheduler::WorkStealing, 1, ThreadPool::Chunking::Guided);
+}
+
+/**
+ * Compares the wall time of the dynamics linearization at the nodes of the legged robot, one node per call versus the batch
+ * kernels of the CppAdInterface.
+ */
+TEST(TestDynamicsBatch, legged_robot) {
+  constexpr int N = 100;
+  constexpr scalar_t dt = 0.01;
+  constexpr int numRepetitions = 100;
+
+  LeggedRobotInterface interface(TASK_FILE, URDF_FILE, REFERENCE_FILE);
+  const auto& info = interface.getCentroidalModelInfo();
+  ModelSettings modelSettings = interface.modelSettings();
+  modelSettings.batchKernelsCppAd = true;
+  LeggedRobotDynamicsAD dynamicsAd(interface.getPinocchioInterface(), info, "dynamics_batch", modelSettings);
+  SystemDynamicsBase& dynamics = dynamicsAd;  // the overloads without pre-computation are hidden in the derived class
+
+  scalar_array_t t(N);
+  vector_array_t x(N);
+  vector_array_t u(N);
+  for (int i = 0; i < N; i++) {
+    t[i] = i * dt;
+    x[i] = interface.getInitialState() + 0.1 * vector_t::Random(info.stateDim);
+    u[i] = vector_t::Random(info.inputDim);
+  }
+
+  std::vector<VectorFunctionLinearApproximation> perNode(N);
+  benchmark::RepeatedTimer perNodeTimer;
+  for (int rep = 0; rep < numRepetitions; rep++) {
+    perNodeTimer.startTimer();
+    for (int i = 0; i < N; i++) {
+      perNode[i] = dynamics.linearApproximation(t[i], x[i], u[i]);
+    }
+    perNodeTimer.endTimer();
+  }
+
+  std::vector<size_t> indices(N);
+  std::iota(indices.begin(), indices.end(), 0);
+  std::vector<VectorFunctionLinearApproximation> batched(N);
+  benchmark::RepeatedTimer batchTimer;
+  for (int rep = 0; rep < numRepetitions; rep++) {
+    batchTimer.startTimer();
+    dynamics.linearApproximationBatch(t, x, u, indices, batched);
+    batchTimer.endTimer();
+  }
+
+  std::cout << "Dynamics linearization per node: " << perNodeTimer.getAverageInMilliseconds() << " [ms] average\n";
+  std::cout << "Dynamics linearization batched (" << cppad_batch::kernelWidth
+            << " nodes per kernel call): " << batchTimer.getAverageInMilliseconds() << " [ms] average\n";
+
+  ASSERT_EQ(batched.size(), N);
+  for (int i = 0; i < N; i++) {
+    EXPECT_TRUE(batched[i].f.isApprox(perNode[i].f));
+    EXPECT_TRUE(batched[i].dfdx.isApprox(perNode[i].dfdx));
+    EXPECT_TRUE(batched[i].dfdu.isApprox(perNode[i].dfdu));
+  }
+}
@@ -29,11 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
-#include <memory>
-#include <string>
-
-#include <ocs2_core/PreComputation.h>
-#include <ocs2_pinocchio_interface/PinocchioInterface.h>
+#include <ocs2_pinocchio_interface/PinocchioPreComputation.h>
 
 #include <ocs2_mobile_manipulator/ManipulatorModelInfo.h>
 #include <ocs2_mobile_manipulator/MobileManipulatorPinocchioMapping.h>
@@ -41,25 +37,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 namespace mobile_manipulator {
 
-/** Callback for caching and reference update */
-class MobileManipulatorPreComputation : public PreComputation {
+/** Callback for caching the kinematics of the mobile manipulator, @see PinocchioPreComputation */
+class MobileManipulatorPreComputation final : public PinocchioPreComputation {
  public:
   MobileManipulatorPreComputation(PinocchioInterface pinocchioInterface, const ManipulatorModelInfo& info);
 
   ~MobileManipulatorPreComputation() override = default;
-
-  MobileManipulatorPreComputation(const MobileManipulatorPreComputation& rhs) = delete;
-  MobileManipulatorPreComputation* clone() const override;
-
-  void request(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) override;
-  void requestFinal(RequestSet request, scalar_t t, const vector_t& x) override;
-
-  PinocchioInterface& getPinocchioInterface() { return pinocchioInterface_; }
-  const PinocchioInterface& getPinocchioInterface() const { return pinocchioInterface_; }
+  MobileManipulatorPreComputation* clone() const override { return new MobileManipulatorPreComputation(*this); }
 
  private:
-  PinocchioInterface pinocchioInterface_;
-  MobileManipulatorPinocchioMapping pinocchioMapping_;
+  MobileManipulatorPreComputation(const MobileManipulatorPreComputation& rhs) = default;
 };
 
 }  // namespace mobile_manipulator
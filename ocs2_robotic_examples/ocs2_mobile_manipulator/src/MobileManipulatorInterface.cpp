@@ -36,6 +36,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_mobile_manipulator/MobileManipulatorInterface.h"
 
+#include <ocs2_core/automatic_differentiation/CppAdInterface.h>
 #include <ocs2_core/initialization/DefaultInitializer.h>
 #include <ocs2_core/misc/LoadData.h>
 #include <ocs2_core/misc/LoadStdVectorOfPair.h>
@@ -159,6 +160,9 @@ MobileManipulatorInterface::MobileManipulatorInterface(const std::string& taskFi
   /*
    * Optimal control problem
    */
+  // the CppAD libraries of all models are compiled in parallel until finish() is called
+  CppAdParallelCompilation parallelCompilation;
+
   // Cost
   problem_.costPtr->add("inputCost", getQuadraticInputCost(taskFile));
 
@@ -204,6 +208,7 @@ MobileManipulatorInterface::MobileManipulatorInterface(const std::string& taskFi
     default:
       throw std::invalid_argument("Invalid manipulator model type provided.");
   }
+  parallelCompilation.finish();
 
   /*
    * Pre-computation
@@ -4,6 +4,8 @@
 
 #include "ocs2_switched_model_interface/core/SwitchedModelPrecomputation.h"
 
+#include <tuple>
+
 #include <ocs2_switched_model_interface/core/Rotations.h>
 #include <ocs2_switched_model_interface/core/TorqueApproximation.h>
 
@@ -115,8 +117,8 @@ void SwitchedModelPreComputation::updateFeetPhases(scalar_t t) {
 
 void SwitchedModelPreComputation::updateMotionReference(scalar_t t) {
   // Interpolate reference
-  stateReference_ = swingTrajectoryPlannerPtr_->getTargetTrajectories().getDesiredState(t);
-  vector_t uRef = swingTrajectoryPlannerPtr_->getTargetTrajectories().getDesiredInput(t);
+  vector_t uRef;
+  std::tie(stateReference_, uRef) = swingTrajectoryPlannerPtr_->getTargetTrajectories().getDesiredStateInput(t);
 
   // Extract elements from reference
   const auto basePose = getBasePose(stateReference_);
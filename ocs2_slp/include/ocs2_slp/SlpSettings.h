@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
 
 #include "ocs2_slp/pipg/PipgSettings.h"
 
@@ -44,6 +45,9 @@ struct Settings {
   scalar_t deltaTol = 1e-6;     // Termination condition : RMS update of x(t) and u(t) are both below this value
   scalar_t costTol = 1e-4;      // Termination condition : (cost{i+1} - (cost{i}) < costTol AND constraints{i+1} < g_min
 
+  // Wall-clock budget of a run() call in [s], 0 for no limit. No iteration is started if it is predicted to exceed the remaining budget.
+  scalar_t maxRunTime = 0.0;
+
   // Linesearch - step size rules
   scalar_t alpha_decay = 0.5;  // multiply the step size by this factor every time a linesearch step is rejected.
   scalar_t alpha_min = 1e-4;   // terminate linesearch if the attempted step size is below this threshold
@@ -57,6 +61,7 @@ struct Settings {
   // Discretization method
   scalar_t dt = 0.01;  // user-defined time discretization
   SensitivityIntegratorType integratorType = SensitivityIntegratorType::RK2;
+  size_t dynamicsBatchSize = 1;  // number of intermediate nodes whose dynamics are linearized in one call, see BatchDynamicsDiscretization
 
   // Inequality penalty relaxed barrier parameters
   scalar_t inequalityConstraintMu = 0.0;
@@ -73,6 +78,9 @@ struct Settings {
   // Threading
   size_t nThreads = 4;
   int threadPriority = 50;
+  ThreadPool::Scheduler threadScheduler = ThreadPool::Scheduler::SharedQueue;  // SharedQueue or WorkStealing
+  std::vector<int> cpuSet;        // CPU cores to pin the threads to (one core per thread if there are enough), empty for no pinning
+  bool pinCallingThread = false;  // Also pin the thread which calls the solver
 
   // LP subproblem solver settings
   pipg::Settings pipgSettings = pipg::Settings();
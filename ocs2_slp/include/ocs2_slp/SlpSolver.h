@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
+#include <ocs2_oc/multiple_shooting/BatchDynamicsDiscretization.h>
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
@@ -69,6 +70,9 @@ class SlpSolver : public SolverBase {
 
   size_t getNumIterations() const override { return totalNumIterations_; }
 
+  /** Reason why the iterations of the last run() call stopped */
+  slp::Convergence getConvergence() const { return convergence_; }
+
   const OptimalControlProblem& getOptimalControlProblem() const override { return ocpDefinitions_.front(); }
 
   const PerformanceIndex& getPerformanceIndeces() const override { return getIterationsLog().back(); };
@@ -112,8 +116,8 @@ class SlpSolver : public SolverBase {
     runImpl(initTime, initState, finalTime);
   }
 
-  /** Run a task in parallel with settings.nThreads */
-  void runParallel(std::function<void(int)> taskFunction);
+  /** Run taskFunction(workerId, i) for i in [begin, end) in parallel with settings.nThreads */
+  void parallelFor(int begin, int end, std::function<void(int, int)> taskFunction);
 
   /** Get profiling information as a string */
   std::string getBenchmarkingInformation() const;
@@ -151,6 +155,7 @@ class SlpSolver : public SolverBase {
   const slp::Settings settings_;
   DynamicsDiscretizer discretizer_;
   DynamicsSensitivityDiscretizer sensitivityDiscretizer_;
+  multiple_shooting::BatchDynamicsDiscretization batchDynamicsDiscretization_;  // used if settings.dynamicsBatchSize > 1
   std::vector<OptimalControlProblem> ocpDefinitions_;
   std::unique_ptr<Initializer> initializerPtr_;
   FilterLinesearch filterLinesearch_;
@@ -184,11 +189,13 @@ class SlpSolver : public SolverBase {
   // Benchmarking
   size_t numProblems_{0};
   size_t totalNumIterations_{0};
+  slp::Convergence convergence_ = slp::Convergence::FALSE;
   benchmark::RepeatedTimer initializationTimer_;
   benchmark::RepeatedTimer linearQuadraticApproximationTimer_;
   benchmark::RepeatedTimer solveQpTimer_;
   benchmark::RepeatedTimer linesearchTimer_;
   benchmark::RepeatedTimer computeControllerTimer_;
+  benchmark::TimeBudget runTimeBudget_;  // budget of the current run() call, predicted from the timers above
 
   // PIPG Solver
   benchmark::RepeatedTimer lambdaEstimation_;
@@ -29,7 +29,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_slp/Helpers.h"
 
-#include <atomic>
 #include <numeric>
 
 namespace {
@@ -108,44 +107,40 @@ vector_t GGTAbsRowSumInParallel(ThreadPool& threadPool, const OcpSize& ocpSize,
   matrix_array_t tempMatrixArray(N);
   vector_array_t absRowSumArray(N);
 
-  std::atomic_int timeIndex{0};
-  auto task = [&](int workerId) {
-    int k;
-    while ((k = timeIndex++) < N) {
-      const auto nx_next = ocpSize.numStates[k + 1];
-      const auto& B = dynamics[k].dfdu;
-      tempMatrixArray[k] =
-          (scalingVectorsPtr == nullptr ? matrix_t::Identity(nx_next, nx_next)
-                                        : (*scalingVectorsPtr)[k].cwiseProduct((*scalingVectorsPtr)[k]).asDiagonal().toDenseMatrix());
-      tempMatrixArray[k] += B * B.transpose();
-
-      if (k != 0) {
-        const auto& A = dynamics[k].dfdx;
-        tempMatrixArray[k] += A * A.transpose();
-      }
-
-      absRowSumArray[k] = tempMatrixArray[k].cwiseAbs().rowwise().sum();
-
-      if (k != 0) {
-        const auto& A = dynamics[k].dfdx;
-        absRowSumArray[k] += (A * (scalingVectorsPtr == nullptr ? matrix_t::Identity(A.cols(), A.cols())
-                                                                : (*scalingVectorsPtr)[k - 1].asDiagonal().toDenseMatrix()))
-                                 .cwiseAbs()
-                                 .rowwise()
-                                 .sum();
-      }
-      if (k != N - 1) {
-        const auto& ANext = dynamics[k + 1].dfdx;
-        absRowSumArray[k] += (ANext * (scalingVectorsPtr == nullptr ? matrix_t::Identity(ANext.cols(), ANext.cols())
-                                                                    : (*scalingVectorsPtr)[k].asDiagonal().toDenseMatrix()))
-                                 .transpose()
-                                 .cwiseAbs()
-                                 .rowwise()
-                                 .sum();
-      }
+  auto task = [&](int workerId, int k) {
+    const auto nx_next = ocpSize.numStates[k + 1];
+    const auto& B = dynamics[k].dfdu;
+    tempMatrixArray[k] =
+        (scalingVectorsPtr == nullptr ? matrix_t::Identity(nx_next, nx_next)
+                                      : (*scalingVectorsPtr)[k].cwiseProduct((*scalingVectorsPtr)[k]).asDiagonal().toDenseMatrix());
+    tempMatrixArray[k] += B * B.transpose();
+
+    if (k != 0) {
+      const auto& A = dynamics[k].dfdx;
+      tempMatrixArray[k] += A * A.transpose();
+    }
+
+    absRowSumArray[k] = tempMatrixArray[k].cwiseAbs().rowwise().sum();
+
+    if (k != 0) {
+      const auto& A = dynamics[k].dfdx;
+      absRowSumArray[k] += (A * (scalingVectorsPtr == nullptr ? matrix_t::Identity(A.cols(), A.cols())
+                                                              : (*scalingVectorsPtr)[k - 1].asDiagonal().toDenseMatrix()))
+                               .cwiseAbs()
+                               .rowwise()
+                               .sum();
+    }
+    if (k != N - 1) {
+      const auto& ANext = dynamics[k + 1].dfdx;
+      absRowSumArray[k] += (ANext * (scalingVectorsPtr == nullptr ? matrix_t::Identity(ANext.cols(), ANext.cols())
+                                                                  : (*scalingVectorsPtr)[k].asDiagonal().toDenseMatrix()))
+                               .transpose()
+                               .cwiseAbs()
+                               .rowwise()
+                               .sum();
     }
   };
-  threadPool.runParallel(std::move(task), threadPool.numThreads() + 1U);
+  threadPool.parallelFor(0, N, 1, std::move(task));
 
   vector_t res = vector_t::Zero(getNumDynamicsConstraints(ocpSize));
   int curRow = 0;
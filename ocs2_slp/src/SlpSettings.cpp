@@ -51,6 +51,7 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   }
 
   loadData::loadPtreeValue(pt, settings.slpIteration, fieldName + ".slpIteration", verbose);
+  loadData::loadPtreeValue(pt, settings.maxRunTime, fieldName + ".maxRunTime", verbose);
   loadData::loadPtreeValue(pt, settings.scalingIteration, fieldName + ".scalingIteration", verbose);
   loadData::loadPtreeValue(pt, settings.deltaTol, fieldName + ".deltaTol", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_decay, fieldName + ".alpha_decay", verbose);
@@ -64,6 +65,7 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   auto integratorName = sensitivity_integrator::toString(settings.integratorType);
   loadData::loadPtreeValue(pt, integratorName, fieldName + ".integratorType", verbose);
   settings.integratorType = sensitivity_integrator::fromString(integratorName);
+  loadData::loadPtreeValue(pt, settings.dynamicsBatchSize, fieldName + ".dynamicsBatchSize", verbose);
   loadData::loadPtreeValue(pt, settings.inequalityConstraintMu, fieldName + ".inequalityConstraintMu", verbose);
   loadData::loadPtreeValue(pt, settings.inequalityConstraintDelta, fieldName + ".inequalityConstraintDelta", verbose);
   loadData::loadPtreeValue(pt, settings.extractProjectionMultiplier, fieldName + ".extractProjectionMultiplier", verbose);
@@ -72,6 +74,11 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.printLinesearch, fieldName + ".printLinesearch", verbose);
   loadData::loadPtreeValue(pt, settings.nThreads, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority, fieldName + ".threadPriority", verbose);
+  auto schedulerName = thread_pool::toString(settings.threadScheduler);
+  loadData::loadPtreeValue(pt, schedulerName, fieldName + ".threadScheduler", verbose);
+  settings.threadScheduler = thread_pool::fromString(schedulerName);
+  loadData::loadStdVector(filename, fieldName + ".cpuSet", settings.cpuSet, verbose);
+  loadData::loadPtreeValue(pt, settings.pinCallingThread, fieldName + ".pinCallingThread", verbose);
   settings.pipgSettings = pipg::loadSettings(filename, fieldName + ".pipg", verbose);
 
   if (verbose) {
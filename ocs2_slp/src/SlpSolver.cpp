@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <iostream>
 #include <numeric>
 
+#include <ocs2_core/automatic_differentiation/CppAdModelSwap.h>
 #include <ocs2_oc/multiple_shooting/Helpers.h>
 #include <ocs2_oc/multiple_shooting/Initialization.h>
 #include <ocs2_oc/multiple_shooting/MetricsComputation.h>
@@ -47,8 +48,10 @@ namespace ocs2 {
 
 SlpSolver::SlpSolver(slp::Settings settings, const OptimalControlProblem& optimalControlProblem, const Initializer& initializer)
     : settings_(std::move(settings)),
+      batchDynamicsDiscretization_(settings_.integratorType, settings_.dynamicsBatchSize),
       pipgSolver_(settings_.pipgSettings),
-      threadPool_(std::max(settings_.nThreads - 1, size_t(1)) - 1, settings_.threadPriority) {
+      threadPool_(std::max(settings_.nThreads - 1, size_t(1)) - 1, settings_.threadPriority, settings_.threadScheduler,
+                  settings_.cpuSet, settings_.pinCallingThread) {
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
 
@@ -85,6 +88,7 @@ void SlpSolver::reset() {
   // reset timers
   numProblems_ = 0;
   totalNumIterations_ = 0;
+  convergence_ = slp::Convergence::FALSE;
   initializationTimer_.reset();
   linearQuadraticApproximationTimer_.reset();
   solveQpTimer_.reset();
@@ -157,6 +161,8 @@ const std::vector<PerformanceIndex>& SlpSolver::getIterationsLog() const {
 }
 
 void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  runTimeBudget_.start(1e3 * settings_.maxRunTime);  // the budget includes the initialization
+
   if (settings_.printSolverStatus || settings_.printLinesearch) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     std::cerr << "\n+++++++++++++ SLP solver is initialized ++++++++++++++";
@@ -178,9 +184,14 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     std::ignore = trajectorySpread(primalSolution_.modeSchedule_, this->getReferenceManager().getModeSchedule(), primalSolution_);
   }
 
-  // Initialize the state and input
+  // Initialize the state and input, a previous solution on the same grid is shifted
   vector_array_t x, u;
-  multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  const auto horizonShift = multiple_shooting::findHorizonShift(timeDiscretization, primalSolution_);
+  if (horizonShift.isValid()) {
+    multiple_shooting::shiftStateInputTrajectories(horizonShift, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  } else {
+    multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  }
 
   // Bookkeeping
   performanceIndeces_.clear();
@@ -192,6 +203,8 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     if (settings_.printSolverStatus || settings_.printLinesearch) {
       std::cerr << "\nPIPG iteration: " << iter << "\n";
     }
+    // between iterations no model is evaluated, background compiled AD models are swapped in here
+    swapCompiledCppAdModels();
     // Make QP approximation
     linearQuadraticApproximationTimer_.startTimer();
     const auto baselinePerformance = setupQuadraticSubproblem(timeDiscretization, initState, x, u, metrics);
@@ -217,6 +230,8 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     ++totalNumIterations_;
   }
 
+  convergence_ = convergence;
+
   computeControllerTimer_.startTimer();
   primalSolution_ = toPrimalSolution(timeDiscretization, std::move(x), std::move(u));
   problemMetrics_ = multiple_shooting::toProblemMetrics(timeDiscretization, std::move(metrics));
@@ -232,8 +247,8 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   }
 }
 
-void SlpSolver::runParallel(std::function<void(int)> taskFunction) {
-  threadPool_.runParallel(std::move(taskFunction), settings_.nThreads);
+void SlpSolver::parallelFor(int begin, int end, std::function<void(int, int)> taskFunction) {
+  threadPool_.parallelFor(begin, end, 1, std::move(taskFunction));
 }
 
 SlpSolver::OcpSubproblemSolution SlpSolver::getOCPSolution(const vector_t& delta_x0) {
@@ -313,59 +328,58 @@ PerformanceIndex SlpSolver::setupQuadraticSubproblem(const std::vector<Annotated
   projectionMultiplierCoefficients_.resize(N);
   metrics.resize(N + 1);
 
-  std::atomic_int timeIndex{0};
-  auto parallelTask = [&](int workerId) {
+  // Linearize the dynamics of the intermediate nodes together, stage by stage
+  const bool batchDynamics = settings_.dynamicsBatchSize > 1;
+  if (batchDynamics) {
+    batchDynamicsDiscretization_.update(threadPool_, ocpDefinitions_, time, x, u);
+  }
+
+  auto parallelTask = [&](int workerId, int i) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
-    PerformanceIndex workerPerformance;  // Accumulate performance in local variable
-
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
-        workerPerformance += multiple_shooting::computePerformanceIndex(result);
-        cost_[i] = std::move(result.cost);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i].resize(0, x[i].size());
-        stateIneqConstraints_[i] = std::move(result.ineqConstraints);
-        stateInputIneqConstraints_[i].resize(0, x[i].size());
-        constraintsProjection_[i].resize(0, x[i].size());
-        projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
-      } else {
-        // Normal, intermediate node
-        const scalar_t ti = getIntervalStart(time[i]);
-        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
-        workerPerformance += multiple_shooting::computePerformanceIndex(result, dt);
-        multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier);
-        cost_[i] = std::move(result.cost);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
-        stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
-        stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
-        constraintsProjection_[i] = std::move(result.constraintsProjection);
-        projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
-      }
 
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
+    if (i == N) {
+      // Terminal node
       const scalar_t tN = getIntervalStart(time[N]);
       auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
       metrics[i] = multiple_shooting::computeMetrics(result);
-      workerPerformance += multiple_shooting::computePerformanceIndex(result);
+      performance[workerId] += multiple_shooting::computePerformanceIndex(result);
       cost_[i] = std::move(result.cost);
       stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+    } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      // Event node
+      auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
+      metrics[i] = multiple_shooting::computeMetrics(result);
+      performance[workerId] += multiple_shooting::computePerformanceIndex(result);
+      cost_[i] = std::move(result.cost);
+      dynamics_[i] = std::move(result.dynamics);
+      stateInputEqConstraints_[i].resize(0, x[i].size());
+      stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+      stateInputIneqConstraints_[i].resize(0, x[i].size());
+      constraintsProjection_[i].resize(0, x[i].size());
+      projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
+    } else {
+      // Normal, intermediate node
+      const scalar_t ti = getIntervalStart(time[i]);
+      const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+      auto result =
+          batchDynamics
+              ? multiple_shooting::setupIntermediateNode(ocpDefinition, batchDynamicsDiscretization_.getDiscreteDynamics(i), ti, dt, x[i],
+                                                         x[i + 1], u[i])
+              : multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
+      metrics[i] = multiple_shooting::computeMetrics(result);
+      performance[workerId] += multiple_shooting::computePerformanceIndex(result, dt);
+      multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier);
+      cost_[i] = std::move(result.cost);
+      dynamics_[i] = std::move(result.dynamics);
+      stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
+      stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
+      stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
+      constraintsProjection_[i] = std::move(result.constraintsProjection);
+      projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
     }
-
-    // Accumulate! Same worker might run multiple tasks
-    performance[workerId] += workerPerformance;
   };
-  runParallel(std::move(parallelTask));
+  parallelFor(0, N + 1, std::move(parallelTask));
 
   // Account for init state in performance
   performance.front().dynamicsViolationSSE += (initState - x.front()).squaredNorm();
@@ -384,35 +398,28 @@ PerformanceIndex SlpSolver::computePerformance(const std::vector<AnnotatedTime>&
   metrics.resize(N + 1);
 
   std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
-  std::atomic_int timeIndex{0};
-  auto parallelTask = [&](int workerId) {
+  auto parallelTask = [&](int workerId, int i) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        performance[workerId] += toPerformanceIndex(metrics[i]);
-      } else {
-        // Normal, intermediate node
-        const scalar_t ti = getIntervalStart(time[i]);
-        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        performance[workerId] += toPerformanceIndex(metrics[i], dt);
-      }
-
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
+    if (i == N) {
+      // Terminal node
       const scalar_t tN = getIntervalStart(time[N]);
       metrics[N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
       performance[workerId] += toPerformanceIndex(metrics[N]);
+    } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      // Event node
+      metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
+      performance[workerId] += toPerformanceIndex(metrics[i]);
+    } else {
+      // Normal, intermediate node
+      const scalar_t ti = getIntervalStart(time[i]);
+      const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+      metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
+      performance[workerId] += toPerformanceIndex(metrics[i], dt);
     }
   };
-  runParallel(std::move(parallelTask));
+  parallelFor(0, N + 1, std::move(parallelTask));
 
   // Account for initial state in performance
   const vector_t initDynamicsViolation = initState - x.front();
@@ -535,6 +542,10 @@ slp::Convergence SlpSolver::checkConvergence(int iteration, const PerformanceInd
   } else if (stepInfo.dx_norm < settings_.deltaTol && stepInfo.du_norm < settings_.deltaTol) {
     // Converged because the change in primal variables is below the specified tolerance
     return Convergence::PRIMAL;
+  } else if (!runTimeBudget_.fits(benchmark::TimeBudget::predictDurationInMilliseconds(
+                 {&linearQuadraticApproximationTimer_, &solveQpTimer_, &linesearchTimer_, &computeControllerTimer_}))) {
+    // Terminated because the next iteration and the controller computation are predicted to exceed the time budget
+    return Convergence::TIME;
   } else {
     // None of the above convergence criteria were met -> not converged.
     return Convergence::FALSE;
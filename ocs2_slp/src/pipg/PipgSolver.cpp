@@ -89,143 +89,148 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
 
   size_t k = 0;
   std::atomic_int timeIndex{1}, finishedTaskCounter{0};
-  std::atomic_bool keepRunning{true}, shouldWait{true};
+  std::atomic_bool keepRunning{true};
   bool isConverged = false;
 
   std::mutex mux;
   std::condition_variable iterationFinished;
   std::vector<int> threadsWorkloadCounter(threadPool.numThreads() + 1U, 0);
 
-  auto updateVariablesTask = [&](int workerId) {
-    int t;
-    int workerOrder;
+  auto updateNode = [&](int workerId, int t) {
+    // Multi-thread performance analysis
+    ++threadsWorkloadCounter[workerId];
+
+    // PIPG algorithm
+    const auto& A = dynamics[t - 1].dfdx;
+    const auto& B = dynamics[t - 1].dfdu;
+    const auto& C = scalingVectors[t - 1];
+    const auto& b = dynamics[t - 1].f;
+
+    const auto& R = cost[t - 1].dfduu;
+    const auto& Q = cost[t].dfdxx;
+    const auto& P = cost[t - 1].dfdux;
+    const auto& q = cost[t].dfdx;
+    const auto& r = cost[t - 1].dfdu;
+
+    if (k != 0) {
+      // Update W of the iteration k - 1. Move the update of W to the front of the calculation of V to prevent data race.
+      // vector_t primalResidual = C * X_[t] - A * X_[t - 1] - B * U_[t - 1] - b;
+      primalResidualArray[t - 1] = -b;
+      primalResidualArray[t - 1].array() += C.array() * X_[t].array();
+      primalResidualArray[t - 1].noalias() -= A * X_[t - 1];
+      primalResidualArray[t - 1].noalias() -= B * U_[t - 1];
+      if (EInv != nullptr) {
+        constraintsViolationInfNormArray[t - 1] = (*EInv)[t - 1].cwiseProduct(primalResidualArray[t - 1]).lpNorm<Eigen::Infinity>();
+      } else {
+        constraintsViolationInfNormArray[t - 1] = primalResidualArray[t - 1].lpNorm<Eigen::Infinity>();
+      }
 
-    while (keepRunning) {
-      // Reset workerOrder in case all tasks have been assigned and some workers cannot enter the following while loop, keeping the
-      // workerOrder from previous iterations.
-      workerOrder = 0;
-      while ((t = timeIndex++) <= N) {
-        if (t == N) {
-          std::lock_guard<std::mutex> lk(mux);
-          shouldWait = true;
-        }
-        // Multi-thread performance analysis
-        ++threadsWorkloadCounter[workerId];
-
-        // PIPG algorithm
-        const auto& A = dynamics[t - 1].dfdx;
-        const auto& B = dynamics[t - 1].dfdu;
-        const auto& C = scalingVectors[t - 1];
-        const auto& b = dynamics[t - 1].f;
-
-        const auto& R = cost[t - 1].dfduu;
-        const auto& Q = cost[t].dfdxx;
-        const auto& P = cost[t - 1].dfdux;
-        const auto& q = cost[t].dfdx;
-        const auto& r = cost[t - 1].dfdu;
-
-        if (k != 0) {
-          // Update W of the iteration k - 1. Move the update of W to the front of the calculation of V to prevent data race.
-          // vector_t primalResidual = C * X_[t] - A * X_[t - 1] - B * U_[t - 1] - b;
-          primalResidualArray[t - 1] = -b;
-          primalResidualArray[t - 1].array() += C.array() * X_[t].array();
-          primalResidualArray[t - 1].noalias() -= A * X_[t - 1];
-          primalResidualArray[t - 1].noalias() -= B * U_[t - 1];
-          if (EInv != nullptr) {
-            constraintsViolationInfNormArray[t - 1] = (*EInv)[t - 1].cwiseProduct(primalResidualArray[t - 1]).lpNorm<Eigen::Infinity>();
-          } else {
-            constraintsViolationInfNormArray[t - 1] = primalResidualArray[t - 1].lpNorm<Eigen::Infinity>();
-          }
-
-          WNew_[t - 1] = W_[t - 1] + betaLast * primalResidualArray[t - 1];
-
-          // What stored in UNew and XNew is the solution of iteration k - 2 and what stored in U and X is the solution of iteration k
-          // - 1. By convention, iteration starts from 0 and the solution of iteration -1 is the initial value. Reuse UNew and XNew
-          // memory to store the difference between the last solution and the one before last solution.
-          UNew_[t - 1] -= U_[t - 1];
-          XNew_[t] -= X_[t];
-
-          solutionSEArray[t - 1] = UNew_[t - 1].squaredNorm() + XNew_[t].squaredNorm();
-          solutionSquaredNormArray[t - 1] = U_[t - 1].squaredNorm() + X_[t].squaredNorm();
-        }
+      WNew_[t - 1] = W_[t - 1] + betaLast * primalResidualArray[t - 1];
 
-        // V_[t - 1] = W_[t - 1] + (beta + betaLast) * (C * X_[t] - A * X_[t - 1] - B * U_[t - 1] - b);
-        V_[t - 1] = W_[t - 1] - (beta + betaLast) * b;
-        V_[t - 1].array() += (beta + betaLast) * C.array() * X_[t].array();
-        V_[t - 1].noalias() -= (beta + betaLast) * (A * X_[t - 1]);
-        V_[t - 1].noalias() -= (beta + betaLast) * (B * U_[t - 1]);
-
-        // UNew_[t - 1] = U_[t - 1] - alpha * (R * U_[t - 1] + P * X_[t - 1] + r - B.transpose() * V_[t - 1]);
-        UNew_[t - 1] = U_[t - 1] - alpha * r;
-        UNew_[t - 1].noalias() -= alpha * (R * U_[t - 1]);
-        UNew_[t - 1].noalias() -= alpha * (P * X_[t - 1]);
-        UNew_[t - 1].noalias() += alpha * (B.transpose() * V_[t - 1]);
-
-        // XNew_[t] = X_[t] - alpha * (Q * X_[t] + q + C * V_[t - 1]);
-        XNew_[t] = X_[t] - alpha * q;
-        XNew_[t].array() -= alpha * C.array() * V_[t - 1].array();
-        XNew_[t].noalias() -= alpha * (Q * X_[t]);
-
-        if (t != N) {
-          const auto& ANext = dynamics[t].dfdx;
-          const auto& BNext = dynamics[t].dfdu;
-          const auto& CNext = scalingVectors[t];
-          const auto& bNext = dynamics[t].f;
-
-          // dfdux
-          const auto& PNext = cost[t].dfdux;
-
-          // vector_t VNext = W_[t] + (beta + betaLast) * (CNext * X_[t + 1] - ANext * X_[t] - BNext * U_[t] - bNext);
-          vector_t VNext = W_[t] - (beta + betaLast) * bNext;
-          VNext.array() += (beta + betaLast) * CNext.array() * X_[t + 1].array();
-          VNext.noalias() -= (beta + betaLast) * (ANext * X_[t]);
-          VNext.noalias() -= (beta + betaLast) * (BNext * U_[t]);
-
-          XNew_[t].noalias() += alpha * (ANext.transpose() * VNext);
-          // Add dfdxu * du if it is not the final state.
-          XNew_[t].noalias() -= alpha * (PNext.transpose() * U_[t]);
-        }
+      // What stored in UNew and XNew is the solution of iteration k - 2 and what stored in U and X is the solution of iteration k
+      // - 1. By convention, iteration starts from 0 and the solution of iteration -1 is the initial value. Reuse UNew and XNew
+      // memory to store the difference between the last solution and the one before last solution.
+      UNew_[t - 1] -= U_[t - 1];
+      XNew_[t] -= X_[t];
+
+      solutionSEArray[t - 1] = UNew_[t - 1].squaredNorm() + XNew_[t].squaredNorm();
+      solutionSquaredNormArray[t - 1] = U_[t - 1].squaredNorm() + X_[t].squaredNorm();
+    }
 
+    // V_[t - 1] = W_[t - 1] + (beta + betaLast) * (C * X_[t] - A * X_[t - 1] - B * U_[t - 1] - b);
+    V_[t - 1] = W_[t - 1] - (beta + betaLast) * b;
+    V_[t - 1].array() += (beta + betaLast) * C.array() * X_[t].array();
+    V_[t - 1].noalias() -= (beta + betaLast) * (A * X_[t - 1]);
+    V_[t - 1].noalias() -= (beta + betaLast) * (B * U_[t - 1]);
+
+    // UNew_[t - 1] = U_[t - 1] - alpha * (R * U_[t - 1] + P * X_[t - 1] + r - B.transpose() * V_[t - 1]);
+    UNew_[t - 1] = U_[t - 1] - alpha * r;
+    UNew_[t - 1].noalias() -= alpha * (R * U_[t - 1]);
+    UNew_[t - 1].noalias() -= alpha * (P * X_[t - 1]);
+    UNew_[t - 1].noalias() += alpha * (B.transpose() * V_[t - 1]);
+
+    // XNew_[t] = X_[t] - alpha * (Q * X_[t] + q + C * V_[t - 1]);
+    XNew_[t] = X_[t] - alpha * q;
+    XNew_[t].array() -= alpha * C.array() * V_[t - 1].array();
+    XNew_[t].noalias() -= alpha * (Q * X_[t]);
+
+    if (t != N) {
+      const auto& ANext = dynamics[t].dfdx;
+      const auto& BNext = dynamics[t].dfdu;
+      const auto& CNext = scalingVectors[t];
+      const auto& bNext = dynamics[t].f;
+
+      // dfdux
+      const auto& PNext = cost[t].dfdux;
+
+      // vector_t VNext = W_[t] + (beta + betaLast) * (CNext * X_[t + 1] - ANext * X_[t] - BNext * U_[t] - bNext);
+      vector_t VNext = W_[t] - (beta + betaLast) * bNext;
+      VNext.array() += (beta + betaLast) * CNext.array() * X_[t + 1].array();
+      VNext.noalias() -= (beta + betaLast) * (ANext * X_[t]);
+      VNext.noalias() -= (beta + betaLast) * (BNext * U_[t]);
+
+      XNew_[t].noalias() += alpha * (ANext.transpose() * VNext);
+      // Add dfdxu * du if it is not the final state.
+      XNew_[t].noalias() -= alpha * (PNext.transpose() * U_[t]);
+    }
+  };
+
+  // The workers stay in the pool for all iterations, dispatching them one by one costs more than the cheap PIPG iterations. The worker
+  // finishing the last node of an iteration runs the serial update and releases the others into the next iteration.
+  auto updateVariablesTask = [&](int workerId) {
+    while (keepRunning) {
+      size_t iteration;
+      {
+        std::lock_guard<std::mutex> lk(mux);
+        iteration = k;
+      }
+
+      int t;
+      int workerOrder = 0;
+      while ((t = timeIndex++) <= N) {
+        updateNode(workerId, t);
         workerOrder = ++finishedTaskCounter;
       }
 
       if (workerOrder != N) {
         std::unique_lock<std::mutex> lk(mux);
-        iterationFinished.wait(lk, [&shouldWait] { return !shouldWait; });
-        lk.unlock();
-      } else {
-        betaLast = beta;
-        // Adaptive step size
-        beta = pipgBounds.dualStepSize(k);
-        alpha = pipgBounds.primalStepSize(k);
+        iterationFinished.wait(lk, [&] { return k != iteration; });
+        continue;
+      }
 
-        if (k != 0 && k % settings().checkTerminationInterval == 0) {
-          constraintsViolationInfNorm =
-              *(std::max_element(constraintsViolationInfNormArray.begin(), constraintsViolationInfNormArray.end()));
+      betaLast = beta;
+      // Adaptive step size
+      beta = pipgBounds.dualStepSize(k);
+      alpha = pipgBounds.primalStepSize(k);
 
-          solutionSSE = std::accumulate(solutionSEArray.begin(), solutionSEArray.end(), 0.0);
-          solutionSquaredNorm = std::accumulate(solutionSquaredNormArray.begin(), solutionSquaredNormArray.end(), 0.0);
+      if (k != 0 && k % settings().checkTerminationInterval == 0) {
+        constraintsViolationInfNorm =
+            *(std::max_element(constraintsViolationInfNormArray.begin(), constraintsViolationInfNormArray.end()));
 
-          isConverged = constraintsViolationInfNorm <= settings().absoluteTolerance &&
-                        (solutionSSE <= settings().relativeTolerance * settings().relativeTolerance * solutionSquaredNorm ||
-                         solutionSSE <= settings().absoluteTolerance);
+        solutionSSE = std::accumulate(solutionSEArray.begin(), solutionSEArray.end(), 0.0);
+        solutionSquaredNorm = std::accumulate(solutionSquaredNormArray.begin(), solutionSquaredNormArray.end(), 0.0);
 
-          keepRunning = k < settings().maxNumIterations && !isConverged;
-        }
+        isConverged = constraintsViolationInfNorm <= settings().absoluteTolerance &&
+                      (solutionSSE <= settings().relativeTolerance * settings().relativeTolerance * solutionSquaredNorm ||
+                       solutionSSE <= settings().absoluteTolerance);
+
+        keepRunning = k < settings().maxNumIterations && !isConverged;
+      }
 
-        XNew_.swap(X_);
-        UNew_.swap(U_);
-        WNew_.swap(W_);
+      XNew_.swap(X_);
+      UNew_.swap(U_);
+      WNew_.swap(W_);
 
+      // open the next iteration only after the serial update, and never after the last one
+      finishedTaskCounter = 0;
+      {
+        std::lock_guard<std::mutex> lk(mux);
         ++k;
-        finishedTaskCounter = 0;
-        timeIndex = 1;
-        {
-          std::lock_guard<std::mutex> lk(mux);
-          shouldWait = false;
+        if (keepRunning) {
+          timeIndex = 1;
         }
-        iterationFinished.notify_all();
       }
+      iterationFinished.notify_all();
     }
   };
   threadPool.runParallel(std::move(updateVariablesTask), threadPool.numThreads() + 1U);
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/initialization/DefaultInitializer.h>
 #include <ocs2_oc/synchronized_module/ReferenceManager.h>
+#include <ocs2_oc/test/circular_kinematics.h>
 #include <ocs2_oc/test/testProblemsGeneration.h>
 
 #include "ocs2_slp/SlpSolver.h"
@@ -121,3 +122,59 @@ TEST(testSlpSolver, test_unconstrained) {
   ASSERT_LE(result.second.size(), 2);
   ASSERT_LT(result.second.back().dynamicsViolationSSE, tol);
 }
+
+TEST(testSlpSolver, test_maxRunTime) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/slp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  auto slpSettings = []() {
+    ocs2::slp::Settings settings;
+    settings.dt = 0.01;
+    settings.slpIteration = 1000;
+    settings.scalingIteration = 3;
+    settings.printSolverStatistics = false;
+    settings.printSolverStatus = false;
+    settings.printLinesearch = false;
+    settings.nThreads = 1;
+    settings.pipgSettings.maxNumIterations = 30000;
+    settings.pipgSettings.absoluteTolerance = 1e-6;
+    settings.pipgSettings.relativeTolerance = 1e-2;
+    settings.pipgSettings.lowerBoundH = 1e-3;
+    settings.pipgSettings.checkTerminationInterval = 1;
+    return settings;
+  }();
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Without a time budget the solver converges after more than one iteration
+  ocs2::SlpSolver referenceSolver(slpSettings, problem, zeroInitializer);
+  referenceSolver.run(startTime, initState, finalTime);
+  ASSERT_NE(referenceSolver.getConvergence(), ocs2::slp::Convergence::TIME);
+  ASSERT_NE(referenceSolver.getConvergence(), ocs2::slp::Convergence::ITERATIONS);
+  ASSERT_GT(referenceSolver.getNumIterations(), 1u);
+
+  // The budget is exhausted after the first iteration, which always runs
+  slpSettings.maxRunTime = 1e-6;
+  ocs2::SlpSolver solver(slpSettings, problem, zeroInitializer);
+  solver.run(startTime, initState, finalTime);
+  ASSERT_EQ(solver.getConvergence(), ocs2::slp::Convergence::TIME);
+  ASSERT_EQ(solver.getNumIterations(), 1u);
+
+  // The solution of the first iteration is returned
+  const auto primalSolution = solver.primalSolution(finalTime);
+  ASSERT_TRUE(primalSolution.stateTrajectory_.front().isApprox(initState));
+  ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.front(), startTime);
+  ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.back(), finalTime);
+  ASSERT_TRUE(primalSolution.controllerPtr_ != nullptr);
+  for (size_t i = 0; i < primalSolution.timeTrajectory_.size() - 1; i++) {
+    ASSERT_TRUE(primalSolution.stateTrajectory_[i].allFinite());
+    ASSERT_TRUE(primalSolution.inputTrajectory_[i].allFinite());
+  }
+}
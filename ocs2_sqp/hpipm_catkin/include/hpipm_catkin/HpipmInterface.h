@@ -45,6 +45,10 @@ namespace ocs2 {
 /**
  * This class implements the interface between Linear Quadratic optimal control problems defined in OCS2 and the HPIPM solver.
  * If the problem dimensions change, resize needs to be called to re-initialize HPIPM.
+ *
+ * With Settings::numCondensingBlocks, the stage-wise problem is partially condensed before it is solved and the solution is expanded
+ * afterwards. The solution and the Riccati quantities are returned for all stages of the original problem. Problems with constraints
+ * are not condensed, see isCondensed().
  */
 class HpipmInterface {
  public:
@@ -62,11 +66,16 @@ class HpipmInterface {
   /** Resize the problem */
   void resize(OcpSize ocpSize);
 
+  /** Whether the problem of the current size is partially condensed. Settings::numCondensingBlocks is ignored for constrained problems. */
+  bool isCondensed() const;
+
   /**
    * Solves a discrete linear quadratic optimal control problem. The interface needs to be resized to a consistent OcpSize before calling
    * this function
    *
    * The problem should be consistently defined in absolute or delta decision variables in x and u.
+   * If the problem is partially condensed, the Riccati quantities inside the condensed blocks are recovered from a copy of dynamics and
+   * cost on the first call to one of the getRiccati* functions, and cached until the next solve().
    *
    * @param x0 : Initial state (deviation).
    * @param dynamics : Linearized approximation of the discrete dynamics.
@@ -54,6 +54,10 @@ struct Settings {
   int warm_start = 0;
   int pred_corr = 1;
   int ric_alg = 0;  // square root ricatti recursion
+
+  // Number of stages of the partially condensed QP that is passed to the solver (N2 in HPIPM). Consecutive stages are condensed into
+  // blocks of about N / numCondensingBlocks stages. Set to 0 to solve the stage-wise QP. Problems with constraints are not condensed.
+  int numCondensingBlocks = 0;
 };
 
 std::ostream& operator<<(std::ostream& stream, const Settings& settings);
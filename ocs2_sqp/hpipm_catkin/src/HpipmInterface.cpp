@@ -29,6 +29,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "hpipm_catkin/HpipmInterface.h"
 
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
 #include <ocs2_core/misc/LinearAlgebra.h>
 
 extern "C" {
@@ -36,6 +40,7 @@ extern "C" {
 #include <hpipm_d_ocp_qp_dim.h>
 #include <hpipm_d_ocp_qp_ipm.h>
 #include <hpipm_d_ocp_qp_sol.h>
+#include <hpipm_d_part_cond.h>
 #include <hpipm_timing.h>
 }
 
@@ -100,6 +105,7 @@ class HpipmInterface::Impl {
     }
 
     ocpSize_ = std::move(ocpSize);
+    isCondensedRiccatiComputed_ = false;
 
     const int dim_size = d_ocp_qp_dim_memsize(ocpSize_.numStages);
     dimMem_.reserve(dim_size);
@@ -116,16 +122,68 @@ class HpipmInterface::Impl {
     qpSolMem_.reserve(qp_sol_size);
     d_ocp_qp_sol_create(&dim_, &qpSol_, qpSolMem_.get());
 
-    const int ipm_arg_size = d_ocp_qp_ipm_arg_memsize(&dim_);
+    // The solver works on the partially condensed problem if condensing is enabled
+    initializeCondensing();
+    d_ocp_qp_dim* solverDim = isCondensed_ ? &condensedDim_ : &dim_;
+
+    const int ipm_arg_size = d_ocp_qp_ipm_arg_memsize(solverDim);
     ipmArgMem_.reserve(ipm_arg_size);
-    d_ocp_qp_ipm_arg_create(&dim_, &arg_, ipmArgMem_.get());
+    d_ocp_qp_ipm_arg_create(solverDim, &arg_, ipmArgMem_.get());
 
     applySettings(settings_);
 
     // Setup workspace after applying the settings
-    const int ipm_size = d_ocp_qp_ipm_ws_memsize(&dim_, &arg_);
+    const int ipm_size = d_ocp_qp_ipm_ws_memsize(solverDim, &arg_);
     ipmMem_.reserve(ipm_size);
-    d_ocp_qp_ipm_ws_create(&dim_, &arg_, &workspace_, ipmMem_.get());
+    d_ocp_qp_ipm_ws_create(solverDim, &arg_, &workspace_, ipmMem_.get());
+  }
+
+  bool isCondensed() const { return isCondensed_; }
+
+  void initializeCondensing() {
+    const int numBlocks = settings_.numCondensingBlocks;
+    const auto hasConstraints = [](const std::vector<int>& numConstraints) {
+      return std::any_of(numConstraints.begin(), numConstraints.end(), [](int n) { return n > 0; });
+    };
+
+    // The Riccati quantities inside the blocks are reconstructed from the stage-wise problem, which is only exact without constraints.
+    const bool isConstrained = hasConstraints(ocpSize_.numIneqConstraints) || hasConstraints(ocpSize_.numStateBoxConstraints) ||
+                               hasConstraints(ocpSize_.numInputBoxConstraints);
+    isCondensed_ = 0 < numBlocks && numBlocks < ocpSize_.numStages && !isConstrained;
+    if (!isCondensed_) {
+      if (0 < numBlocks && isConstrained && !hasWarnedAboutConstraints_) {
+        std::cerr << "[HpipmInterface] numCondensingBlocks = " << numBlocks
+                  << " is ignored, problems with constraints are solved without partial condensing.\n";
+        hasWarnedAboutConstraints_ = true;
+      }
+      return;
+    }
+
+    // Stage i of the condensed problem combines blockSize_[i] consecutive stages. The terminal stage is not condensed.
+    blockSize_.resize(numBlocks + 1);
+    d_part_cond_qp_compute_block_size(ocpSize_.numStages, numBlocks, blockSize_.data());
+
+    const int dim_size = d_ocp_qp_dim_memsize(numBlocks);
+    condensedDimMem_.reserve(dim_size);
+    d_ocp_qp_dim_create(numBlocks, &condensedDim_, condensedDimMem_.get());
+    d_part_cond_qp_compute_dim(&dim_, blockSize_.data(), &condensedDim_);
+
+    const int qp_size = d_ocp_qp_memsize(&condensedDim_);
+    condensedQpMem_.reserve(qp_size);
+    d_ocp_qp_create(&condensedDim_, &condensedQp_, condensedQpMem_.get());
+
+    const int qp_sol_size = d_ocp_qp_sol_memsize(&condensedDim_);
+    condensedQpSolMem_.reserve(qp_sol_size);
+    d_ocp_qp_sol_create(&condensedDim_, &condensedQpSol_, condensedQpSolMem_.get());
+
+    const int cond_arg_size = d_part_cond_qp_arg_memsize(numBlocks);
+    condArgMem_.reserve(cond_arg_size);
+    d_part_cond_qp_arg_create(numBlocks, &condArg_, condArgMem_.get());
+    d_part_cond_qp_arg_set_default(&condArg_);
+
+    const int cond_size = d_part_cond_qp_ws_memsize(&dim_, blockSize_.data(), &condensedDim_, &condArg_);
+    condMem_.reserve(cond_size);
+    d_part_cond_qp_ws_create(&dim_, blockSize_.data(), &condensedDim_, &condArg_, &condWorkspace_, condMem_.get());
   }
 
   void applySettings(Settings& settings) {
@@ -281,7 +339,22 @@ class HpipmInterface::Impl {
     // === Set and solve ===
     d_ocp_qp_set_all(AA.data(), BB.data(), bb.data(), QQ.data(), SS.data(), RR.data(), qq.data(), rr.data(), hidxbx, hlbx, hubx, hidxbu,
                      hlbu, hubu, CC.data(), DD.data(), llg.data(), uug.data(), hZl, hZu, hzl, hzu, hidxs, hlls, hlus, &qp_);
-    d_ocp_qp_ipm_solve(&qp_, &qpSol_, &arg_, &workspace_);
+    if (isCondensed_) {
+      d_part_cond_qp_cond(&qp_, &condensedQp_, &condArg_, &condWorkspace_);
+      d_ocp_qp_ipm_solve(&condensedQp_, &condensedQpSol_, &arg_, &workspace_);
+      d_part_cond_qp_expand_sol(&qp_, &condensedQpSol_, &qpSol_, &condArg_, &condWorkspace_);
+
+      // Keep a copy of the stage-wise problem to reconstruct the Riccati quantities inside the blocks on the first getter call
+      stagewiseDynamics_.resize(N);
+      stagewiseCost_.resize(N);
+      for (int k = 1; k < N; k++) {
+        stagewiseDynamics_[k] = dynamics[k];
+        stagewiseCost_[k] = cost[k];
+      }
+      isCondensedRiccatiComputed_ = false;
+    } else {
+      d_ocp_qp_ipm_solve(&qp_, &qpSol_, &arg_, &workspace_);
+    }
 
     if (verbose) {
       printStatus();
@@ -328,6 +401,14 @@ class HpipmInterface::Impl {
   }
 
   matrix_array_t getRiccatiFeedback(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0) {
+    if (isCondensed_) {
+      const auto& riccati = getCondensedRiccati();
+      matrix_array_t RiccatiFeedback = riccati.feedback;
+      vector_t feedforward0;
+      riccatiStep(dynamics0, cost0, riccati.costToGo[1], nullptr, RiccatiFeedback[0], feedforward0);
+      return RiccatiFeedback;
+    }
+
     const int N = ocpSize_.numStages;
     matrix_array_t RiccatiFeedback(N);
 
@@ -367,6 +448,14 @@ class HpipmInterface::Impl {
 
   vector_array_t getRiccatiFeedforward(const VectorFunctionLinearApproximation& dynamics0,
                                        const ScalarFunctionQuadraticApproximation& cost0) {
+    if (isCondensed_) {
+      const auto& riccati = getCondensedRiccati();
+      vector_array_t RiccatiFeedforward = riccati.feedforward;
+      matrix_t feedback0;
+      riccatiStep(dynamics0, cost0, riccati.costToGo[1], nullptr, feedback0, RiccatiFeedforward[0]);
+      return RiccatiFeedforward;
+    }
+
     const int N = ocpSize_.numStages;
     vector_array_t RiccatiFeedforward(N);
 
@@ -402,6 +491,15 @@ class HpipmInterface::Impl {
     /*
      * Note on notation: HPIPM uses P, p for the cost-to-go, where we use Sm, sv
      */
+    if (isCondensed_) {
+      const auto& riccati = getCondensedRiccati();
+      std::vector<ScalarFunctionQuadraticApproximation> RiccatiCostToGo = riccati.costToGo;
+      matrix_t feedback0;
+      vector_t feedforward0;
+      riccatiStep(dynamics0, cost0, riccati.costToGo[1], &RiccatiCostToGo[0], feedback0, feedforward0);
+      return RiccatiCostToGo;
+    }
+
     const int N = ocpSize_.numStages;
     std::vector<ScalarFunctionQuadraticApproximation> RiccatiCostToGo(N + 1);
 
@@ -454,6 +552,113 @@ class HpipmInterface::Impl {
     return RiccatiCostToGo;
   }
 
+  struct RiccatiSolution {
+    std::vector<ScalarFunctionQuadraticApproximation> costToGo;
+    matrix_array_t feedback;
+    vector_array_t feedforward;
+  };
+
+  /**
+   * Riccati quantities of the stages k >= 1 of the previously solved, partially condensed problem. They are computed on the first call
+   * after each solve and cached, the stage k = 0 depends on the arguments of the getters and is completed by them.
+   */
+  const RiccatiSolution& getCondensedRiccati() {
+    if (!isCondensedRiccatiComputed_) {
+      computeCondensedRiccati();
+      isCondensedRiccatiComputed_ = true;
+    }
+    return condensedRiccati_;
+  }
+
+  /**
+   * HPIPM only provides the cost-to-go at the first node of each block. The other nodes are recovered with the Riccati recursion of the
+   * stage-wise problem, starting from the end of each block.
+   */
+  void computeCondensedRiccati() {
+    const int N = ocpSize_.numStages;
+    const auto& dynamics = stagewiseDynamics_;
+    const auto& cost = stagewiseCost_;
+
+    auto& solution = condensedRiccati_;
+    solution.costToGo.resize(N + 1);
+    solution.feedback.resize(N);
+    solution.feedforward.resize(N);
+
+    // k = N is the terminal stage of the condensed problem. k = 0 is not a block start, since the state is not a decision variable
+    int condensedStage = settings_.numCondensingBlocks;
+    int blockStart = N;
+    for (int k = N; k >= 1; k--) {
+      const bool isBlockStart = (k == blockStart);
+      if (k < N) {
+        auto* costToGo_k = isBlockStart ? nullptr : &solution.costToGo[k];
+        riccatiStep(dynamics[k], cost[k], solution.costToGo[k + 1], costToGo_k, solution.feedback[k], solution.feedforward[k]);
+      }
+
+      if (isBlockStart) {
+        auto& costToGo_k = solution.costToGo[k];
+        costToGo_k.dfdxx.resize(ocpSize_.numStates[k], ocpSize_.numStates[k]);
+        costToGo_k.dfdx.resize(ocpSize_.numStates[k]);
+        d_ocp_qp_ipm_get_ric_P(&condensedQp_, &arg_, &workspace_, condensedStage, costToGo_k.dfdxx.data());
+        d_ocp_qp_ipm_get_ric_p(&condensedQp_, &arg_, &workspace_, condensedStage, costToGo_k.dfdx.data());
+        condensedStage--;
+        blockStart -= blockSize_[condensedStage];
+      }
+    }
+  }
+
+  /**
+   * One step of the discrete-time Riccati recursion of the stage-wise problem.
+   *
+   * @param [in] dynamics : dynamics at k
+   * @param [in] cost : cost at k
+   * @param [in] nextCostToGo : cost-to-go at k + 1
+   * @param [out] costToGo : cost-to-go at k, not computed if nullptr
+   * @param [out] feedback : feedback matrix K at k, untouched if there are no inputs
+   * @param [out] feedforward : feedforward vector k at k, untouched if there are no inputs
+   */
+  static void riccatiStep(const VectorFunctionLinearApproximation& dynamics, const ScalarFunctionQuadraticApproximation& cost,
+                          const ScalarFunctionQuadraticApproximation& nextCostToGo, ScalarFunctionQuadraticApproximation* costToGo,
+                          matrix_t& feedback, vector_t& feedforward) {
+    // Shorthand notation
+    const matrix_t& A = dynamics.dfdx;
+    const matrix_t& B = dynamics.dfdu;
+    const matrix_t& P = nextCostToGo.dfdxx;
+    const matrix_t P_A = P * A;
+    vector_t p_Pb = nextCostToGo.dfdx;  // p + P * b
+    p_Pb.noalias() += P * dynamics.f;
+
+    if (costToGo != nullptr) {
+      costToGo->dfdxx = cost.dfdxx;
+      costToGo->dfdxx.noalias() += A.transpose() * P_A;
+      costToGo->dfdx = cost.dfdx;
+      costToGo->dfdx.noalias() += A.transpose() * p_Pb;
+    }
+
+    if (B.cols() > 0) {
+      // Lr * Lr^T = R + B^T * P * B, Lr matrix is lower triangular
+      const matrix_t P_B = P * B;
+      matrix_t Lr = cost.dfduu;
+      Lr.noalias() += B.transpose() * P_B;
+      Lr = Lr.llt().matrixL();
+      LinearAlgebra::setTriangularMinimumEigenvalues(Lr);
+
+      // tmp1 = inv(Lr) * (S + B^T * P * A), tmp2 = inv(Lr) * (r + B^T * p + B^T * P * b)
+      matrix_t tmp1 = cost.dfdux;
+      tmp1.noalias() += P_B.transpose() * A;
+      Lr.triangularView<Eigen::Lower>().solveInPlace(tmp1);
+      vector_t tmp2 = cost.dfdu;
+      tmp2.noalias() += B.transpose() * p_Pb;
+      Lr.triangularView<Eigen::Lower>().solveInPlace(tmp2);
+
+      if (costToGo != nullptr) {
+        costToGo->dfdxx.noalias() -= tmp1.transpose() * tmp1;
+        costToGo->dfdx.noalias() -= tmp1.transpose() * tmp2;
+      }
+      feedback.noalias() = -Lr.triangularView<Eigen::Lower>().transpose().solve(tmp1);
+      feedforward.noalias() = -Lr.triangularView<Eigen::Lower>().transpose().solve(tmp2);
+    }
+  }
+
   void printStatus() {
     int hpipmStatus = -1;
     d_ocp_qp_ipm_get_status(&workspace_, &hpipmStatus);
@@ -520,6 +725,32 @@ class HpipmInterface::Impl {
 
   MemoryBlock ipmMem_;
   d_ocp_qp_ipm_ws workspace_;
+
+  // Partial condensing
+  bool isCondensed_ = false;
+  bool hasWarnedAboutConstraints_ = false;
+  std::vector<int> blockSize_;
+
+  MemoryBlock condensedDimMem_;
+  d_ocp_qp_dim condensedDim_;
+
+  MemoryBlock condensedQpMem_;
+  d_ocp_qp condensedQp_;
+
+  MemoryBlock condensedQpSolMem_;
+  d_ocp_qp_sol condensedQpSol_;
+
+  MemoryBlock condArgMem_;
+  d_part_cond_qp_arg condArg_;
+
+  MemoryBlock condMem_;
+  d_part_cond_qp_ws condWorkspace_;
+
+  // Stages k = 1, ..., N-1 of the last solved stage-wise problem, needed to reconstruct the Riccati quantities inside the blocks
+  std::vector<VectorFunctionLinearApproximation> stagewiseDynamics_;
+  std::vector<ScalarFunctionQuadraticApproximation> stagewiseCost_;
+  RiccatiSolution condensedRiccati_;
+  bool isCondensedRiccatiComputed_ = false;
 };
 
 HpipmInterface::HpipmInterface(OcpSize ocpSize, const Settings& settings)
@@ -527,6 +758,10 @@ HpipmInterface::HpipmInterface(OcpSize ocpSize, const Settings& settings)
 
 HpipmInterface::~HpipmInterface() = default;
 
+bool HpipmInterface::isCondensed() const {
+  return pImpl_->isCondensed();
+}
+
 void HpipmInterface::resize(OcpSize ocpSize) {
   pImpl_->initializeMemory(std::move(ocpSize));
 }
@@ -29,8 +29,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <iostream>
+
 #include "hpipm_catkin/HpipmInterface.h"
 
+#include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/test/testTools.h>
 #include <ocs2_oc/test/testProblemsGeneration.h>
 
@@ -338,3 +341,160 @@ TEST(test_hpiphm_interface, retrieveRiccati) {
     ASSERT_TRUE(uSol[k].isApprox(KSol[k] * xSol[k] + kSol[k]));
   }
 }
+
+TEST(test_hpiphm_interface, partialCondensing) {
+  int nx = 3;
+  int nu = 2;
+  int N = 5;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+
+  // Reference solution of the stage-wise problem
+  ocs2::OcpSize ocpSize(N, nx, nu);
+  ocs2::HpipmInterface hpipmInterface(ocpSize);
+  std::vector<ocs2::vector_t> xSolGiven;
+  std::vector<ocs2::vector_t> uSolGiven;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, nullptr, xSolGiven, uSolGiven), hpipm_status::SUCCESS);
+  const auto KSolGiven = hpipmInterface.getRiccatiFeedback(system[0], cost[0]);
+  const auto kSolGiven = hpipmInterface.getRiccatiFeedforward(system[0], cost[0]);
+  const auto CostToGoGiven = hpipmInterface.getRiccatiCostToGo(system[0], cost[0]);
+
+  for (int numBlocks = 1; numBlocks < N; numBlocks++) {
+    ocs2::HpipmInterface::Settings settings;
+    settings.numCondensingBlocks = numBlocks;
+    ocs2::HpipmInterface condensedHpipmInterface(ocpSize, settings);
+    ASSERT_TRUE(condensedHpipmInterface.isCondensed());
+
+    // Solve! The Riccati quantities must not depend on the problem data after solve()
+    std::vector<ocs2::vector_t> xSol;
+    std::vector<ocs2::vector_t> uSol;
+    {
+      auto systemCopy = system;
+      auto costCopy = cost;
+      const auto status = condensedHpipmInterface.solve(x0, systemCopy, costCopy, nullptr, xSol, uSol);
+      ASSERT_EQ(status, hpipm_status::SUCCESS);
+    }
+
+    // The expanded solution and the Riccati quantities are the ones of the stage-wise problem
+    const auto KSol = condensedHpipmInterface.getRiccatiFeedback(system[0], cost[0]);
+    const auto kSol = condensedHpipmInterface.getRiccatiFeedforward(system[0], cost[0]);
+    const auto CostToGo = condensedHpipmInterface.getRiccatiCostToGo(system[0], cost[0]);
+    ASSERT_TRUE(ocs2::isEqual(xSolGiven, xSol, 1e-9)) << "numBlocks: " << numBlocks;
+    ASSERT_TRUE(ocs2::isEqual(uSolGiven, uSol, 1e-9)) << "numBlocks: " << numBlocks;
+    ASSERT_TRUE(ocs2::isEqual(KSolGiven, KSol, 1e-9)) << "numBlocks: " << numBlocks;
+    ASSERT_TRUE(ocs2::isEqual(kSolGiven, kSol, 1e-9)) << "numBlocks: " << numBlocks;
+    for (int i = 0; i < (N + 1); i++) {
+      ASSERT_TRUE(CostToGoGiven[i].dfdxx.isApprox(CostToGo[i].dfdxx, 1e-9)) << "numBlocks: " << numBlocks << ", node: " << i;
+      ASSERT_TRUE(CostToGoGiven[i].dfdx.isApprox(CostToGo[i].dfdx, 1e-9)) << "numBlocks: " << numBlocks << ", node: " << i;
+    }
+  }
+}
+
+TEST(test_hpiphm_interface, partialCondensingWithConstraints) {
+  int nx = 3;
+  int nu = 2;
+  int nc = 1;
+  int N = 5;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::VectorFunctionLinearApproximation> constraints;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+    constraints.emplace_back(ocs2::getRandomConstraints(nx, nu, nc));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+  constraints.emplace_back(ocs2::getRandomConstraints(nx, 0, nc));
+  ocs2::OcpSize ocpSize(N, nx, nu);
+  std::fill(ocpSize.numIneqConstraints.begin(), ocpSize.numIneqConstraints.end(), nc);
+
+  ocs2::HpipmInterface hpipmInterface(ocpSize);
+  std::vector<ocs2::vector_t> xSolGiven;
+  std::vector<ocs2::vector_t> uSolGiven;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, &constraints, xSolGiven, uSolGiven), hpipm_status::SUCCESS);
+
+  // Constrained problems are solved stage-wise
+  ocs2::HpipmInterface::Settings settings;
+  settings.numCondensingBlocks = 2;
+  ocs2::HpipmInterface condensedHpipmInterface(ocpSize, settings);
+  ASSERT_FALSE(condensedHpipmInterface.isCondensed());
+
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  ASSERT_EQ(condensedHpipmInterface.solve(x0, system, cost, &constraints, xSol, uSol), hpipm_status::SUCCESS);
+  ASSERT_TRUE(ocs2::isEqual(xSolGiven, xSol, 1e-9));
+  ASSERT_TRUE(ocs2::isEqual(uSolGiven, uSol, 1e-9));
+
+  // Without constraints, the same interface condenses after resizing
+  condensedHpipmInterface.resize(ocs2::OcpSize(N, nx, nu));
+  ASSERT_TRUE(condensedHpipmInterface.isCondensed());
+}
+
+TEST(test_hpiphm_interface, partialCondensingBenchmark) {
+  int nx = 12;
+  int nu = 4;
+  int N = 100;
+  constexpr int numRepeats = 100;
+
+  // Problem setup, a discretized stable system such that the condensed problems are well conditioned
+  const ocs2::scalar_t dt = 0.01;
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    system[k].dfdx = ocs2::matrix_t::Identity(nx, nx) + dt * system[k].dfdx;
+    system[k].dfdu *= dt;
+    system[k].f *= dt;
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+  const ocs2::OcpSize ocpSize(N, nx, nu);
+
+  std::vector<ocs2::vector_t> xSolGiven;
+  std::vector<ocs2::vector_t> uSolGiven;
+  for (int numBlocks : {0, 50, 25, 20, 10, 5}) {
+    ocs2::HpipmInterface::Settings settings;
+    settings.numCondensingBlocks = numBlocks;
+    ocs2::HpipmInterface hpipmInterface(ocpSize, settings);
+
+    std::vector<ocs2::vector_t> xSol;
+    std::vector<ocs2::vector_t> uSol;
+    ocs2::benchmark::RepeatedTimer solveTimer;
+    ocs2::benchmark::RepeatedTimer feedbackTimer;
+    for (int i = 0; i < numRepeats; i++) {
+      solveTimer.startTimer();
+      const auto status = hpipmInterface.solve(x0, system, cost, nullptr, xSol, uSol);
+      solveTimer.endTimer();
+      ASSERT_EQ(status, hpipm_status::SUCCESS);
+
+      feedbackTimer.startTimer();
+      hpipmInterface.getRiccatiFeedback(system[0], cost[0]);
+      feedbackTimer.endTimer();
+    }
+
+    // All block sizes give the solution of the stage-wise problem
+    if (numBlocks == 0) {
+      xSolGiven = xSol;
+      uSolGiven = uSol;
+    } else {
+      EXPECT_TRUE(ocs2::isEqual(xSolGiven, xSol, 1e-6)) << "numBlocks: " << numBlocks;
+      EXPECT_TRUE(ocs2::isEqual(uSolGiven, uSol, 1e-6)) << "numBlocks: " << numBlocks;
+    }
+
+    std::cout << "HPIPM with " << N << " stages in " << (hpipmInterface.isCondensed() ? numBlocks : N) << " blocks\n"
+              << "  solve    [ms]: " << solveTimer.getAverageInMilliseconds() << "\n"
+              << "  feedback [ms]: " << feedbackTimer.getAverageInMilliseconds() << "\n";
+  }
+}
@@ -29,13 +29,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
+
 #include <ocs2_core/initialization/Initializer.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
+#include <ocs2_oc/multiple_shooting/BatchDynamicsDiscretization.h>
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
+#include <ocs2_oc/oc_problem/OcpSize.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/oc_solver/SolverBase.h>
 #include <ocs2_oc/search_strategy/FilterLinesearch.h>
@@ -63,6 +67,21 @@ class SqpSolver : public SolverBase {
 
   void reset() override;
 
+  /**
+   * Preparation phase of the real-time iteration, only used with settings.realTimeIteration. The LQ approximation is set up around the
+   * previous solution shifted to [initTime, finalTime], such that the next run() only solves the QP for the new initial state and
+   * takes the full step (feedback phase). The latency of run() is then about the QP solve time.
+   *
+   * The feedback phase uses the target trajectories of the preparation. If run() does not start exactly at initTime, the first interval
+   * of the prepared grid is re-timed to start at the actual time and only the first node is approximated again. The preparation is
+   * discarded and the next run() does the full SQP if the offset exceeds settings.dt, if it leaves no first interval, or if the events
+   * within the horizon changed.
+   *
+   * @param [in] initTime: The predicted initial time of the next run() call.
+   * @param [in] finalTime: The final time of the next run() call.
+   */
+  void prepare(scalar_t initTime, scalar_t finalTime);
+
   scalar_t getFinalTime() const override { return primalSolution_.timeTrajectory_.back(); };
 
   void getPrimalSolution(scalar_t finalTime, PrimalSolution* primalSolutionPtr) const override { *primalSolutionPtr = primalSolution_; }
@@ -71,6 +90,12 @@ class SqpSolver : public SolverBase {
 
   size_t getNumIterations() const override { return totalNumIterations_; }
 
+  /** Reason why the iterations of the last run() call stopped */
+  sqp::Convergence getConvergence() const { return convergence_; }
+
+  /** Number of run() calls which only did the feedback phase of a real-time iteration, since the construction or the last reset() */
+  size_t getNumRealTimeIterations() const { return numRealTimeIterations_; }
+
   const OptimalControlProblem& getOptimalControlProblem() const override { return ocpDefinitions_.front(); }
 
   const PerformanceIndex& getPerformanceIndeces() const override { return getIterationsLog().back(); };
@@ -109,22 +134,58 @@ class SqpSolver : public SolverBase {
     primalSolution_.inputTrajectory_ = primalSolution.inputTrajectory_;
     primalSolution_.postEventIndices_ = primalSolution.postEventIndices_;
     primalSolution_.modeSchedule_ = primalSolution.modeSchedule_;
+    preparation_.isPrepared = false;
     runImpl(initTime, initState, finalTime);
   }
 
-  /** Run a task in parallel with settings.nThreads */
-  void runParallel(std::function<void(int)> taskFunction);
+  /** Run taskFunction(workerId, i) for i in [begin, end) in parallel with settings.nThreads */
+  void parallelFor(int begin, int end, std::function<void(int, int)> taskFunction);
+
+  /** Whether the last preparation phase can be used for a run() call at initTime */
+  bool isPreparedFor(scalar_t initTime) const;
+
+  /** Feedback phase of the real-time iteration: solves the prepared QP for the given initial state and takes the full step */
+  void runFeedback(scalar_t initTime, const vector_t& initState);
+
+  /** Initializes the iterate of the workspace, by shifting primalSolution_ if the horizon moved by whole steps */
+  void initializeIterate(const vector_t& initState, const std::vector<AnnotatedTime>& timeDiscretization);
+
+  /** Moves the iterate of the workspace to primalSolution_ and copies its metrics to problemMetrics_ */
+  void updatePrimalSolution(const std::vector<AnnotatedTime>& time, const std::vector<Metrics>& metrics);
 
   /** Get profiling information as a string */
   std::string getBenchmarkingInformation() const;
 
-  /** Creates QP around t, x(t), u(t). Returns performance metrics at the current {t, x(t), u(t)} */
+  /**
+   * Creates QP around t, x(t), u(t). Returns performance metrics at the current {t, x(t), u(t)}. The performance of the first node is
+   * also written to firstNodePerformancePtr if given.
+   */
   PerformanceIndex setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                            const vector_array_t& u, std::vector<Metrics>& metrics);
+                                            const vector_array_t& u, std::vector<Metrics>& metrics,
+                                            PerformanceIndex* firstNodePerformancePtr = nullptr);
 
-  /** Computes only the performance metrics at the current {t, x(t), u(t)} */
-  PerformanceIndex computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                      const vector_array_t& u, std::vector<Metrics>& metrics);
+  /**
+   * Creates the QP of node i around t, x(t), u(t) and returns its performance, without the initial state constraint. With batchDynamics,
+   * the discrete dynamics of an intermediate node are taken from the last update of batchDynamicsDiscretization_.
+   */
+  PerformanceIndex setupQuadraticSubproblemNode(OptimalControlProblem& ocpDefinition, const std::vector<AnnotatedTime>& time,
+                                                const vector_array_t& x, const vector_array_t& u, int i, bool batchDynamics,
+                                                Metrics& metrics);
+
+  /** A linesearch candidate {x(t), u(t)} <- {x(t) + a*dx(t), u(t) + a*du(t)} with its metrics */
+  struct LinesearchCandidate {
+    scalar_t stepSize = 0.0;
+    vector_array_t x, u;
+    std::vector<Metrics> metrics;
+    PerformanceIndex performance;
+  };
+
+  /**
+   * Computes only the performance metrics of the first numCandidates linesearch candidates at their {t, x(t), u(t)}. The nodes of all
+   * candidates are distributed over the threads, such that the candidates are evaluated concurrently.
+   */
+  void computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, std::vector<LinesearchCandidate>& candidates,
+                          size_t numCandidates);
 
   /** Returns solution of the QP subproblem in delta coordinates: */
   struct OcpSubproblemSolution {
@@ -132,7 +193,7 @@ class SqpSolver : public SolverBase {
     vector_array_t deltaUSol;      // delta_u(t)
     scalar_t armijoDescentMetric;  // inner product of the cost gradient and decision variable step
   };
-  OcpSubproblemSolution getOCPSolution(const vector_t& delta_x0);
+  const OcpSubproblemSolution& getOCPSolution(const vector_t& delta_x0);
 
   /** Extract the value function based on the last solved QP */
   void extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x);
@@ -140,7 +201,10 @@ class SqpSolver : public SolverBase {
   /** Constructs the primal solution based on the optimized state and input trajectories */
   PrimalSolution toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u);
 
-  /** Decides on the step to take and overrides given trajectories {x(t), u(t)} <- {x(t) + a*dx(t), u(t) + a*du(t)} */
+  /**
+   * Decides on the step to take and overrides given trajectories {x(t), u(t)} <- {x(t) + a*dx(t), u(t) + a*du(t)}. The step sizes are
+   * tried in batches of settings.numLinesearchCandidates, the largest step size of a batch that the filter accepts is taken.
+   */
   sqp::StepInfo takeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization, const vector_t& initState,
                          const OcpSubproblemSolution& subproblemSolution, vector_array_t& x, vector_array_t& u,
                          std::vector<Metrics>& metrics);
@@ -152,6 +216,7 @@ class SqpSolver : public SolverBase {
   const sqp::Settings settings_;
   DynamicsDiscretizer discretizer_;
   DynamicsSensitivityDiscretizer sensitivityDiscretizer_;
+  multiple_shooting::BatchDynamicsDiscretization batchDynamicsDiscretization_;  // used if settings.dynamicsBatchSize > 1
   std::vector<OptimalControlProblem> ocpDefinitions_;
   std::unique_ptr<Initializer> initializerPtr_;
   FilterLinesearch filterLinesearch_;
@@ -165,8 +230,37 @@ class SqpSolver : public SolverBase {
   // Solution
   PrimalSolution primalSolution_;
 
+  /**
+   * Buffers which persist across MPC calls. In steady-state MPC the problem size rarely changes, such that the trajectories are written
+   * in place and the QP solver memory is reused. Only the nodes whose dimensions change are reallocated.
+   */
+  struct Workspace {
+    OcpSize qpSize;                               // size of the last QP, the QP solver memory is re-initialized when it changes
+    vector_array_t x, u;                          // current iterate
+    std::vector<Metrics> metrics;                 // metrics of the current iterate
+    std::vector<LinesearchCandidate> candidates;  // linesearch candidates, one per concurrently evaluated step size
+    OcpSubproblemSolution qpSolution;             // solution of the last QP
+    std::vector<const scalar_t*> stateBuffers, inputBuffers;  // memory of the trajectory nodes, used for counting reallocations
+  };
+  Workspace workspace_;
+
+  // Real-time iteration, the QP of the preparation phase is set up around the iterate in the workspace
+  struct Preparation {
+    bool isPrepared = false;
+    scalar_t initTime = 0.0;
+    scalar_t finalTime = 0.0;
+    scalar_array_t eventTimes;  // event times within the horizon
+    std::vector<AnnotatedTime> timeDiscretization;
+    PerformanceIndex baselinePerformance;   // performance of the linearization point
+    PerformanceIndex firstNodePerformance;  // share of the first node in baselinePerformance, replaced if the first node is re-timed
+  };
+  Preparation preparation_;
+
   // Value function in absolute state coordinates (without the constant value)
   std::vector<ScalarFunctionQuadraticApproximation> valueFunction_;
+  // Interval of the previous getValueFunction query, such that the sequential queries of a tracking controller take O(1). The hint only
+  // affects the search cost, hence concurrent queries may overwrite each other's hint.
+  mutable std::atomic_int valueFunctionIntervalHint_{0};
 
   // LQ approximation
   std::vector<ScalarFunctionQuadraticApproximation> cost_;
@@ -188,12 +282,17 @@ class SqpSolver : public SolverBase {
   // Benchmarking
   size_t numProblems_{0};
   size_t totalNumIterations_{0};
+  sqp::Convergence convergence_ = sqp::Convergence::FALSE;
+  size_t numRealTimeIterations_{0};
+  size_t numTrajectoryBufferAllocations_{0};  // reallocated state and input nodes of the iterate, candidates and QP solution
+  size_t numQpSolverResizes_{0};              // re-initializations of the QP solver memory
   sqp::Logger<sqp::LogEntry> logger_;
   benchmark::RepeatedTimer initializationTimer_;
   benchmark::RepeatedTimer linearQuadraticApproximationTimer_;
   benchmark::RepeatedTimer solveQpTimer_;
   benchmark::RepeatedTimer linesearchTimer_;
   benchmark::RepeatedTimer computeControllerTimer_;
+  benchmark::TimeBudget runTimeBudget_;  // budget of the current run() call, predicted from the timers above
 };
 
 }  // namespace ocs2
@@ -49,9 +49,12 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   }
 
   loadData::loadPtreeValue(pt, settings.sqpIteration, fieldName + ".sqpIteration", verbose);
+  loadData::loadPtreeValue(pt, settings.maxRunTime, fieldName + ".maxRunTime", verbose);
   loadData::loadPtreeValue(pt, settings.deltaTol, fieldName + ".deltaTol", verbose);
+  loadData::loadPtreeValue(pt, settings.realTimeIteration, fieldName + ".realTimeIteration", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_decay, fieldName + ".alpha_decay", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_min, fieldName + ".alpha_min", verbose);
+  loadData::loadPtreeValue(pt, settings.numLinesearchCandidates, fieldName + ".numLinesearchCandidates", verbose);
   loadData::loadPtreeValue(pt, settings.gamma_c, fieldName + ".gamma_c", verbose);
   loadData::loadPtreeValue(pt, settings.g_max, fieldName + ".g_max", verbose);
   loadData::loadPtreeValue(pt, settings.g_min, fieldName + ".g_min", verbose);
@@ -63,6 +66,7 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   auto integratorName = sensitivity_integrator::toString(settings.integratorType);
   loadData::loadPtreeValue(pt, integratorName, fieldName + ".integratorType", verbose);
   settings.integratorType = sensitivity_integrator::fromString(integratorName);
+  loadData::loadPtreeValue(pt, settings.dynamicsBatchSize, fieldName + ".dynamicsBatchSize", verbose);
   loadData::loadPtreeValue(pt, settings.inequalityConstraintMu, fieldName + ".inequalityConstraintMu", verbose);
   loadData::loadPtreeValue(pt, settings.inequalityConstraintDelta, fieldName + ".inequalityConstraintDelta", verbose);
   loadData::loadPtreeValue(pt, settings.projectStateInputEqualityConstraints, fieldName + ".projectStateInputEqualityConstraints", verbose);
@@ -75,6 +79,11 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.logFilePath, fieldName + ".logFilePath", verbose);
   loadData::loadPtreeValue(pt, settings.nThreads, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority, fieldName + ".threadPriority", verbose);
+  auto schedulerName = thread_pool::toString(settings.threadScheduler);
+  loadData::loadPtreeValue(pt, schedulerName, fieldName + ".threadScheduler", verbose);
+  settings.threadScheduler = thread_pool::fromString(schedulerName);
+  loadData::loadStdVector(filename, fieldName + ".cpuSet", settings.cpuSet, verbose);
+  loadData::loadPtreeValue(pt, settings.pinCallingThread, fieldName + ".pinCallingThread", verbose);
 
   if (verbose) {
     std::cerr << settings.hpipmSettings;
@@ -29,12 +29,18 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/SqpSolver.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <numeric>
 
 #include <boost/filesystem.hpp>
 
+#include <ocs2_core/NumericTraits.h>
+#include <ocs2_core/automatic_differentiation/CppAdModelSwap.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+
 #include <ocs2_oc/multiple_shooting/Helpers.h>
 #include <ocs2_oc/multiple_shooting/Initialization.h>
 #include <ocs2_oc/multiple_shooting/MetricsComputation.h>
@@ -53,12 +59,42 @@ sqp::Settings rectifySettings(const OptimalControlProblem& ocp, sqp::Settings&&
   }
   return settings;
 }
+
+/** Records the memory of the nodes of a trajectory. */
+void takeBufferSnapshot(const vector_array_t& trajectory, std::vector<const scalar_t*>& buffers) {
+  buffers.resize(trajectory.size());
+  for (size_t i = 0; i < trajectory.size(); i++) {
+    buffers[i] = trajectory[i].data();
+  }
+}
+
+/** Counts the nodes of a trajectory which hold new memory since the snapshot was taken, i.e. which were (re)allocated. */
+size_t countNewBuffers(const vector_array_t& trajectory, const std::vector<const scalar_t*>& buffers) {
+  size_t count = 0;
+  for (size_t i = 0; i < trajectory.size(); i++) {
+    const auto* data = trajectory[i].data();
+    if (data != nullptr && (i >= buffers.size() || data != buffers[i])) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+/** Returns the event times within the horizon (initTime, finalTime). */
+scalar_array_t eventTimesInHorizon(const scalar_array_t& eventTimes, scalar_t initTime, scalar_t finalTime) {
+  scalar_array_t eventTimesInHorizon;
+  std::copy_if(eventTimes.cbegin(), eventTimes.cend(), std::back_inserter(eventTimesInHorizon),
+               [=](scalar_t t) { return initTime < t && t < finalTime; });
+  return eventTimesInHorizon;
+}
 }  // anonymous namespace
 
 SqpSolver::SqpSolver(sqp::Settings settings, const OptimalControlProblem& optimalControlProblem, const Initializer& initializer)
     : settings_(rectifySettings(optimalControlProblem, std::move(settings))),
+      batchDynamicsDiscretization_(settings_.integratorType, settings_.dynamicsBatchSize),
       hpipmInterface_(OcpSize(), settings_.hpipmSettings),
-      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority),
+      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority, settings_.threadScheduler,
+                  settings_.cpuSet, settings_.pinCallingThread),
       logger_(settings_.logSize) {
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
@@ -80,6 +116,7 @@ SqpSolver::SqpSolver(sqp::Settings settings, const OptimalControlProblem& optima
   filterLinesearch_.g_min = settings_.g_min;
   filterLinesearch_.gamma_c = settings_.gamma_c;
   filterLinesearch_.armijoFactor = settings_.armijoFactor;
+  workspace_.candidates.resize(std::max<size_t>(settings_.numLinesearchCandidates, 1));
 }
 
 SqpSolver::~SqpSolver() {
@@ -112,12 +149,21 @@ SqpSolver::~SqpSolver() {
 void SqpSolver::reset() {
   // Clear solution
   primalSolution_ = PrimalSolution();
+  preparation_ = Preparation();
+  problemMetrics_.clear();
+  workspace_ = Workspace();
+  workspace_.candidates.resize(std::max<size_t>(settings_.numLinesearchCandidates, 1));
   valueFunction_.clear();
+  valueFunctionIntervalHint_ = 0;
   performanceIndeces_.clear();
 
   // reset timers
   numProblems_ = 0;
   totalNumIterations_ = 0;
+  convergence_ = sqp::Convergence::FALSE;
+  numRealTimeIterations_ = 0;
+  numTrajectoryBufferAllocations_ = 0;
+  numQpSolverResizes_ = 0;
   logger_ = sqp::Logger<sqp::LogEntry>(settings_.logSize);
   linearQuadraticApproximationTimer_.reset();
   solveQpTimer_.reset();
@@ -147,6 +193,13 @@ std::string SqpSolver::getBenchmarkingInformation() const {
                << linesearchTotal / benchmarkTotal * inPercent << "%)\n";
     infoStream << "\tCompute Controller :\t" << computeControllerTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << computeControllerTotal / benchmarkTotal * inPercent << "%)\n";
+    if (settings_.hpipmSettings.numCondensingBlocks > 0) {
+      infoStream << "\tQP partially condensed :\t" << (hpipmInterface_.isCondensed() ? "yes" : "no (constrained QP)") << "\n";
+    }
+    const auto numIterations = static_cast<scalar_t>(std::max<size_t>(totalNumIterations_, 1));
+    infoStream << "\tTrajectory buffer allocations per iteration :\t"
+               << static_cast<scalar_t>(numTrajectoryBufferAllocations_) / numIterations << "\n";
+    infoStream << "\tQP solver resizes per iteration :\t" << static_cast<scalar_t>(numQpSolverResizes_) / numIterations << "\n";
   }
   return infoStream.str();
 }
@@ -164,7 +217,9 @@ ScalarFunctionQuadraticApproximation SqpSolver::getValueFunction(scalar_t time,
     throw std::runtime_error("[SqpSolver] Value function is empty! Is createValueFunction true and did the solver run?");
   } else {
     // Interpolation
-    const auto indexAlpha = LinearInterpolation::timeSegment(time, primalSolution_.timeTrajectory_);
+    int intervalHint = valueFunctionIntervalHint_.load(std::memory_order_relaxed);
+    const auto indexAlpha = LinearInterpolation::timeSegment(time, primalSolution_.timeTrajectory_, intervalHint);
+    valueFunctionIntervalHint_.store(intervalHint, std::memory_order_relaxed);
 
     ScalarFunctionQuadraticApproximation valueFunction;
     using T = std::vector<ocs2::ScalarFunctionQuadraticApproximation>;
@@ -180,7 +235,179 @@ ScalarFunctionQuadraticApproximation SqpSolver::getValueFunction(scalar_t time,
   }
 }
 
+void SqpSolver::prepare(scalar_t initTime, scalar_t finalTime) {
+  preparation_.isPrepared = false;
+  if (!settings_.realTimeIteration || primalSolution_.timeTrajectory_.empty()) {
+    return;
+  }
+
+  // Determine time discretization, taking into account event times.
+  const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
+  auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
+
+  // Shift the previous solution to the new horizon, the references of the previous run() are kept
+  const vector_t predictedState =
+      LinearInterpolation::interpolate(initTime, primalSolution_.timeTrajectory_, primalSolution_.stateTrajectory_);
+  initializeIterate(predictedState, timeDiscretization);
+  const auto& x = workspace_.x;
+  const auto& u = workspace_.u;
+
+  // The feedback phase reuses this approximation, background compiled AD models are therefore only swapped in here
+  swapCompiledCppAdModels();
+
+  // Make QP approximation, the initial state only enters in the feedback phase
+  linearQuadraticApproximationTimer_.startTimer();
+  preparation_.baselinePerformance =
+      setupQuadraticSubproblem(timeDiscretization, x.front(), x, u, workspace_.metrics, &preparation_.firstNodePerformance);
+  linearQuadraticApproximationTimer_.endTimer();
+
+  preparation_.isPrepared = true;
+  preparation_.initTime = initTime;
+  preparation_.finalTime = finalTime;
+  preparation_.eventTimes = eventTimesInHorizon(eventTimes, initTime, finalTime);
+  preparation_.timeDiscretization = std::move(timeDiscretization);
+}
+
+bool SqpSolver::isPreparedFor(scalar_t initTime) const {
+  if (!preparation_.isPrepared || std::abs(initTime - preparation_.initTime) > settings_.dt) {
+    return false;
+  }
+  // an offset is absorbed by re-timing the first interval of the prepared grid, which has to remain a regular interval
+  const auto& time = preparation_.timeDiscretization;
+  const scalar_t minIntervalDuration = 1e-3 * settings_.dt;
+  if (time.front().event == AnnotatedTime::Event::PreEvent || initTime > time[1].time - minIntervalDuration) {
+    return false;
+  }
+  // the discretization of the prepared QP is only valid if the events within the horizon did not change
+  const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
+  const scalar_t horizonStart = std::min(initTime, preparation_.initTime);
+  return eventTimesInHorizon(eventTimes, horizonStart, preparation_.finalTime) == preparation_.eventTimes;
+}
+
+void SqpSolver::runFeedback(scalar_t initTime, const vector_t& initState) {
+  auto& timeDiscretization = preparation_.timeDiscretization;
+  auto& x = workspace_.x;
+  auto& u = workspace_.u;
+  auto& metrics = workspace_.metrics;
+  PerformanceIndex baselinePerformance = preparation_.baselinePerformance;
+
+  // Re-time the first interval to start at the actual time, only the first node of the prepared QP changes
+  if (std::abs(initTime - preparation_.initTime) > numeric_traits::weakEpsilon<scalar_t>()) {
+    linearQuadraticApproximationTimer_.startTimer();
+    timeDiscretization.front().time = initTime;
+    x.front() = LinearInterpolation::interpolate(initTime, primalSolution_.timeTrajectory_, primalSolution_.stateTrajectory_);
+    const auto firstNodePerformance =
+        setupQuadraticSubproblemNode(ocpDefinitions_.front(), timeDiscretization, x, u, 0, false, metrics.front());
+    baselinePerformance += -1.0 * preparation_.firstNodePerformance;
+    baselinePerformance += firstNodePerformance;
+    baselinePerformance.merit =
+        baselinePerformance.cost + baselinePerformance.equalityLagrangian + baselinePerformance.inequalityLagrangian;
+    linearQuadraticApproximationTimer_.endTimer();
+  }
+
+  // Solve QP
+  solveQpTimer_.startTimer();
+  const vector_t delta_x0 = initState - x[0];
+  const auto& deltaSolution = getOCPSolution(delta_x0);
+  extractValueFunction(timeDiscretization, x);
+  solveQpTimer_.endTimer();
+
+  // Apply the full step, the candidate is written to the buffers of the workspace
+  linesearchTimer_.startTimer();
+  auto& xNew = workspace_.candidates.front().x;
+  auto& uNew = workspace_.candidates.front().u;
+  xNew.resize(x.size());
+  uNew.resize(u.size());
+  takeBufferSnapshot(xNew, workspace_.stateBuffers);
+  takeBufferSnapshot(uNew, workspace_.inputBuffers);
+  multiple_shooting::incrementTrajectory(u, deltaSolution.deltaUSol, 1.0, uNew);
+  multiple_shooting::incrementTrajectory(x, deltaSolution.deltaXSol, 1.0, xNew);
+  numTrajectoryBufferAllocations_ += countNewBuffers(xNew, workspace_.stateBuffers) + countNewBuffers(uNew, workspace_.inputBuffers);
+  x.swap(xNew);
+  u.swap(uNew);
+  linesearchTimer_.endTimer();
+
+  // The performance is not evaluated after the step, it is the one of the linearization point for the given initial state
+  baselinePerformance.dynamicsViolationSSE += delta_x0.squaredNorm();
+  metrics.front().dynamicsViolation += delta_x0;
+
+  sqp::StepInfo stepInfo;
+  stepInfo.stepSize = 1.0;
+  stepInfo.stepType = FilterLinesearch::StepType::FULL;
+  stepInfo.dx_norm = multiple_shooting::trajectoryNorm(deltaSolution.deltaXSol);
+  stepInfo.du_norm = multiple_shooting::trajectoryNorm(deltaSolution.deltaUSol);
+  stepInfo.performanceAfterStep = baselinePerformance;
+  stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(baselinePerformance);
+
+  performanceIndeces_.clear();
+  performanceIndeces_.push_back(baselinePerformance);
+
+  // Logging
+  if (settings_.enableLogging) {
+    auto& logEntry = logger_.currentEntry();
+    logEntry.problemNumber = numProblems_;
+    logEntry.time = initTime;
+    logEntry.iteration = 0;
+    logEntry.linearQuadraticApproximationTime = linearQuadraticApproximationTimer_.getLastIntervalInMilliseconds();
+    logEntry.solveQpTime = solveQpTimer_.getLastIntervalInMilliseconds();
+    logEntry.linesearchTime = linesearchTimer_.getLastIntervalInMilliseconds();
+    logEntry.baselinePerformanceIndex = baselinePerformance;
+    logEntry.totalConstraintViolationBaseline = FilterLinesearch::totalConstraintViolation(baselinePerformance);
+    logEntry.stepInfo = stepInfo;
+    logEntry.convergence = sqp::Convergence::ITERATIONS;
+    logger_.advance();
+  }
+
+  convergence_ = sqp::Convergence::ITERATIONS;
+  ++totalNumIterations_;
+  ++numRealTimeIterations_;
+  ++numProblems_;
+
+  updatePrimalSolution(timeDiscretization, metrics);
+  preparation_.isPrepared = false;
+
+  if (settings_.printSolverStatus || settings_.printLinesearch) {
+    std::cerr << "\n[SqpSolver] Real-time iteration feedback at time " << initTime << " with |delta_x0| = " << delta_x0.norm() << "\n";
+  }
+}
+
+void SqpSolver::initializeIterate(const vector_t& initState, const std::vector<AnnotatedTime>& timeDiscretization) {
+  auto& x = workspace_.x;
+  auto& u = workspace_.u;
+  takeBufferSnapshot(x, workspace_.stateBuffers);
+  takeBufferSnapshot(u, workspace_.inputBuffers);
+  // A previous solution on the same grid is reused verbatim, the initial state then enters through delta_x0 of the first QP
+  const auto horizonShift = multiple_shooting::findHorizonShift(timeDiscretization, primalSolution_);
+  if (horizonShift.isValid()) {
+    multiple_shooting::shiftStateInputTrajectories(horizonShift, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  } else {
+    multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  }
+  numTrajectoryBufferAllocations_ += countNewBuffers(x, workspace_.stateBuffers) + countNewBuffers(u, workspace_.inputBuffers);
+}
+
+void SqpSolver::updatePrimalSolution(const std::vector<AnnotatedTime>& time, const std::vector<Metrics>& metrics) {
+  computeControllerTimer_.startTimer();
+  auto primalSolution = toPrimalSolution(time, std::move(workspace_.x), std::move(workspace_.u));
+  // hand the buffers of the previous solution over to the workspace, such that the next call initializes them in place
+  workspace_.x.swap(primalSolution_.stateTrajectory_);
+  workspace_.u.swap(primalSolution_.inputTrajectory_);
+  primalSolution_ = std::move(primalSolution);
+  // the metrics are copied, such that neither the workspace nor problemMetrics_ reallocate when the problem size does not change
+  multiple_shooting::toProblemMetrics(time, metrics, problemMetrics_);
+  computeControllerTimer_.endTimer();
+}
+
 void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  runTimeBudget_.start(1e3 * settings_.maxRunTime);  // the budget includes the initialization
+
+  // Real-time iteration: only the feedback phase is left if this call was prepared
+  if (isPreparedFor(initTime)) {
+    runFeedback(initTime, initState);
+    return;
+  }
+  preparation_.isPrepared = false;
+
   if (settings_.printSolverStatus || settings_.printLinesearch) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     std::cerr << "\n+++++++++++++ SQP solver is initialized ++++++++++++++";
@@ -202,13 +429,14 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     std::ignore = trajectorySpread(primalSolution_.modeSchedule_, this->getReferenceManager().getModeSchedule(), primalSolution_);
   }
 
-  // Initialize the state and input
-  vector_array_t x, u;
-  multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  // Initialize the state and input in the buffers of the workspace
+  initializeIterate(initState, timeDiscretization);
+  auto& x = workspace_.x;
+  auto& u = workspace_.u;
 
   // Bookkeeping
   performanceIndeces_.clear();
-  std::vector<Metrics> metrics;
+  auto& metrics = workspace_.metrics;
 
   int iter = 0;
   sqp::Convergence convergence = sqp::Convergence::FALSE;
@@ -216,6 +444,8 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     if (settings_.printSolverStatus || settings_.printLinesearch) {
       std::cerr << "\nSQP iteration: " << iter << "\n";
     }
+    // between iterations no model is evaluated, background compiled AD models are swapped in here
+    swapCompiledCppAdModels();
     // Make QP approximation
     linearQuadraticApproximationTimer_.startTimer();
     const auto baselinePerformance = setupQuadraticSubproblem(timeDiscretization, initState, x, u, metrics);
@@ -224,7 +454,7 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     // Solve QP
     solveQpTimer_.startTimer();
     const vector_t delta_x0 = initState - x[0];
-    const auto deltaSolution = getOCPSolution(delta_x0);
+    const auto& deltaSolution = getOCPSolution(delta_x0);
     extractValueFunction(timeDiscretization, x);
     solveQpTimer_.endTimer();
 
@@ -258,12 +488,10 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     ++totalNumIterations_;
   }
 
+  convergence_ = convergence;
   ++numProblems_;
 
-  computeControllerTimer_.startTimer();
-  primalSolution_ = toPrimalSolution(timeDiscretization, std::move(x), std::move(u));
-  problemMetrics_ = multiple_shooting::toProblemMetrics(timeDiscretization, std::move(metrics));
-  computeControllerTimer_.endTimer();
+  updatePrimalSolution(timeDiscretization, metrics);
 
   if (settings_.printSolverStatus || settings_.printLinesearch) {
     std::cerr << "\nConvergence : " << toString(convergence) << "\n";
@@ -273,26 +501,34 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   }
 }
 
-void SqpSolver::runParallel(std::function<void(int)> taskFunction) {
-  threadPool_.runParallel(std::move(taskFunction), settings_.nThreads);
+void SqpSolver::parallelFor(int begin, int end, std::function<void(int, int)> taskFunction) {
+  threadPool_.parallelFor(begin, end, 1, std::move(taskFunction));
 }
 
-SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const vector_t& delta_x0) {
+const SqpSolver::OcpSubproblemSolution& SqpSolver::getOCPSolution(const vector_t& delta_x0) {
   // Solve the QP
-  OcpSubproblemSolution solution;
+  auto& solution = workspace_.qpSolution;
   auto& deltaXSol = solution.deltaXSol;
   auto& deltaUSol = solution.deltaUSol;
-  hpipm_status status;
+  // without constraints, or when using projection, we have an unconstrained QP.
   const bool hasStateInputConstraints = !ocpDefinitions_.front().equalityConstraintPtr->empty();
-  if (hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints) {
-    hpipmInterface_.resize(extractSizesFromProblem(dynamics_, cost_, &stateInputEqConstraints_));
-    status =
-        hpipmInterface_.solve(delta_x0, dynamics_, cost_, &stateInputEqConstraints_, deltaXSol, deltaUSol, settings_.printSolverStatus);
-  } else {  // without constraints, or when using projection, we have an unconstrained QP.
-    hpipmInterface_.resize(extractSizesFromProblem(dynamics_, cost_, nullptr));
-    status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+  const bool isConstrainedQp = hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints;
+  auto* constraintsPtr = isConstrainedQp ? &stateInputEqConstraints_ : nullptr;
+
+  // the QP solver memory is only re-initialized if the problem size changed
+  auto qpSize = extractSizesFromProblem(dynamics_, cost_, constraintsPtr);
+  if (!(qpSize == workspace_.qpSize)) {
+    hpipmInterface_.resize(qpSize);
+    workspace_.qpSize = std::move(qpSize);
+    ++numQpSolverResizes_;
   }
 
+  takeBufferSnapshot(deltaXSol, workspace_.stateBuffers);
+  takeBufferSnapshot(deltaUSol, workspace_.inputBuffers);
+  const auto status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, constraintsPtr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+  numTrajectoryBufferAllocations_ +=
+      countNewBuffers(deltaXSol, workspace_.stateBuffers) + countNewBuffers(deltaUSol, workspace_.inputBuffers);
+
   if (status != hpipm_status::SUCCESS) {
     throw std::runtime_error("[SqpSolver] Failed to solve QP");
   }
@@ -334,7 +570,8 @@ PrimalSolution SqpSolver::toPrimalSolution(const std::vector<AnnotatedTime>& tim
 }
 
 PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState,
-                                                     const vector_array_t& x, const vector_array_t& u, std::vector<Metrics>& metrics) {
+                                                     const vector_array_t& x, const vector_array_t& u, std::vector<Metrics>& metrics,
+                                                     PerformanceIndex* firstNodePerformancePtr) {
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
 
@@ -348,62 +585,23 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
   projectionMultiplierCoefficients_.resize(N);
   metrics.resize(N + 1);
 
-  std::atomic_int timeIndex{0};
-  auto parallelTask = [&](int workerId) {
+  // Linearize the dynamics of the intermediate nodes together, stage by stage
+  const bool batchDynamics = settings_.dynamicsBatchSize > 1;
+  if (batchDynamics) {
+    batchDynamicsDiscretization_.update(threadPool_, ocpDefinitions_, time, x, u);
+  }
+
+  auto parallelTask = [&](int workerId, int i) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
-    PerformanceIndex workerPerformance;  // Accumulate performance in local variable
-
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
-        workerPerformance += multiple_shooting::computePerformanceIndex(result);
-        cost_[i] = std::move(result.cost);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i].resize(0, x[i].size());
-        stateIneqConstraints_[i] = std::move(result.ineqConstraints);
-        stateInputIneqConstraints_[i].resize(0, x[i].size());
-        constraintsProjection_[i].resize(0, x[i].size());
-        projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
-      } else {
-        // Normal, intermediate node
-        const scalar_t ti = getIntervalStart(time[i]);
-        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
-        workerPerformance += multiple_shooting::computePerformanceIndex(result, dt);
-        if (settings_.projectStateInputEqualityConstraints) {
-          multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier);
-        }
-        cost_[i] = std::move(result.cost);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
-        stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
-        stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
-        constraintsProjection_[i] = std::move(result.constraintsProjection);
-        projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
-      }
-
-      i = timeIndex++;
-    }
 
-    if (i == N) {  // Only one worker will execute this
-      const scalar_t tN = getIntervalStart(time[N]);
-      auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
-      metrics[i] = multiple_shooting::computeMetrics(result);
-      workerPerformance += multiple_shooting::computePerformanceIndex(result);
-      cost_[i] = std::move(result.cost);
-      stateInputEqConstraints_[i].resize(0, x[i].size());
-      stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+    const auto nodePerformance = setupQuadraticSubproblemNode(ocpDefinition, time, x, u, i, batchDynamics, metrics[i]);
+    performance[workerId] += nodePerformance;
+    if (i == 0 && firstNodePerformancePtr != nullptr) {
+      *firstNodePerformancePtr = nodePerformance;
     }
-
-    // Accumulate! Same worker might run multiple tasks
-    performance[workerId] += workerPerformance;
   };
-  runParallel(std::move(parallelTask));
+  parallelFor(0, N + 1, std::move(parallelTask));
 
   // Account for initial state in performance
   const vector_t initDynamicsViolation = initState - x.front();
@@ -417,52 +615,114 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
   return totalPerformance;
 }
 
-PerformanceIndex SqpSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                               const vector_array_t& u, std::vector<Metrics>& metrics) {
+PerformanceIndex SqpSolver::setupQuadraticSubproblemNode(OptimalControlProblem& ocpDefinition, const std::vector<AnnotatedTime>& time,
+                                                         const vector_array_t& x, const vector_array_t& u, int i, bool batchDynamics,
+                                                         Metrics& metrics) {
+  const int N = static_cast<int>(time.size()) - 1;
+
+  if (i == N) {
+    // Terminal node
+    const scalar_t tN = getIntervalStart(time[N]);
+    auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
+    metrics = multiple_shooting::computeMetrics(result);
+    cost_[i] = std::move(result.cost);
+    stateInputEqConstraints_[i].resize(0, x[i].size());
+    stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+    return multiple_shooting::computePerformanceIndex(result);
+  } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
+    // Event node
+    auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
+    metrics = multiple_shooting::computeMetrics(result);
+    cost_[i] = std::move(result.cost);
+    dynamics_[i] = std::move(result.dynamics);
+    stateInputEqConstraints_[i].resize(0, x[i].size());
+    stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+    stateInputIneqConstraints_[i].resize(0, x[i].size());
+    constraintsProjection_[i].resize(0, x[i].size());
+    projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
+    return multiple_shooting::computePerformanceIndex(result);
+  } else {
+    // Normal, intermediate node
+    const scalar_t ti = getIntervalStart(time[i]);
+    const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+    auto result =
+        batchDynamics
+            ? multiple_shooting::setupIntermediateNode(ocpDefinition, batchDynamicsDiscretization_.getDiscreteDynamics(i), ti, dt, x[i],
+                                                       x[i + 1], u[i])
+            : multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
+    metrics = multiple_shooting::computeMetrics(result);
+    const auto performance = multiple_shooting::computePerformanceIndex(result, dt);
+    if (settings_.projectStateInputEqualityConstraints) {
+      multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier);
+    }
+    cost_[i] = std::move(result.cost);
+    dynamics_[i] = std::move(result.dynamics);
+    stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
+    stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
+    stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
+    constraintsProjection_[i] = std::move(result.constraintsProjection);
+    projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
+    return performance;
+  }
+}
+
+void SqpSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState,
+                                   std::vector<LinesearchCandidate>& candidates, size_t numCandidates) {
   // Problem size
   const int N = static_cast<int>(time.size()) - 1;
-  metrics.resize(N + 1);
+  const int numNodes = N + 1;
+  for (size_t c = 0; c < numCandidates; c++) {
+    candidates[c].metrics.resize(N + 1);
+  }
 
-  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
-  std::atomic_int timeIndex{0};
-  auto parallelTask = [&](int workerId) {
+  // one performance index per candidate and worker
+  std::vector<PerformanceIndex> performance(numCandidates * settings_.nThreads, PerformanceIndex());
+  auto parallelTask = [&](int workerId, int k) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        performance[workerId] += toPerformanceIndex(metrics[i]);
-      } else {
-        // Normal, intermediate node
-        const scalar_t ti = getIntervalStart(time[i]);
-        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        performance[workerId] += toPerformanceIndex(metrics[i], dt);
-      }
-
-      i = timeIndex++;
-    }
+    // Task k is the node i of candidate c
+    const size_t c = k / numNodes;
+    const int i = k % numNodes;
+    const auto& x = candidates[c].x;
+    const auto& u = candidates[c].u;
+    auto& metrics = candidates[c].metrics;
+    auto& candidatePerformance = performance[c * settings_.nThreads + workerId];
 
-    if (i == N) {  // Only one worker will execute this
+    if (i == N) {
+      // Terminal node
       const scalar_t tN = getIntervalStart(time[N]);
       metrics[N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
-      performance[workerId] += toPerformanceIndex(metrics[N]);
+      candidatePerformance += toPerformanceIndex(metrics[N]);
+    } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      // Event node
+      metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
+      candidatePerformance += toPerformanceIndex(metrics[i]);
+    } else {
+      // Normal, intermediate node
+      const scalar_t ti = getIntervalStart(time[i]);
+      const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+      metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
+      candidatePerformance += toPerformanceIndex(metrics[i], dt);
     }
   };
-  runParallel(std::move(parallelTask));
-
-  // Account for initial state in performance
-  const vector_t initDynamicsViolation = initState - x.front();
-  metrics.front().dynamicsViolation += initDynamicsViolation;
-  performance.front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
-
-  // Sum performance of the threads
-  PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
-  totalPerformance.merit = totalPerformance.cost + totalPerformance.equalityLagrangian + totalPerformance.inequalityLagrangian;
-  return totalPerformance;
+  parallelFor(0, static_cast<int>(numCandidates) * numNodes, std::move(parallelTask));
+
+  for (size_t c = 0; c < numCandidates; c++) {
+    auto& candidate = candidates[c];
+    const auto performanceBegin = std::next(performance.begin(), c * settings_.nThreads);
+    const auto performanceEnd = std::next(performanceBegin, settings_.nThreads);
+
+    // Account for initial state in performance
+    const vector_t initDynamicsViolation = initState - candidate.x.front();
+    candidate.metrics.front().dynamicsViolation += initDynamicsViolation;
+    performanceBegin->dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+
+    // Sum performance of the threads
+    candidate.performance = std::accumulate(std::next(performanceBegin), performanceEnd, *performanceBegin);
+    candidate.performance.merit = candidate.performance.cost + candidate.performance.equalityLagrangian +
+                                  candidate.performance.inequalityLagrangian;
+  }
 }
 
 sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
@@ -490,59 +750,79 @@ sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::v
   const auto deltaUnorm = multiple_shooting::trajectoryNorm(du);
   const auto deltaXnorm = multiple_shooting::trajectoryNorm(dx);
 
+  // the candidates are written to the buffers of the workspace
+  auto& candidates = workspace_.candidates;
+  for (auto& candidate : candidates) {
+    candidate.x.resize(x.size());
+    candidate.u.resize(u.size());
+  }
+
   scalar_t alpha = 1.0;
-  vector_array_t xNew(x.size());
-  vector_array_t uNew(u.size());
-  std::vector<Metrics> metricsNew(metrics.size());
-  do {
-    // Compute step
-    multiple_shooting::incrementTrajectory(u, du, alpha, uNew);
-    multiple_shooting::incrementTrajectory(x, dx, alpha, xNew);
-
-    // Compute cost and constraints
-    const PerformanceIndex performanceNew = computePerformance(timeDiscretization, initState, xNew, uNew, metricsNew);
-
-    // Step acceptance and record step type
-    bool stepAccepted;
-    StepType stepType;
-    std::tie(stepAccepted, stepType) =
-        filterLinesearch_.acceptStep(baseline, performanceNew, alpha * subproblemSolution.armijoDescentMetric);
-
-    if (settings_.printLinesearch) {
-      std::cerr << "Step size: " << alpha << ", Step Type: " << toString(stepType)
-                << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
-      std::cerr << "|dx| = " << alpha * deltaXnorm << "\t|du| = " << alpha * deltaUnorm << "\n";
-      std::cerr << performanceNew << "\n";
-    }
+  bool isStepTooSmall = false;
+  bool hasCandidates = true;
+  while (hasCandidates) {
+    // Compute the steps of the next batch of candidates
+    size_t numCandidates = 0;
+    while (hasCandidates && numCandidates < candidates.size()) {
+      auto& candidate = candidates[numCandidates++];
+      candidate.stepSize = alpha;
+      takeBufferSnapshot(candidate.x, workspace_.stateBuffers);
+      takeBufferSnapshot(candidate.u, workspace_.inputBuffers);
+      multiple_shooting::incrementTrajectory(u, du, alpha, candidate.u);
+      multiple_shooting::incrementTrajectory(x, dx, alpha, candidate.x);
+      numTrajectoryBufferAllocations_ += countNewBuffers(candidate.x, workspace_.stateBuffers);
+      numTrajectoryBufferAllocations_ += countNewBuffers(candidate.u, workspace_.inputBuffers);
 
-    if (stepAccepted) {  // Return if step accepted
-      x = std::move(xNew);
-      u = std::move(uNew);
-      metrics = std::move(metricsNew);
-
-      // Prepare step info
-      sqp::StepInfo stepInfo;
-      stepInfo.stepSize = alpha;
-      stepInfo.stepType = stepType;
-      stepInfo.dx_norm = alpha * deltaXnorm;
-      stepInfo.du_norm = alpha * deltaUnorm;
-      stepInfo.performanceAfterStep = performanceNew;
-      stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(performanceNew);
-      return stepInfo;
-
-    } else {  // Try smaller step
+      // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
       alpha *= settings_.alpha_decay;
+      isStepTooSmall = alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol;
+      hasCandidates = !isStepTooSmall && alpha >= settings_.alpha_min;
+    }
 
-      // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
-      if (alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol) {
-        if (settings_.printLinesearch) {
-          std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
-                    << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
-        }
-        break;
+    // Compute cost and constraints of all candidates of the batch
+    computePerformance(timeDiscretization, initState, candidates, numCandidates);
+
+    // Step acceptance in the order of decreasing step size, such that the largest accepted step is taken
+    for (size_t c = 0; c < numCandidates; c++) {
+      auto& candidate = candidates[c];
+      const scalar_t stepSize = candidate.stepSize;
+      const PerformanceIndex& performanceNew = candidate.performance;
+
+      bool stepAccepted;
+      StepType stepType;
+      std::tie(stepAccepted, stepType) =
+          filterLinesearch_.acceptStep(baseline, performanceNew, stepSize * subproblemSolution.armijoDescentMetric);
+
+      if (settings_.printLinesearch) {
+        std::cerr << "Step size: " << stepSize << ", Step Type: " << toString(stepType)
+                  << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
+        std::cerr << "|dx| = " << stepSize * deltaXnorm << "\t|du| = " << stepSize * deltaUnorm << "\n";
+        std::cerr << performanceNew << "\n";
+      }
+
+      if (stepAccepted) {  // Return if step accepted
+        // swap such that the buffers of the previous iterate are reused for the next candidate
+        x.swap(candidate.x);
+        u.swap(candidate.u);
+        metrics.swap(candidate.metrics);
+
+        // Prepare step info
+        sqp::StepInfo stepInfo;
+        stepInfo.stepSize = stepSize;
+        stepInfo.stepType = stepType;
+        stepInfo.dx_norm = stepSize * deltaXnorm;
+        stepInfo.du_norm = stepSize * deltaUnorm;
+        stepInfo.performanceAfterStep = performanceNew;
+        stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(performanceNew);
+        return stepInfo;
       }
     }
-  } while (alpha >= settings_.alpha_min);
+  }
+
+  if (isStepTooSmall && settings_.printLinesearch) {
+    std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
+              << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
+  }
 
   // Alpha_min reached -> Don't take a step
   sqp::StepInfo stepInfo;
@@ -575,6 +855,10 @@ sqp::Convergence SqpSolver::checkConvergence(int iteration, const PerformanceInd
   } else if (stepInfo.dx_norm < settings_.deltaTol && stepInfo.du_norm < settings_.deltaTol) {
     // Converged because the change in primal variables is below the specified tolerance
     return Convergence::PRIMAL;
+  } else if (!runTimeBudget_.fits(benchmark::TimeBudget::predictDurationInMilliseconds(
+                 {&linearQuadraticApproximationTimer_, &solveQpTimer_, &linesearchTimer_, &computeControllerTimer_}))) {
+    // Terminated because the next iteration and the controller computation are predicted to exceed the time budget
+    return Convergence::TIME;
   } else {
     // None of the above convergence criteria were met -> not converged.
     return Convergence::FALSE;
@@ -141,3 +141,94 @@ TEST(test_circular_kinematics, solve_EqConstraints_inQPSubproblem) {
     ASSERT_TRUE(u.isApprox(primalSolution.controllerPtr_->computeInput(t, x)));
   }
 }
+
+TEST(test_circular_kinematics, parallelLinesearch) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+  settings.nThreads = 3;
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Solve with the sequential and the parallel linesearch, the largest accepted step size is the same
+  auto solve = [&](size_t numLinesearchCandidates) {
+    settings.numLinesearchCandidates = numLinesearchCandidates;
+    ocs2::SqpSolver solver(settings, problem, zeroInitializer);
+    solver.run(startTime, initState, finalTime);
+    return solver.primalSolution(finalTime);
+  };
+  const auto sequentialSolution = solve(1);
+  const auto parallelSolution = solve(3);
+
+  ASSERT_EQ(sequentialSolution.timeTrajectory_.size(), parallelSolution.timeTrajectory_.size());
+  for (int i = 0; i < sequentialSolution.timeTrajectory_.size(); i++) {
+    ASSERT_TRUE(sequentialSolution.stateTrajectory_[i].isApprox(parallelSolution.stateTrajectory_[i], 1e-9));
+    ASSERT_TRUE(sequentialSolution.inputTrajectory_[i].isApprox(parallelSolution.inputTrajectory_[i], 1e-9));
+  }
+}
+
+TEST(test_circular_kinematics, maxRunTime) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 1000;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useFeedbackPolicy = true;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Without a time budget the solver converges after more than one iteration
+  ocs2::SqpSolver referenceSolver(settings, problem, zeroInitializer);
+  referenceSolver.run(startTime, initState, finalTime);
+  ASSERT_NE(referenceSolver.getConvergence(), ocs2::sqp::Convergence::TIME);
+  ASSERT_NE(referenceSolver.getConvergence(), ocs2::sqp::Convergence::ITERATIONS);
+  ASSERT_GT(referenceSolver.getNumIterations(), 1u);
+
+  // The budget is exhausted after the first iteration, which always runs
+  settings.maxRunTime = 1e-6;
+  ocs2::SqpSolver solver(settings, problem, zeroInitializer);
+  solver.run(startTime, initState, finalTime);
+  ASSERT_EQ(solver.getConvergence(), ocs2::sqp::Convergence::TIME);
+  ASSERT_EQ(solver.getNumIterations(), 1u);
+
+  // The solution of the first iteration is returned
+  const auto primalSolution = solver.primalSolution(finalTime);
+  ASSERT_TRUE(primalSolution.stateTrajectory_.front().isApprox(initState));
+  ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.front(), startTime);
+  ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.back(), finalTime);
+  ASSERT_TRUE(primalSolution.controllerPtr_ != nullptr);
+  for (int i = 0; i < primalSolution.timeTrajectory_.size() - 1; i++) {
+    const auto t = primalSolution.timeTrajectory_[i];
+    const auto& x = primalSolution.stateTrajectory_[i];
+    const auto& u = primalSolution.inputTrajectory_[i];
+    ASSERT_TRUE(x.allFinite());
+    ASSERT_TRUE(u.allFinite());
+    ASSERT_TRUE(u.isApprox(primalSolution.controllerPtr_->computeInput(t, x)));
+  }
+}